@@ -32,6 +32,7 @@ option(SEQUOIA_ENGINE_ASAN "Enable Clang's address sanitizer (asan)" OFF)
 
 option(SEQUOIA_ENGINE_TESTING "Enable testing" ON)
 option(SEQUOIA_ENGINE_BENCHMARKING "Enable benchmarking" OFF)
+option(SEQUOIA_ENGINE_TOOLS "Build the tools (e.g SequoiaPack)" ON)
 
 sequoia_export_options(SEQUOIA_ENGINE
   SEQUOIA_ENGINE_ASSERTS
@@ -42,4 +43,5 @@ sequoia_export_options(SEQUOIA_ENGINE
   SEQUOIA_ENGINE_ASAN
   SEQUOIA_ENGINE_TESTING
   SEQUOIA_ENGINE_BENCHMARKING
+  SEQUOIA_ENGINE_TOOLS
 )
\ No newline at end of file
@@ -0,0 +1,257 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                         _____                        _
+//                        / ____|                      (_)
+//                       | (___   ___  __ _ _   _  ___  _  __ _
+//                        \___ \ / _ \/ _` | | | |/ _ \| |/ _` |
+//                        ____) |  __/ (_| | |_| | (_) | | (_| |
+//                       |_____/ \___|\__, |\__,_|\___/|_|\__,_| - Game Engine (2016-2017)
+//                                       | |
+//                                       |_|
+//
+// This file is distributed under the MIT License (MIT).
+// See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#include "sequoia-engine/Core/Archive.h"
+#include "sequoia-engine/Core/Assert.h"
+#include "sequoia-engine/Core/Compression.h"
+#include "sequoia-engine/Core/Exception.h"
+#include "sequoia-engine/Core/Hash.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+namespace sequoia {
+
+namespace core {
+
+static_assert(sizeof(Archive::Header) == 48, "Archive::Header is expected to be unpadded");
+static_assert(sizeof(Archive::Entry) == 48, "Archive::Entry is expected to be unpadded");
+
+static const char ArchiveMagic[4] = {'S', 'Q', 'P', 'A'};
+
+namespace {
+
+inline std::uint64_t alignTo(std::uint64_t value, std::uint64_t alignment) noexcept {
+  return (value + alignment - 1) & ~(alignment - 1);
+}
+
+inline bool compareHash(const Archive::Entry& entry, std::uint64_t hash) noexcept {
+  return entry.Hash < hash;
+}
+
+inline bool isSeparator(char c) noexcept { return c == '/' || c == '\\'; }
+
+/// @brief Compare the paths `a` and `b` (ignoring the kind of path separators)
+inline bool equalPaths(StringRef a, StringRef b) noexcept {
+  return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin(), [](char x, char y) {
+           return x == y || (isSeparator(x) && isSeparator(y));
+         });
+}
+
+} // anonymous namespace
+
+//===------------------------------------------------------------------------------------------===//
+//    Archive
+//===------------------------------------------------------------------------------------------===//
+
+constexpr std::uint32_t Archive::Version;
+
+Archive::Archive(const platform::Path& path)
+    : file_(std::make_shared<MappedFile>(path)), paths_(nullptr) {
+  const Byte* data = file_->getData();
+  const std::uint64_t numBytes = file_->getNumBytes();
+  const std::string pathStr = platform::toAnsiString(path);
+
+  auto invalid = [&pathStr](const char* reason) {
+    SEQUOIA_THROW(Exception, "invalid archive \"{}\": {}", pathStr, reason);
+  };
+
+  if(numBytes < sizeof(Header))
+    invalid("file too small");
+
+  Header header;
+  std::memcpy(&header, data, sizeof(Header));
+
+  if(std::memcmp(header.Magic, ArchiveMagic, sizeof(ArchiveMagic)) != 0)
+    invalid("not an archive");
+
+  if(header.Version != Version)
+    invalid("version mismatch");
+
+  // Validate the table of contents and the paths (the mapping is page aligned, the entries can
+  // thus be accessed in-place)
+  if(header.EntriesOffset % alignof(Entry) != 0 || header.EntriesOffset > numBytes ||
+     header.NumEntries > (numBytes - header.EntriesOffset) / sizeof(Entry))
+    invalid("table of contents out of bounds");
+
+  if(header.PathsOffset > numBytes || header.PathsNumBytes > numBytes - header.PathsOffset)
+    invalid("paths out of bounds");
+
+  entries_ = ArrayRef<Entry>(reinterpret_cast<const Entry*>(data + header.EntriesOffset),
+                             header.NumEntries);
+  paths_ = reinterpret_cast<const char*>(data + header.PathsOffset);
+
+  for(std::size_t i = 0; i < entries_.size(); ++i) {
+    const Entry& entry = entries_[i];
+    if(entry.Offset > numBytes || entry.NumBytes > numBytes - entry.Offset)
+      invalid("blob out of bounds");
+    if(std::uint64_t(entry.PathOffset) + entry.PathLength > header.PathsNumBytes)
+      invalid("path out of bounds");
+    if(!entry.isCompressed() && entry.NumBytes != entry.NumBytesUncompressed)
+      invalid("size mismatch");
+    // The uncompressed size is allocated before decompressing, hence it has to be bounded
+    if(entry.isCompressed() &&
+       entry.NumBytesUncompressed > compression::getDecompressBound(entry.NumBytes))
+      invalid("uncompressed size exceeds the maximum compression ratio");
+    if(i > 0 && entries_[i - 1].Hash > entry.Hash)
+      invalid("table of contents is not sorted");
+  }
+}
+
+const Archive::Entry* Archive::find(StringRef path) const noexcept {
+  const std::uint64_t h = hash(path);
+  for(auto it = std::lower_bound(entries_.begin(), entries_.end(), h, compareHash);
+      it != entries_.end() && it->Hash == h; ++it) {
+    // Resolve hash collisions
+    if(equalPaths(getPath(*it), path))
+      return it;
+  }
+  return nullptr;
+}
+
+StringRef Archive::getPath(const Entry& entry) const noexcept {
+  return StringRef(paths_ + entry.PathOffset, entry.PathLength);
+}
+
+const Byte* Archive::getBlob(const Entry& entry) const noexcept {
+  return file_->getData() + entry.Offset;
+}
+
+std::uint64_t Archive::hash(StringRef path) noexcept {
+  std::uint64_t h = core::fnv1a(nullptr, 0);
+  for(char c : path) {
+    if(isSeparator(c))
+      c = '/';
+    h = core::fnv1a(&c, 1, h);
+  }
+  return h;
+}
+
+//===------------------------------------------------------------------------------------------===//
+//    ArchiveWriter
+//===------------------------------------------------------------------------------------------===//
+
+ArchiveWriter::ArchiveWriter(std::size_t alignment)
+    : alignment_(alignment), numBytesUncompressed_(0), numBytes_(0) {
+  SEQUOIA_ASSERT_MSG(alignment_ > 0 && (alignment_ & (alignment_ - 1)) == 0,
+                     "alignment must be a power of 2");
+}
+
+void ArchiveWriter::add(StringRef path, const Byte* data, std::size_t numBytes, bool compress) {
+  PendingEntry entry;
+  entry.Path = path.str();
+  std::replace(entry.Path.begin(), entry.Path.end(), '\\', '/');
+  entry.Hash = Archive::hash(entry.Path);
+  entry.NumBytesUncompressed = numBytes;
+  entry.Compressed = false;
+
+  for(const PendingEntry& e : entries_)
+    if(e.Hash == entry.Hash && e.Path == entry.Path)
+      SEQUOIA_THROW(Exception, "cannot add \"{}\" to archive: file already exists", entry.Path);
+
+  if(compress && numBytes > 0 && numBytes <= std::size_t(UINT32_MAX)) {
+    entry.Data.resize(compression::getCompressBound(numBytes));
+    std::size_t numBytesCompressed =
+        compression::compress(data, numBytes, entry.Data.data(), entry.Data.size());
+
+    // Only keep the compressed data if it actually saves space
+    if(numBytesCompressed > 0 && numBytesCompressed < numBytes) {
+      entry.Data.resize(numBytesCompressed);
+      entry.Compressed = true;
+    }
+  }
+
+  if(!entry.Compressed)
+    entry.Data.assign(data, data + numBytes);
+
+  numBytesUncompressed_ += numBytes;
+  numBytes_ += entry.Data.size();
+  entries_.emplace_back(std::move(entry));
+}
+
+void ArchiveWriter::write(const platform::Path& path) const {
+  const std::string pathStr = platform::toAnsiString(path);
+
+  // Blobs are stored in path order (this keeps archives reproducible and files of the same
+  // directory close to each other), the table of contents is sorted by hash
+  std::vector<const PendingEntry*> pendingEntries;
+  for(const PendingEntry& entry : entries_)
+    pendingEntries.push_back(&entry);
+  std::sort(pendingEntries.begin(), pendingEntries.end(),
+            [](const PendingEntry* a, const PendingEntry* b) { return a->Path < b->Path; });
+
+  std::vector<Archive::Entry> entries;
+  std::string paths;
+  std::uint64_t offset = alignTo(sizeof(Archive::Header), alignment_);
+
+  for(const PendingEntry* pendingEntry : pendingEntries) {
+    Archive::Entry entry;
+    entry.Hash = pendingEntry->Hash;
+    entry.Offset = offset;
+    entry.NumBytes = pendingEntry->Data.size();
+    entry.NumBytesUncompressed = pendingEntry->NumBytesUncompressed;
+    entry.PathOffset = static_cast<std::uint32_t>(paths.size());
+    entry.PathLength = static_cast<std::uint32_t>(pendingEntry->Path.size());
+    entry.Flags = pendingEntry->Compressed ? Archive::EF_Compressed : Archive::EF_None;
+    entry.Padding = 0;
+    entries.push_back(entry);
+
+    paths += pendingEntry->Path;
+    offset = alignTo(offset + entry.NumBytes, alignment_);
+  }
+
+  auto byHash = [](const Archive::Entry& a, const Archive::Entry& b) { return a.Hash < b.Hash; };
+  std::stable_sort(entries.begin(), entries.end(), byHash);
+
+  Archive::Header header;
+  std::memcpy(header.Magic, ArchiveMagic, sizeof(ArchiveMagic));
+  header.Version = Archive::Version;
+  header.NumEntries = entries.size();
+  header.EntriesOffset = alignTo(offset, alignof(Archive::Entry));
+  header.PathsOffset = header.EntriesOffset + entries.size() * sizeof(Archive::Entry);
+  header.PathsNumBytes = paths.size();
+  header.Alignment = alignment_;
+
+  std::ofstream file(pathStr.c_str(), std::ios_base::out | std::ios_base::binary);
+  if(!file.is_open())
+    SEQUOIA_THROW(Exception, "cannot open archive: \"{}\"", pathStr);
+
+  const char zeros[256] = {0};
+  std::uint64_t position = 0;
+  auto writeBytes = [&](const void* data, std::size_t numBytes) {
+    file.write(static_cast<const char*>(data), numBytes);
+    position += numBytes;
+  };
+  auto pad = [&](std::uint64_t target) {
+    while(position < target)
+      writeBytes(zeros, std::min<std::uint64_t>(sizeof(zeros), target - position));
+  };
+
+  writeBytes(&header, sizeof(header));
+  for(const PendingEntry* pendingEntry : pendingEntries) {
+    pad(alignTo(position, alignment_));
+    writeBytes(pendingEntry->Data.data(), pendingEntry->Data.size());
+  }
+  pad(header.EntriesOffset);
+  writeBytes(entries.data(), entries.size() * sizeof(Archive::Entry));
+  writeBytes(paths.data(), paths.size());
+
+  if(file.fail())
+    SEQUOIA_THROW(Exception, "failed to write archive: \"{}\"", pathStr);
+}
+
+} // namespace core
+
+} // namespace sequoia
@@ -0,0 +1,198 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                         _____                        _
+//                        / ____|                      (_)
+//                       | (___   ___  __ _ _   _  ___  _  __ _
+//                        \___ \ / _ \/ _` | | | |/ _ \| |/ _` |
+//                        ____) |  __/ (_| | |_| | (_) | | (_| |
+//                       |_____/ \___|\__, |\__,_|\___/|_|\__,_| - Game Engine (2016-2017)
+//                                       | |
+//                                       |_|
+//
+// This file is distributed under the MIT License (MIT).
+// See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#ifndef SEQUOIA_ENGINE_CORE_ARCHIVE_H
+#define SEQUOIA_ENGINE_CORE_ARCHIVE_H
+
+#include "sequoia-engine/Core/ArrayRef.h"
+#include "sequoia-engine/Core/Byte.h"
+#include "sequoia-engine/Core/Export.h"
+#include "sequoia-engine/Core/MappedFile.h"
+#include "sequoia-engine/Core/Memory.h"
+#include "sequoia-engine/Core/NonCopyable.h"
+#include "sequoia-engine/Core/Platform.h"
+#include "sequoia-engine/Core/StringRef.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace sequoia {
+
+namespace core {
+
+/// @brief Read-only view of a packed archive of files
+///
+/// An archive bundles many (small) files into a single file which is mapped into memory as a
+/// whole. Looking up a file is a binary search over the table of contents and the (uncompressed)
+/// content of a file can be used in-place, thus no syscalls are involved after opening the
+/// archive. Archives are created with `ArchiveWriter` (see also the `SequoiaPack` tool).
+///
+/// The layout of the archive is
+///
+/// @verbatim
+///   +----------------------+
+///   | Header               |
+///   +----------------------+
+///   | Blob 0               |  <- aligned to Header::Alignment
+///   | ...                  |
+///   | Blob N-1             |
+///   +----------------------+
+///   | Entry 0              |  <- table of contents, sorted by Entry::Hash
+///   | ...                  |
+///   | Entry N-1            |
+///   +----------------------+
+///   | Paths                |  <- concatenated paths of the entries
+///   +----------------------+
+/// @endverbatim
+///
+/// All integers are stored in the native byte order.
+///
+/// @ingroup core
+class SEQUOIA_API Archive : public NonCopyable {
+public:
+  /// @brief Header of the archive
+  struct Header {
+    char Magic[4];               ///< Magic bytes "SQPA"
+    std::uint32_t Version;       ///< Version of the format
+    std::uint64_t NumEntries;    ///< Number of entries in the table of contents
+    std::uint64_t EntriesOffset; ///< Offset of the table of contents
+    std::uint64_t PathsOffset;   ///< Offset of the path strings
+    std::uint64_t PathsNumBytes; ///< Size of the path strings
+    std::uint64_t Alignment;     ///< Alignment of the blobs
+  };
+
+  /// @brief Flags of an entry
+  enum EntryFlags : std::uint32_t {
+    EF_None = 0,
+    EF_Compressed = 1 << 0 ///< Blob is compressed with `compression::compress`
+  };
+
+  /// @brief Entry of the table of contents
+  struct Entry {
+    std::uint64_t Hash;                 ///< Hash of the path (see `Archive::hash`)
+    std::uint64_t Offset;               ///< Offset of the blob
+    std::uint64_t NumBytes;             ///< Size of the blob
+    std::uint64_t NumBytesUncompressed; ///< Size of the file
+    std::uint32_t PathOffset;           ///< Offset of the path (relative to Header::PathsOffset)
+    std::uint32_t PathLength;           ///< Length of the path
+    std::uint32_t Flags;                ///< Combination of `EntryFlags`
+    std::uint32_t Padding;              ///< Unused
+
+    /// @brief Check if the blob is compressed
+    bool isCompressed() const noexcept { return Flags & EF_Compressed; }
+  };
+
+  /// @brief Current version of the format
+  static constexpr std::uint32_t Version = 1;
+
+  /// @brief Map and validate the archive `path`
+  /// @throws Exception   Archive cannot be opened or is invalid
+  Archive(const platform::Path& path);
+
+  /// @brief Find the entry of `path` or return `nullptr` if `path` is not part of the archive
+  const Entry* find(StringRef path) const noexcept;
+
+  /// @brief Get the path of `entry`
+  StringRef getPath(const Entry& entry) const noexcept;
+
+  /// @brief Get the (possibly compressed) blob of `entry`
+  const Byte* getBlob(const Entry& entry) const noexcept;
+
+  /// @brief Get the table of contents
+  ArrayRef<Entry> getEntries() const noexcept { return entries_; }
+
+  /// @brief Get the mapped archive
+  const std::shared_ptr<MappedFile>& getMappedFile() const noexcept { return file_; }
+
+  /// @brief Compute the hash of `path`
+  ///
+  /// Path separators are normalized i.e "foo\bar.png" and "foo/bar.png" refer to the same entry.
+  static std::uint64_t hash(StringRef path) noexcept;
+
+private:
+  /// Mapped archive
+  std::shared_ptr<MappedFile> file_;
+
+  /// Table of contents
+  ArrayRef<Entry> entries_;
+
+  /// Concatenated paths of the entries
+  const char* paths_;
+};
+
+/// @brief Create an `Archive`
+///
+/// @code{.cpp}
+///   ArchiveWriter writer;
+///   writer.add("foo/bar.txt", data, numBytes, true);
+///   writer.write("assets.sqpa");
+/// @endcode
+///
+/// @ingroup core
+class SEQUOIA_API ArchiveWriter : public NonCopyable {
+public:
+  /// @brief Initialize the writer
+  /// @param alignment  Alignment of the blobs (needs to be a power of 2)
+  ArchiveWriter(std::size_t alignment = memory::DefaultAlignment);
+
+  /// @brief Add the file `path` with content `data` of `numBytes` bytes
+  ///
+  /// If `compress` is `true`, the content is compressed unless this does not save any space.
+  ///
+  /// @throws Exception   `path` was already added
+  void add(StringRef path, const Byte* data, std::size_t numBytes, bool compress = false);
+
+  /// @brief Write the archive to `path`
+  /// @throws Exception   Failed to write the archive
+  void write(const platform::Path& path) const;
+
+  /// @brief Get the number of added files
+  std::size_t getNumEntries() const noexcept { return entries_.size(); }
+
+  /// @brief Get the accumulated size of the added files
+  std::size_t getNumBytesUncompressed() const noexcept { return numBytesUncompressed_; }
+
+  /// @brief Get the accumulated size of the (possibly compressed) blobs
+  std::size_t getNumBytes() const noexcept { return numBytes_; }
+
+private:
+  struct PendingEntry {
+    std::string Path;
+    std::uint64_t Hash;
+    std::vector<Byte> Data;
+    std::size_t NumBytesUncompressed;
+    bool Compressed;
+  };
+
+  /// Alignment of the blobs
+  std::size_t alignment_;
+
+  /// Added files
+  std::vector<PendingEntry> entries_;
+
+  /// Statistics
+  std::size_t numBytesUncompressed_;
+  std::size_t numBytes_;
+};
+
+} // namespace core
+
+using Archive = core::Archive;
+using ArchiveWriter = core::ArchiveWriter;
+
+} // namespace sequoia
+
+#endif
@@ -0,0 +1,107 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                         _____                        _
+//                        / ____|                      (_)
+//                       | (___   ___  __ _ _   _  ___  _  __ _
+//                        \___ \ / _ \/ _` | | | |/ _ \| |/ _` |
+//                        ____) |  __/ (_| | |_| | (_) | | (_| |
+//                       |_____/ \___|\__, |\__,_|\___/|_|\__,_| - Game Engine (2016-2017)
+//                                       | |
+//                                       |_|
+//
+// This file is distributed under the MIT License (MIT).
+// See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#include "sequoia-engine/Core/ArchiveFileSystem.h"
+#include "sequoia-engine/Core/Compression.h"
+#include "sequoia-engine/Core/Exception.h"
+#include "sequoia-engine/Core/Format.h"
+
+namespace sequoia {
+
+namespace core {
+
+ArchiveFileSystem::ArchiveFileSystem(const std::string& path)
+    : FileSystem(path), archive_(std::make_unique<Archive>(platform::asPath(path))) {}
+
+ArchiveFileSystem::~ArchiveFileSystem() {}
+
+std::shared_ptr<FileBuffer> ArchiveFileSystem::read(StringRef path,
+                                                    FileBuffer::FileFormat format) {
+  const std::string pathStr = path.str();
+  {
+    SEQUOIA_LOCK_GUARD(mutex_);
+    auto it = files_.find(pathStr);
+    if(it != files_.end())
+      return it->second;
+  }
+
+  const Archive::Entry* entry = archive_->find(path);
+  if(!entry)
+    SEQUOIA_THROW(Exception, "no such file: \"{}\"", pathStr);
+
+  // Decompression happens outside of the lock, concurrent reads of other files are not blocked
+  std::shared_ptr<FileBuffer> buffer = nullptr;
+  if(entry->isCompressed()) {
+    buffer = std::make_shared<FileBuffer>(format, pathStr, entry->NumBytesUncompressed);
+    if(!compression::decompress(archive_->getBlob(*entry), entry->NumBytes,
+                                buffer->getDataAs<Byte>(), buffer->getNumBytes()))
+      SEQUOIA_THROW(Exception, "failed to read: \"{}\" (corrupted archive)", pathStr);
+  } else {
+    buffer = std::make_shared<FileBuffer>(format, pathStr, archive_->getMappedFile(),
+                                          entry->Offset, entry->NumBytes);
+  }
+
+  SEQUOIA_LOCK_GUARD(mutex_);
+  return files_.emplace(pathStr, buffer).first->second;
+}
+
+void ArchiveFileSystem::write(StringRef path, const std::shared_ptr<FileBuffer>& buffer) {
+  if(archive_->find(path))
+    SEQUOIA_THROW(Exception, "cannot write \"{}\": file is part of a read-only archive",
+                  path.str());
+
+  SEQUOIA_LOCK_GUARD(mutex_);
+  auto it = files_.find(path.str());
+  if(it == files_.end())
+    SEQUOIA_THROW(Exception, "cannot write \"{}\": no such file", path.str());
+
+  it->second = buffer;
+  if(buffer->getPath() != it->first)
+    buffer->setPath(it->first);
+}
+
+bool ArchiveFileSystem::exists(StringRef path) {
+  {
+    SEQUOIA_LOCK_GUARD(mutex_);
+    if(files_.count(path.str()))
+      return true;
+  }
+  return archive_->find(path) != nullptr;
+}
+
+void ArchiveFileSystem::addFile(StringRef path, const std::shared_ptr<FileBuffer>& buffer) {
+  if(archive_->find(path))
+    SEQUOIA_THROW(Exception, "cannot add virtual file \"{}\": file already exists in archive",
+                  path.str());
+
+  const std::string pathStr = path.str();
+  SEQUOIA_LOCK_GUARD(mutex_);
+  files_[pathStr] = buffer;
+  if(buffer->getPath() != pathStr)
+    buffer->setPath(pathStr);
+}
+
+std::pair<std::string, std::string> ArchiveFileSystem::toStringImpl() const {
+  return std::make_pair("ArchiveFileSystem", core::format("{}"
+                                                          "numEntries = {},\n"
+                                                          "numCachedFiles = {}\n",
+                                                          Base::toStringImpl().second,
+                                                          archive_->getEntries().size(),
+                                                          files_.size()));
+}
+
+} // namespace core
+
+} // namespace sequoia
@@ -0,0 +1,86 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                         _____                        _
+//                        / ____|                      (_)
+//                       | (___   ___  __ _ _   _  ___  _  __ _
+//                        \___ \ / _ \/ _` | | | |/ _ \| |/ _` |
+//                        ____) |  __/ (_| | |_| | (_) | | (_| |
+//                       |_____/ \___|\__, |\__,_|\___/|_|\__,_| - Game Engine (2016-2017)
+//                                       | |
+//                                       |_|
+//
+// This file is distributed under the MIT License (MIT).
+// See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#ifndef SEQUOIA_ENGINE_CORE_ARCHIVEFILESYSTEM_H
+#define SEQUOIA_ENGINE_CORE_ARCHIVEFILESYSTEM_H
+
+#include "sequoia-engine/Core/Archive.h"
+#include "sequoia-engine/Core/Export.h"
+#include "sequoia-engine/Core/FileSystem.h"
+#include "sequoia-engine/Core/Mutex.h"
+#include <memory>
+#include <unordered_map>
+
+namespace sequoia {
+
+namespace core {
+
+/// @brief A read-only file system serving the files of a packed `Archive`
+///
+/// Uncompressed files are exposed in-place (i.e the returned `FileBuffer` is a view into the
+/// mapped archive) while compressed files are decompressed on first access. In both cases the
+/// buffer is cached and subsequent reads of the same file return the same buffer.
+///
+/// Files of the archive cannot be modified, however virtual files can be added via `addFile` (and
+/// modified via `write`).
+///
+/// @remark Thread-safe
+/// @ingroup core
+class SEQUOIA_API ArchiveFileSystem final : public FileSystem {
+public:
+  /// @brief Open the archive `path`
+  /// @throws Exception   Archive cannot be opened or is invalid
+  ArchiveFileSystem(const std::string& path);
+  virtual ~ArchiveFileSystem();
+
+  /// @copydoc FileSystem::read
+  virtual std::shared_ptr<FileBuffer> read(StringRef path, FileBuffer::FileFormat format) override;
+
+  /// @copydoc FileSystem::write
+  virtual void write(StringRef path, const std::shared_ptr<FileBuffer>& buffer) override;
+
+  /// @copydoc FileSystem::exists
+  virtual bool exists(StringRef path) override;
+
+  /// @copydoc FileSystem::addFile
+  virtual void addFile(StringRef path, const std::shared_ptr<FileBuffer>& buffer) override;
+
+  /// @brief Get the underlying archive
+  const Archive& getArchive() const noexcept { return *archive_; }
+
+protected:
+  /// @copydoc FileSystem::toStringImpl
+  virtual std::pair<std::string, std::string> toStringImpl() const override;
+
+private:
+  using Base = FileSystem;
+
+  /// Opened archive
+  std::unique_ptr<Archive> archive_;
+
+  /// Already read files of the archive as well as virtual files
+  std::unordered_map<std::string, std::shared_ptr<FileBuffer>> files_;
+
+  /// Access mutex of `files_`
+  SpinMutex mutex_;
+};
+
+} // namespace core
+
+using ArchiveFileSystem = core::ArchiveFileSystem;
+
+} // namespace sequoia
+
+#endif
@@ -0,0 +1,237 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                         _____                        _
+//                        / ____|                      (_)
+//                       | (___   ___  __ _ _   _  ___  _  __ _
+//                        \___ \ / _ \/ _` | | | |/ _ \| |/ _` |
+//                        ____) |  __/ (_| | |_| | (_) | | (_| |
+//                       |_____/ \___|\__, |\__,_|\___/|_|\__,_| - Game Engine (2016-2017)
+//                                       | |
+//                                       |_|
+//
+// This file is distributed under the MIT License (MIT).
+// See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#include "sequoia-engine/Core/Assert.h"
+#include "sequoia-engine/Core/Compression.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace sequoia {
+
+namespace core {
+
+namespace compression {
+
+namespace {
+
+/// Minimum length of a match
+constexpr std::size_t MinMatch = 4;
+
+/// The last `LastLiterals` bytes are always encoded as literals
+constexpr std::size_t LastLiterals = 5;
+
+/// No match is started within the last `MatchFindLimit` bytes
+constexpr std::size_t MatchFindLimit = 12;
+
+/// Maximum distance of a back-reference
+constexpr std::size_t MaxOffset = 65535;
+
+/// Number of bits of the hash table used to find matches
+constexpr int HashLog = 16;
+
+inline std::uint32_t read32(const Byte* ptr) noexcept {
+  std::uint32_t value;
+  std::memcpy(&value, ptr, sizeof(value));
+  return value;
+}
+
+inline std::uint32_t hashSequence(std::uint32_t sequence) noexcept {
+  return (sequence * 2654435761u) >> (32 - HashLog);
+}
+
+/// @brief Number of bytes required to encode `length` in the token nibble and extra bytes
+inline std::size_t getLengthNumBytes(std::size_t length) noexcept {
+  return length < 15 ? 0 : (length - 15) / 255 + 1;
+}
+
+/// @brief Write the extra bytes of `length` (which is >= 15)
+inline Byte* writeLength(Byte* out, std::size_t length) noexcept {
+  for(length -= 15; length >= 255; length -= 255)
+    *out++ = 255;
+  *out++ = static_cast<Byte>(length);
+  return out;
+}
+
+/// @brief Read the extra bytes of a length and add them to `length`
+inline bool readLength(const Byte*& in, const Byte* inEnd, std::size_t& length) noexcept {
+  Byte value;
+  do {
+    if(in >= inEnd)
+      return false;
+    value = *in++;
+    length += value;
+  } while(value == 255);
+  return true;
+}
+
+} // anonymous namespace
+
+std::size_t getCompressBound(std::size_t numBytes) noexcept {
+  return numBytes + numBytes / 255 + 16;
+}
+
+std::size_t getDecompressBound(std::size_t numBytes) noexcept {
+  return numBytes > SIZE_MAX / 255 ? SIZE_MAX : 255 * numBytes;
+}
+
+std::size_t compress(const Byte* src, std::size_t numBytes, Byte* dest,
+                     std::size_t capacity) noexcept {
+  SEQUOIA_ASSERT_MSG(numBytes <= std::size_t(UINT32_MAX), "input exceeds 4 GiB");
+
+  const Byte* in = src;
+  const Byte* inEnd = src + numBytes;
+  const Byte* anchor = src;
+  Byte* out = dest;
+  Byte* outEnd = dest + capacity;
+
+  // Position (relative to `src`) of the last occurrence of each hashed 4-byte sequence
+  std::vector<std::uint32_t> table(std::size_t(1) << HashLog, 0);
+
+  if(numBytes > MatchFindLimit) {
+    const Byte* matchFindEnd = inEnd - MatchFindLimit;
+    const Byte* matchEnd = inEnd - LastLiterals;
+
+    while(in < matchFindEnd) {
+      const std::uint32_t sequence = read32(in);
+      std::uint32_t& entry = table[hashSequence(sequence)];
+      const Byte* match = src + entry;
+      entry = static_cast<std::uint32_t>(in - src);
+
+      if(match >= in || std::size_t(in - match) > MaxOffset || read32(match) != sequence) {
+        // Skip faster through incompressible data
+        in += 1 + ((in - anchor) >> 6);
+        continue;
+      }
+
+      // Extend the match backwards and forwards
+      while(in > anchor && match > src && in[-1] == match[-1]) {
+        --in;
+        --match;
+      }
+
+      const Byte* matchIn = in + MinMatch;
+      const Byte* matchRef = match + MinMatch;
+      while(matchIn < matchEnd && *matchIn == *matchRef) {
+        ++matchIn;
+        ++matchRef;
+      }
+
+      // Emit the sequence
+      const std::size_t numLiterals = in - anchor;
+      const std::size_t matchLength = (matchIn - in) - MinMatch;
+      if(std::size_t(outEnd - out) < 1 + getLengthNumBytes(numLiterals) + numLiterals + 2 +
+                                         getLengthNumBytes(matchLength))
+        return 0;
+
+      Byte* token = out++;
+      *token = static_cast<Byte>(std::min<std::size_t>(numLiterals, 15) << 4);
+      if(numLiterals >= 15)
+        out = writeLength(out, numLiterals);
+      std::memcpy(out, anchor, numLiterals);
+      out += numLiterals;
+
+      const std::size_t offset = in - match;
+      *out++ = static_cast<Byte>(offset & 0xff);
+      *out++ = static_cast<Byte>(offset >> 8);
+
+      *token |= static_cast<Byte>(std::min<std::size_t>(matchLength, 15));
+      if(matchLength >= 15)
+        out = writeLength(out, matchLength);
+
+      in = anchor = matchIn;
+    }
+  }
+
+  // Emit the remaining literals
+  const std::size_t numLiterals = inEnd - anchor;
+  if(std::size_t(outEnd - out) < 1 + getLengthNumBytes(numLiterals) + numLiterals)
+    return 0;
+
+  Byte* token = out++;
+  *token = static_cast<Byte>(std::min<std::size_t>(numLiterals, 15) << 4);
+  if(numLiterals >= 15)
+    out = writeLength(out, numLiterals);
+  if(numLiterals > 0)
+    std::memcpy(out, anchor, numLiterals);
+  out += numLiterals;
+
+  return out - dest;
+}
+
+bool decompress(const Byte* src, std::size_t numBytes, Byte* dest,
+                std::size_t numBytesDest) noexcept {
+  const Byte* in = src;
+  const Byte* inEnd = src + numBytes;
+  Byte* out = dest;
+  Byte* outEnd = dest + numBytesDest;
+
+  while(in < inEnd) {
+    const Byte token = *in++;
+
+    // Literals
+    std::size_t numLiterals = token >> 4;
+    if(numLiterals == 15 && !readLength(in, inEnd, numLiterals))
+      return false;
+
+    if(numLiterals > std::size_t(inEnd - in) || numLiterals > std::size_t(outEnd - out))
+      return false;
+
+    if(numLiterals > 0)
+      std::memcpy(out, in, numLiterals);
+    in += numLiterals;
+    out += numLiterals;
+
+    // The last sequence consists only of literals
+    if(in == inEnd)
+      break;
+
+    // Match
+    if(inEnd - in < 2)
+      return false;
+
+    const std::size_t offset = std::size_t(in[0]) | (std::size_t(in[1]) << 8);
+    in += 2;
+    if(offset == 0 || offset > std::size_t(out - dest))
+      return false;
+
+    std::size_t matchLength = token & 15;
+    if(matchLength == 15 && !readLength(in, inEnd, matchLength))
+      return false;
+    matchLength += MinMatch;
+
+    if(matchLength > std::size_t(outEnd - out))
+      return false;
+
+    // The source and destination of the copy may overlap (i.e repeated patterns)
+    const Byte* match = out - offset;
+    if(offset >= matchLength) {
+      std::memcpy(out, match, matchLength);
+    } else {
+      for(std::size_t i = 0; i < matchLength; ++i)
+        out[i] = match[i];
+    }
+    out += matchLength;
+  }
+
+  return out == outEnd;
+}
+
+} // namespace compression
+
+} // namespace core
+
+} // namespace sequoia
@@ -0,0 +1,74 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                         _____                        _
+//                        / ____|                      (_)
+//                       | (___   ___  __ _ _   _  ___  _  __ _
+//                        \___ \ / _ \/ _` | | | |/ _ \| |/ _` |
+//                        ____) |  __/ (_| | |_| | (_) | | (_| |
+//                       |_____/ \___|\__, |\__,_|\___/|_|\__,_| - Game Engine (2016-2017)
+//                                       | |
+//                                       |_|
+//
+// This file is distributed under the MIT License (MIT).
+// See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#ifndef SEQUOIA_ENGINE_CORE_COMPRESSION_H
+#define SEQUOIA_ENGINE_CORE_COMPRESSION_H
+
+#include "sequoia-engine/Core/Byte.h"
+#include "sequoia-engine/Core/Export.h"
+#include <cstddef>
+
+namespace sequoia {
+
+namespace core {
+
+/// @brief Fast LZ77 block compression
+///
+/// The encoding follows the LZ4 block format: a sequence of tokens, each describing a run of
+/// literals followed by a back-reference (16-bit offset, at least 4 bytes long) into the already
+/// decoded data. Decompression is a simple copy loop and runs at memory bandwidth, which makes it
+/// suitable for assets which are compressed once (offline) and decompressed at every load.
+///
+/// @ingroup core
+namespace compression {
+
+/// @brief Get the maximum size of the compressed output of `numBytes` bytes of input
+SEQUOIA_API extern std::size_t getCompressBound(std::size_t numBytes) noexcept;
+
+/// @brief Get the maximum size of the decompressed output of `numBytes` bytes of compressed input
+///
+/// Each byte of input encodes at most 255 bytes of output (the extension bytes of a run length).
+SEQUOIA_API extern std::size_t getDecompressBound(std::size_t numBytes) noexcept;
+
+/// @brief Compress `numBytes` bytes of `src` into `dest`
+///
+/// @param src        Data to compress (at most 4 GiB)
+/// @param numBytes   Number of bytes of `src`
+/// @param dest       Output buffer of size `capacity`
+/// @param capacity   Number of bytes available in `dest` (`getCompressBound(numBytes)` is always
+///                   sufficient)
+/// @returns number of bytes written to `dest` or 0 if `capacity` is exceeded
+SEQUOIA_API extern std::size_t compress(const Byte* src, std::size_t numBytes, Byte* dest,
+                                        std::size_t capacity) noexcept;
+
+/// @brief Decompress `numBytes` bytes of `src` into `dest`
+///
+/// The input is treated as untrusted, malformed data never results in an out of bounds access.
+///
+/// @param src              Compressed data
+/// @param numBytes         Number of bytes of `src`
+/// @param dest             Output buffer of size `numBytesDest`
+/// @param numBytesDest     Exact size of the decompressed data
+/// @returns `true` if `src` was successfully decompressed into exactly `numBytesDest` bytes
+SEQUOIA_API extern bool decompress(const Byte* src, std::size_t numBytes, Byte* dest,
+                                   std::size_t numBytesDest) noexcept;
+
+} // namespace compression
+
+} // namespace core
+
+} // namespace sequoia
+
+#endif
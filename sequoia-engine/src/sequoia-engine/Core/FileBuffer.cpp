@@ -13,6 +13,7 @@
 //
 //===------------------------------------------------------------------------------------------===//
 
+#include "sequoia-engine/Core/Assert.h"
 #include "sequoia-engine/Core/FileBuffer.h"
 #include "sequoia-engine/Core/Format.h"
 #include "sequoia-engine/Core/Platform.h"
@@ -42,6 +43,41 @@ FileBuffer::FileBuffer(FileFormat format, const std::string& path, std::size_t n
   allocate(numBytes, UH_Dynamic);
 }
 
+FileBuffer::FileBuffer(FileFormat format, const std::string& path,
+                       std::unique_ptr<MappedFile> mapping)
+    : format_(format), path_(path), mapping_(std::move(mapping)) {
+  SEQUOIA_ASSERT(mapping_);
+  setExternalData(mapping_->getData(), mapping_->getNumBytes());
+}
+
+FileBuffer::FileBuffer(FileFormat format, const std::string& path,
+                       const std::shared_ptr<MappedFile>& mapping, std::size_t offset,
+                       std::size_t numBytes)
+    : format_(format), path_(path), mapping_(mapping) {
+  SEQUOIA_ASSERT(mapping_);
+  SEQUOIA_ASSERT_MSG(offset + numBytes <= mapping_->getNumBytes(), "view exceeds the mapping");
+  setExternalData(mapping_->getData() + offset, numBytes);
+}
+
+FileBuffer::~FileBuffer() {
+  // Release the borrowed pointer before unmapping the file
+  setExternalData(nullptr, 0);
+}
+
+void FileBuffer::allocateImpl(std::size_t numBytes, UsageHint usageHint) {
+  HostBuffer::allocateImpl(numBytes, usageHint);
+  mapping_.reset();
+}
+
+bool FileBuffer::canBeMapped(FileFormat format) {
+#ifdef SEQUOIA_ON_WIN32
+  return format == FF_Binary;
+#else
+  (void)format;
+  return true;
+#endif
+}
+
 std::string FileBuffer::getFilename() const {
   return platform::toAnsiString(platform::Path(path_).filename());
 }
@@ -54,8 +90,10 @@ std::pair<std::string, std::string> FileBuffer::toStringImpl() const {
   return std::make_pair("FileBuffer",
                         core::format("{}"
                                      "format = {},\n"
-                                     "path = \"{}\"\n",
-                                     Base::toStringImpl().second, formatToString(format_), path_));
+                                     "path = \"{}\",\n"
+                                     "mapped = {}\n",
+                                     Base::toStringImpl().second, formatToString(format_), path_,
+                                     isMapped() ? "true" : "false"));
 }
 
 } // namespace core
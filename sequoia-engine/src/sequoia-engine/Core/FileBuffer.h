@@ -17,6 +17,8 @@
 #define SEQUOIA_ENGINE_CORE_FILEBUFFER_H
 
 #include "sequoia-engine/Core/HostBuffer.h"
+#include "sequoia-engine/Core/MappedFile.h"
+#include <memory>
 #include <string>
 
 namespace sequoia {
@@ -36,6 +38,31 @@ public:
   /// @brief Allocate the FileBuffer with `numBytes` capacity
   FileBuffer(FileFormat format, const std::string& path, std::size_t numBytes);
 
+  /// @brief Expose the memory mapped file `mapping` as content of the FileBuffer (zero-copy)
+  ///
+  /// The data is page-aligned and is mapped copy-on-write i.e modifications of the buffer are
+  /// **not** written back to the file.
+  FileBuffer(FileFormat format, const std::string& path, std::unique_ptr<MappedFile> mapping);
+
+  /// @brief Expose `numBytes` of the memory mapped file `mapping`, starting at `offset`, as content
+  /// of the FileBuffer (zero-copy)
+  ///
+  /// The mapping is shared with all other views of it (i.e modifications of overlapping views are
+  /// visible to each other).
+  FileBuffer(FileFormat format, const std::string& path, const std::shared_ptr<MappedFile>& mapping,
+             std::size_t offset, std::size_t numBytes);
+
+  /// @brief Free the buffer (and unmap the file)
+  ~FileBuffer();
+
+  /// @brief Check if the content of the buffer is backed by a memory mapped file
+  bool isMapped() const { return mapping_ != nullptr; }
+
+  /// @brief Check if files of `format` can be mapped into memory as is
+  ///
+  /// Text files on Win32 are subject to newline conversion and thus need to be read via streams.
+  static bool canBeMapped(FileFormat format);
+
   /// @brief Get the name to the file
   std::string getFilename() const;
 
@@ -58,12 +85,18 @@ protected:
   /// @copydoc Buffer::toStringImpl
   virtual std::pair<std::string, std::string> toStringImpl() const override;
 
+  /// @copydoc HostBuffer::allocateImpl
+  virtual void allocateImpl(std::size_t numBytes, UsageHint usageHint) override;
+
 private:
   /// Format of the file
   FileFormat format_;
 
   /// Path of the file
   std::string path_;
+
+  /// Memory mapped file (if any)
+  std::shared_ptr<MappedFile> mapping_;
 };
 
 } // namespace core
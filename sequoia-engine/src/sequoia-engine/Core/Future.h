@@ -22,16 +22,59 @@
 #include "sequoia-engine/Core/NonCopyable.h"
 #include "sequoia-engine/Core/Optional.h"
 #include "sequoia-engine/Core/Task.h"
+#include <atomic>
 #include <condition_variable>
 #include <functional>
+#include <iterator>
 #include <memory>
+#include <type_traits>
+#include <vector>
 
 namespace sequoia {
 
 namespace core {
 
+template <class T>
+class Future;
+
 namespace internal {
 
+/// @brief Move-only `void(void)` function wrapper
+///
+/// In contrast to `std::function`, the wrapped functor is not required to be copyable (e.g a lambda
+/// capturing a `std::unique_ptr`).
+class UniqueFunction {
+  template <class Functor>
+  class FunctorTask : public Task {
+    Functor functor_;
+
+  public:
+    template <class F>
+    FunctorTask(F&& functor) : functor_(std::forward<F>(functor)) {}
+    virtual void run() override { functor_(); }
+  };
+
+  std::unique_ptr<Task> task_;
+
+public:
+  UniqueFunction() = default;
+
+  template <class Functor, class = std::enable_if_t<
+                               !std::is_same<std::decay_t<Functor>, UniqueFunction>::value>>
+  UniqueFunction(Functor&& functor)
+      : task_(std::make_unique<FunctorTask<std::decay_t<Functor>>>(
+            std::forward<Functor>(functor))) {}
+
+  UniqueFunction(UniqueFunction&&) = default;
+  UniqueFunction& operator=(UniqueFunction&&) = default;
+
+  /// @brief Invoke the wrapped functor
+  void operator()() { task_->run(); }
+
+  /// @brief Check if a functor is wrapped
+  explicit operator bool() const noexcept { return task_ != nullptr; }
+};
+
 template <class T>
 class FutureResult {
   core::optional<T> value_;
@@ -51,7 +94,7 @@ public:
 
 template <>
 class FutureResult<void> {
-  bool isReady_;
+  bool isReady_ = false;
 
 public:
   void set() { isReady_ = true; }
@@ -62,6 +105,10 @@ public:
 
 template <class T>
 class FutureStateBase : public NonCopyable {
+public:
+  /// @brief State of the result
+  enum StatusKind { SK_Pending = 0, SK_Ready, SK_Error };
+
 protected:
   /// Store the result of the future
   FutureResult<T> result_;
@@ -69,6 +116,12 @@ protected:
   /// Store the error (if any)
   std::exception_ptr error_;
 
+  /// Status of the result (allows to query the state without locking)
+  std::atomic<int> status_;
+
+  /// Functions to run once the result or an error is available
+  std::vector<UniqueFunction> continuations_;
+
   /// Wait variable
   mutable std::condition_variable available_;
 
@@ -76,23 +129,69 @@ protected:
   mutable std::mutex mutex_;
 
 public:
+  FutureStateBase() : status_(SK_Pending) {}
+
   /// @brief Notify all waiting threads
   void notifyAll() const { available_.notify_all(); }
 
   /// @brief Set the `error` and notify waiting variables
   void setError(std::exception_ptr error) {
+    std::unique_lock<std::mutex> lock(mutex_);
     error_ = error;
-    notifyAll();
+    publish(SK_Error, lock, true);
   }
 
   /// @brief Blocks until the result becomes available
   void wait() const {
+    if(isDone())
+      return;
     std::unique_lock<std::mutex> lock(mutex_);
-    available_.wait(lock, [this]() -> bool { return result_.isReady() || error_; });
+    available_.wait(lock, [this]() -> bool { return isDone(); });
   }
 
   /// @brief Is the result ready?
-  bool isReady() const noexcept { return result_.isReady(); }
+  /// @remark Lock-free
+  bool isReady() const noexcept { return status_.load(std::memory_order_acquire) == SK_Ready; }
+
+  /// @brief Is an error set?
+  /// @remark Lock-free
+  bool hasError() const noexcept { return status_.load(std::memory_order_acquire) == SK_Error; }
+
+  /// @brief Is the result or an error available?
+  /// @remark Lock-free
+  bool isDone() const noexcept { return status_.load(std::memory_order_acquire) != SK_Pending; }
+
+  /// @brief Run `continuation` once the result or an error is available
+  ///
+  /// If the state is already done, the `continuation` is run immediately by the calling thread,
+  /// otherwise it is run by the thread which sets the result or error.
+  void addContinuation(UniqueFunction continuation) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if(!isDone()) {
+        continuations_.emplace_back(std::move(continuation));
+        return;
+      }
+    }
+    continuation();
+  }
+
+protected:
+  /// @brief Publish the new `status`, notify the waiting threads (if `notify` is `true`) and run
+  /// the continuations (the lock is released before running the continuations)
+  void publish(StatusKind status, std::unique_lock<std::mutex>& lock, bool notify) {
+    status_.store(status, std::memory_order_release);
+
+    std::vector<UniqueFunction> continuations;
+    continuations.swap(continuations_);
+    lock.unlock();
+
+    if(notify)
+      notifyAll();
+
+    for(auto& continuation : continuations)
+      continuation();
+  }
 };
 
 template <class T>
@@ -104,14 +203,13 @@ public:
   /// @brief Set the `value` and notify all waiting threads
   template <class S>
   void setValue(S&& value, bool notify = true) {
+    std::unique_lock<std::mutex> lock(this->mutex_);
     this->result_.set(std::forward<S>(value));
-    if(notify)
-      this->notifyAll();
+    this->publish(Base::SK_Ready, lock, notify);
   }
 
   /// @brief Waits until the future has a valid result and retrieves it
   T& get() {
-
     // Wait for task to finish
     this->wait();
 
@@ -120,7 +218,7 @@ public:
       std::rethrow_exception(this->error_);
 
     // Retrive the value
-    if(this->isReady())
+    if(this->result_.isReady())
       return this->result_.get();
 
     SEQUOIA_THROW(core::Exception, "future is not initailized");
@@ -135,14 +233,13 @@ public:
 
   /// @brief Set the result to be ready and notify all waiting threads
   void setValue(bool notify = true) {
+    std::unique_lock<std::mutex> lock(this->mutex_);
     this->result_.set();
-    if(notify)
-      this->notifyAll();
+    this->publish(Base::SK_Ready, lock, notify);
   }
 
   /// @brief Waits until the future has a valid result
   void get() {
-
     // Wait for task to finish
     this->wait();
 
@@ -151,13 +248,31 @@ public:
       std::rethrow_exception(this->error_);
 
     // Retrive the value
-    if(this->isReady())
+    if(this->result_.isReady())
       return;
 
     SEQUOIA_THROW(core::Exception, "future is not initailized");
   }
 };
 
+template <class T>
+struct RunAndAssign {
+  template <class Function>
+  static inline void apply(std::shared_ptr<internal::FutureState<T>>& state, Function& function) {
+    state->setValue(function(), true);
+  }
+};
+
+template <>
+struct RunAndAssign<void> {
+  template <class Function>
+  static inline void apply(std::shared_ptr<internal::FutureState<void>>& state,
+                           Function& function) {
+    function();
+    state->setValue(true);
+  }
+};
+
 } // namespace internal
 
 template <class T>
@@ -190,6 +305,58 @@ public:
   /// @brief Checks if the future refers to a shared state
   bool valid() const { return state_ != nullptr; }
 
+  /// @brief Check if the result is available (`false` if an error occured, see `isDone`)
+  /// @remark Lock-free
+  bool isReady() const noexcept { return valid() && state_->isReady(); }
+
+  /// @brief Check if the result or an error is available i.e `get()` does not block
+  /// @remark Lock-free
+  bool isDone() const noexcept { return valid() && state_->isDone(); }
+
+  /// @brief Check if an error occured during the computation of the result
+  /// @remark Lock-free
+  bool hasError() const noexcept { return valid() && state_->hasError(); }
+
+  /// @brief Attach a continuation which is run once the result (or an error) is available
+  ///
+  /// The `continuation` is called with a ready `Future<T>` (calling `get()` on it retrieves the
+  /// result or rethrows the error) and its return value (or exception) is forwarded to the
+  /// returned future. The continuation is run by the thread which completes this future or, if
+  /// the result is already available, immediately by the calling thread. Hence, continuations
+  /// should be cheap; heavy work should be spawned as a new job. The `continuation` only needs to
+  /// be movable.
+  ///
+  /// This future is invalidated (i.e `valid() == false`) after the call.
+  ///
+  /// @code{.cpp}
+  ///   Future<int> f = ...;
+  ///   Future<std::string> g = f.then([](Future<int> f) { return std::to_string(f.get()); });
+  /// @endcode
+  template <class Functor>
+  auto then(Functor&& continuation) {
+    SEQUOIA_ASSERT_MSG(this->valid(), "future does not contain a shared state");
+    using ReturnType = std::result_of_t<std::decay_t<Functor>(Future<T>)>;
+
+    auto state = std::make_shared<internal::FutureState<ReturnType>>();
+    auto source = std::move(this->state_);
+
+    // The continuation holds on to the source state until it has run
+    auto* sourcePtr = source.get();
+    std::decay_t<Functor> functor(std::forward<Functor>(continuation));
+    auto function = [source, fn = std::move(functor)]() mutable -> ReturnType {
+      return fn(Future<T>(source));
+    };
+
+    sourcePtr->addContinuation([state, function = std::move(function)]() mutable {
+      try {
+        internal::RunAndAssign<ReturnType>::apply(state, function);
+      } catch(...) {
+        state->setError(std::current_exception());
+      }
+    });
+    return Future<ReturnType>(std::move(state));
+  }
+
   /// @brief Get the shared state (internal use only)
   const std::shared_ptr<internal::FutureState<T>>& getState() const { return state_; }
 };
@@ -244,28 +411,116 @@ public:
     this->state_->get();
     this->state_ = nullptr;
   }
+
+  /// @brief Create a ready Future
+  static Future<void> create() {
+    auto state = std::make_shared<internal::FutureState<void>>();
+    state->setValue(false);
+    return Future<void>(std::move(state));
+  }
 };
 
-namespace internal {
+/// @brief Create a future which becomes ready once all the futures in `[first, last)` are ready
+///
+/// The returned future holds the (ready) input futures, errors of the individual futures are
+/// *not* propagated but can be queried (or rethrown) via the input futures.
+///
+/// @ingroup core
+template <class InputIterator>
+Future<std::vector<typename std::iterator_traits<InputIterator>::value_type>>
+when_all(InputIterator first, InputIterator last) {
+  using FutureType = typename std::iterator_traits<InputIterator>::value_type;
+  using ResultType = std::vector<FutureType>;
+
+  struct Context {
+    ResultType Futures;
+    std::atomic<std::size_t> NumPending;
+  };
+
+  auto state = std::make_shared<internal::FutureState<ResultType>>();
+  auto ctx = std::make_shared<Context>();
+  ctx->Futures.assign(first, last);
+  ctx->NumPending = ctx->Futures.size() + 1;
+
+  auto notify = [state, ctx]() {
+    if(--ctx->NumPending == 0)
+      state->setValue(std::move(ctx->Futures));
+  };
+
+  // The additional count guarantees we are done registering before the result is set
+  for(const FutureType& future : ctx->Futures) {
+    SEQUOIA_ASSERT_MSG(future.valid(), "future does not contain a shared state");
+    future.getState()->addContinuation(notify);
+  }
+  notify();
 
+  return Future<ResultType>(std::move(state));
+}
+
+/// @brief Create a future which becomes ready once all the `futures` are ready
+/// @ingroup core
 template <class T>
-struct RunAndAssign {
-  static inline void apply(std::shared_ptr<internal::FutureState<T>>& state,
-                           std::function<T(void)>& function) {
-    state->setValue(function(), true);
-  }
+Future<std::vector<Future<T>>> when_all(const std::vector<Future<T>>& futures) {
+  return when_all(futures.begin(), futures.end());
+}
+
+/// @brief Result of `when_any`
+/// @ingroup core
+template <class FutureType>
+struct WhenAnyResult {
+  /// Index of the first ready future
+  std::size_t Index;
+
+  /// Input futures
+  std::vector<FutureType> Futures;
 };
 
-template <>
-struct RunAndAssign<void> {
-  static inline void apply(std::shared_ptr<internal::FutureState<void>>& state,
-                           std::function<void(void)>& function) {
-    function();
-    state->setValue(true);
+/// @brief Create a future which becomes ready once any of the futures in `[first, last)` is ready
+///
+/// The returned result holds the index of the first future which became ready (errors count as
+/// ready) and all the input futures.
+///
+/// @ingroup core
+template <class InputIterator>
+Future<WhenAnyResult<typename std::iterator_traits<InputIterator>::value_type>>
+when_any(InputIterator first, InputIterator last) {
+  using FutureType = typename std::iterator_traits<InputIterator>::value_type;
+  using ResultType = WhenAnyResult<FutureType>;
+
+  struct Context {
+    ResultType Result;
+    std::atomic<bool> Done;
+  };
+
+  auto state = std::make_shared<internal::FutureState<ResultType>>();
+  auto ctx = std::make_shared<Context>();
+  ctx->Result.Futures.assign(first, last);
+  ctx->Result.Index = ctx->Result.Futures.size();
+  ctx->Done = false;
+
+  SEQUOIA_ASSERT_MSG(!ctx->Result.Futures.empty(), "when_any requires at least one future");
+
+  // Copy the futures as the first continuation may move the result while we are still registering
+  std::vector<FutureType> futures = ctx->Result.Futures;
+  for(std::size_t i = 0; i < futures.size(); ++i) {
+    SEQUOIA_ASSERT_MSG(futures[i].valid(), "future does not contain a shared state");
+    futures[i].getState()->addContinuation([state, ctx, i]() {
+      if(!ctx->Done.exchange(true)) {
+        ctx->Result.Index = i;
+        state->setValue(std::move(ctx->Result));
+      }
+    });
   }
-};
 
-} // namespace internal
+  return Future<ResultType>(std::move(state));
+}
+
+/// @brief Create a future which becomes ready once any of the `futures` is ready
+/// @ingroup core
+template <class T>
+Future<WhenAnyResult<Future<T>>> when_any(const std::vector<Future<T>>& futures) {
+  return when_any(futures.begin(), futures.end());
+}
 
 /// @brief Specialization of a `Task` which produces a `Future`
 /// @ingroup core
@@ -304,6 +559,9 @@ using Future = core::Future<T>;
 template <class T>
 using FutureTask = core::FutureTask<T>;
 
+using core::when_all;
+using core::when_any;
+
 } // namespace sequoia
 
 #endif
@@ -0,0 +1,113 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                         _____                        _
+//                        / ____|                      (_)
+//                       | (___   ___  __ _ _   _  ___  _  __ _
+//                        \___ \ / _ \/ _` | | | |/ _ \| |/ _` |
+//                        ____) |  __/ (_| | |_| | (_) | | (_| |
+//                       |_____/ \___|\__, |\__,_|\___/|_|\__,_| - Game Engine (2016-2017)
+//                                       | |
+//                                       |_|
+//
+// This file is distributed under the MIT License (MIT).
+// See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#ifndef SEQUOIA_ENGINE_CORE_HALF_H
+#define SEQUOIA_ENGINE_CORE_HALF_H
+
+#include <cstdint>
+#include <cstring>
+
+namespace sequoia {
+
+namespace core {
+
+/// @brief IEEE 754 half-precision (16-bit) floating point number
+///
+/// The half is only a storage format (e.g for vertex attributes), all arithmetic is done in single
+/// precision. The conversion from `float` rounds to nearest even and handles subnormals, infinities
+/// and NaNs.
+///
+/// @ingroup core
+struct Half {
+  std::uint16_t Bits = 0; ///< Bit representation
+
+  Half() = default;
+
+  /// @brief Convert `value` to half precision
+  Half(float value) noexcept : Bits(fromFloat(value)) {}
+
+  /// @brief Convert to single precision
+  operator float() const noexcept { return toFloat(Bits); }
+
+  /// @brief Convert the single precision `value` to the bits of a half
+  static std::uint16_t fromFloat(float value) noexcept {
+    std::uint32_t f;
+    std::memcpy(&f, &value, sizeof(float));
+
+    const std::uint32_t sign = (f >> 16) & 0x8000;
+    f &= 0x7fffffff;
+
+    // Infinity and NaN (keep NaNs quiet)
+    if(f >= 0x7f800000)
+      return sign | 0x7c00 | (f > 0x7f800000 ? 0x0200 : 0);
+
+    // Overflow (65520 and above round to infinity)
+    if(f >= 0x477ff000)
+      return sign | 0x7c00;
+
+    // Subnormal half or zero
+    if(f < 0x38800000) {
+      if(f < 0x33000000)
+        return sign;
+
+      const std::uint32_t shift = 126 - (f >> 23);
+      const std::uint32_t mantissa = (f & 0x007fffff) | 0x00800000;
+      std::uint32_t bits = mantissa >> shift;
+      const std::uint32_t remainder = mantissa & ((1u << shift) - 1);
+      const std::uint32_t halfway = 1u << (shift - 1);
+      if(remainder > halfway || (remainder == halfway && (bits & 1)))
+        ++bits;
+      return sign | bits;
+    }
+
+    // Normal half, rebias the exponent from 127 to 15 (a carry of the rounding correctly
+    // propagates into the exponent)
+    std::uint32_t bits = (f >> 13) - (112 << 10);
+    const std::uint32_t remainder = f & 0x1fff;
+    if(remainder > 0x1000 || (remainder == 0x1000 && (bits & 1)))
+      ++bits;
+    return sign | bits;
+  }
+
+  /// @brief Convert the `bits` of a half to single precision
+  static float toFloat(std::uint16_t bits) noexcept {
+    const std::uint32_t sign = static_cast<std::uint32_t>(bits & 0x8000) << 16;
+    const std::uint32_t exponent = (bits >> 10) & 0x1f;
+    const std::uint32_t mantissa = bits & 0x03ff;
+
+    std::uint32_t f;
+    if(exponent == 0x1f) {
+      f = sign | 0x7f800000 | (mantissa << 13);
+    } else if(exponent == 0) {
+      // Zero or subnormal i.e `mantissa * 2^-24`
+      const float value = static_cast<float>(mantissa) * (1.0f / 16777216.0f);
+      return sign ? -value : value;
+    } else {
+      f = sign | ((exponent + 112) << 23) | (mantissa << 13);
+    }
+
+    float value;
+    std::memcpy(&value, &f, sizeof(float));
+    return value;
+  }
+};
+
+} // namespace core
+
+using Half = core::Half;
+
+} // namespace sequoia
+
+#endif
@@ -16,6 +16,7 @@
 #ifndef SEQUOIA_ENGINE_CORE_HASH_H
 #define SEQUOIA_ENGINE_CORE_HASH_H
 
+#include <cstdint>
 #include <functional>
 #include <type_traits>
 #include <utility>
@@ -104,6 +105,22 @@ inline std::size_t hash(Args&&... values) noexcept {
   return seed;
 }
 
+/// @brief Compute the 64-bit FNV-1a hash of `numBytes` bytes of `data`
+///
+/// In contrast to `std::hash`, the result is stable across platforms and launches and can thus be
+/// persisted. Multiple ranges can be chained by passing the previous hash as `seed`.
+///
+/// @ingroup core
+inline std::uint64_t fnv1a(const void* data, std::size_t numBytes,
+                           std::uint64_t seed = 14695981039346656037ull) noexcept {
+  const unsigned char* bytes = static_cast<const unsigned char*>(data);
+  for(std::size_t i = 0; i < numBytes; ++i) {
+    seed ^= bytes[i];
+    seed *= 1099511628211ull;
+  }
+  return seed;
+}
+
 } // namespace core
 
 } // namespace sequoia
@@ -22,7 +22,7 @@ namespace sequoia {
 
 namespace core {
 
-HostBuffer::HostBuffer() : Buffer(BK_HostBuffer), dataPtr_(nullptr) {}
+HostBuffer::HostBuffer() : Buffer(BK_HostBuffer), dataPtr_(nullptr), ownsData_(false) {}
 
 std::unique_ptr<HostBuffer> HostBuffer::create(std::size_t numBytes) {
   auto buffer = std::make_unique<HostBuffer>();
@@ -48,17 +48,25 @@ void HostBuffer::allocateImpl(std::size_t numBytes, Buffer::UsageHint usageHint)
   (void)usageHint;
   free();
   dataPtr_ = memory::aligned_alloc(numBytes);
+  ownsData_ = true;
 }
 
 std::pair<std::string, std::string> HostBuffer::toStringImpl() const {
   return std::make_pair("HostBuffer", Base::toStringImpl().second);
 }
 
+void HostBuffer::setExternalData(void* dataPtr, std::size_t numBytes) {
+  free();
+  dataPtr_ = dataPtr;
+  ownsData_ = false;
+  setNumBytes(numBytes);
+}
+
 void HostBuffer::free() {
-  if(dataPtr_) {
+  if(dataPtr_ && ownsData_)
     memory::aligned_free(dataPtr_);
-    dataPtr_ = nullptr;
-  }
+  dataPtr_ = nullptr;
+  ownsData_ = false;
 }
 
 } // namespace core
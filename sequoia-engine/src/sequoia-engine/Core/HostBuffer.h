@@ -25,7 +25,8 @@ namespace core {
 /// @brief Buffer allocate in the CPU RAM
 /// @ingroup render
 class SEQUOIA_API HostBuffer : public Buffer {
-  void* dataPtr_; ///< Pointer to host memory
+  void* dataPtr_;  ///< Pointer to host memory
+  bool ownsData_;  ///< Was `dataPtr_` allocated by us (or is it borrowed)?
 
 public:
   using Base = Buffer;
@@ -80,6 +81,12 @@ protected:
   /// @copydoc Buffer::toStringImpl
   virtual std::pair<std::string, std::string> toStringImpl() const override;
 
+  /// @brief Use the externally owned memory `dataPtr` of `numBytes` as the content of the buffer
+  ///
+  /// The caller has to keep the memory alive for the lifetime of the buffer (or until the next
+  /// call to `allocate`).
+  void setExternalData(void* dataPtr, std::size_t numBytes);
+
 private:
   /// @brief Free allocated memory
   void free();
@@ -0,0 +1,146 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                         _____                        _
+//                        / ____|                      (_)
+//                       | (___   ___  __ _ _   _  ___  _  __ _
+//                        \___ \ / _ \/ _` | | | |/ _ \| |/ _` |
+//                        ____) |  __/ (_| | |_| | (_) | | (_| |
+//                       |_____/ \___|\__, |\__,_|\___/|_|\__,_| - Game Engine (2016-2017)
+//                                       | |
+//                                       |_|
+//
+// This file is distributed under the MIT License (MIT).
+// See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#include "sequoia-engine/Core/Exception.h"
+#include "sequoia-engine/Core/MappedFile.h"
+
+#ifdef SEQUOIA_ON_WIN32
+#include "sequoia-engine/Core/Win32Util.h"
+#include <windows.h>
+#elif defined(SEQUOIA_ON_UNIX)
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace sequoia {
+
+namespace core {
+
+#ifdef SEQUOIA_ON_WIN32
+
+MappedFile::MappedFile(const platform::Path& path)
+    : data_(nullptr), numBytes_(0), mappingHandle_(nullptr) {
+  HANDLE file = ::CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+  if(file == INVALID_HANDLE_VALUE)
+    SEQUOIA_THROW(Exception, "cannot open file \"{}\": {}", platform::toAnsiString(path),
+                  Win32Util::getLastError());
+
+  LARGE_INTEGER size;
+  if(!::GetFileSizeEx(file, &size)) {
+    std::string error = Win32Util::getLastError();
+    ::CloseHandle(file);
+    SEQUOIA_THROW(Exception, "cannot stat file \"{}\": {}", platform::toAnsiString(path), error);
+  }
+  numBytes_ = static_cast<std::size_t>(size.QuadPart);
+
+  // Empty files cannot be mapped
+  if(numBytes_ == 0) {
+    ::CloseHandle(file);
+    return;
+  }
+
+  mappingHandle_ = ::CreateFileMappingW(file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+  ::CloseHandle(file);
+  if(!mappingHandle_)
+    SEQUOIA_THROW(Exception, "cannot map file \"{}\": {}", platform::toAnsiString(path),
+                  Win32Util::getLastError());
+
+  data_ = static_cast<Byte*>(::MapViewOfFile(mappingHandle_, FILE_MAP_COPY, 0, 0, 0));
+  if(!data_) {
+    std::string error = Win32Util::getLastError();
+    ::CloseHandle(mappingHandle_);
+    SEQUOIA_THROW(Exception, "cannot map file \"{}\": {}", platform::toAnsiString(path), error);
+  }
+}
+
+MappedFile::~MappedFile() {
+  if(data_)
+    ::UnmapViewOfFile(data_);
+  if(mappingHandle_)
+    ::CloseHandle(mappingHandle_);
+}
+
+std::size_t MappedFile::getPageSize() noexcept {
+  // Views have to start at a multiple of the allocation granularity (not the page size)
+  SYSTEM_INFO info;
+  ::GetSystemInfo(&info);
+  return static_cast<std::size_t>(info.dwAllocationGranularity);
+}
+
+#else
+
+MappedFile::MappedFile(const platform::Path& path) : data_(nullptr), numBytes_(0) {
+  int fd = ::open(path.c_str(), O_RDONLY);
+  if(fd == -1)
+    SEQUOIA_THROW(Exception, "cannot open file \"{}\": {}", platform::toAnsiString(path),
+                  std::strerror(errno));
+
+  struct stat st;
+  if(::fstat(fd, &st) == -1) {
+    int error = errno;
+    ::close(fd);
+    SEQUOIA_THROW(Exception, "cannot stat file \"{}\": {}", platform::toAnsiString(path),
+                  std::strerror(error));
+  }
+  numBytes_ = static_cast<std::size_t>(st.st_size);
+
+  // Empty files cannot be mapped
+  if(numBytes_ == 0) {
+    ::close(fd);
+    return;
+  }
+
+  void* data = ::mmap(nullptr, numBytes_, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+  int error = errno;
+
+  // The mapping keeps a reference to the file, the descriptor is no longer needed
+  ::close(fd);
+
+  if(data == MAP_FAILED)
+    SEQUOIA_THROW(Exception, "cannot map file \"{}\": {}", platform::toAnsiString(path),
+                  std::strerror(error));
+
+  // Files are usually consumed front to back by the decoders
+  ::madvise(data, numBytes_, MADV_SEQUENTIAL);
+  data_ = static_cast<Byte*>(data);
+}
+
+MappedFile::~MappedFile() {
+  if(data_)
+    ::munmap(data_, numBytes_);
+}
+
+std::size_t MappedFile::getPageSize() noexcept {
+  return static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+}
+
+#endif
+
+std::unique_ptr<MappedFile> MappedFile::tryMap(const platform::Path& path) noexcept {
+  try {
+    return std::make_unique<MappedFile>(path);
+  } catch(std::exception&) {
+    return nullptr;
+  }
+}
+
+} // namespace core
+
+} // namespace sequoia
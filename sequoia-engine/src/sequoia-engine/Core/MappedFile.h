@@ -0,0 +1,81 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                         _____                        _
+//                        / ____|                      (_)
+//                       | (___   ___  __ _ _   _  ___  _  __ _
+//                        \___ \ / _ \/ _` | | | |/ _ \| |/ _` |
+//                        ____) |  __/ (_| | |_| | (_) | | (_| |
+//                       |_____/ \___|\__, |\__,_|\___/|_|\__,_| - Game Engine (2016-2017)
+//                                       | |
+//                                       |_|
+//
+// This file is distributed under the MIT License (MIT).
+// See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#ifndef SEQUOIA_ENGINE_CORE_MAPPEDFILE_H
+#define SEQUOIA_ENGINE_CORE_MAPPEDFILE_H
+
+#include "sequoia-engine/Core/Byte.h"
+#include "sequoia-engine/Core/Export.h"
+#include "sequoia-engine/Core/NonCopyable.h"
+#include "sequoia-engine/Core/Platform.h"
+#include <cstddef>
+#include <memory>
+
+namespace sequoia {
+
+namespace core {
+
+/// @brief Read-only view of a file mapped into the address space of the process
+///
+/// The file is mapped copy-on-write (`MAP_PRIVATE` on POSIX, `FILE_MAP_COPY` on Win32): the
+/// pages are read lazily by the OS and writes to the mapped memory are never propagated back to
+/// the file. The mapping always starts at a page boundary.
+///
+/// @note If the underlying file is truncated by someone else while it is mapped, accessing the
+/// truncated pages results in undefined behaviour (`SIGBUS` on POSIX).
+///
+/// @ingroup core
+class SEQUOIA_API MappedFile : public NonCopyable {
+public:
+  /// @brief Map the entire file `path` into memory
+  /// @throws Exception   File cannot be opened or mapped
+  MappedFile(const platform::Path& path);
+
+  /// @brief Unmap the file
+  ~MappedFile();
+
+  /// @brief Map the file `path` into memory or return `nullptr` if the file cannot be mapped
+  static std::unique_ptr<MappedFile> tryMap(const platform::Path& path) noexcept;
+
+  /// @brief Get the mapped data (`nullptr` for empty files)
+  Byte* getData() noexcept { return data_; }
+  const Byte* getData() const noexcept { return data_; }
+
+  /// @brief Get the number of mapped bytes i.e the size of the file
+  std::size_t getNumBytes() const noexcept { return numBytes_; }
+
+  /// @brief Get the page size (i.e the granularity of the mapping) of the system
+  static std::size_t getPageSize() noexcept;
+
+private:
+  /// First byte of the mapping
+  Byte* data_;
+
+  /// Size of the mapping
+  std::size_t numBytes_;
+
+#ifdef SEQUOIA_ON_WIN32
+  /// Handle to the file mapping object
+  void* mappingHandle_;
+#endif
+};
+
+} // namespace core
+
+using MappedFile = core::MappedFile;
+
+} // namespace sequoia
+
+#endif
@@ -0,0 +1,87 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                         _____                        _
+//                        / ____|                      (_)
+//                       | (___   ___  __ _ _   _  ___  _  __ _
+//                        \___ \ / _ \/ _` | | | |/ _ \| |/ _` |
+//                        ____) |  __/ (_| | |_| | (_) | | (_| |
+//                       |_____/ \___|\__, |\__,_|\___/|_|\__,_| - Game Engine (2016-2017)
+//                                       | |
+//                                       |_|
+//
+// This file is distributed under the MIT License (MIT).
+// See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#ifndef SEQUOIA_ENGINE_CORE_RADIXSORT_H
+#define SEQUOIA_ENGINE_CORE_RADIXSORT_H
+
+#include <array>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace sequoia {
+
+namespace core {
+
+/// @brief Stable LSD radix sort of `values` by the 64-bit key returned by `getKey`
+///
+/// The keys are processed in 8-bit digits starting from the least significant one. Digits which are
+/// shared by *all* keys are skipped, hence sorting keys which only differ in a few bits is cheap.
+/// The `scratch` buffer is resized to `values.size()` and can be reused across calls to avoid
+/// allocations.
+///
+/// @code{.cpp}
+///   std::vector<std::pair<std::uint64_t, int>> values = {{3, 0}, {1, 1}, {2, 2}};
+///   std::vector<std::pair<std::uint64_t, int>> scratch;
+///   core::radixSort(values, scratch, [](const auto& v) { return v.first; });
+/// @endcode
+///
+/// @ingroup core
+template <class T, class GetKeyFunctor>
+void radixSort(std::vector<T>& values, std::vector<T>& scratch, GetKeyFunctor&& getKey) {
+  constexpr int NumBuckets = 256;
+  constexpr int NumDigits = sizeof(std::uint64_t);
+
+  const std::size_t size = values.size();
+  if(size <= 1)
+    return;
+
+  // Compute the histograms of all digits in a single pass
+  std::array<std::array<std::size_t, NumBuckets>, NumDigits> histograms{};
+  for(const T& value : values) {
+    std::uint64_t key = getKey(value);
+    for(int digit = 0; digit < NumDigits; ++digit)
+      ++histograms[digit][(key >> (8 * digit)) & 0xff];
+  }
+
+  scratch.resize(size);
+  for(int digit = 0; digit < NumDigits; ++digit) {
+    std::array<std::size_t, NumBuckets>& histogram = histograms[digit];
+
+    // All keys share this digit -> nothing to do
+    const std::uint64_t firstKey = getKey(values.front());
+    if(histogram[(firstKey >> (8 * digit)) & 0xff] == size)
+      continue;
+
+    // Exclusive prefix sum
+    std::size_t offset = 0;
+    for(std::size_t& count : histogram) {
+      std::size_t c = count;
+      count = offset;
+      offset += c;
+    }
+
+    for(T& value : values)
+      scratch[histogram[(getKey(value) >> (8 * digit)) & 0xff]++] = std::move(value);
+
+    values.swap(scratch);
+  }
+}
+
+} // namespace core
+
+} // namespace sequoia
+
+#endif
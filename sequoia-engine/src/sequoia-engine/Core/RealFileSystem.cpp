@@ -17,6 +17,7 @@
 #include "sequoia-engine/Core/Exception.h"
 #include "sequoia-engine/Core/FileBuffer.h"
 #include "sequoia-engine/Core/Format.h"
+#include "sequoia-engine/Core/MappedFile.h"
 #include "sequoia-engine/Core/StringUtil.h"
 #include "sequoia-engine/Core/Unreachable.h"
 
@@ -227,10 +228,18 @@ std::shared_ptr<FileBuffer> RealFileSystem::readImpl(FileBuffer::FileFormat form
     std::size_t numBytes = info->FileStream->tellg();
     info->FileStream->seekg(0, std::ios_base::beg);
 
-    info->Buffer = std::make_unique<FileBuffer>(format, it->first, numBytes);
-    info->FileStream->read(info->Buffer->getDataAs<char>(), info->Buffer->getNumBytes());
-    if(info->FileStream->fail())
-      SEQUOIA_THROW(Exception, "failed to read: \"{}\"", info->Buffer->getPath());
+    // Files spanning at least a page are mapped into memory instead of being copied
+    if(FileBuffer::canBeMapped(format) && numBytes >= MappedFile::getPageSize()) {
+      if(auto mapping = MappedFile::tryMap(baseDirPath_ / platform::asPath(it->first)))
+        info->Buffer = std::make_shared<FileBuffer>(format, it->first, std::move(mapping));
+    }
+
+    if(!info->Buffer) {
+      info->Buffer = std::make_shared<FileBuffer>(format, it->first, numBytes);
+      info->FileStream->read(info->Buffer->getDataAs<char>(), info->Buffer->getNumBytes());
+      if(info->FileStream->fail())
+        SEQUOIA_THROW(Exception, "failed to read: \"{}\"", info->Buffer->getPath());
+    }
   }
   return info->Buffer;
 }
@@ -241,7 +250,9 @@ bool RealFileSystem::writeImpl(Iterator it) {
     SEQUOIA_ASSERT(info->Buffer);
     SEQUOIA_LOCK_GUARD(info->Mutex);
 
+    // Flush to make the content visible to other readers of the file (e.g other file systems)
     info->FileStream->write(info->Buffer->getDataAs<char>(), info->Buffer->getNumBytes());
+    info->FileStream->flush();
     if(info->FileStream->fail())
       SEQUOIA_THROW(Exception, "failed to write: \"{}\"", info->Buffer->getPath());
   }
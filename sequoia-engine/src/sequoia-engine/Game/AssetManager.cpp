@@ -20,6 +20,7 @@
 #include "sequoia-engine/Core/UtfString.h"
 #include "sequoia-engine/Game/AssetManager.h"
 #include "sequoia-engine/Game/Exception.h"
+#include "sequoia-engine/Render/RenderServer.h"
 #include <fstream>
 
 namespace sequoia {
@@ -33,9 +34,9 @@ namespace game {
 AssetFile::AssetFile(FileType type, std::size_t id, AssetManager* manager)
     : File(type), id_(id), manager_(manager) {}
 
-const Byte* AssetFile::getData() { return manager_->getAsset(id_).Data.data(); }
+const Byte* AssetFile::getData() { return manager_->getAsset(id_).Data->getDataAs<Byte>(); }
 
-std::size_t AssetFile::getNumBytes() { return manager_->getAsset(id_).Data.size(); }
+std::size_t AssetFile::getNumBytes() { return manager_->getAsset(id_).Data->getNumBytes(); }
 
 std::string AssetFile::getPath() const noexcept { return manager_->getPath(id_); }
 
@@ -61,57 +62,143 @@ std::string AssetFile::getExtension() const noexcept {
 
 AssetManager::Asset::Asset(AssetManager* manager, FileType type, std::size_t id,
                            const std::string& path)
-    : ID(id), Path(path), File(std::make_shared<AssetFile>(type, id, manager)) {}
+    : ID(id), Path(path), File(std::make_shared<AssetFile>(type, id, manager)), IsLoaded(false) {}
 
 AssetManager::Asset::~Asset() {}
 
-AssetManager::AssetManager(const std::string& path) { assetPath_ = platform::asPath(path); }
+AssetManager::AssetManager(const std::string& path, render::RenderServer* server)
+    : server_(server) {
+  assetPath_ = platform::asPath(path);
+}
+
+AssetManager::~AssetManager() {
+  // Finish the pending loads while the assets are still alive. The images are waited for first as
+  // their decoding may still run after the read of the file completed.
+  for(auto& entry : imageCache_)
+    entry.second->Pending.wait();
+  for(auto& asset : assets_)
+    asset->Pending.wait();
+  ownedServer_.reset();
+}
 
 std::shared_ptr<File> AssetManager::load(const std::string& path, FileType type) {
-  if(type == FileType::Unknown)
-    type = File::TypeFromExtension(path);
+  Asset* asset = getOrRegisterAsset(path, type);
+  ensureLoaded(asset);
+  return asset->File;
+}
 
-  if(type == FileType::Unknown)
-    Log::warn("Cannot deduce extension for '{}'", path);
+Future<std::shared_ptr<File>> AssetManager::loadAsync(const std::string& path, FileType type) {
+  Asset* asset = getOrRegisterAsset(path, type);
+  if(asset->IsLoaded.load(std::memory_order_acquire))
+    return Future<std::shared_ptr<File>>::create(asset->File);
+
+  // Concurrent requests share the pending load (a failed load is retried by the next request)
+  render::RenderServer* server = getRenderServer();
+  SEQUOIA_LOCK_GUARD(pendingMutex_);
+  if(!asset->Pending.valid() || asset->Pending.hasError())
+    asset->Pending = server->spawnRessourceTask([this, asset]() -> std::shared_ptr<File> {
+      ensureLoaded(asset);
+      return asset->File;
+    });
+  return asset->Pending;
+}
 
-  auto it = pathLookupMap_.find(path);
-  std::size_t id = std::size_t(-1);
+std::shared_ptr<Image> AssetManager::loadImage(const std::shared_ptr<File>& file) {
+  ImageEntry* entry = getOrRegisterImage(file);
+
+  if(!entry->IsDecoded.load(std::memory_order_acquire)) {
+    // Concurrent requests of the same image wait here for the first one to finish decoding
+    SEQUOIA_LOCK_GUARD(entry->DecodeMutex);
+    if(!entry->IsDecoded.load(std::memory_order_relaxed)) {
+      entry->Decoded = Image::load(file);
+      entry->IsDecoded.store(true, std::memory_order_release);
+    }
+  }
+  return entry->Decoded;
+}
 
-  if(it == pathLookupMap_.end()) {
-    Log::info("Loading asset \"{}\" ({}) ...", path, File::TypeToString(type));
-    id = assets_.size();
+Future<std::shared_ptr<Image>> AssetManager::loadImageAsync(const std::string& path,
+                                                            FileType type) {
+  Asset* asset = getOrRegisterAsset(path, type);
+  ImageEntry* entry = getOrRegisterImage(asset->File);
+  if(entry->IsDecoded.load(std::memory_order_acquire))
+    return Future<std::shared_ptr<Image>>::create(entry->Decoded);
+
+  Future<std::shared_ptr<File>> file = loadAsync(path, type);
+  render::RenderServer* server = getRenderServer();
+
+  // Concurrent requests share the pending load (a failed load is retried by the next request)
+  SEQUOIA_LOCK_GUARD(pendingMutex_);
+  if(entry->Pending.valid() && !entry->Pending.hasError())
+    return entry->Pending;
+
+  if(file.isDone()) {
+    entry->Pending = server->spawnRessourceTask([this, asset]() -> std::shared_ptr<Image> {
+      ensureLoaded(asset);
+      return loadImage(asset->File);
+    });
+  } else {
+    // Decode the image by the job which reads the file instead of waiting for the read
+    entry->Pending = file.then([this](Future<std::shared_ptr<File>> loadedFile) {
+      return loadImage(loadedFile.get());
+    });
+  }
+  return entry->Pending;
+}
 
-    // Register new asset
-    assets_.emplace_back(std::make_unique<Asset>(this, type, id, path));
+const platform::Path& AssetManager::getAssetPath() const { return assetPath_; }
 
-    // Update lookup map
-    pathLookupMap_[path] = id;
+AssetManager::Asset* AssetManager::getOrRegisterAsset(const std::string& path, FileType type) {
+  SEQUOIA_LOCK_GUARD(mutex_);
 
-    // Load content
-    loadFromDisk(assets_.back());
+  auto it = pathLookupMap_.find(path);
+  if(it != pathLookupMap_.end())
+    return assets_[it->second].get();
 
-  } else {
-    id = it->second;
-  }
+  if(type == FileType::Unknown)
+    type = File::TypeFromExtension(path);
+
+  if(type == FileType::Unknown)
+    Log::warn("Cannot deduce extension for '{}'", path);
 
-  return assets_[id]->File;
+  // Register new asset (the content is loaded by `ensureLoaded`)
+  std::size_t id = assets_.size();
+  assets_.emplace_back(std::make_unique<Asset>(this, type, id, path));
+  pathLookupMap_[path] = id;
+  return assets_[id].get();
 }
 
-std::shared_ptr<Image> AssetManager::loadImage(const std::shared_ptr<File>& file) {
-  std::shared_ptr<Image> image = nullptr;
+AssetManager::ImageEntry* AssetManager::getOrRegisterImage(const std::shared_ptr<File>& file) {
+  SEQUOIA_LOCK_GUARD(mutex_);
 
   auto it = imageCache_.find(file);
-  if(it == imageCache_.end()) {
-    image = Image::load(file);
-    imageCache_.emplace(file, image);
-  } else {
-    image = it->second;
-  }
+  if(it == imageCache_.end())
+    it = imageCache_.emplace(file, std::make_unique<ImageEntry>()).first;
+  return it->second.get();
+}
 
-  return image;
+void AssetManager::ensureLoaded(Asset* asset) {
+  if(asset->IsLoaded.load(std::memory_order_acquire))
+    return;
+
+  // Concurrent requests of the same asset wait here for the first one to finish reading. If the
+  // read throws, `IsLoaded` remains unset and the next request tries again.
+  SEQUOIA_LOCK_GUARD(asset->LoadMutex);
+  if(!asset->IsLoaded.load(std::memory_order_relaxed)) {
+    loadFromDisk(asset);
+    asset->IsLoaded.store(true, std::memory_order_release);
+  }
 }
 
-const platform::Path& AssetManager::getAssetPath() const { return assetPath_; }
+render::RenderServer* AssetManager::getRenderServer() {
+  if(server_)
+    return server_;
+
+  SEQUOIA_LOCK_GUARD(mutex_);
+  if(!ownedServer_)
+    ownedServer_ = std::make_unique<render::RenderServer>();
+  return ownedServer_.get();
+}
 
 const std::string& AssetManager::getPath(std::size_t id) const {
   SEQUOIA_ASSERT_MSG(id < assets_.size(), "invalid id");
@@ -123,25 +210,39 @@ const AssetManager::Asset& AssetManager::getAsset(std::size_t id) const {
   return *assets_[id];
 }
 
-void AssetManager::loadFromDisk(std::unique_ptr<AssetManager::Asset>& asset) {
-  std::string fullPath = platform::toAnsiString(assetPath_ / platform::asPath(asset->Path));
+void AssetManager::loadFromDisk(AssetManager::Asset* asset) {
+  Log::info("Loading asset \"{}\" ({}) ...", asset->Path,
+            File::TypeToString(asset->File->getType()));
 
-  std::ios_base::openmode mode = std::ios_base::in;
-  if(asset->File->isBinary())
-    mode |= std::ios_base::binary;
+  platform::Path fullPath = assetPath_ / platform::asPath(asset->Path);
+  core::FileBuffer::FileFormat format =
+      asset->File->isBinary() ? core::FileBuffer::FF_Binary : core::FileBuffer::FF_Text;
 
-  std::ifstream file(fullPath.c_str(), mode);
+  // Map the file into memory, this allows decoders to consume the asset without an additional
+  // copy and the OS to only page-in what is actually accessed
+  if(core::FileBuffer::canBeMapped(format)) {
+    if(auto mapping = core::MappedFile::tryMap(fullPath))
+      asset->Data = std::make_unique<core::FileBuffer>(format, asset->Path, std::move(mapping));
+  }
+
+  if(!asset->Data) {
+    std::ios_base::openmode mode = std::ios_base::in;
+    if(format == core::FileBuffer::FF_Binary)
+      mode |= std::ios_base::binary;
 
-  if(!file.is_open())
-    SEQUOIA_THROW(GameException, "cannot load asset: '{}'", asset->Path.c_str());
+    std::ifstream file(platform::toAnsiString(fullPath).c_str(), mode);
 
-  // Allocate memory
-  file.seekg(0, std::ios_base::end);
-  asset->Data.resize(file.tellg());
-  file.seekg(0, std::ios_base::beg);
+    if(!file.is_open())
+      SEQUOIA_THROW(GameException, "cannot load asset: '{}'", asset->Path.c_str());
 
-  // Read ASCII file
-  file.read(reinterpret_cast<char*>(asset->Data.data()), asset->Data.size());
+    // Allocate memory
+    file.seekg(0, std::ios_base::end);
+    asset->Data = std::make_unique<core::FileBuffer>(format, asset->Path, file.tellg());
+    file.seekg(0, std::ios_base::beg);
+
+    // Read the file
+    file.read(asset->Data->getDataAs<char>(), asset->Data->getNumBytes());
+  }
 
   Log::info("Successfully loaded asset \"{}\"", asset->Path);
 }
@@ -16,14 +16,18 @@
 #ifndef SEQUOIA_ENGINE_GAME_ASSETMANAGER_H
 #define SEQUOIA_ENGINE_GAME_ASSETMANAGER_H
 
-#include "sequoia-engine/Core/AlignedADT.h"
+#include "sequoia-engine/Core/ConcurrentADT.h"
 #include "sequoia-engine/Core/Export.h"
 #include "sequoia-engine/Core/File.h"
+#include "sequoia-engine/Core/FileBuffer.h"
+#include "sequoia-engine/Core/Future.h"
 #include "sequoia-engine/Core/Image.h"
+#include "sequoia-engine/Core/Mutex.h"
 #include "sequoia-engine/Core/NonCopyable.h"
 #include "sequoia-engine/Core/Platform.h"
+#include "sequoia-engine/Render/RenderFwd.h"
+#include <atomic>
 #include <unordered_map>
-#include <vector>
 
 namespace sequoia {
 
@@ -71,7 +75,13 @@ public:
 
 /// @brief Load assets from disk
 ///
-/// All access to the AssetManager is @b threadsafe.
+/// All access to the AssetManager is @b threadsafe. Assets (and decoded images) are cached and
+/// concurrent requests of the same asset share a single read (or decode) i.e the second request
+/// waits for the first one to finish instead of doing the work twice.
+///
+/// Asynchronous loads are executed as jobs of a `render::RenderServer`. The pending future of an
+/// asset (or image) is shared by all asynchronous requests and the decoding of an image is chained
+/// to the pending read of its file, hence no job waits for another one.
 ///
 /// @ingroup game
 class SEQUOIA_API AssetManager : public NonCopyable {
@@ -87,22 +97,50 @@ public:
     /// Path to the asset
     std::string Path;
 
-    /// Content of the file
-    aligned_vector<Byte> Data;
+    /// Content of the file (memory mapped if possible)
+    std::unique_ptr<core::FileBuffer> Data;
 
     /// Reference to the file
     std::shared_ptr<AssetFile> File;
+
+    /// Is `Data` loaded?
+    std::atomic<bool> IsLoaded;
+
+    /// Held while loading `Data`
+    Mutex LoadMutex;
+
+    /// Last asynchronous load (guarded by `AssetManager::pendingMutex_`)
+    Future<std::shared_ptr<core::File>> Pending;
   };
 
   /// @brief Initialize the manager with an archive
   ///
   /// @param path     Full path to the archive
-  AssetManager(const std::string& path);
+  /// @param server   Server used to run the asynchronous loads. If `nullptr`, the manager creates
+  ///                 its own server on the first asynchronous load.
+  ///
+  /// @note The `server` needs to outlive the manager
+  AssetManager(const std::string& path, render::RenderServer* server = nullptr);
+
+  /// @brief Wait for the pending asynchronous loads (they reference the manager)
+  ~AssetManager();
 
   /// @brief Load asset from disk
+  ///
+  /// If the asset is currently loaded by another thread, this waits for the load to finish.
+  ///
   /// @remark Thread-safe
   std::shared_ptr<File> load(const std::string& path, FileType type = FileType::Unknown);
 
+  /// @brief Load asset from disk asynchronously
+  ///
+  /// If the asset is already loaded, the returned future is ready immediately. If the asset is
+  /// currently loaded asynchronously, the pending future is returned.
+  ///
+  /// @remark Thread-safe
+  Future<std::shared_ptr<File>> loadAsync(const std::string& path,
+                                          FileType type = FileType::Unknown);
+
   /// @brief Load image from disk (or file)
   /// @remark Thread-safe
   /// @{
@@ -112,6 +150,14 @@ public:
   std::shared_ptr<Image> loadImage(const std::shared_ptr<File>& file);
   /// @}
 
+  /// @brief Load and decode image from disk asynchronously
+  ///
+  /// If the image is currently loaded asynchronously, the pending future is returned.
+  ///
+  /// @remark Thread-safe
+  Future<std::shared_ptr<Image>> loadImageAsync(const std::string& path,
+                                                FileType type = FileType::Unknown);
+
   /// @brief Get the root path to the assets
   const platform::Path& getAssetPath() const;
 
@@ -122,17 +168,50 @@ public:
   const Asset& getAsset(std::size_t id) const;
 
 private:
-  void loadFromDisk(std::unique_ptr<Asset>& asset);
+  /// @brief Decoded image
+  struct ImageEntry : public NonCopyable {
+    std::shared_ptr<Image> Decoded;         ///< Decoded image
+    std::atomic<bool> IsDecoded{false};     ///< Is `Decoded` set?
+    Mutex DecodeMutex;                      ///< Held while decoding the image
+    Future<std::shared_ptr<Image>> Pending; ///< Last asynchronous load (see `pendingMutex_`)
+  };
+
+  /// @brief Get the asset of `path` (register a new asset if necessary)
+  Asset* getOrRegisterAsset(const std::string& path, FileType type);
+
+  /// @brief Get the image entry of `file` (register a new entry if necessary)
+  ImageEntry* getOrRegisterImage(const std::shared_ptr<File>& file);
+
+  /// @brief Load the content of `asset` unless it was already loaded
+  void ensureLoaded(Asset* asset);
+
+  /// @brief Read the content of `asset` from disk
+  void loadFromDisk(Asset* asset);
+
+  /// @brief Get the server used for asynchronous loading
+  render::RenderServer* getRenderServer();
 
 private:
   /// Loaded assets (indexed by `id`s)
-  std::vector<std::unique_ptr<Asset>> assets_;
+  concurrent_vector<std::unique_ptr<Asset>> assets_;
 
   /// Map to of path to the index (i.e `id`) in `assets`
   std::unordered_map<std::string, std::size_t> pathLookupMap_;
 
   /// Map of file to image
-  std::unordered_map<std::shared_ptr<File>, std::shared_ptr<Image>> imageCache_;
+  std::unordered_map<std::shared_ptr<File>, std::unique_ptr<ImageEntry>> imageCache_;
+
+  /// Access mutex of `pathLookupMap_`, `imageCache_` and the registration of `assets_`
+  SpinMutex mutex_;
+
+  /// Access mutex of the pending futures of the assets and images (never held while loading)
+  Mutex pendingMutex_;
+
+  /// Server used for asynchronous loading
+  render::RenderServer* server_;
+
+  /// Server created by the manager (if no server was provided)
+  std::unique_ptr<render::RenderServer> ownedServer_;
 
   /// Full path to the assets
   platform::Path assetPath_;
@@ -17,9 +17,16 @@
 #include "sequoia-engine/Core/Format.h"
 #include "sequoia-engine/Game/Drawable.h"
 #include "sequoia-engine/Game/Game.h"
+#include "sequoia-engine/Game/Material.h"
+#include "sequoia-engine/Game/Mesh.h"
 #include "sequoia-engine/Game/SceneNode.h"
 #include "sequoia-engine/Game/SceneNodeAlloc.h"
+#include "sequoia-engine/Math/Frustum.h"
+#include "sequoia-engine/Render/Camera.h"
 #include "sequoia-engine/Render/DrawCommand.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
 
 namespace sequoia {
 
@@ -28,26 +35,103 @@ namespace game {
 Drawable::~Drawable() {}
 
 Drawable::Drawable(SceneNode* node, const std::shared_ptr<Shape>& shape)
-    : Base(node), active_(true), shape_(shape) {}
+    : Drawable(node, std::vector<LodLevel>{LodLevel{shape, 0.0f}}) {}
 
-void Drawable::prepareDrawCommands(std::vector<render::DrawCommand>& drawCommands) {
+Drawable::Drawable(SceneNode* node, std::vector<LodLevel> lods, float lodHysteresis)
+    : Base(node), active_(true), lods_(std::move(lods)), lodHysteresis_(lodHysteresis), lod_(0) {
+  SEQUOIA_ASSERT_MSG(!lods_.empty(), "no level of detail");
+  SEQUOIA_ASSERT_MSG(std::is_sorted(lods_.begin(), lods_.end(),
+                                    [](const LodLevel& a, const LodLevel& b) {
+                                      return a.ScreenSize > b.ScreenSize;
+                                    }),
+                     "screen sizes of the levels of detail are not decreasing");
+}
+
+std::vector<Drawable::LodLevel>
+Drawable::makeLods(const std::vector<std::shared_ptr<Shape>>& shapes, float screenSize,
+                   float factor) {
+  std::vector<LodLevel> lods;
+  for(std::size_t i = 0; i < shapes.size(); ++i) {
+    lods.emplace_back(LodLevel{shapes[i], i + 1 == shapes.size() ? 0.0f : screenSize});
+    screenSize *= factor;
+  }
+  return lods;
+}
+
+float Drawable::computeScreenSize(const render::Camera* camera) {
+  // The bounding box of the finest level is used to make the screen size independent of the
+  // selected level
+  math::AxisAlignedBox bbox = lods_.front().Shape->getAxisAlignedBox();
+  if(bbox.isNull())
+    return 0.0f;
+  if(bbox.isInfinite())
+    return std::numeric_limits<float>::infinity();
+  bbox.transform(getNode()->getWorldMatrix());
+
+  const math::vec3 center = 0.5f * (bbox.getMinimum() + bbox.getMaximum());
+  const float radius = 0.5f * math::length(bbox.getMaximum() - bbox.getMinimum());
+  const float distance = math::length(center - camera->getEye());
+  if(distance <= radius)
+    return std::numeric_limits<float>::infinity();
+
+  const float tanHalfFovy = std::tan(0.5f * math::Degree(camera->getFieldOfViewY()).inRadians());
+  return radius / (distance * tanHalfFovy);
+}
+
+std::size_t Drawable::selectLod(const render::Camera* camera) {
+  std::size_t lod = getLod();
+  if(lods_.size() == 1)
+    return lod;
+
+  const float screenSize = computeScreenSize(camera);
+
+  // Refine while the threshold of the next finer level is exceeded by the hysteresis ...
+  while(lod > 0 && screenSize >= lods_[lod - 1].ScreenSize * (1.0f + lodHysteresis_))
+    --lod;
+
+  // ... and coarsen while the screen size falls below the threshold of the current level by the
+  // hysteresis
+  while(lod + 1 < lods_.size() && screenSize < lods_[lod].ScreenSize * (1.0f - lodHysteresis_))
+    ++lod;
+
+  lod_.store(lod, std::memory_order_relaxed);
+  return lod;
+}
+
+bool Drawable::isVisible(const math::Frustum& frustum) {
+  math::AxisAlignedBox bbox = lods_.front().Shape->getAxisAlignedBox();
+  bbox.transform(getNode()->getWorldMatrix());
+  return frustum.intersects(bbox);
+}
+
+void Drawable::prepareDrawCommands(std::vector<render::DrawCommand>& drawCommands, float alpha,
+                                   const render::Camera* camera) {
   SEQUOIA_ASSERT(active_);
 
-  math::mat4 modelMatrix = getNode()->getModelMatrix();
-  shape_->forEach([this, &drawCommands, &modelMatrix](const std::shared_ptr<Mesh>& mesh,
-                                                      const std::shared_ptr<Material>& material) {
-    render::DrawCommand cmd(mesh->getVertexData(), modelMatrix);
+  const std::size_t lod = camera ? selectLod(camera) : getLod();
+  const Shape* shape = lods_[lod].Shape.get();
 
-    // Textures
-    for(const auto& textureUnitTexturePair : material->getTextures())
-      cmd.setTexture(textureUnitTexturePair.first, textureUnitTexturePair.second.get());
+  const math::mat4 modelMatrix =
+      alpha == 1.0f ? getNode()->getWorldMatrix() : getNode()->getInterpolatedWorldMatrix(alpha);
+  const auto& meshes = shape->getMeshes();
+  const auto& materials = shape->getMaterials();
 
-    // Uniforms
-    for(const auto& nameVariablePair : material->getUniforms())
-      cmd.setUniformVariable(nameVariablePair.first, nameVariablePair.second);
+  // The textures and uniforms are shared via the BindingSet of the material, this does not allocate
+  // (given `drawCommands` has enough capacity)
+  for(std::size_t i = 0; i < meshes.size(); ++i) {
+    const std::shared_ptr<render::VertexData>& data = meshes[i]->getSharedVertexData();
 
-    drawCommands.emplace_back(std::move(cmd));
-  });
+    // Quantized positions are mapped to the mesh by the model matrix
+    if(data->hasPositionDequantization()) {
+      const render::PositionDequantization& dequantization = data->getPositionDequantization();
+      drawCommands.emplace_back(
+          data, math::scale(math::translate(modelMatrix, math::make_vec3(dequantization.Offset)),
+                            math::make_vec3(dequantization.Scale)),
+          materials[i]->getBindingSet());
+    } else {
+      drawCommands.emplace_back(data, modelMatrix, materials[i]->getBindingSet());
+    }
+  }
 }
 
 void Drawable::update(const SceneNodeUpdateEvent& event) {}
@@ -55,13 +139,16 @@ void Drawable::update(const SceneNodeUpdateEvent& event) {}
 std::string Drawable::toString() const {
   return core::format("Drawable[\n"
                       "  active = {},\n"
+                      "  lod = {},\n"
+                      "  numLods = {},\n"
+                      "  lodHysteresis = {},\n"
                       "  shape = {},\n"
                       "]",
-                      active_, shape_->toString());
+                      active_, getLod(), lods_.size(), lodHysteresis_, getShape()->toString());
 }
 
 std::shared_ptr<SceneNodeCapability> Drawable::clone(SceneNode* node) const {
-  return scene::allocate_shared<Drawable>(node, shape_);
+  return scene::allocate_shared<Drawable>(node, lods_, lodHysteresis_);
 }
 
 } // namespace game
@@ -19,9 +19,12 @@
 #include "sequoia-engine/Game/GameFwd.h"
 #include "sequoia-engine/Game/SceneNodeCapability.h"
 #include "sequoia-engine/Game/Shape.h"
+#include "sequoia-engine/Math/MathFwd.h"
 #include "sequoia-engine/Render/DrawCommand.h"
 #include "sequoia-engine/Render/RenderFwd.h"
+#include <atomic>
 #include <memory>
+#include <vector>
 
 namespace sequoia {
 
@@ -30,11 +33,34 @@ namespace game {
 /// @brief Add the capability to a SceneNode to be drawn to the screen
 /// @ingroup game
 class SEQUOIA_API Drawable final : public SceneNodeCapability {
+public:
+  /// @brief Level of detail of the Drawable
+  struct LodLevel {
+    /// Shape of the level (including the mesh and material properties)
+    std::shared_ptr<game::Shape> Shape;
+
+    /// Minimal screen size at which the level is used, i.e the fraction of the viewport height
+    /// covered by the bounding sphere of the node
+    float ScreenSize;
+  };
+
+  /// @brief Default hysteresis of the level of detail selection
+  static constexpr float DefaultLodHysteresis = 0.1f;
+
+private:
   /// Is drawing enabled?
   bool active_;
 
-  /// Shape of the node (including the mesh and material properties)
-  std::shared_ptr<Shape> shape_;
+  /// Levels of detail ordered from the finest to the coarsest
+  std::vector<LodLevel> lods_;
+
+  /// Relative margin by which the screen size has to cross a threshold before switching the level
+  float lodHysteresis_;
+
+  /// Index of the selected level of detail. This is atomic as it is selected while preparing the
+  /// draw commands which may run concurrently to the update of the scene (see
+  /// `Game.PipelinedFrames`).
+  std::atomic<std::size_t> lod_;
 
 public:
   using Base = SceneNodeCapability;
@@ -45,18 +71,69 @@ public:
   /// @brief Construct with the associated shape
   Drawable(SceneNode* node, const std::shared_ptr<Shape>& shape);
 
+  /// @brief Construct with levels of detail
+  ///
+  /// @param node           Associated node
+  /// @param lods           Levels of detail ordered from the finest to the coarsest, the screen
+  ///                       sizes need to be decreasing (the screen size of the last level is
+  ///                       ignored)
+  /// @param lodHysteresis  Relative margin by which the screen size has to cross the threshold of
+  ///                       a level before the level is switched (avoids popping)
+  Drawable(SceneNode* node, std::vector<LodLevel> lods,
+           float lodHysteresis = DefaultLodHysteresis);
+
+  /// @brief Create the levels of detail of `shapes` (ordered from the finest to the coarsest)
+  ///
+  /// The level `i` is used down to a screen size of `screenSize * factor^i`.
+  static std::vector<LodLevel> makeLods(const std::vector<std::shared_ptr<Shape>>& shapes,
+                                        float screenSize = 0.5f, float factor = 0.5f);
+
   /// @brief Is the node rendered?
   bool isActive() const { return active_; }
 
   /// @brief Set if the node is rendered
   void setActive(bool active) { active_ = active; }
 
-  /// @brief Get the associated shape
-  Shape* getShape() noexcept { return shape_.get(); }
-  const Shape* getShape() const noexcept { return shape_.get(); }
+  /// @brief Get the shape of the selected level of detail
+  Shape* getShape() noexcept { return lods_[getLod()].Shape.get(); }
+  const Shape* getShape() const noexcept { return lods_[getLod()].Shape.get(); }
+
+  /// @brief Get the levels of detail
+  const std::vector<LodLevel>& getLods() const noexcept { return lods_; }
+
+  /// @brief Get the index of the selected level of detail
+  std::size_t getLod() const noexcept { return lod_.load(std::memory_order_relaxed); }
+
+  /// @brief Get/Set the hysteresis of the level of detail selection
+  /// @{
+  float getLodHysteresis() const noexcept { return lodHysteresis_; }
+  void setLodHysteresis(float lodHysteresis) noexcept { lodHysteresis_ = lodHysteresis; }
+  /// @}
+
+  /// @brief Compute the fraction of the viewport height of `camera` covered by the bounding sphere
+  /// of the node
+  float computeScreenSize(const render::Camera* camera);
+
+  /// @brief Select the level of detail for rendering the node with `camera`
+  ///
+  /// The selected level only changes if the screen size exceeds the threshold of a finer level
+  /// (or falls below the threshold of the current level) by more than the hysteresis.
+  ///
+  /// @returns index of the selected level of detail
+  std::size_t selectLod(const render::Camera* camera);
+
+  /// @brief Check if the shape, transformed by the model matrix of the node, intersects `frustum`
+  bool isVisible(const math::Frustum& frustum);
 
   /// @brief Prepare the DrawCommand for rendering
-  void prepareDrawCommands(std::vector<render::DrawCommand>& drawCommands);
+  ///
+  /// @param drawCommands   DrawCommands to append to
+  /// @param alpha          Interpolation factor between the previous and the current time-step
+  ///                       (see `SceneNode::getInterpolatedWorldMatrix`)
+  /// @param camera         Camera used to select the level of detail (if `nullptr`, the
+  ///                       previously selected level is used)
+  void prepareDrawCommands(std::vector<render::DrawCommand>& drawCommands, float alpha = 1.0f,
+                           const render::Camera* camera = nullptr);
 
   /// @copydoc SceneNodeCapability::update
   virtual void update(const SceneNodeUpdateEvent& event) override;
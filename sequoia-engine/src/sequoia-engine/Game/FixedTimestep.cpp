@@ -0,0 +1,66 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                         _____                        _
+//                        / ____|                      (_)
+//                       | (___   ___  __ _ _   _  ___  _  __ _
+//                        \___ \ / _ \/ _` | | | |/ _ \| |/ _` |
+//                        ____) |  __/ (_| | |_| | (_) | | (_| |
+//                       |_____/ \___|\__, |\__,_|\___/|_|\__,_| - Game Engine (2016-2017)
+//                                       | |
+//                                       |_|
+//
+// This file is distributed under the MIT License (MIT).
+// See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#include "sequoia-engine/Core/Assert.h"
+#include "sequoia-engine/Game/FixedTimestep.h"
+#include <algorithm>
+#include <chrono>
+
+namespace sequoia {
+
+namespace game {
+
+FixedTimestep::FixedTimestep(double timestep, int maxStepsPerFrame, ClockType clock)
+    : clock_(std::move(clock)), timestep_(timestep), maxStepsPerFrame_(maxStepsPerFrame) {
+  SEQUOIA_ASSERT_MSG(timestep_ > 0.0, "timestep must be positive");
+  SEQUOIA_ASSERT_MSG(maxStepsPerFrame_ > 0, "maximum number of steps per frame must be positive");
+  reset();
+}
+
+FixedTimestep::ClockType FixedTimestep::getDefaultClock() {
+  return []() -> double {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+  };
+}
+
+void FixedTimestep::reset() {
+  lastTime_ = clock_();
+  accumulator_ = 0.0;
+  numSteps_ = 0;
+  droppedTime_ = 0.0;
+}
+
+int FixedTimestep::advance() {
+  const double now = clock_();
+  accumulator_ += std::max(0.0, now - lastTime_);
+  lastTime_ = now;
+
+  int numSteps = static_cast<int>(accumulator_ / timestep_);
+  accumulator_ -= numSteps * timestep_;
+
+  // Drop the time we can't catch up with
+  if(numSteps > maxStepsPerFrame_) {
+    droppedTime_ += (numSteps - maxStepsPerFrame_) * timestep_;
+    numSteps = maxStepsPerFrame_;
+  }
+
+  numSteps_ += numSteps;
+  return numSteps;
+}
+
+} // namespace game
+
+} // namespace sequoia
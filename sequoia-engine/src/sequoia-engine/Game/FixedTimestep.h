@@ -0,0 +1,111 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                         _____                        _
+//                        / ____|                      (_)
+//                       | (___   ___  __ _ _   _  ___  _  __ _
+//                        \___ \ / _ \/ _` | | | |/ _ \| |/ _` |
+//                        ____) |  __/ (_| | |_| | (_) | | (_| |
+//                       |_____/ \___|\__, |\__,_|\___/|_|\__,_| - Game Engine (2016-2017)
+//                                       | |
+//                                       |_|
+//
+// This file is distributed under the MIT License (MIT).
+// See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#ifndef SEQUOIA_ENGINE_GAME_FIXEDTIMESTEP_H
+#define SEQUOIA_ENGINE_GAME_FIXEDTIMESTEP_H
+
+#include "sequoia-engine/Core/Export.h"
+#include <cstddef>
+#include <functional>
+
+namespace sequoia {
+
+namespace game {
+
+/// @brief Fixed-timestep accumulator driving the simulation of the main-loop
+///
+/// The time elapsed between two frames is accumulated and consumed in steps of a fixed size, hence
+/// the simulation advances independently of the frame rate. To avoid a spiral of death (i.e the
+/// updates taking longer than the time they simulate), at most `maxStepsPerFrame` steps are taken
+/// per frame and the surplus time is dropped.
+///
+/// The time left in the accumulator, relative to the timestep, yields the interpolation alpha in
+/// `[0, 1)` which is used to blend the previous and the current state of the simulation when
+/// rendering.
+///
+/// @code{.cpp}
+///   FixedTimestep timestep(1.0 / 60.0);
+///   while(running) {
+///     for(int step = 0, numSteps = timestep.advance(); step < numSteps; ++step)
+///       update(timestep.getTimestep());
+///     render(timestep.getAlpha());
+///   }
+/// @endcode
+///
+/// @ingroup game
+class SEQUOIA_API FixedTimestep {
+public:
+  /// @brief Clock returning the current time in seconds
+  using ClockType = std::function<double(void)>;
+
+  /// @brief Initialize the accumulator and start measuring the time
+  ///
+  /// @param timestep           Size of a step in seconds
+  /// @param maxStepsPerFrame   Maximum number of steps taken per frame
+  /// @param clock              Clock used to measure the elapsed time (allows faking the time)
+  FixedTimestep(double timestep, int maxStepsPerFrame = 5,
+                ClockType clock = FixedTimestep::getDefaultClock());
+
+  /// @brief Get a monotonic clock based on `std::chrono::steady_clock`
+  static ClockType getDefaultClock();
+
+  /// @brief Clear the accumulator and measure the elapsed time from now on
+  void reset();
+
+  /// @brief Accumulate the time elapsed since the last call and return the number of steps which
+  /// need to be taken in this frame
+  int advance();
+
+  /// @brief Get the size of a step in seconds
+  double getTimestep() const noexcept { return timestep_; }
+
+  /// @brief Get the maximum number of steps taken per frame
+  int getMaxStepsPerFrame() const noexcept { return maxStepsPerFrame_; }
+
+  /// @brief Get the interpolation alpha in `[0, 1)` between the previous and the current step
+  float getAlpha() const noexcept { return static_cast<float>(accumulator_ / timestep_); }
+
+  /// @brief Get the total number of steps taken
+  std::size_t getNumSteps() const noexcept { return numSteps_; }
+
+  /// @brief Get the total time (in seconds) which has been dropped because the simulation could not
+  /// catch up
+  double getDroppedTime() const noexcept { return droppedTime_; }
+
+private:
+  ClockType clock_;
+
+  /// Size of a step
+  double timestep_;
+
+  /// Maximum number of steps per frame
+  int maxStepsPerFrame_;
+
+  /// Time of the last call to `advance` or `reset`
+  double lastTime_;
+
+  /// Time which has not yet been consumed by steps
+  double accumulator_;
+
+  /// Statistics
+  std::size_t numSteps_;
+  double droppedTime_;
+};
+
+} // namespace game
+
+} // namespace sequoia
+
+#endif
@@ -13,23 +13,32 @@
 //
 //===------------------------------------------------------------------------------------------===//
 
+#include "sequoia-engine/Core/DoubleBuffered.h"
 #include "sequoia-engine/Core/ErrorHandler.h"
 #include "sequoia-engine/Core/Logging.h"
 #include "sequoia-engine/Core/Options.h"
 #include "sequoia-engine/Core/Platform.h"
+#include "sequoia-engine/Core/RealFileSystem.h"
 #include "sequoia-engine/Core/StringSwitch.h"
 #include "sequoia-engine/Core/StringUtil.h"
 #include "sequoia-engine/Core/Timer.h"
 #include "sequoia-engine/Core/Version.h"
 #include "sequoia-engine/Game/AssetManager.h"
+#include "sequoia-engine/Game/FixedTimestep.h"
 #include "sequoia-engine/Game/Game.h"
 #include "sequoia-engine/Game/Keymap.h"
+#include "sequoia-engine/Game/MeshCache.h"
 #include "sequoia-engine/Game/Scene.h"
 #include "sequoia-engine/Game/ShapeManager.h"
 #include "sequoia-engine/Render/Camera.h"
 #include "sequoia-engine/Render/Exception.h"
+#include "sequoia-engine/Render/RenderServer.h"
 #include "sequoia-engine/Render/RenderSystem.h"
 #include "sequoia-engine/Render/RenderWindow.h"
+#include <algorithm>
+#include <tbb/task_group.h>
+#include <tbb/task_scheduler_init.h>
+#include <thread>
 
 namespace sequoia {
 
@@ -37,10 +46,31 @@ SEQUOIA_DECLARE_SINGLETON(game::Game);
 
 namespace game {
 
+namespace {
+
+/// @brief Create the on-disk cache of the imported meshes (`nullptr` if the cache is disabled)
+static std::unique_ptr<MeshCache> makeMeshCache(const Options& options) {
+  const std::string dir = options.getString("Game.MeshCacheDir");
+  if(!options.getBool("Game.MeshCache") || dir.empty())
+    return nullptr;
+
+  try {
+    platform::filesystem::create_directories(platform::asPath(dir));
+  } catch(std::exception& e) {
+    Log::warn("Failed to create mesh cache directory \"{}\": {}", dir, e.what());
+    return nullptr;
+  }
+
+  Log::info("Using mesh cache \"{}\"", dir);
+  return std::make_unique<MeshCache>(std::make_shared<core::RealFileSystem>(dir));
+}
+
+} // anonymous namespace
+
 Game::Game()
-    : renderSystem_(nullptr), assetManager_(nullptr), shapeManager_(nullptr), mainWindow_(nullptr),
-      quitKey_(nullptr), shouldClose_(false), activeScene_(nullptr), name_("<unknown>"),
-      options_(nullptr) {}
+    : taskScheduler_(nullptr), renderSystem_(nullptr), assetManager_(nullptr),
+      shapeManager_(nullptr), mainWindow_(nullptr), quitKey_(nullptr), shouldClose_(false),
+      activeScene_(nullptr), name_("<unknown>"), options_(nullptr) {}
 
 Game::~Game() { cleanup(); }
 
@@ -55,24 +85,63 @@ void Game::run() {
 
   Log::info("Starting main-loop ...");
 
-  render::RenderCommand cmd(getMainRenderTarget());
   Timer timer;
 
+  // Advance the simulation in fixed time-steps, independent of the frame rate
+  FixedTimestep timestep(1.0 / options_->getFloat("Game.UpdateRate"),
+                         options_->getInt("Game.MaxUpdatesPerFrame"));
+
+  const SceneNode::ExecutionPolicy updatePolicy = options_->getBool("Game.ParallelUpdate")
+                                                      ? SceneNode::EP_Parallel
+                                                      : SceneNode::EP_Sequential;
+
+  // Advance the scene by as many time-steps as needed to catch up with the elapsed time and
+  // prepare the RenderCommand (interpolated between the last two time-steps). The RenderCommand is
+  // expected to be empty, resetting it is left to the thread owning the context of the
+  // render-system.
+  auto prepareFrame = [&](render::RenderCommand& cmd) {
+    for(int step = 0, numSteps = timestep.advance(); step < numSteps; ++step)
+      activeScene_->updateImpl(timestep.getTimestep(), updatePolicy);
+
+    activeScene_->prepareRenderCommand(cmd, timestep.getAlpha());
+  };
+
+  // While frame N is submitted by this thread (which owns the context of the render-system), frame
+  // N + 1 is prepared concurrently in the other buffer
+  const bool pipelinedFrames = options_->getBool("Game.PipelinedFrames");
+  DoubleBuffered<render::RenderCommand> commands(render::RenderCommand(getMainRenderTarget()),
+                                                 render::RenderCommand(getMainRenderTarget()));
+  tbb::task_group prepareTask;
+
+  prepareFrame(commands.get());
+
   // Start main-loop
   while(!mainWindow_->isClosed() && !shouldClose_) {
+    render::RenderCommand& cmd = commands.get();
+    commands.nextTimestep(false);
+    render::RenderCommand& nextCmd = commands.get();
 
-    // Advance the scene to the next time-step
-    activeScene_->updateImpl(0.1f); /* TODO: use actual timestep */
+    if(pipelinedFrames)
+      prepareTask.run([&prepareFrame, &nextCmd]() { prepareFrame(nextCmd); });
 
     // Render the scene
-    cmd.reset(getMainRenderTarget());
-    activeScene_->prepareRenderCommand(cmd);
     renderSystem_->renderOneFrame(cmd);
 
     // Update screen
     mainWindow_->swapBuffers();
 
-    // Query I/O events
+    if(pipelinedFrames)
+      prepareTask.wait();
+
+    // Release the meshes and materials of the submitted frame. The update of the scene has joined
+    // at this point, hence if it dropped its references in the meantime, the resources are freed
+    // by this thread (which owns the context of the render-system).
+    cmd.reset(getMainRenderTarget());
+
+    if(!pipelinedFrames)
+      prepareFrame(nextCmd);
+
+    // Query I/O events (the scene is not being updated at this point)
     renderSystem_->pollEvents();
   }
 
@@ -93,6 +162,16 @@ void Game::init(const std::shared_ptr<Options>& gameOptions) {
   using namespace render;
 
   try {
+    // The TBB scheduler (which runs the update of the scene) and the workers of the render-server
+    // share the hardware threads. The scheduler keeps at least one thread besides the main thread
+    // to prepare the frames concurrently.
+    const int numWorkers = options_->getInt("Render.NumWorkers") > 0
+                               ? options_->getInt("Render.NumWorkers")
+                               : static_cast<int>(RenderServer::getDefaultNumWorkers());
+    const int numThreads = std::max(1u, std::thread::hardware_concurrency());
+    taskScheduler_ =
+        std::make_unique<tbb::task_scheduler_init>(std::max(2, numThreads - numWorkers));
+
     // Initialize the RenderSystem
     renderSystem_ = RenderSystem::create(
         options_->getEnum<render::RenderSystemKind>("Game.RenderSystem"), options_);
@@ -115,8 +194,9 @@ void Game::init(const std::shared_ptr<Options>& gameOptions) {
     renderSystem_->addMouseListener(this);
 
     // Initialize the managers
-    assetManager_ = std::make_unique<AssetManager>(options_->getString("Game.RessourcePath"));
-    shapeManager_ = std::make_unique<ShapeManager>();
+    assetManager_ = std::make_unique<AssetManager>(options_->getString("Game.RessourcePath"),
+                                                   renderSystem_->getRenderServer());
+    shapeManager_ = std::make_unique<ShapeManager>(makeMeshCache(*options_));
 
   } catch(core::Exception& e) {
     ErrorHandler::fatal(e.what());
@@ -138,6 +218,8 @@ void Game::cleanup() {
   // Free all RenderSystem objects
   renderSystem_.reset();
 
+  taskScheduler_.reset();
+
   Log::info("Done terminating {}", name_);
 }
 
@@ -227,6 +309,15 @@ void Game::setDefaultOptions(const std::shared_ptr<Options>& options) {
   options->setDefaultBool("Game.HideWindow", false);
   options->setDefaultString("Game.Name", "Game");
   options->setDefaultInt("Game.RenderSystem", render::RK_OpenGL);
+  options->setDefaultBool("Game.ParallelUpdate", false);
+  options->setDefaultFloat("Game.UpdateRate", 60.0f);
+  options->setDefaultInt("Game.MaxUpdatesPerFrame", 5);
+  options->setDefaultBool("Game.PipelinedFrames", false);
+  options->setDefaultBool("Game.MeshCache", true);
+  options->setDefaultString("Game.MeshCacheDir",
+                            platform::toAnsiString(platform::filesystem::temp_directory_path() /
+                                                   PLATFORM_STR("sequoia-engine") /
+                                                   PLATFORM_STR("MeshCache")));
 
   // Render
   render::RenderSystem::setDefaultOptions(options);
@@ -32,6 +32,10 @@
 #include <set>
 #include <unordered_map>
 
+namespace tbb {
+class task_scheduler_init;
+}
+
 namespace sequoia {
 
 namespace game {
@@ -44,6 +48,9 @@ class SEQUOIA_API Game final : public Singleton<Game>,
                                public SceneListener,
                                public Listenable<KeyListener, MouseListener> {
 
+  /// Scheduler of the TBB tasks (sized against the workers of the render-server)
+  std::unique_ptr<tbb::task_scheduler_init> taskScheduler_;
+
   /// Active render-system
   std::unique_ptr<render::RenderSystem> renderSystem_;
 
@@ -88,6 +95,17 @@ public:
   void cleanup();
 
   /// @brief Run the main-loop
+  ///
+  /// If `Game.ParallelUpdate` is enabled (disabled by default), independent subtrees of the scene
+  /// graph are updated concurrently. The `update()` of the scene nodes and their capabilities must
+  /// then be thread-safe with respect to any state shared with unrelated nodes.
+  ///
+  /// If `Game.PipelinedFrames` is enabled (disabled by default), the scene is updated and the
+  /// RenderCommand of the next frame is prepared on a worker thread while the current frame is
+  /// submitted by the calling thread. Consequently, updates of the scene must neither call into the
+  /// RenderSystem nor drop the last reference to a render resource which is not part of a frame in
+  /// flight. The DrawCommands in flight share the ownership of their meshes and materials, which
+  /// are released by the calling thread once the update has joined.
   void run();
 
   /// @brief Set the quit key (use `nullptr` to disable the quit key)
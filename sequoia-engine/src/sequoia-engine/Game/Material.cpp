@@ -28,6 +28,29 @@ Material::Material(std::unordered_map<int, std::shared_ptr<render::Texture>> tex
                    std::unordered_map<std::string, render::UniformVariable> uniforms)
     : textures_(std::move(textures)), uniforms_(std::move(uniforms)) {}
 
+const std::shared_ptr<const render::BindingSet>& Material::getBindingSet() const {
+  if(!bindingSet_) {
+    std::vector<render::BindingSet::TextureBinding> textures;
+    std::vector<std::shared_ptr<render::Texture>> ownedTextures;
+    textures.reserve(textures_.size());
+    ownedTextures.reserve(textures_.size());
+    for(const auto& unitTexturePair : textures_) {
+      textures.emplace_back(unitTexturePair.first, unitTexturePair.second.get());
+      ownedTextures.emplace_back(unitTexturePair.second);
+    }
+
+    render::UniformNameTable& nameTable = render::UniformNameTable::getGlobal();
+    std::vector<render::BindingSet::UniformBinding> uniforms;
+    uniforms.reserve(uniforms_.size());
+    for(const auto& nameVariablePair : uniforms_)
+      uniforms.emplace_back(nameTable.intern(nameVariablePair.first), nameVariablePair.second);
+
+    bindingSet_ = std::make_shared<render::BindingSet>(std::move(textures), std::move(uniforms),
+                                                       std::move(ownedTextures));
+  }
+  return bindingSet_;
+}
+
 std::string Material::toString() const {
   return core::format(
       "Material[\n"
@@ -19,6 +19,7 @@
 #include "sequoia-engine/Core/Export.h"
 #include "sequoia-engine/Core/Hash.h"
 #include "sequoia-engine/Core/NonCopyable.h"
+#include "sequoia-engine/Render/BindingSet.h"
 #include "sequoia-engine/Render/RenderFwd.h"
 #include "sequoia-engine/Render/Texture.h"
 #include "sequoia-engine/Render/UniformVariable.h"
@@ -52,6 +53,7 @@ public:
   /// @param texture        Texture to bind
   void setTexture(int textureUnit, const std::shared_ptr<render::Texture>& texture) noexcept {
     textures_[textureUnit] = texture;
+    bindingSet_ = nullptr;
   }
 
   /// @brief Get the texture map
@@ -64,6 +66,7 @@ public:
   /// Note that if the uniform variable has already been set, the existing value is overriden.
   void setUniformVariable(const std::string& name, const render::UniformVariable& value) noexcept {
     uniforms_[name] = value;
+    bindingSet_ = nullptr;
   }
 
   /// @brief Set the uniform struct `name` to `value`
@@ -88,6 +91,7 @@ public:
   template <class StructType>
   void setUniformStruct(const std::string& name, const StructType& value, int index = -1) {
     value.toUniformVariableMap(name, uniforms_, index);
+    bindingSet_ = nullptr;
   }
 
   /// @brief Get the uniform variable map
@@ -95,6 +99,13 @@ public:
     return uniforms_;
   }
 
+  /// @brief Get the textures and uniform variables as BindingSet
+  ///
+  /// The BindingSet is created on first access and shared until the material is modified, which
+  /// creates a new one. `DrawCommand`s in flight share the ownership of the old BindingSet, hence
+  /// the material can be modified at any time.
+  const std::shared_ptr<const render::BindingSet>& getBindingSet() const;
+
   /// @brief Convert to string
   std::string toString() const;
 
@@ -104,6 +115,9 @@ private:
 
   /// Uniform variables
   std::unordered_map<std::string, render::UniformVariable> uniforms_;
+
+  /// Cached BindingSet of the textures and uniforms (`nullptr` if it needs to be recreated)
+  mutable std::shared_ptr<const render::BindingSet> bindingSet_;
 };
 
 } // namespace game
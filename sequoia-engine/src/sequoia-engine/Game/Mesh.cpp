@@ -25,14 +25,17 @@ namespace sequoia {
 namespace game {
 
 bool MeshParameter::operator==(const MeshParameter& other) const noexcept {
-  return TexCoordInvertV == other.TexCoordInvertV;
+  return TexCoordInvertV == other.TexCoordInvertV && Optimize == other.Optimize &&
+         Simplify == other.Simplify;
 }
 
 std::string MeshParameter::toString() const {
   return core::format("MeshParameter[\n"
-                      "  TexCoordInvertV = {}\n"
+                      "  TexCoordInvertV = {},\n"
+                      "  Optimize = {},\n"
+                      "  Simplify = {}\n"
                       "]",
-                      TexCoordInvertV ? "true" : "false");
+                      TexCoordInvertV ? "true" : "false", Optimize ? "true" : "false", Simplify);
 }
 
 Mesh::Mesh(const std::shared_ptr<render::VertexData>& data, bool modifiable)
@@ -42,6 +45,8 @@ const math::AxisAlignedBox& Mesh::getAxisAlignedBox() const noexcept {
   return data_->getAxisAlignedBox();
 }
 
+bool Mesh::hasAxisAlignedBox() const noexcept { return data_->hasAxisAlignedBox(); }
+
 void Mesh::dump() const { data_->dump(); }
 
 std::string Mesh::toString() const {
@@ -35,6 +35,13 @@ struct SEQUOIA_API MeshParameter {
   /// Invert the v-component of the `uv` texture coordinates i.e `v = 1.0 - v`
   bool TexCoordInvertV = false;
 
+  /// Reorder the triangles and vertices for the post-transform vertex cache and to reduce overdraw
+  bool Optimize = true;
+
+  /// Fraction of the triangles kept by the simplification of the imported meshes (see
+  /// MeshSimplifier), `1` disables the simplification
+  float Simplify = 1.0f;
+
   /// @name Comparison
   /// @{
   bool operator==(const MeshParameter& other) const noexcept;
@@ -66,9 +73,15 @@ public:
   /// @brief Get the VertexData
   render::VertexData* getVertexData() const noexcept { return data_.get(); }
 
+  /// @brief Get the VertexData as shared pointer (e.g to keep it alive while it is rendered)
+  const std::shared_ptr<render::VertexData>& getSharedVertexData() const noexcept { return data_; }
+
   /// @brief Get the axis aligned bounding box
   const math::AxisAlignedBox& getAxisAlignedBox() const noexcept;
 
+  /// @brief Check if the axis aligned bounding box is available
+  bool hasAxisAlignedBox() const noexcept;
+
   /// @brief Is the mesh modifyable?
   bool isModifiable() const noexcept { return modifiable_; }
 
@@ -84,7 +97,8 @@ public:
 
 } // namespace sequoia
 
-SEQUOIA_DECLARE_STD_HASH(sequoia::game::MeshParameter, param, param.TexCoordInvertV)
+SEQUOIA_DECLARE_STD_HASH(sequoia::game::MeshParameter, param, param.TexCoordInvertV, param.Optimize,
+                         param.Simplify)
 SEQUOIA_DECLARE_STD_HASH(std::shared_ptr<sequoia::game::MeshParameter>, paramPtr, *paramPtr)
 
 #endif
@@ -0,0 +1,55 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                         _____                        _
+//                        / ____|                      (_)
+//                       | (___   ___  __ _ _   _  ___  _  __ _
+//                        \___ \ / _ \/ _` | | | |/ _ \| |/ _` |
+//                        ____) |  __/ (_| | |_| | (_) | | (_| |
+//                       |_____/ \___|\__, |\__,_|\___/|_|\__,_| - Game Engine (2016-2017)
+//                                       | |
+//                                       |_|
+//
+// This file is distributed under the MIT License (MIT).
+// See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#ifndef SEQUOIA_ENGINE_GAME_MESHADJACENCY_H
+#define SEQUOIA_ENGINE_GAME_MESHADJACENCY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace sequoia {
+
+namespace game {
+
+namespace internal {
+
+/// @brief Triangles adjacent to each vertex of an indexed triangle list (compressed sparse row)
+///
+/// Shared by `MeshOptimizer` and `MeshSimplifier`.
+struct MeshAdjacency {
+  std::vector<std::uint32_t> Offsets;   ///< Triangles of `v` are `[Offsets[v], Offsets[v + 1])`
+  std::vector<std::uint32_t> Triangles; ///< Indices of the triangles
+
+  MeshAdjacency(const std::uint32_t* indices, std::size_t numIndices, std::size_t numVertices)
+      : Offsets(numVertices + 1, 0), Triangles(numIndices) {
+    for(std::size_t i = 0; i < numIndices; ++i)
+      Offsets[indices[i] + 1]++;
+    for(std::size_t v = 0; v < numVertices; ++v)
+      Offsets[v + 1] += Offsets[v];
+
+    std::vector<std::uint32_t> fill(Offsets.begin(), Offsets.end() - 1);
+    for(std::size_t i = 0; i < numIndices; ++i)
+      Triangles[fill[indices[i]]++] = i / 3;
+  }
+};
+
+} // namespace internal
+
+} // namespace game
+
+} // namespace sequoia
+
+#endif
@@ -0,0 +1,254 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                         _____                        _
+//                        / ____|                      (_)
+//                       | (___   ___  __ _ _   _  ___  _  __ _
+//                        \___ \ / _ \/ _` | | | |/ _ \| |/ _` |
+//                        ____) |  __/ (_| | |_| | (_) | | (_| |
+//                       |_____/ \___|\__, |\__,_|\___/|_|\__,_| - Game Engine (2016-2017)
+//                                       | |
+//                                       |_|
+//
+// This file is distributed under the MIT License (MIT).
+// See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#include "sequoia-engine/Core/Format.h"
+#include "sequoia-engine/Core/Hash.h"
+#include "sequoia-engine/Core/Logging.h"
+#include "sequoia-engine/Core/StringUtil.h"
+#include "sequoia-engine/Game/MeshCache.h"
+#include <algorithm>
+#include <cstring>
+
+namespace sequoia {
+
+namespace game {
+
+namespace {
+
+/// @brief Header of a cache entry (followed by `NumMeshes` MeshHeaders and the mesh data)
+struct EntryHeader {
+  char Magic[4];
+  std::uint32_t Version;
+  std::uint64_t Key;
+  std::uint32_t NumMeshes;
+  std::uint32_t Padding;
+  std::uint64_t NumBytes;
+};
+
+/// @brief Header of a mesh
+///
+/// The vertices and indices of all meshes are stored after the last header in the same order as
+/// the headers (each block is padded to a multiple of 4 bytes).
+struct MeshHeader {
+  std::uint8_t LayoutID;
+  std::uint8_t SizeOf;
+  std::uint8_t SizeOfIndex;
+  std::uint8_t Padding0;
+  std::uint32_t NumVertices;
+  std::uint32_t NumIndices;
+  float Minimum[3];
+  float Maximum[3];
+  std::uint32_t Padding1;
+};
+
+static_assert(sizeof(EntryHeader) == 32, "EntryHeader is expected to be unpadded");
+static_assert(sizeof(MeshHeader) == 40, "MeshHeader is expected to be unpadded");
+
+static const char EntryMagic[4] = {'S', 'Q', 'M', 'C'};
+
+static std::uint64_t alignBlock(std::uint64_t numBytes) {
+  return (numBytes + 3) & ~std::uint64_t(3);
+}
+
+static std::uint64_t getVerticesNumBytes(const MeshHeader& header) {
+  return alignBlock(std::uint64_t(header.NumVertices) * header.SizeOf);
+}
+
+static std::uint64_t getIndicesNumBytes(const MeshHeader& header) {
+  return alignBlock(std::uint64_t(header.NumIndices) * header.SizeOfIndex);
+}
+
+template <class IndexType>
+static bool isIndexOutOfBounds(const void* indices, std::uint32_t numIndices,
+                               std::uint32_t numVertices) {
+  const IndexType* first = static_cast<const IndexType*>(indices);
+  return numIndices > 0 && *std::max_element(first, first + numIndices) >= numVertices;
+}
+
+} // anonymous namespace
+
+MeshCache::MeshCache(const std::shared_ptr<core::FileSystem>& fileSystem)
+    : fileSystem_(fileSystem), numHits_(0), numMisses_(0), numInvalid_(0) {}
+
+std::uint64_t MeshCache::makeKey(const void* data, std::size_t numBytes,
+                                 std::uint64_t parameters) noexcept {
+  std::uint64_t hashes[3] = {core::fnv1a(data, numBytes), parameters, Version};
+  return core::fnv1a(hashes, sizeof(hashes));
+}
+
+bool MeshCache::load(std::uint64_t key, Entry& entry) {
+  const std::string path = getPath(key);
+
+  std::shared_ptr<core::FileBuffer> buffer;
+  try {
+    if(fileSystem_->exists(path))
+      buffer = fileSystem_->read(path, core::FileBuffer::FF_Binary);
+  } catch(std::exception& e) {
+    Log::warn("Failed to read cached mesh \"{}\": {}", path, e.what());
+  }
+
+  if(!buffer) {
+    numMisses_++;
+    return false;
+  }
+
+  auto invalid = [this, &path](const char* reason) {
+    Log::warn("Ignoring cached mesh \"{}\": {}", path, reason);
+    numInvalid_++;
+    return false;
+  };
+
+  // Trailing bytes are ignored as an overwritten entry may be shorter than the previous one
+  const Byte* data = buffer->getDataAs<Byte>();
+  const std::uint64_t numBytes = buffer->getNumBytes();
+
+  EntryHeader header;
+  if(numBytes < sizeof(EntryHeader))
+    return invalid("truncated header");
+  std::memcpy(&header, data, sizeof(EntryHeader));
+
+  if(std::memcmp(header.Magic, EntryMagic, sizeof(EntryMagic)) != 0)
+    return invalid("invalid magic");
+  if(header.Version != Version)
+    return invalid("version mismatch");
+  if(header.Key != key)
+    return invalid("key mismatch");
+  if(numBytes - sizeof(EntryHeader) < header.NumBytes ||
+     header.NumBytes / sizeof(MeshHeader) < header.NumMeshes)
+    return invalid("truncated data");
+
+  std::vector<MeshView> meshes(header.NumMeshes);
+  std::uint64_t offset = sizeof(EntryHeader) + header.NumMeshes * sizeof(MeshHeader);
+  const std::uint64_t end = sizeof(EntryHeader) + header.NumBytes;
+
+  for(std::uint32_t i = 0; i < header.NumMeshes; ++i) {
+    MeshHeader meshHeader;
+    std::memcpy(&meshHeader, data + sizeof(EntryHeader) + i * sizeof(MeshHeader),
+                sizeof(MeshHeader));
+
+    const std::uint64_t verticesNumBytes = getVerticesNumBytes(meshHeader);
+    const std::uint64_t indicesNumBytes = getIndicesNumBytes(meshHeader);
+    if(meshHeader.SizeOfIndex != sizeof(std::uint16_t) &&
+       meshHeader.SizeOfIndex != sizeof(std::uint32_t))
+      return invalid("invalid index size");
+    if(meshHeader.SizeOf == 0 || end - offset < verticesNumBytes ||
+       end - offset - verticesNumBytes < indicesNumBytes)
+      return invalid("truncated mesh");
+
+    MeshView& mesh = meshes[i];
+    mesh.LayoutID = meshHeader.LayoutID;
+    mesh.SizeOf = meshHeader.SizeOf;
+    mesh.SizeOfIndex = meshHeader.SizeOfIndex;
+    mesh.NumVertices = meshHeader.NumVertices;
+    mesh.NumIndices = meshHeader.NumIndices;
+    mesh.Vertices = data + offset;
+    mesh.Indices = data + offset + verticesNumBytes;
+    mesh.AxisAlignedBox = math::AxisAlignedBox(math::make_vec3(meshHeader.Minimum),
+                                               math::make_vec3(meshHeader.Maximum));
+    offset += verticesNumBytes + indicesNumBytes;
+
+    // Out of bounds indices would make the GPU read past the vertex buffer
+    if(mesh.SizeOfIndex == sizeof(std::uint16_t)
+           ? isIndexOutOfBounds<std::uint16_t>(mesh.Indices, mesh.NumIndices, mesh.NumVertices)
+           : isIndexOutOfBounds<std::uint32_t>(mesh.Indices, mesh.NumIndices, mesh.NumVertices))
+      return invalid("index out of bounds");
+  }
+
+  entry.Storage = std::move(buffer);
+  entry.Meshes = std::move(meshes);
+  numHits_++;
+  return true;
+}
+
+bool MeshCache::store(std::uint64_t key, const std::vector<MeshView>& meshes) {
+  const std::string path = getPath(key);
+
+  EntryHeader header;
+  std::memcpy(header.Magic, EntryMagic, sizeof(EntryMagic));
+  header.Version = Version;
+  header.Key = key;
+  header.NumMeshes = meshes.size();
+  header.Padding = 0;
+
+  std::vector<MeshHeader> meshHeaders(meshes.size());
+  header.NumBytes = meshes.size() * sizeof(MeshHeader);
+
+  for(std::size_t i = 0; i < meshes.size(); ++i) {
+    const MeshView& mesh = meshes[i];
+    MeshHeader& meshHeader = meshHeaders[i];
+    std::memset(&meshHeader, 0, sizeof(MeshHeader));
+
+    meshHeader.LayoutID = mesh.LayoutID;
+    meshHeader.SizeOf = mesh.SizeOf;
+    meshHeader.SizeOfIndex = mesh.SizeOfIndex;
+    meshHeader.NumVertices = mesh.NumVertices;
+    meshHeader.NumIndices = mesh.NumIndices;
+    for(int j = 0; j < 3; ++j) {
+      meshHeader.Minimum[j] = mesh.AxisAlignedBox.getMinimum()[j];
+      meshHeader.Maximum[j] = mesh.AxisAlignedBox.getMaximum()[j];
+    }
+    header.NumBytes += getVerticesNumBytes(meshHeader) + getIndicesNumBytes(meshHeader);
+  }
+
+  try {
+    auto buffer = std::make_shared<core::FileBuffer>(core::FileBuffer::FF_Binary, path,
+                                                     sizeof(EntryHeader) + header.NumBytes);
+
+    Byte* data = buffer->getDataAs<Byte>();
+    std::memcpy(data, &header, sizeof(EntryHeader));
+    std::memcpy(data + sizeof(EntryHeader), meshHeaders.data(),
+                meshHeaders.size() * sizeof(MeshHeader));
+
+    Byte* ptr = data + sizeof(EntryHeader) + meshHeaders.size() * sizeof(MeshHeader);
+    for(std::size_t i = 0; i < meshes.size(); ++i) {
+      const std::uint64_t verticesNumBytes = getVerticesNumBytes(meshHeaders[i]);
+      const std::uint64_t indicesNumBytes = getIndicesNumBytes(meshHeaders[i]);
+      const std::uint64_t numVertexBytes = std::uint64_t(meshes[i].NumVertices) * meshes[i].SizeOf;
+      const std::uint64_t numIndexBytes =
+          std::uint64_t(meshes[i].NumIndices) * meshes[i].SizeOfIndex;
+
+      if(numVertexBytes > 0)
+        std::memcpy(ptr, meshes[i].Vertices, numVertexBytes);
+      std::memset(ptr + numVertexBytes, 0, verticesNumBytes - numVertexBytes);
+      if(numIndexBytes > 0)
+        std::memcpy(ptr + verticesNumBytes, meshes[i].Indices, numIndexBytes);
+      std::memset(ptr + verticesNumBytes + numIndexBytes, 0, indicesNumBytes - numIndexBytes);
+      ptr += verticesNumBytes + indicesNumBytes;
+    }
+
+    fileSystem_->write(path, buffer);
+  } catch(std::exception& e) {
+    Log::warn("Failed to write cached mesh \"{}\": {}", path, e.what());
+    return false;
+  }
+  return true;
+}
+
+std::string MeshCache::getPath(std::uint64_t key) { return core::format("{:016x}.mesh", key); }
+
+std::string MeshCache::toString() const {
+  return core::format("MeshCache[\n"
+                      "  fileSystem = {},\n"
+                      "  numHits = {},\n"
+                      "  numMisses = {},\n"
+                      "  numInvalid = {}\n"
+                      "]",
+                      core::indent(fileSystem_->toString()), numHits_.load(), numMisses_.load(),
+                      numInvalid_.load());
+}
+
+} // namespace game
+
+} // namespace sequoia
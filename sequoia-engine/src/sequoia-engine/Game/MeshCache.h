@@ -0,0 +1,119 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                         _____                        _
+//                        / ____|                      (_)
+//                       | (___   ___  __ _ _   _  ___  _  __ _
+//                        \___ \ / _ \/ _` | | | |/ _ \| |/ _` |
+//                        ____) |  __/ (_| | |_| | (_) | | (_| |
+//                       |_____/ \___|\__, |\__,_|\___/|_|\__,_| - Game Engine (2016-2017)
+//                                       | |
+//                                       |_|
+//
+// This file is distributed under the MIT License (MIT).
+// See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#ifndef SEQUOIA_ENGINE_GAME_MESHCACHE_H
+#define SEQUOIA_ENGINE_GAME_MESHCACHE_H
+
+#include "sequoia-engine/Core/Byte.h"
+#include "sequoia-engine/Core/Export.h"
+#include "sequoia-engine/Core/FileSystem.h"
+#include "sequoia-engine/Core/NonCopyable.h"
+#include "sequoia-engine/Math/AxisAlignedBox.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace sequoia {
+
+namespace game {
+
+/// @brief On-disk cache of imported meshes
+///
+/// Each entry stores the meshes of one imported file in the engine-native representation, i.e
+/// the interleaved vertices (identified by the `render::VertexLayout::ID`), the 16 or 32-bit
+/// indices and the bounding box of each mesh. Loading an entry thus boils down to reading the file
+/// (which is memory mapped by `core::RealFileSystem` if large enough) and copying the vertices and
+/// indices into the hardware buffers.
+///
+/// Entries are keyed by the *content* of the imported file and the import parameters. Entries
+/// which are truncated, were produced by a different version or for a different vertex layout are
+/// reported as cache misses and will be overwritten by the next `store`.
+///
+/// @remark Thread-safe
+/// @ingroup game
+class SEQUOIA_API MeshCache : public NonCopyable {
+public:
+  /// @brief Current version of the file format (bump to invalidate all existing entries)
+  static constexpr std::uint32_t Version = 2;
+
+  /// @brief View of the vertices and indices of one mesh
+  struct MeshView {
+    std::uint8_t LayoutID = 0;           ///< `render::VertexLayout::ID` of the vertices
+    std::uint8_t SizeOf = 0;             ///< Size of one vertex (in bytes)
+    std::uint8_t SizeOfIndex = 4;        ///< Size of one index (2 or 4 bytes)
+    std::uint32_t NumVertices = 0;       ///< Number of vertices
+    std::uint32_t NumIndices = 0;        ///< Number of indices
+    const Byte* Vertices = nullptr;      ///< Interleaved vertices
+    const void* Indices = nullptr;       ///< Indices (`std::uint16_t` or `std::uint32_t`)
+    math::AxisAlignedBox AxisAlignedBox; ///< Bounding box of the vertices
+  };
+
+  /// @brief Meshes of an entry
+  struct Entry {
+    std::shared_ptr<const void> Storage; ///< Keeps the memory referenced by `Meshes` alive
+    std::vector<MeshView> Meshes;        ///< Meshes of the entry
+  };
+
+  /// @brief Create the cache operating on `fileSystem`
+  MeshCache(const std::shared_ptr<core::FileSystem>& fileSystem);
+
+  /// @brief Compute the key of the file with content `data` imported with `parameters`
+  ///
+  /// @param data         Content of the imported file
+  /// @param numBytes     Size of `data` (in bytes)
+  /// @param parameters   Hash of all parameters influencing the import (e.g the vertex layout)
+  static std::uint64_t makeKey(const void* data, std::size_t numBytes,
+                               std::uint64_t parameters) noexcept;
+
+  /// @brief Load the entry stored under `key`
+  /// @returns `true` if a valid entry was found, `false` otherwise
+  bool load(std::uint64_t key, Entry& entry);
+
+  /// @brief Store `meshes` under `key` (overwrites any existing entry)
+  /// @returns `true` on success, failures are logged but otherwise ignored
+  bool store(std::uint64_t key, const std::vector<MeshView>& meshes);
+
+  /// @brief Get the path (relative to the base directory of the file system) of the entry `key`
+  static std::string getPath(std::uint64_t key);
+
+  /// @brief Get the number of successful loads
+  std::size_t getNumHits() const noexcept { return numHits_; }
+
+  /// @brief Get the number of loads which did not find an entry
+  std::size_t getNumMisses() const noexcept { return numMisses_; }
+
+  /// @brief Get the number of loads which found an invalid entry
+  std::size_t getNumInvalid() const noexcept { return numInvalid_; }
+
+  /// @brief Convert to string
+  std::string toString() const;
+
+private:
+  /// File system storing the entries
+  std::shared_ptr<core::FileSystem> fileSystem_;
+
+  /// Statistics
+  std::atomic<std::size_t> numHits_;
+  std::atomic<std::size_t> numMisses_;
+  std::atomic<std::size_t> numInvalid_;
+};
+
+} // namespace game
+
+} // namespace sequoia
+
+#endif
@@ -0,0 +1,274 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                         _____                        _
+//                        / ____|                      (_)
+//                       | (___   ___  __ _ _   _  ___  _  __ _
+//                        \___ \ / _ \/ _` | | | |/ _ \| |/ _` |
+//                        ____) |  __/ (_| | |_| | (_) | | (_| |
+//                       |_____/ \___|\__, |\__,_|\___/|_|\__,_| - Game Engine (2016-2017)
+//                                       | |
+//                                       |_|
+//
+// This file is distributed under the MIT License (MIT).
+// See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#include "sequoia-engine/Core/Assert.h"
+#include "sequoia-engine/Game/MeshAdjacency.h"
+#include "sequoia-engine/Game/MeshOptimizer.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+namespace sequoia {
+
+namespace game {
+
+namespace {
+
+/// @brief FIFO cache simulated with time stamps
+class FIFOCache {
+  std::vector<std::uint32_t> cacheTime_;
+  std::uint32_t timeStamp_;
+  std::uint32_t cacheSize_;
+
+public:
+  FIFOCache(std::size_t numVertices, int cacheSize)
+      : cacheTime_(numVertices, 0), timeStamp_(cacheSize + 1), cacheSize_(cacheSize) {}
+
+  /// @brief Time `v` has spent in the cache (larger than the cache size if `v` is not cached)
+  std::uint32_t getAge(std::uint32_t v) const noexcept { return timeStamp_ - cacheTime_[v]; }
+
+  /// @brief Access `v` and return `true` on a cache miss
+  bool access(std::uint32_t v) noexcept {
+    if(getAge(v) <= cacheSize_)
+      return false;
+    cacheTime_[v] = timeStamp_++;
+    return true;
+  }
+};
+
+} // anonymous namespace
+
+void MeshOptimizer::optimizeVertexCache(std::uint32_t* indices, std::size_t numIndices,
+                                        std::size_t numVertices, int cacheSize) {
+  SEQUOIA_ASSERT_MSG(numIndices % 3 == 0, "expected a triangle list");
+  if(numIndices == 0)
+    return;
+
+  const std::size_t numTriangles = numIndices / 3;
+  internal::MeshAdjacency adjacency(indices, numIndices, numVertices);
+
+  // Number of adjacent triangles which are not yet emitted
+  std::vector<std::uint32_t> live(numVertices);
+  for(std::size_t v = 0; v < numVertices; ++v)
+    live[v] = adjacency.Offsets[v + 1] - adjacency.Offsets[v];
+
+  std::vector<bool> emitted(numTriangles, false);
+  std::vector<std::uint32_t> deadEnd;
+  std::vector<std::uint32_t> candidates;
+  std::vector<std::uint32_t> output;
+  output.reserve(numIndices);
+
+  FIFOCache cache(numVertices, cacheSize);
+  std::size_t cursor = 0;
+
+  // Fan around the vertex `fanning` by emitting all its remaining triangles, then continue with
+  // the candidate which is expected to remain longest in the cache
+  std::int64_t fanning = 0;
+  while(fanning >= 0) {
+    candidates.clear();
+
+    for(std::uint32_t i = adjacency.Offsets[fanning]; i < adjacency.Offsets[fanning + 1]; ++i) {
+      std::uint32_t t = adjacency.Triangles[i];
+      if(emitted[t])
+        continue;
+
+      for(int k = 0; k < 3; ++k) {
+        std::uint32_t v = indices[3 * t + k];
+        output.push_back(v);
+        deadEnd.push_back(v);
+        candidates.push_back(v);
+        live[v]--;
+        cache.access(v);
+      }
+      emitted[t] = true;
+    }
+
+    // Get next fanning vertex
+    fanning = -1;
+    std::int64_t bestPriority = -1;
+    for(std::uint32_t v : candidates) {
+      if(live[v] == 0)
+        continue;
+
+      // Prefer the vertices which will still be in the cache after fanning around them
+      std::int64_t priority = 0;
+      if(cache.getAge(v) + 2 * live[v] <= static_cast<std::uint32_t>(cacheSize))
+        priority = cache.getAge(v);
+
+      if(priority > bestPriority) {
+        bestPriority = priority;
+        fanning = v;
+      }
+    }
+
+    // Dead end, take the most recently used vertex with remaining triangles or the next vertex
+    // in input order
+    while(fanning < 0 && !deadEnd.empty()) {
+      std::uint32_t v = deadEnd.back();
+      deadEnd.pop_back();
+      if(live[v] > 0)
+        fanning = v;
+    }
+
+    while(fanning < 0 && cursor < numVertices) {
+      if(live[cursor] > 0)
+        fanning = cursor;
+      cursor++;
+    }
+  }
+
+  SEQUOIA_ASSERT(output.size() == numIndices);
+  std::copy(output.begin(), output.end(), indices);
+}
+
+void MeshOptimizer::optimizeOverdraw(std::uint32_t* indices, std::size_t numIndices,
+                                     const float* positions, std::size_t positionStride,
+                                     std::size_t numVertices, int cacheSize) {
+  SEQUOIA_ASSERT_MSG(numIndices % 3 == 0, "expected a triangle list");
+  if(numIndices == 0)
+    return;
+
+  const std::size_t numTriangles = numIndices / 3;
+  auto getPosition = [&](std::uint32_t v) {
+    return reinterpret_cast<const float*>(reinterpret_cast<const char*>(positions) +
+                                          v * positionStride);
+  };
+
+  // Split into clusters at the triangles which miss the cache with all vertices
+  std::vector<std::uint32_t> clusters;
+  FIFOCache cache(numVertices, cacheSize);
+  for(std::size_t t = 0; t < numTriangles; ++t) {
+    int misses = 0;
+    for(int k = 0; k < 3; ++k)
+      misses += cache.access(indices[3 * t + k]);
+    if(t == 0 || misses == 3)
+      clusters.push_back(t);
+  }
+  const std::size_t numClusters = clusters.size();
+  clusters.push_back(numTriangles);
+
+  if(numClusters == 1)
+    return;
+
+  // Area weighted centroid and normal of the clusters and the mesh
+  std::vector<float> clusterCentroids(3 * numClusters, 0.0f);
+  std::vector<float> clusterNormals(3 * numClusters, 0.0f);
+  float meshCentroid[3] = {0.0f, 0.0f, 0.0f};
+  float meshArea = 0.0f;
+
+  for(std::size_t c = 0; c < numClusters; ++c) {
+    float* centroid = &clusterCentroids[3 * c];
+    float* normal = &clusterNormals[3 * c];
+    float clusterArea = 0.0f;
+
+    for(std::uint32_t t = clusters[c]; t < clusters[c + 1]; ++t) {
+      const float* p0 = getPosition(indices[3 * t + 0]);
+      const float* p1 = getPosition(indices[3 * t + 1]);
+      const float* p2 = getPosition(indices[3 * t + 2]);
+
+      float e1[3] = {p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2]};
+      float e2[3] = {p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2]};
+      float n[3] = {e1[1] * e2[2] - e1[2] * e2[1], e1[2] * e2[0] - e1[0] * e2[2],
+                    e1[0] * e2[1] - e1[1] * e2[0]};
+      float area = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+
+      for(int k = 0; k < 3; ++k) {
+        float center = (p0[k] + p1[k] + p2[k]) / 3.0f;
+        centroid[k] += center * area;
+        meshCentroid[k] += center * area;
+        normal[k] += n[k];
+      }
+      clusterArea += area;
+    }
+
+    if(clusterArea > 0.0f)
+      for(int k = 0; k < 3; ++k)
+        centroid[k] /= clusterArea;
+    meshArea += clusterArea;
+  }
+
+  if(meshArea > 0.0f)
+    for(int k = 0; k < 3; ++k)
+      meshCentroid[k] /= meshArea;
+
+  // Clusters facing away from the center of the mesh are likely to occlude the others, hence
+  // they are drawn first
+  std::vector<float> sortKeys(numClusters);
+  for(std::size_t c = 0; c < numClusters; ++c) {
+    const float* centroid = &clusterCentroids[3 * c];
+    const float* normal = &clusterNormals[3 * c];
+    float length = std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+
+    float key = 0.0f;
+    for(int k = 0; k < 3; ++k)
+      key += (centroid[k] - meshCentroid[k]) * normal[k];
+    sortKeys[c] = length > 0.0f ? key / length : 0.0f;
+  }
+
+  std::vector<std::uint32_t> order(numClusters);
+  for(std::size_t c = 0; c < numClusters; ++c)
+    order[c] = c;
+  std::stable_sort(order.begin(), order.end(), [&sortKeys](std::uint32_t a, std::uint32_t b) {
+    return sortKeys[a] > sortKeys[b];
+  });
+
+  std::vector<std::uint32_t> output;
+  output.reserve(numIndices);
+  for(std::uint32_t c : order)
+    output.insert(output.end(), indices + 3 * clusters[c], indices + 3 * clusters[c + 1]);
+  std::copy(output.begin(), output.end(), indices);
+}
+
+std::size_t MeshOptimizer::optimizeVertexFetch(void* vertices, std::size_t numVertices,
+                                               std::size_t sizeOf, std::uint32_t* indices,
+                                               std::size_t numIndices) {
+  const std::uint32_t invalid = ~std::uint32_t(0);
+  std::vector<std::uint32_t> remap(numVertices, invalid);
+
+  std::uint32_t numReferenced = 0;
+  for(std::size_t i = 0; i < numIndices; ++i) {
+    std::uint32_t& newIndex = remap[indices[i]];
+    if(newIndex == invalid)
+      newIndex = numReferenced++;
+    indices[i] = newIndex;
+  }
+
+  std::vector<char> reordered(numReferenced * sizeOf);
+  const char* data = static_cast<const char*>(vertices);
+  for(std::size_t v = 0; v < numVertices; ++v)
+    if(remap[v] != invalid)
+      std::memcpy(reordered.data() + remap[v] * sizeOf, data + v * sizeOf, sizeOf);
+
+  if(!reordered.empty())
+    std::memcpy(vertices, reordered.data(), reordered.size());
+  return numReferenced;
+}
+
+float MeshOptimizer::computeACMR(const std::uint32_t* indices, std::size_t numIndices,
+                                 std::size_t numVertices, int cacheSize) {
+  if(numIndices < 3)
+    return 0.0f;
+
+  FIFOCache cache(numVertices, cacheSize);
+  std::size_t numMisses = 0;
+  for(std::size_t i = 0; i < numIndices; ++i)
+    numMisses += cache.access(indices[i]);
+  return static_cast<float>(numMisses) / (numIndices / 3);
+}
+
+} // namespace game
+
+} // namespace sequoia
@@ -0,0 +1,96 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                         _____                        _
+//                        / ____|                      (_)
+//                       | (___   ___  __ _ _   _  ___  _  __ _
+//                        \___ \ / _ \/ _` | | | |/ _ \| |/ _` |
+//                        ____) |  __/ (_| | |_| | (_) | | (_| |
+//                       |_____/ \___|\__, |\__,_|\___/|_|\__,_| - Game Engine (2016-2017)
+//                                       | |
+//                                       |_|
+//
+// This file is distributed under the MIT License (MIT).
+// See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#ifndef SEQUOIA_ENGINE_GAME_MESHOPTIMIZER_H
+#define SEQUOIA_ENGINE_GAME_MESHOPTIMIZER_H
+
+#include "sequoia-engine/Core/Export.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace sequoia {
+
+namespace game {
+
+/// @brief Reorder the triangles and vertices of indexed triangle lists for the GPU
+///
+/// The usual pipeline is
+///
+///  1. `optimizeVertexCache` : reorder the triangles to maximize the hits in the post-transform
+///     vertex cache (Tipsify [Sander et al. 2007])
+///  2. `optimizeOverdraw`    : reorder the clusters produced by 1. such that outward facing
+///     clusters are drawn first (which reduces overdraw at a small, bounded loss of cache
+///     efficiency)
+///  3. `optimizeVertexFetch` : reorder the vertices in the order they are referenced to improve
+///     the locality of the vertex fetches (and drop unreferenced vertices)
+///
+/// The efficiency of the vertex cache is measured by the ACMR (average cache miss ratio) i.e the
+/// number of transformed vertices per triangle which lies in `[0.5, 3]` for a FIFO cache.
+///
+/// @ingroup game
+class SEQUOIA_API MeshOptimizer {
+public:
+  MeshOptimizer() = delete;
+
+  /// @brief Size of the simulated FIFO vertex cache
+  static constexpr int DefaultCacheSize = 16;
+
+  /// @brief Reorder the triangles to improve the post-transform vertex cache efficiency
+  ///
+  /// @param indices      Indices of the triangles (modified in place)
+  /// @param numIndices   Number of indices (multiple of 3)
+  /// @param numVertices  Number of vertices (all indices need to be smaller than `numVertices`)
+  /// @param cacheSize    Size of the vertex cache
+  static void optimizeVertexCache(std::uint32_t* indices, std::size_t numIndices,
+                                  std::size_t numVertices, int cacheSize = DefaultCacheSize);
+
+  /// @brief Reorder the clusters of a cache optimized triangle list to reduce overdraw
+  ///
+  /// Clusters start at the triangles which miss the cache with all their vertices i.e the order
+  /// within the clusters is preserved. The ACMR only changes at the cluster boundaries where the
+  /// cache is not entirely cold anymore, the loss is thus bounded by the number of clusters.
+  ///
+  /// @param indices          Indices of the triangles (modified in place)
+  /// @param numIndices       Number of indices (multiple of 3)
+  /// @param positions        Pointer to the `float[3]` position of the first vertex
+  /// @param positionStride   Distance (in bytes) between two positions
+  /// @param numVertices      Number of vertices
+  /// @param cacheSize        Size of the vertex cache
+  static void optimizeOverdraw(std::uint32_t* indices, std::size_t numIndices,
+                               const float* positions, std::size_t positionStride,
+                               std::size_t numVertices, int cacheSize = DefaultCacheSize);
+
+  /// @brief Reorder the vertices in the order of their first use and remap the indices
+  ///
+  /// @param vertices     Vertices (modified in place)
+  /// @param numVertices  Number of vertices
+  /// @param sizeOf       Size of one vertex (in bytes)
+  /// @param indices      Indices of the triangles (modified in place)
+  /// @param numIndices   Number of indices
+  /// @returns number of referenced vertices (the vertices past this number are unused)
+  static std::size_t optimizeVertexFetch(void* vertices, std::size_t numVertices,
+                                         std::size_t sizeOf, std::uint32_t* indices,
+                                         std::size_t numIndices);
+
+  /// @brief Compute the ACMR of `indices` for a FIFO vertex cache of size `cacheSize`
+  static float computeACMR(const std::uint32_t* indices, std::size_t numIndices,
+                           std::size_t numVertices, int cacheSize = DefaultCacheSize);
+};
+
+} // namespace game
+
+} // namespace sequoia
+
+#endif
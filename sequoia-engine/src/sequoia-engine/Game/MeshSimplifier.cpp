@@ -0,0 +1,404 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                         _____                        _
+//                        / ____|                      (_)
+//                       | (___   ___  __ _ _   _  ___  _  __ _
+//                        \___ \ / _ \/ _` | | | |/ _ \| |/ _` |
+//                        ____) |  __/ (_| | |_| | (_) | | (_| |
+//                       |_____/ \___|\__, |\__,_|\___/|_|\__,_| - Game Engine (2016-2017)
+//                                       | |
+//                                       |_|
+//
+// This file is distributed under the MIT License (MIT).
+// See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#include "sequoia-engine/Core/Assert.h"
+#include "sequoia-engine/Game/MeshAdjacency.h"
+#include "sequoia-engine/Game/MeshSimplifier.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <vector>
+
+namespace sequoia {
+
+namespace game {
+
+namespace {
+
+/// @brief Weight of the planes which keep the border vertices on the border
+constexpr double BorderWeight = 10.0;
+
+/// @brief Classification of the vertices
+enum VertexKind : std::uint8_t {
+  VK_Manifold, ///< Interior vertex (can be collapsed onto any neighbour)
+  VK_Border,   ///< Vertex with exactly two border edges (can be collapsed along the border)
+  VK_Locked    ///< Seam or non-manifold vertex (never collapsed)
+};
+
+/// @brief Quadric error metric i.e the symmetric matrix `Q` of `v^T Q v` with `v = (x, y, z, 1)`
+struct Quadric {
+  double A00 = 0.0, A01 = 0.0, A02 = 0.0, A11 = 0.0, A12 = 0.0, A22 = 0.0;
+  double B0 = 0.0, B1 = 0.0, B2 = 0.0;
+  double C = 0.0;
+  double Weight = 0.0;
+
+  /// @brief Quadric of the plane `dot(n, p) + d = 0` (with `|n| = 1`) scaled by `weight`
+  static Quadric fromPlane(const double* n, double d, double weight) noexcept {
+    Quadric q;
+    q.A00 = weight * n[0] * n[0];
+    q.A01 = weight * n[0] * n[1];
+    q.A02 = weight * n[0] * n[2];
+    q.A11 = weight * n[1] * n[1];
+    q.A12 = weight * n[1] * n[2];
+    q.A22 = weight * n[2] * n[2];
+    q.B0 = weight * n[0] * d;
+    q.B1 = weight * n[1] * d;
+    q.B2 = weight * n[2] * d;
+    q.C = weight * d * d;
+    q.Weight = weight;
+    return q;
+  }
+
+  Quadric& operator+=(const Quadric& other) noexcept {
+    A00 += other.A00;
+    A01 += other.A01;
+    A02 += other.A02;
+    A11 += other.A11;
+    A12 += other.A12;
+    A22 += other.A22;
+    B0 += other.B0;
+    B1 += other.B1;
+    B2 += other.B2;
+    C += other.C;
+    Weight += other.Weight;
+    return *this;
+  }
+
+  /// @brief Weighted mean of the squared distances of `p` to the planes
+  double getError(const float* p) const noexcept {
+    if(Weight == 0.0)
+      return 0.0;
+    const double x = p[0], y = p[1], z = p[2];
+    const double error = A00 * x * x + A11 * y * y + A22 * z * z +
+                         2.0 * (A01 * x * y + A02 * x * z + A12 * y * z) +
+                         2.0 * (B0 * x + B1 * y + B2 * z) + C;
+    return std::max(error, 0.0) / Weight;
+  }
+};
+
+/// @brief Candidate for collapsing the vertex `From` onto `To`
+struct Collapse {
+  std::uint32_t From;
+  std::uint32_t To;
+  double Error;
+};
+
+inline void sub(const float* a, const float* b, double* res) noexcept {
+  for(int i = 0; i < 3; ++i)
+    res[i] = double(a[i]) - double(b[i]);
+}
+
+inline void cross(const double* a, const double* b, double* res) noexcept {
+  res[0] = a[1] * b[2] - a[2] * b[1];
+  res[1] = a[2] * b[0] - a[0] * b[2];
+  res[2] = a[0] * b[1] - a[1] * b[0];
+}
+
+inline double dot(const double* a, const double* b) noexcept {
+  return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+}
+
+/// @brief Unnormalized normal of the triangle `(p0, p1, p2)`
+inline void computeNormal(const float* p0, const float* p1, const float* p2, double* n) noexcept {
+  double e1[3], e2[3];
+  sub(p1, p0, e1);
+  sub(p2, p0, e2);
+  cross(e1, e2, n);
+}
+
+inline std::uint64_t makeEdge(std::uint32_t a, std::uint32_t b) noexcept {
+  return a < b ? (std::uint64_t(a) << 32) | b : (std::uint64_t(b) << 32) | a;
+}
+
+/// @brief Sorted undirected edges of the triangles (an edge appears once per adjacent triangle)
+void getEdges(const std::uint32_t* indices, std::size_t numIndices,
+              std::vector<std::uint64_t>& edges) {
+  edges.clear();
+  for(std::size_t i = 0; i < numIndices; i += 3)
+    for(int j = 0; j < 3; ++j)
+      edges.push_back(makeEdge(indices[i + j], indices[i + (j + 1) % 3]));
+  std::sort(edges.begin(), edges.end());
+}
+
+/// @brief Number of triangles adjacent to the edge `(a, b)`
+std::size_t getEdgeCount(const std::vector<std::uint64_t>& edges, std::uint32_t a,
+                         std::uint32_t b) {
+  auto range = std::equal_range(edges.begin(), edges.end(), makeEdge(a, b));
+  return range.second - range.first;
+}
+
+} // anonymous namespace
+
+std::size_t MeshSimplifier::simplify(std::uint32_t* indices, std::size_t numIndices,
+                                     const float* positions, std::size_t positionStride,
+                                     std::size_t numVertices, std::size_t targetNumIndices,
+                                     float targetError, float* resultError) {
+  SEQUOIA_ASSERT_MSG(numIndices % 3 == 0, "number of indices is not a multiple of 3");
+
+  if(resultError)
+    *resultError = 0.0f;
+
+  if(numIndices <= targetNumIndices)
+    return numIndices;
+
+  auto getPosition = [&](std::uint32_t v) {
+    return reinterpret_cast<const float*>(reinterpret_cast<const char*>(positions) +
+                                          v * positionStride);
+  };
+
+  std::vector<bool> isUsed(numVertices, false);
+  for(std::size_t i = 0; i < numIndices; ++i)
+    isUsed[indices[i]] = true;
+
+  // The errors are measured relative to the extent of the mesh
+  float lower[3] = {std::numeric_limits<float>::max(), std::numeric_limits<float>::max(),
+                    std::numeric_limits<float>::max()};
+  float upper[3] = {std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest(),
+                    std::numeric_limits<float>::lowest()};
+  for(std::uint32_t v = 0; v < numVertices; ++v) {
+    if(!isUsed[v])
+      continue;
+    const float* p = getPosition(v);
+    for(int i = 0; i < 3; ++i) {
+      lower[i] = std::min(lower[i], p[i]);
+      upper[i] = std::max(upper[i], p[i]);
+    }
+  }
+  const double extent =
+      std::max({upper[0] - lower[0], upper[1] - lower[1], upper[2] - lower[2], 0.0f});
+  const double errorLimit = (double(targetError) * extent) * (double(targetError) * extent);
+
+  //
+  // Classify the vertices
+  //
+  std::vector<VertexKind> kinds(numVertices, VK_Manifold);
+
+  // Vertices sharing their position with other vertices are on an attribute seam
+  std::vector<std::uint32_t> order;
+  for(std::uint32_t v = 0; v < numVertices; ++v)
+    if(isUsed[v])
+      order.push_back(v);
+
+  auto lessPosition = [&](std::uint32_t a, std::uint32_t b) {
+    const float* pa = getPosition(a);
+    const float* pb = getPosition(b);
+    return std::lexicographical_compare(pa, pa + 3, pb, pb + 3);
+  };
+  std::sort(order.begin(), order.end(), lessPosition);
+  for(std::size_t i = 1; i < order.size(); ++i)
+    if(!lessPosition(order[i - 1], order[i]))
+      kinds[order[i - 1]] = kinds[order[i]] = VK_Locked;
+
+  // Vertices with exactly two border edges are on the border, vertices of non-manifold edges (or
+  // with more border edges) are locked
+  std::vector<std::uint64_t> edges;
+  getEdges(indices, numIndices, edges);
+
+  std::vector<std::uint8_t> numBorderEdges(numVertices, 0);
+  for(std::size_t i = 0; i < edges.size();) {
+    std::size_t j = i;
+    while(j < edges.size() && edges[j] == edges[i])
+      ++j;
+
+    const std::uint32_t a = edges[i] >> 32, b = edges[i] & 0xffffffff;
+    if(j - i == 1) {
+      numBorderEdges[a] = std::min(numBorderEdges[a] + 1, 3);
+      numBorderEdges[b] = std::min(numBorderEdges[b] + 1, 3);
+    } else if(j - i > 2) {
+      kinds[a] = kinds[b] = VK_Locked;
+    }
+    i = j;
+  }
+
+  for(std::uint32_t v = 0; v < numVertices; ++v) {
+    if(kinds[v] == VK_Locked || numBorderEdges[v] == 0)
+      continue;
+    kinds[v] = numBorderEdges[v] == 2 ? VK_Border : VK_Locked;
+  }
+
+  //
+  // Accumulate the quadrics of the planes of the adjacent triangles (weighted by the area) and the
+  // planes through the border edges perpendicular to the triangles
+  //
+  std::vector<Quadric> quadrics(numVertices);
+  for(std::size_t i = 0; i < numIndices; i += 3) {
+    double n[3];
+    computeNormal(getPosition(indices[i]), getPosition(indices[i + 1]),
+                  getPosition(indices[i + 2]), n);
+
+    const double length = std::sqrt(dot(n, n));
+    if(length == 0.0)
+      continue;
+    for(int j = 0; j < 3; ++j)
+      n[j] /= length;
+
+    const float* p0 = getPosition(indices[i]);
+    const double p0d[3] = {p0[0], p0[1], p0[2]};
+    const Quadric q = Quadric::fromPlane(n, -dot(n, p0d), 0.5 * length);
+    for(int j = 0; j < 3; ++j)
+      quadrics[indices[i + j]] += q;
+
+    for(int j = 0; j < 3; ++j) {
+      const std::uint32_t a = indices[i + j], b = indices[i + (j + 1) % 3];
+      if(getEdgeCount(edges, a, b) != 1)
+        continue;
+
+      double e[3], m[3];
+      sub(getPosition(b), getPosition(a), e);
+      cross(e, n, m);
+
+      const double lengthM = std::sqrt(dot(m, m));
+      if(lengthM == 0.0)
+        continue;
+      for(int k = 0; k < 3; ++k)
+        m[k] /= lengthM;
+
+      const float* pa = getPosition(a);
+      const double pad[3] = {pa[0], pa[1], pa[2]};
+      const Quadric border = Quadric::fromPlane(m, -dot(m, pad), BorderWeight * dot(e, e));
+      quadrics[a] += border;
+      quadrics[b] += border;
+    }
+  }
+
+  //
+  // Collapse the edges in passes, each pass collapses the cheapest edges with disjoint
+  // neighbourhoods
+  //
+  std::vector<Collapse> collapses;
+  std::vector<std::uint32_t> remap(numVertices);
+  std::vector<bool> isTouched(numVertices);
+  double maxError = 0.0;
+
+  auto canCollapse = [&](std::uint32_t from, std::uint32_t to, bool isBorderEdge) {
+    switch(kinds[from]) {
+    case VK_Manifold:
+      return !isBorderEdge;
+    case VK_Border:
+      return isBorderEdge && kinds[to] != VK_Manifold;
+    default:
+      return false;
+    }
+  };
+
+  auto getCollapseError = [&](std::uint32_t from, std::uint32_t to) {
+    Quadric q = quadrics[from];
+    q += quadrics[to];
+    return q.getError(getPosition(to));
+  };
+
+  // Check if moving `from` to `to` flips (or degenerates) any of the remaining triangles
+  auto hasFlippedTriangles = [&](const internal::MeshAdjacency& adjacency, std::uint32_t from,
+                                 std::uint32_t to) {
+    for(std::uint32_t k = adjacency.Offsets[from]; k < adjacency.Offsets[from + 1]; ++k) {
+      const std::uint32_t* triangle = indices + 3 * adjacency.Triangles[k];
+      if(triangle[0] == to || triangle[1] == to || triangle[2] == to)
+        continue;
+
+      const float* p[3];
+      const float* q[3];
+      for(int j = 0; j < 3; ++j) {
+        p[j] = getPosition(triangle[j]);
+        q[j] = getPosition(triangle[j] == from ? to : triangle[j]);
+      }
+
+      double nOld[3], nNew[3];
+      computeNormal(p[0], p[1], p[2], nOld);
+      computeNormal(q[0], q[1], q[2], nNew);
+
+      const double lengthOld = std::sqrt(dot(nOld, nOld));
+      if(lengthOld != 0.0 && dot(nOld, nNew) <= 0.25 * lengthOld * std::sqrt(dot(nNew, nNew)))
+        return true;
+    }
+    return false;
+  };
+
+  while(numIndices > targetNumIndices) {
+    getEdges(indices, numIndices, edges);
+
+    collapses.clear();
+    for(std::size_t i = 0; i < edges.size();) {
+      std::size_t j = i;
+      while(j < edges.size() && edges[j] == edges[i])
+        ++j;
+
+      const std::uint32_t a = edges[i] >> 32, b = edges[i] & 0xffffffff;
+      const bool isBorderEdge = (j - i == 1);
+      if(canCollapse(a, b, isBorderEdge))
+        collapses.push_back(Collapse{a, b, getCollapseError(a, b)});
+      if(canCollapse(b, a, isBorderEdge))
+        collapses.push_back(Collapse{b, a, getCollapseError(b, a)});
+      i = j;
+    }
+
+    std::sort(collapses.begin(), collapses.end(),
+              [](const Collapse& a, const Collapse& b) { return a.Error < b.Error; });
+
+    internal::MeshAdjacency adjacency(indices, numIndices, numVertices);
+    std::iota(remap.begin(), remap.end(), 0);
+    std::fill(isTouched.begin(), isTouched.end(), false);
+
+    const std::size_t numTrianglesToRemove = (numIndices - targetNumIndices + 2) / 3;
+    std::size_t numTrianglesRemoved = 0;
+
+    for(const Collapse& collapse : collapses) {
+      if(collapse.Error > errorLimit || numTrianglesRemoved >= numTrianglesToRemove)
+        break;
+
+      if(isTouched[collapse.From] || isTouched[collapse.To] ||
+         hasFlippedTriangles(adjacency, collapse.From, collapse.To))
+        continue;
+
+      remap[collapse.From] = collapse.To;
+      quadrics[collapse.To] += quadrics[collapse.From];
+
+      // Lock the neighbourhood of the collapse for the rest of the pass
+      for(std::uint32_t k = adjacency.Offsets[collapse.From];
+          k < adjacency.Offsets[collapse.From + 1]; ++k)
+        for(int j = 0; j < 3; ++j)
+          isTouched[indices[3 * adjacency.Triangles[k] + j]] = true;
+
+      numTrianglesRemoved += kinds[collapse.From] == VK_Border ? 1 : 2;
+      maxError = std::max(maxError, collapse.Error);
+    }
+
+    if(numTrianglesRemoved == 0)
+      break;
+
+    // Apply the collapses and drop the degenerate triangles
+    std::size_t newNumIndices = 0;
+    for(std::size_t i = 0; i < numIndices; i += 3) {
+      const std::uint32_t a = remap[indices[i]], b = remap[indices[i + 1]],
+                          c = remap[indices[i + 2]];
+      if(a == b || b == c || c == a)
+        continue;
+
+      indices[newNumIndices++] = a;
+      indices[newNumIndices++] = b;
+      indices[newNumIndices++] = c;
+    }
+    numIndices = newNumIndices;
+  }
+
+  if(resultError)
+    *resultError = extent == 0.0 ? 0.0f : float(std::sqrt(maxError) / extent);
+
+  return numIndices;
+}
+
+} // namespace game
+
+} // namespace sequoia
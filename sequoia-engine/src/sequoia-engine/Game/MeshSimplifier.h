@@ -0,0 +1,75 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                         _____                        _
+//                        / ____|                      (_)
+//                       | (___   ___  __ _ _   _  ___  _  __ _
+//                        \___ \ / _ \/ _` | | | |/ _ \| |/ _` |
+//                        ____) |  __/ (_| | |_| | (_) | | (_| |
+//                       |_____/ \___|\__, |\__,_|\___/|_|\__,_| - Game Engine (2016-2017)
+//                                       | |
+//                                       |_|
+//
+// This file is distributed under the MIT License (MIT).
+// See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#ifndef SEQUOIA_ENGINE_GAME_MESHSIMPLIFIER_H
+#define SEQUOIA_ENGINE_GAME_MESHSIMPLIFIER_H
+
+#include "sequoia-engine/Core/Export.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace sequoia {
+
+namespace game {
+
+/// @brief Reduce the number of triangles of indexed triangle lists (used to generate the levels of
+/// detail of a Shape)
+///
+/// The triangles are simplified by iteratively collapsing the edge with the smallest quadric error
+/// [Garland and Heckbert 1997]. The collapses are half-edge collapses i.e a vertex is merged into
+/// one of its neighbours which means no new vertices are created and the attributes (normals,
+/// texture coordinates, ...) of the remaining vertices stay valid.
+///
+/// Vertices on the border of the mesh are only moved along the border. Vertices which share their
+/// position with another vertex (attribute seams) or lie on non-manifold edges are never moved.
+///
+/// @ingroup game
+class SEQUOIA_API MeshSimplifier {
+public:
+  MeshSimplifier() = delete;
+
+  /// @brief Default upper bound of the error (relative to the extent of the mesh)
+  static constexpr float DefaultTargetError = 1e-2f;
+
+  /// @brief Collapse edges until at most `targetNumIndices` indices are left or the error of the
+  /// next collapse exceeds `targetError`
+  ///
+  /// The resulting indices reference the input vertices, `MeshOptimizer::optimizeVertexFetch` can
+  /// be used to drop the unreferenced vertices.
+  ///
+  /// @param indices            Indices of the triangles (modified in place)
+  /// @param numIndices         Number of indices (multiple of 3)
+  /// @param positions          Pointer to the `float[3]` position of the first vertex
+  /// @param positionStride     Distance (in bytes) between two positions
+  /// @param numVertices        Number of vertices
+  /// @param targetNumIndices   Requested number of indices
+  /// @param targetError        Upper bound of the distance between the simplified and the original
+  ///                           surface (relative to the extent of the mesh)
+  /// @param resultError        If not `nullptr`, set to the largest error of the collapses
+  ///                           (relative to the extent of the mesh)
+  /// @returns number of indices of the simplified triangles (the indices past this number are
+  /// unused)
+  static std::size_t simplify(std::uint32_t* indices, std::size_t numIndices,
+                              const float* positions, std::size_t positionStride,
+                              std::size_t numVertices, std::size_t targetNumIndices,
+                              float targetError = DefaultTargetError,
+                              float* resultError = nullptr);
+};
+
+} // namespace game
+
+} // namespace sequoia
+
+#endif
@@ -20,6 +20,8 @@
 #include "sequoia-engine/Game/Game.h"
 #include "sequoia-engine/Game/Scene.h"
 #include "sequoia-engine/Game/SceneGraph.h"
+#include "sequoia-engine/Game/TransformStore.h"
+#include "sequoia-engine/Math/Frustum.h"
 #include "sequoia-engine/Render/Camera.h"
 #include "sequoia-engine/Render/RenderCommand.h"
 
@@ -28,7 +30,8 @@ namespace sequoia {
 namespace game {
 
 Scene::Scene(const std::string& name)
-    : name_(name), sceneGraph_(std::make_shared<SceneGraph>()), activeCamera_(nullptr) {}
+    : name_(name), sceneGraph_(std::make_shared<SceneGraph>()), activeCamera_(nullptr),
+      frustumCulling_(true), interpolationAlpha_(1.0f) {}
 
 void Scene::setActiveCamera(const std::shared_ptr<render::Camera>& camera) {
   activeCamera_ = camera;
@@ -45,29 +48,55 @@ void Scene::prepareRenderTechniques(std::vector<render::RenderTechnique*>& techi
 void Scene::prepareRenderTarget(render::RenderTarget*& target) {}
 
 void Scene::prepareDrawCommands(std::vector<render::DrawCommand>& drawCommands) {
-  sceneGraph_->apply([&drawCommands](SceneNode* node) {
-    if(Drawable* drawable = node->get<Drawable>()) {
-      if(drawable->isActive()) {
-        drawable->prepareDrawCommands(drawCommands);
+  if(frustumCulling_ && activeCamera_) {
+    const math::Frustum frustum = activeCamera_->getFrustum();
+    sceneGraph_->apply([&drawCommands, &frustum, this](SceneNode* node) {
+      if(Drawable* drawable = node->get<Drawable>()) {
+        if(drawable->isActive() && drawable->isVisible(frustum)) {
+          drawable->prepareDrawCommands(drawCommands, interpolationAlpha_, activeCamera_.get());
+        }
       }
-    }
-  });
+    });
+  } else {
+    sceneGraph_->apply([&drawCommands, this](SceneNode* node) {
+      if(Drawable* drawable = node->get<Drawable>()) {
+        if(drawable->isActive()) {
+          drawable->prepareDrawCommands(drawCommands, interpolationAlpha_, activeCamera_.get());
+        }
+      }
+    });
+  }
 }
 
-void Scene::prepareRenderCommand(render::RenderCommand& cmd) {
+void Scene::prepareRenderCommand(render::RenderCommand& cmd, float alpha) {
+  interpolationAlpha_ = alpha;
   prepareRenderTarget(cmd.Target);
   prepareRenderTechniques(cmd.Techniques);
   prepareDrawCommands(cmd.DrawCommands);
+
+  // The camera may be modified by the next update while the command is being rendered
+  if(activeCamera_) {
+    cmd.ViewMatrix = activeCamera_->getViewMatrix();
+    cmd.ProjectionMatrix = activeCamera_->getProjectionMatrix();
+  }
 }
 
 void Scene::update() {}
 
-void Scene::updateImpl(float timeStep) {
+void Scene::updateImpl(float timeStep, SceneNode::ExecutionPolicy policy) {
+  // Remember the state of the previous time-step
+  TransformStore::getGlobal().storePreviousWorldMatrices();
+
   // Inform the nodes to progress to the next time-step
-  sceneGraph_->update(SceneNode::UpdateEvent{timeStep});
+  sceneGraph_->update(SceneNode::UpdateEvent{timeStep}, policy);
 
   // Update the scene
   update();
+
+  // Recompute the model matrices in one linear pass over the store and propagate the modified
+  // transformations down the graph
+  TransformStore::getGlobal().computeModelMatrices();
+  sceneGraph_->updateWorldMatrices(true);
 }
 
 } // namespace game
@@ -20,6 +20,7 @@
 #include "sequoia-engine/Core/Listenable.h"
 #include "sequoia-engine/Core/NonCopyable.h"
 #include "sequoia-engine/Game/GameFwd.h"
+#include "sequoia-engine/Game/SceneNode.h"
 #include "sequoia-engine/Render/RenderFwd.h"
 #include <memory>
 #include <string>
@@ -79,9 +80,21 @@ public:
   /// @brief Prepare a list of `DrawCommand`s which is used in the next render call
   ///
   /// This is called automatically by `prepareRenderCommand`. By default the SceneGraph is traversed
-  /// and each actice `Drawable` is added to the `drawCommands`.
+  /// and each actice `Drawable` is added to the `drawCommands`. If frustum culling is enabled,
+  /// `Drawable`s whose bounding box lies outside the view frustum of the active camera are
+  /// skipped.
   virtual void prepareDrawCommands(std::vector<render::DrawCommand>& drawCommands);
 
+  /// @brief Enable/Disable view frustum culling of `Drawable`s (enabled by default)
+  void setFrustumCulling(bool frustumCulling) { frustumCulling_ = frustumCulling; }
+
+  /// @brief Check if view frustum culling is enabled
+  bool hasFrustumCulling() const { return frustumCulling_; }
+
+  /// @brief Get the interpolation factor between the previous and the current time-step used to
+  /// render the next frame (see `FixedTimestep::getAlpha`)
+  float getInterpolationAlpha() const { return interpolationAlpha_; }
+
   /// @brief Prepare the RenderTarget whis is used in the next render call
   ///
   /// This is called automatically by `prepareRenderCommand`. By default, this does not change the
@@ -94,13 +107,23 @@ private:
   /// @brief Send an update notification to all SceneNodes in the SceneGraph and call `update()`
   ///
   /// This is called by the `Game` in the main-loop.
-  void updateImpl(float timeStep);
+  ///
+  /// The world matrices at the beginning of the time-step are stored as the previous world matrices
+  /// to allow interpolating between the time-steps when rendering.
+  ///
+  /// @param timeStep   Time since the last update
+  /// @param policy     Execution policy used to update the SceneGraph
+  void updateImpl(float timeStep, SceneNode::ExecutionPolicy policy = SceneNode::EP_Sequential);
 
   /// @brief Prepare the RenderCommand by calling `prepareRenderTechniques` as well as
   /// `prepareDrawCommands`
   ///
-  /// This is called by the `Game` in the main-loop.
-  void prepareRenderCommand(render::RenderCommand& cmd);
+  /// This is called by the `Game` in the main-loop. The view-projection matrix of the active camera
+  /// is stored in the command, hence the command stays valid while the scene is updated.
+  ///
+  /// @param cmd      RenderCommand to prepare
+  /// @param alpha    Interpolation factor between the previous and the current time-step
+  void prepareRenderCommand(render::RenderCommand& cmd, float alpha = 1.0f);
 
 private:
   /// Name of the scene
@@ -111,6 +134,12 @@ private:
 
   /// Currently active camera
   std::shared_ptr<render::Camera> activeCamera_;
+
+  /// Cull `Drawable`s outside the view frustum of the active camera?
+  bool frustumCulling_;
+
+  /// Interpolation factor between the previous and the current time-step
+  float interpolationAlpha_;
 };
 
 } // namespace game
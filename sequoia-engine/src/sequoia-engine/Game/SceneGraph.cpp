@@ -28,9 +28,8 @@ SceneGraph::SceneGraph() { root_ = SceneNode::allocate<SceneNode>("__root__"); }
 
 SceneGraph::~SceneGraph() {}
 
-void SceneGraph::update(const SceneNode::UpdateEvent& event) {
-  // TODO: Maybe do in parallel?
-  apply([&event](SceneNode* node) { node->update(event); });
+void SceneGraph::update(const SceneNode::UpdateEvent& event, SceneNode::ExecutionPolicy policy) {
+  apply([&event](SceneNode* node) { node->update(event); }, policy);
 }
 
 void SceneGraph::clear() { root_->clearChildren(); }
@@ -44,15 +44,29 @@ public:
   void remove(const std::shared_ptr<SceneNode>& node) { root_->removeChild(node); }
 
   /// @brief Update all nodes to indicate we moved on to the next time-step
-  void update(const SceneNode::UpdateEvent& event);
+  ///
+  /// @param event    Update event passed to each `SceneNode::update`
+  /// @param policy   If `EP_Parallel`, independent subtrees are updated concurrently. A node is
+  ///                 always updated before its children.
+  void update(const SceneNode::UpdateEvent& event,
+              SceneNode::ExecutionPolicy policy = SceneNode::EP_Sequential);
+
+  /// @brief Recompute the world matrices of all nodes which have been modified since the last call
+  ///
+  /// @see SceneNode::updateWorldMatrices
+  void updateWorldMatrices(bool modelMatricesComputed = false) {
+    root_->updateWorldMatrices(modelMatricesComputed);
+  }
 
   /// @brief Apply `functor` to the node and all its children
   ///
   /// @tparam Functor   Function type: `void(SceneNode*)` or `void(SceneNode*) noexcept`
   /// @param functor    Functor to apply to the node and its children
+  /// @param policy     Execution policy to launch `functor`
   template <class Functor>
-  void apply(Functor&& functor) const {
-    root_->apply(std::forward<Functor>(functor));
+  void apply(Functor&& functor,
+             SceneNode::ExecutionPolicy policy = SceneNode::EP_Sequential) const {
+    root_->apply(std::forward<Functor>(functor), policy);
   }
 
   /// @brief Clear the graph
@@ -21,23 +21,28 @@
 #include "sequoia-engine/Math/CoordinateSystem.h"
 #include <boost/lexical_cast.hpp>
 #include <numeric>
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
 
 namespace sequoia {
 
 namespace game {
 
 SceneNode::SceneNode(const std::string& name, SceneNode::SceneNodeKind kind)
-    : std::enable_shared_from_this<SceneNode>(), kind_(kind), position_(math::vec3()),
-      orientation_(math::quat()), scale_(1.0f), modelMatrix_(), modelMatrixIsDirty_(true),
-      parent_(), name_(name) {
+    : std::enable_shared_from_this<SceneNode>(), kind_(kind), store_(&TransformStore::getGlobal()),
+      transform_(store_->allocate()), modelMatrixIsDirty_(true), worldMatrixIsDirty_(true),
+      hasPreviousWorldMatrix_(false), subtreeIsDirty_(true), parent_(), name_(name) {
   for(int i = 0; i < capabilities_.size(); ++i)
     capabilities_[i] = nullptr;
 }
 
 SceneNode::SceneNode(const SceneNode& other)
-    : std::enable_shared_from_this<SceneNode>(), kind_(other.kind_), position_(other.position_),
-      orientation_(other.orientation_), scale_(other.scale_), modelMatrix_(other.modelMatrix_),
-      modelMatrixIsDirty_(other.modelMatrixIsDirty_), parent_(other.parent_) {
+    : std::enable_shared_from_this<SceneNode>(), kind_(other.kind_), store_(other.store_),
+      transform_(store_->allocate()), modelMatrixIsDirty_(true), worldMatrixIsDirty_(true),
+      hasPreviousWorldMatrix_(false), subtreeIsDirty_(true), parent_(other.parent_) {
+  store_->getPosition(transform_) = other.getPosition();
+  store_->getOrientation(transform_) = other.getOrientation();
+  store_->getScale(transform_) = other.getScale();
 
   // Adjust the name, we append a `_copy_X` where `X` is the version of the copy
   StringRef nameRef(other.name_);
@@ -60,7 +65,7 @@ SceneNode::SceneNode(const SceneNode& other)
     capabilities_[i] = other.capabilities_[i] ? other.capabilities_[i]->clone(this) : nullptr;
 }
 
-SceneNode::~SceneNode() {}
+SceneNode::~SceneNode() { store_->free(transform_); }
 
 void SceneNode::resetOrientation() { setOrientation(math::quat()); }
 
@@ -84,6 +89,30 @@ void SceneNode::applyNoexceptImpl(
     child->applyNoexceptImpl(functor);
 }
 
+void SceneNode::applyParallelImpl(const std::function<void(SceneNode*)>& functor) {
+  functor(this);
+
+  // The children may query our world matrix concurrently (e.g via their own `getWorldMatrix`),
+  // hence it has to be up to date before they are spawned. Note that our ancestors have already
+  // been processed and are thus up to date as well.
+  if(worldMatrixIsDirty_)
+    computeWorldMatrix();
+
+  // Each child is the root of an independent subtree, we hand them to the work-stealing scheduler
+  // which recursively splits the subtrees further (exceptions are propagated to the caller)
+  const std::size_t numChildren = children_.size();
+  if(numChildren == 0)
+    return;
+  else if(numChildren == 1)
+    children_.front()->applyParallelImpl(functor);
+  else
+    tbb::parallel_for(tbb::blocked_range<std::size_t>(0, numChildren),
+                      [this, &functor](const tbb::blocked_range<std::size_t>& range) {
+                        for(std::size_t i = range.begin(); i != range.end(); ++i)
+                          children_[i]->applyParallelImpl(functor);
+                      });
+}
+
 void SceneNode::update(const UpdateEvent& event) {
   for(int i = 0; i < capabilities_.size(); ++i)
     if(capabilities_[i])
@@ -137,7 +166,8 @@ std::pair<std::string, std::string> SceneNode::toStringImpl() const {
           "parent = {},\n"
           "capabilities = {},\n"
           "children = {},\n",
-          name_, position_, orientation_, scale_, hasParent() ? getParent()->getName() : "null",
+          name_, getPosition(), getOrientation(), getScale(),
+          hasParent() ? getParent()->getName() : "null",
 
           // Capabilities
           std::accumulate(
@@ -157,12 +187,65 @@ std::pair<std::string, std::string> SceneNode::toStringImpl() const {
               : "null"));
 }
 
-void SceneNode::computeModelMatrix() {
-  // ModelMatrix = TranslationMatrix * RotatationMatrix * ScaleMatrix
-  modelMatrix_ = math::translate(math::mat4(1.0f), position_);
-  modelMatrix_ = modelMatrix_ * math::mat4_cast(orientation_);
-  modelMatrix_ = math::scale(modelMatrix_, glm::vec3(scale_));
+void SceneNode::invalidateWorldMatrix() {
+  markWorldMatrixDirty();
+
+  // Notify the ancestors (stop as soon as we hit an ancestor which has already been notified)
+  auto parent = getParent();
+  while(parent && !parent->subtreeIsDirty_.exchange(true))
+    parent = parent->getParent();
+}
+
+void SceneNode::markWorldMatrixDirty() noexcept {
+  subtreeIsDirty_ = true;
+
+  // If the world matrix is already dirty, so are the ones of our descendants
+  if(worldMatrixIsDirty_)
+    return;
+
+  worldMatrixIsDirty_ = true;
+  for(const auto& child : children_)
+    child->markWorldMatrixDirty();
+}
+
+void SceneNode::computeWorldMatrix() {
+  auto parent = getParent();
+  math::mat4& worldMatrix = store_->getWorldMatrix(transform_);
+  worldMatrix = parent ? parent->getWorldMatrix() * getModelMatrix() : getModelMatrix();
+  worldMatrixIsDirty_ = false;
 
+  // Newly created nodes have no previous state to interpolate from
+  if(!hasPreviousWorldMatrix_) {
+    store_->getPreviousWorldMatrix(transform_) = worldMatrix;
+    hasPreviousWorldMatrix_ = true;
+  }
+}
+
+math::mat4 SceneNode::getInterpolatedWorldMatrix(float alpha) {
+  const math::mat4& worldMatrix = getWorldMatrix();
+  const math::mat4& previousWorldMatrix = store_->getPreviousWorldMatrix(transform_);
+  return previousWorldMatrix + (worldMatrix - previousWorldMatrix) * alpha;
+}
+
+void SceneNode::updateWorldMatrices(bool modelMatricesComputed) {
+  if(!subtreeIsDirty_)
+    return;
+
+  // A node with a dirty model matrix always lies in a dirty subtree, hence it is visited here
+  if(modelMatricesComputed)
+    modelMatrixIsDirty_ = false;
+
+  // Parents are processed before their children, hence the world matrix of the parent is up to date
+  if(worldMatrixIsDirty_)
+    computeWorldMatrix();
+
+  subtreeIsDirty_ = false;
+  for(const auto& child : children_)
+    child->updateWorldMatrices(modelMatricesComputed);
+}
+
+void SceneNode::computeModelMatrix() {
+  store_->computeModelMatrix(transform_);
   modelMatrixIsDirty_ = false;
 }
 
@@ -19,9 +19,11 @@
 #include "sequoia-engine/Core/Export.h"
 #include "sequoia-engine/Game/SceneNodeAlloc.h"
 #include "sequoia-engine/Game/SceneNodeCapability.h"
+#include "sequoia-engine/Game/TransformStore.h"
 #include "sequoia-engine/Math/Math.h"
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <functional>
 #include <memory>
 #include <string>
@@ -67,6 +69,12 @@ public:
     TS_World   ///< Transform is relative to world space
   };
 
+  /// @brief Execution policy used to traverse the node and its children
+  enum ExecutionPolicy : std::uint8_t {
+    EP_Sequential, ///< Traverse all nodes on the calling thread
+    EP_Parallel    ///< Traverse independent subtrees concurrently (parents before children)
+  };
+
   SceneNode(const std::string& name, SceneNodeKind kind = SK_SceneNode);
   SceneNode(const SceneNode& other);
 
@@ -84,47 +92,76 @@ public:
 
   // TODO --- Move into Moveable capability ---
 
-  /// @brief Get the position (in world space
-  const math::vec3& getPosition() const { return position_; }
+  /// @brief Get the position (relative to the parent)
+  const math::vec3& getPosition() const { return store_->getPosition(transform_); }
 
-  /// @brief Set the position (in world space)
+  /// @brief Set the position (relative to the parent)
   void setPosition(const math::vec3& position) {
-    modelMatrixIsDirty_ = true;
-    position_ = position;
+    invalidateModelMatrix();
+    store_->getPosition(transform_) = position;
   }
 
-  /// @brief Get the orientation
-  const math::quat& getOrientation() const { return orientation_; }
+  /// @brief Get the orientation (relative to the parent)
+  const math::quat& getOrientation() const { return store_->getOrientation(transform_); }
 
-  /// @brief Set the orientation (in world space)
+  /// @brief Set the orientation (relative to the parent)
   void setOrientation(const math::quat& orientation) {
-    modelMatrixIsDirty_ = true;
-    orientation_ = orientation;
+    invalidateModelMatrix();
+    store_->getOrientation(transform_) = orientation;
   }
 
   /// @brief Resets the orientation (local axes as world axes, no rotation)
   void resetOrientation();
 
   /// @brief Get the scaling factor
-  float getScale() const { return scale_; }
+  float getScale() const { return store_->getScale(transform_); }
 
   /// @brief Set the scaling factor
   virtual void setScale(float scale) {
-    modelMatrixIsDirty_ = true;
-    scale_ = scale;
+    invalidateModelMatrix();
+    store_->getScale(transform_) = scale;
   }
 
   /// @brief Get a matrix whose columns are the local axes based on the nodes orientation
   /// relative to it's parent
   math::mat3 getLocalAxes() const;
 
-  /// @brief Get the model matrix
+  /// @brief Get the model matrix (i.e the transformation relative to the parent)
   const math::mat4& getModelMatrix() {
     if(modelMatrixIsDirty_)
       computeModelMatrix();
-    return modelMatrix_;
+    return store_->getModelMatrix(transform_);
+  }
+
+  /// @brief Get the world matrix (i.e the model matrix composed with the parent's world matrix)
+  ///
+  /// The world matrix is cached and only recomputed if the node or one of its ancestors has been
+  /// modified since the last call.
+  const math::mat4& getWorldMatrix() {
+    if(worldMatrixIsDirty_)
+      computeWorldMatrix();
+    return store_->getWorldMatrix(transform_);
   }
 
+  /// @brief Get the world matrix interpolated between the previous and the current time-step
+  ///
+  /// The previous world matrix is the one at the beginning of the last time-step (see
+  /// `TransformStore::storePreviousWorldMatrices`). The matrices are blended component-wise which
+  /// is accurate as long as the rotation per time-step is small.
+  ///
+  /// @param alpha    Interpolation factor in `[0, 1]` (`1` yields the current world matrix)
+  math::mat4 getInterpolatedWorldMatrix(float alpha);
+
+  /// @brief Recompute the world matrices of all modified nodes in a single top-down pass
+  ///
+  /// Subtrees which do not contain any modified nodes are skipped entirely, the cost is thus
+  /// proportional to the number of modified nodes (and their descendants).
+  ///
+  /// @param modelMatricesComputed  The model matrices have already been recomputed in a batch (see
+  ///                               `TransformStore::computeModelMatrices`), the visited nodes only
+  ///                               clear their dirty flag
+  void updateWorldMatrices(bool modelMatricesComputed = false);
+
   // ----------------------------------------
 
   /// @brief Add a child to the scene node
@@ -136,6 +173,7 @@ public:
   /// @brief Remove a child from the scene node
   void removeChild(const std::shared_ptr<SceneNode>& child) {
     children_.erase(std::remove(children_.begin(), children_.end(), child), children_.end());
+    child->setParent(nullptr);
   }
 
   /// @brief Remove all children
@@ -155,7 +193,12 @@ public:
   std::shared_ptr<SceneNode> getParent() const { return parent_.lock(); }
 
   /// @brief Set the parent node
-  void setParent(const std::shared_ptr<SceneNode>& parent) { parent_ = parent; }
+  ///
+  /// This invalidates the world matrices of the node and all its children.
+  void setParent(const std::shared_ptr<SceneNode>& parent) {
+    parent_ = parent;
+    invalidateWorldMatrix();
+  }
 
   /// @}
   /// @name Operations
@@ -163,12 +206,18 @@ public:
 
   /// @brief Apply `functor` to the node and all its children
   ///
+  /// With `EP_Parallel`, the subtrees of the children are processed as independent tasks by the
+  /// task scheduler. The `functor` is still invoked on a node before any of its children but it
+  /// may be called concurrently on unrelated nodes and thus needs to be thread-safe.
+  ///
   /// @tparam Functor   Function type: `void(SceneNode*)` or `void(SceneNode*) noexcept`
   /// @param functor    Functor to apply to the node and its children
-  /// @param policy     Executation policy to launch `functor`
+  /// @param policy     Execution policy to launch `functor`
   template <class Functor>
-  inline void apply(Functor&& functor) {
-    if(noexcept(functor(this)))
+  inline void apply(Functor&& functor, ExecutionPolicy policy = EP_Sequential) {
+    if(policy == EP_Parallel)
+      applyParallelImpl(std::forward<Functor>(functor));
+    else if(noexcept(functor(this)))
       applyNoexceptImpl(std::forward<Functor>(functor));
     else
       applyImpl(std::forward<Functor>(functor));
@@ -250,6 +299,9 @@ public:
   /// @brief Get the kind of the ScenenNode
   SceneNodeKind getKind() const { return kind_; }
 
+  /// @brief Get the handle of the transformation of this node in the TransformStore
+  TransformStore::Handle getTransformHandle() const noexcept { return transform_; }
+
   /// @}
 
   /// @brief RTTI implementation
@@ -259,6 +311,7 @@ private:
   /// @brief Apply `functor` to the node and all its children
   void applyImpl(const std::function<void(SceneNode*)>& functor);
   void applyNoexceptImpl(const std::function<void(SceneNode*) noexcept>& functor) noexcept;
+  void applyParallelImpl(const std::function<void(SceneNode*)>& functor);
 
 protected:
   /// @brief Implementation of `toString` which returns the class name and stringified members
@@ -267,6 +320,21 @@ protected:
   /// @brief Compute the model matrix
   void computeModelMatrix();
 
+  /// @brief Compute the world matrix (this may compute the world matrices of the ancestors)
+  void computeWorldMatrix();
+
+  /// @brief Mark the model matrix and the world matrices of the subtree as dirty
+  void invalidateModelMatrix() {
+    modelMatrixIsDirty_ = true;
+    invalidateWorldMatrix();
+  }
+
+  /// @brief Mark the world matrices of the subtree as dirty and notify the ancestors
+  void invalidateWorldMatrix();
+
+  /// @brief Mark the world matrices of the subtree as dirty
+  void markWorldMatrixDirty() noexcept;
+
 private:
   /// Type of node
   SceneNodeKind kind_;
@@ -279,20 +347,26 @@ private:
   /// List of children
   std::vector<std::shared_ptr<SceneNode>> children_;
 
-  /// Position of the node relative to it's parent.
-  math::vec3 position_;
+  /// Store of the transformation (position, orientation and scale relative to the parent as well
+  /// as the model and world matrix)
+  TransformStore* store_;
 
-  /// Orientation of the node relative to it's parent.
-  math::quat orientation_;
+  /// Handle of the transformation in the `store_`
+  TransformStore::Handle transform_;
 
-  /// Scaling factor
-  float scale_;
+  /// Model matrix needs to be recomputed
+  bool modelMatrixIsDirty_;
 
-  /// ModelView matrix
-  math::mat4 modelMatrix_;
+  /// World matrix needs to be recomputed (if set, it is also set for all descendants)
+  bool worldMatrixIsDirty_;
 
-  /// ModelView matrix needs to be recomputed
-  bool modelMatrixIsDirty_;
+  /// The previous world matrix has been set (nodes without a previous state are not interpolated)
+  bool hasPreviousWorldMatrix_;
+
+  /// The subtree rooted at this node contains a node with a dirty world matrix (if set, it is also
+  /// set for all ancestors). This is atomic as concurrently updated siblings may set the flag of
+  /// their common ancestors.
+  std::atomic<bool> subtreeIsDirty_;
 
   /// Parent node (if any)
   std::weak_ptr<SceneNode> parent_;
@@ -27,11 +27,21 @@ Shape::Shape(const std::string& name, std::vector<std::shared_ptr<Mesh>> meshes,
              std::vector<std::shared_ptr<Material>> materials)
     : name_(name), meshes_(std::move(meshes)), materials_(std::move(materials)) {
   SEQUOIA_ASSERT(meshes_.size() == materials_.size());
+  for(const auto& mesh : meshes_)
+    mergeAxisAlignedBox(mesh.get());
 }
 
 void Shape::add(const std::shared_ptr<Mesh>& mesh, const std::shared_ptr<Material>& material) {
   meshes_.emplace_back(mesh);
   materials_.emplace_back(material);
+  mergeAxisAlignedBox(mesh.get());
+}
+
+void Shape::mergeAxisAlignedBox(const Mesh* mesh) {
+  if(mesh->hasAxisAlignedBox())
+    bbox_.merge(mesh->getAxisAlignedBox());
+  else
+    bbox_.setInfinite();
 }
 
 void Shape::forEach(
@@ -20,6 +20,7 @@
 #include "sequoia-engine/Core/NonCopyable.h"
 #include "sequoia-engine/Game/Material.h"
 #include "sequoia-engine/Game/Mesh.h"
+#include "sequoia-engine/Math/AxisAlignedBox.h"
 #include <functional>
 #include <memory>
 #include <string>
@@ -42,6 +43,9 @@ class SEQUOIA_API Shape : public NonCopyable {
   /// Materials of the Shape
   std::vector<std::shared_ptr<Material>> materials_;
 
+  /// Bounding box of all meshes (in object space)
+  math::AxisAlignedBox bbox_;
+
 public:
   /// @brief Create the shape
   ///
@@ -65,8 +69,17 @@ public:
   /// @brief Get the name of the mesh
   const std::string& getName() const noexcept { return name_; }
 
+  /// @brief Get the axis aligned bounding box enclosing all meshes (in object space)
+  ///
+  /// If any of the meshes does not provide a bounding box, the box is infinite.
+  const math::AxisAlignedBox& getAxisAlignedBox() const noexcept { return bbox_; }
+
   /// @brief Convert to string
   std::string toString() const;
+
+private:
+  /// @brief Extend the bounding box by the box of `mesh`
+  void mergeAxisAlignedBox(const Mesh* mesh);
 };
 
 } // namespace game
@@ -15,10 +15,13 @@
 
 #include "sequoia-engine/Core/AlignedADT.h"
 #include "sequoia-engine/Core/Assert.h"
+#include "sequoia-engine/Core/Format.h"
 #include "sequoia-engine/Core/Logging.h"
 #include "sequoia-engine/Core/STLExtras.h"
 #include "sequoia-engine/Game/Exception.h"
 #include "sequoia-engine/Game/Game.h"
+#include "sequoia-engine/Game/MeshOptimizer.h"
+#include "sequoia-engine/Game/MeshSimplifier.h"
 #include "sequoia-engine/Game/ShapeManager.h"
 #include "sequoia-engine/Render/RenderSystem.h"
 #include "sequoia-engine/Render/VertexAdapter.h"
@@ -28,6 +31,9 @@
 #include <assimp/LogStream.hpp>
 #include <assimp/postprocess.h>
 #include <assimp/scene.h>
+#include <cmath>
+#include <cstring>
+#include <limits>
 
 namespace sequoia {
 
@@ -71,7 +77,8 @@ public:
 ///   - Implement Vritual FS to allow loading files from memory
 /// 
 
-ShapeManager::ShapeManager() {
+ShapeManager::ShapeManager(std::unique_ptr<MeshCache> meshCache)
+    : meshCache_(std::move(meshCache)) {
   // Create Assimp logger
   Assimp::DefaultLogger::create("", core::Logger::getSingleton().getLevel() <= core::Logger::Debug
                                         ? Assimp::Logger::VERBOSE
@@ -94,322 +101,347 @@ ShapeManager::~ShapeManager() {
   Assimp::DefaultLogger::kill();
 }
 
-/*
-std::shared_ptr<Mesh> MeshManager::load(const std::string& name, const std::shared_ptr<File>& file,
-                                        bool modifiable, const MeshParameter& param,
-                                        render::Buffer::UsageHint usage) {
-  Log::debug("Loading mesh \"{}\" from \"{}\" ...", name, file->getPath());
+//===------------------------------------------------------------------------------------------===//
+//    Load
+//===------------------------------------------------------------------------------------------===//
 
-  std::shared_ptr<render::VertexData> vertexData = nullptr;
-  VertexDataAccessRecord* record = nullptr;
+namespace {
+
+/// @brief Vertex of the imported meshes
+using ImportVertex = render::Vertex_posf3_norf3_texf2_colu4;
+
+/// @brief Flags passed to Assimp
+static unsigned int getImportFlags(const MeshParameter& param) {
+  unsigned int flags = aiProcessPreset_TargetRealtime_Quality;
+  if(param.TexCoordInvertV)
+    flags |= aiProcess_FlipUVs;
+  return flags;
+}
+
+} // anonymous namespace
+
+struct ShapeManager::ImportedMeshes {
+  struct MeshData {
+    core::aligned_vector<ImportVertex> Vertices;
+    std::vector<std::uint32_t> Indices;
+    std::vector<std::uint16_t> NarrowIndices;
+    math::AxisAlignedBox AxisAlignedBox;
+  };
+  std::vector<MeshData> Meshes;
+};
+
+std::shared_ptr<Shape> ShapeManager::load(const std::string& name,
+                                          const std::shared_ptr<File>& file, bool modifiable,
+                                          const MeshParameter& param,
+                                          core::Buffer::UsageHint usage) {
+  return loadImpl(name, file, modifiable, param, usage, nullptr);
+}
+
+std::shared_ptr<Shape> ShapeManager::loadImpl(const std::string& name,
+                                              const std::shared_ptr<File>& file, bool modifiable,
+                                              const MeshParameter& param,
+                                              core::Buffer::UsageHint usage,
+                                              std::shared_ptr<const ImportedMeshes>* source) {
+  Log::debug("Loading shape \"{}\" from \"{}\" ...", name, file->getPath());
+
+  std::vector<std::shared_ptr<render::VertexData>> vertexData;
+  ShapeAccessRecord* record = nullptr;
 
   internal::MeshInfo info{file, param};
+
   meshMutex_.lock();
 
   auto it = meshLookupMap_.find(info);
   if(it != meshLookupMap_.end())
     record = it->second.get();
   else
-    record = meshLookupMap_.emplace(std::move(info), std::make_unique<VertexDataAccessRecord>())
+    record = meshLookupMap_.emplace(std::move(info), std::make_unique<ShapeAccessRecord>())
                  .first->second.get();
 
-  record->Mutex.lock();
   meshMutex_.unlock();
 
-  if(record->Index != -1) {
-    vertexDataMutex_.lock_read();
-    vertexData = vertexData_[record->Index];
-    vertexDataMutex_.unlock();
+  {
+    SEQUOIA_LOCK_GUARD(record->Mutex);
+
+    if(record->Index != -1) {
+      shapeDataMutex_.lock_read();
+      vertexData = shapeData_[record->Index]->Data;
+      shapeDataMutex_.unlock();
+    } else {
+      MeshCache::Entry entry = readMeshesImpl(file, param, source);
+      for(const MeshCache::MeshView& mesh : entry.Meshes)
+        vertexData.emplace_back(createVertexData(mesh, usage));
+
+      // Register the data
+      shapeDataMutex_.lock();
+      auto shapeData = std::make_unique<ShapeData>();
+      shapeData->Data = vertexData;
+      shapeData_.emplace_back(std::move(shapeData));
+      record->Index = shapeData_.size() - 1;
+      shapeDataMutex_.unlock();
+    }
+  }
+
+  // TODO: Copy for modifieable
+
+  Log::debug("Successfully loaded shape \"{}\" from \"{}\"", name, file->getPath());
+
+  std::vector<std::shared_ptr<Mesh>> meshes;
+  std::vector<std::shared_ptr<Material>> materials;
+  for(const auto& data : vertexData) {
+    meshes.emplace_back(std::make_shared<Mesh>(data, modifiable));
+    materials.emplace_back(std::make_shared<Material>());
+  }
+  return std::make_shared<Shape>(name, std::move(meshes), std::move(materials));
+}
+
+std::vector<std::shared_ptr<Shape>>
+ShapeManager::loadLods(const std::string& name, const std::shared_ptr<File>& file, int numLods,
+                       float reduction, const MeshParameter& param,
+                       core::Buffer::UsageHint usage) {
+  SEQUOIA_ASSERT_MSG(numLods >= 1, "at least one level of detail is required");
+  SEQUOIA_ASSERT_MSG(reduction > 0.0f && reduction <= 1.0f, "invalid reduction");
+
+  // The levels only differ in the simplification, hence they share the imported meshes
+  std::shared_ptr<const ImportedMeshes> source = nullptr;
+
+  std::vector<std::shared_ptr<Shape>> lods;
+  for(int lod = 0; lod < numLods; ++lod) {
+    MeshParameter lodParam = param;
+    lodParam.Simplify = param.Simplify * std::pow(reduction, lod);
+    lods.emplace_back(loadImpl(lod == 0 ? name : core::format("{}#LOD{}", name, lod), file, false,
+                               lodParam, usage, &source));
+  }
+  return lods;
+}
+
+MeshCache::Entry ShapeManager::readMeshes(const std::shared_ptr<File>& file,
+                                          const MeshParameter& param) {
+  return readMeshesImpl(file, param, nullptr);
+}
+
+MeshCache::Entry ShapeManager::readMeshesImpl(const std::shared_ptr<File>& file,
+                                              const MeshParameter& param,
+                                              std::shared_ptr<const ImportedMeshes>* source) {
+  const render::VertexLayout layout = ImportVertex::getLayout();
+
+  // Everything which influences the content of the imported meshes has to be part of the key
+  std::uint32_t simplify;
+  std::memcpy(&simplify, &param.Simplify, sizeof(float));
+  const std::uint64_t parameters[] = {layout.ID, layout.SizeOf, getImportFlags(param),
+                                      param.Optimize, simplify};
+  const std::uint64_t key = MeshCache::makeKey(
+      file->getData(), file->getNumBytes(), core::fnv1a(parameters, sizeof(parameters)));
+
+  MeshCache::Entry entry;
+  if(meshCache_ && meshCache_->load(key, entry)) {
+    bool isValid = std::all_of(entry.Meshes.begin(), entry.Meshes.end(), [&](const auto& mesh) {
+      return mesh.LayoutID == layout.ID && mesh.SizeOf == layout.SizeOf;
+    });
+
+    if(isValid) {
+      Log::debug("Using cached meshes \"{}\" of \"{}\"", MeshCache::getPath(key),
+                 file->getPath());
+      return entry;
+    }
+    Log::warn("Ignoring cached meshes \"{}\" of \"{}\": vertex layout mismatch",
+              MeshCache::getPath(key), file->getPath());
+  }
+
+  if(source) {
+    // The processing modifies the meshes, the shared source is thus copied
+    if(!*source)
+      *source = importMeshes(file, param);
+    entry = processMeshes(std::make_shared<ImportedMeshes>(**source), file, param);
   } else {
-#if 0
-    
-    // Default flags
-    int flags = aiProcessPreset_TargetRealtime_Quality;
-    //int flags = aiProcessPreset_TargetRealtime_Fast;    
-  
-    // Optional flags
-    flags = param.TexCoordInvertV ? flags | aiProcess_FlipUVs : flags;
-    
-    // Load mesh
-    const aiScene* scene = importer_->ReadFile(
-        "/home/thfabian/Desktop/sequoia/sequoia-engine/test/ressource/sequoia-engine/"
-        "Game/TestMeshManager/Cube.obj",
-        flags);
+    entry = processMeshes(importMeshes(file, param), file, param);
+  }
+
+  if(meshCache_)
+    meshCache_->store(key, entry.Meshes);
+  return entry;
+}
+
+std::shared_ptr<ShapeManager::ImportedMeshes>
+ShapeManager::importMeshes(const std::shared_ptr<File>& file, const MeshParameter& param) {
+  auto imported = std::make_shared<ImportedMeshes>();
 
+  {
+    SEQUOIA_LOCK_GUARD(importerMutex_);
+
+    // Assimp deduces the format from the hint (i.e the extension without the dot)
+    std::string hint = file->getExtension();
+    if(!hint.empty() && hint.front() == '.')
+      hint.erase(0, 1);
+
+    const aiScene* scene = importer_->ReadFileFromMemory(file->getData(), file->getNumBytes(),
+                                                         getImportFlags(param), hint.c_str());
     if(!scene)
-      SEQUOIA_THROW(GameException, "failed to load mesh {}: {}", file->getPath(),
+      SEQUOIA_THROW(GameException, "failed to load mesh \"{}\": {}", file->getPath(),
                     importer_->GetErrorString());
-    
-    std::vector<std::shared_ptr<Mesh>> meshes(scene->mNumMeshes);
-//    std::vector<std::shared_ptr<Material>> materials(pScene->mNumMaterials);    
-    
-    core::aligned_vector<unsigned int> indexBuffer;
-    core::aligned_vector<render::Vertex3D> vertexBuffer;
-    
-    for(int meshIdx = 0 ; meshIdx < meshes.size(); meshIdx++) {
-      indexBuffer.clear();
-      vertexBuffer.clear();
 
+    for(unsigned int meshIdx = 0; meshIdx < scene->mNumMeshes; ++meshIdx) {
       const aiMesh* mesh = scene->mMeshes[meshIdx];
-      
-      const int numVertices = mesh->mNumVertices;
-      const int mumFaces = mesh->mNumFaces;
 
-      vertexBuffer.reserve(numVertices);
-      indexBuffer.reserve(3 * mumFaces);
-      
+      // Points and lines are split into separate meshes by `aiProcess_SortByPType`
+      if(!(mesh->mPrimitiveTypes & aiPrimitiveType_TRIANGLE) || mesh->mNumVertices == 0)
+        continue;
+
+      imported->Meshes.emplace_back();
+      ImportedMeshes::MeshData& data = imported->Meshes.back();
+      data.Vertices.resize(mesh->mNumVertices);
+      data.Indices.reserve(3 * mesh->mNumFaces);
+
       // Vertices
-      for(int vertexIdx = 0; vertexIdx < numVertices; ++vertexIdx) {
-        render::Vertex3D vertex;
-        
+      for(unsigned int vertexIdx = 0; vertexIdx < mesh->mNumVertices; ++vertexIdx) {
+        ImportVertex& vertex = data.Vertices[vertexIdx];
+
         // Position
         const aiVector3D& position = mesh->mVertices[vertexIdx];
         for(int j = 0; j < 3; ++j)
           vertex.Position[j] = position[j];
+        data.AxisAlignedBox.merge(math::make_vec3(vertex.Position));
 
         // Normal
-        const aiVector3D& normal = mesh->mNormals[vertexIdx];
         for(int j = 0; j < 3; ++j)
-          vertex.Normal[j] = normal[j];
-        
-        // UV
-        if(mesh->HasTextureCoords(0)) {
-          const aiVector3D& texCoord = mesh->mTextureCoords[0][vertexIdx];
-          for(int j = 0; j < 2; ++j)
-            vertex.TexCoord[j] = texCoord[j];
-        } else {
-          for(int j = 0; j < 2; ++j)
-            vertex.TexCoord[0] = 0;
-        }
-        
+          vertex.Normal[j] = mesh->HasNormals() ? mesh->mNormals[vertexIdx][j] : 0.0f;
+
+        // TexCoord
+        for(int j = 0; j < 2; ++j)
+          vertex.TexCoord[j] =
+              mesh->HasTextureCoords(0) ? mesh->mTextureCoords[0][vertexIdx][j] : 0.0f;
+
         // Color
-        constexpr auto maxRGBValue = std::numeric_limits<render::Vertex3D::ColorType>::max();
         if(mesh->HasVertexColors(0)) {
           const aiColor4D& color = mesh->mColors[0][vertexIdx];
           for(int j = 0; j < 4; ++j)
-            vertex.Color[j] = maxRGBValue * color[j];
+            vertex.Color[j] = Color::Uint8Max * std::min(std::max(color[j], 0.0f), 1.0f);
         } else {
           for(int j = 0; j < 3; ++j)
             vertex.Color[j] = 0;
-          vertex.Color[3] = maxRGBValue;
+          vertex.Color[3] = Color::Uint8Max;
         }
-        vertexBuffer.emplace_back(std::move(vertex));
       }
-      
-      // Indices
-      for(int faceIDx = 0; faceIDx < mumFaces; ++faceIDx) {
-        const aiFace& face = mesh->mFaces[faceIDx];
-        SEQUOIA_ASSERT_MSG(face.mNumIndices == 3, "more than 3 vertices per face");
-      
-        indexBuffer.push_back(face.mIndices[0]);
-        indexBuffer.push_back(face.mIndices[1]);
-        indexBuffer.push_back(face.mIndices[2]);
+
+      // Indices (`aiProcess_Triangulate` leaves only faces with 3 indices)
+      for(unsigned int faceIdx = 0; faceIdx < mesh->mNumFaces; ++faceIdx) {
+        const aiFace& face = mesh->mFaces[faceIdx];
+        if(face.mNumIndices != 3)
+          continue;
+
+        for(int j = 0; j < 3; ++j)
+          data.Indices.push_back(face.mIndices[j]);
       }
-      
-//      for(auto i : indexBuffer)
-//        std::cout << i << std::endl;
-      
-//      for(auto v : vertexBuffer)
-//        std::cout << render::Vertex3D::toString(v) << std::endl;
     }
-      
-    //    tinyobj::attrib_t attrib;
-    //    std::vector<tinyobj::shape_t> shapes;
-    //    std::vector<tinyobj::material_t> materials;
-
-    //    std::string err;
-
-    //    std::unique_ptr<std::istringstream> objStream =
-    //        std::make_unique<std::istringstream>(objFile->getDataAsString());
-
-    //    std::unique_ptr<std::istringstream> mtlStream = nullptr;
-    //    std::unique_ptr<tinyobj::MaterialStreamReader> materialReader = nullptr;
-    //    if(mtlFile) {
-    //      mtlStream = std::make_unique<std::istringstream>(mtlFile->getDataAsString());
-    //      materialReader = std::make_unique<tinyobj::MaterialStreamReader>(*mtlStream);
-    //    }
-
-    //    bool ret =
-    //        tinyobj::LoadObj(&attrib, &shapes, &materials, &err, objStream.get(),
-    //        materialReader.get());
-
-    //    if(!ret)
-    //      SEQUOIA_THROW(GameException, "failed to load obj mesh {}: {}", objFile->getPath(), err);
-
-    //    if(!err.empty())
-    //      Log::warn("obj mesh: {}: {}", objFile->getPath(), err);
-
-    //    // Append `default` material
-    //    materials.push_back(tinyobj::material_t());
-
-    //    math::AxisAlignedBox aab;
-
-    //    // Allocate temporary buffer
-    //    std::unordered_map<render::Vertex3D, std::size_t> indexMap;
-
-    //    aligned_vector<unsigned int> indexBuffer;
-    //    aligned_vector<render::Vertex3D> vertexBuffer;
-
-    //    for(std::size_t s = 0; s < shapes.size(); ++s) {
-    //      std::size_t numIndicesPerFace = shapes[s].mesh.indices.size() / 3;
-    //      for(std::size_t f = 0; f < numIndicesPerFace; ++f) {
-
-    //        // Vertices per face
-    //        std::array<render::Vertex3D, 3> vertices;
-
-    //        tinyobj::index_t idx0 = shapes[s].mesh.indices[3 * f + 0];
-    //        tinyobj::index_t idx1 = shapes[s].mesh.indices[3 * f + 1];
-    //        tinyobj::index_t idx2 = shapes[s].mesh.indices[3 * f + 2];
-
-    //        // Decode vertices
-    //        for(int k = 0; k < 3; ++k) {
-    //          int f0 = idx0.vertex_index;
-    //          int f1 = idx1.vertex_index;
-    //          int f2 = idx2.vertex_index;
-
-    //          vertices[0].Position[k] = attrib.vertices[3 * f0 + k];
-    //          vertices[1].Position[k] = attrib.vertices[3 * f1 + k];
-    //          vertices[2].Position[k] = attrib.vertices[3 * f2 + k];
-    //        }
-
-    //        // Update bounding box
-    //        for(int i = 0; i < 3; ++i)
-    //          aab.merge(math::make_vec3(vertices[i].Position));
-
-    //        // Decode normals
-    //        if(attrib.normals.size() > 0) {
-    //          int f0 = idx0.normal_index;
-    //          int f1 = idx1.normal_index;
-    //          int f2 = idx2.normal_index;
-
-    //          for(int k = 0; k < 3; ++k) {
-    //            vertices[0].Normal[k] = attrib.normals[3 * f0 + k];
-    //            vertices[1].Normal[k] = attrib.normals[3 * f1 + k];
-    //            vertices[2].Normal[k] = attrib.normals[3 * f2 + k];
-    //          }
-    //        } else {
-    //          math::vec3 v0 = math::make_vec3(vertices[0].Position);
-    //          math::vec3 v1 = math::make_vec3(vertices[1].Position);
-    //          math::vec3 v2 = math::make_vec3(vertices[2].Position);
-
-    //          math::vec3 v10 = v1 - v0;
-    //          math::vec3 v20 = v2 - v0;
-
-    //          math::vec3 n = math::normalize(math::cross(v10, v20));
-
-    //          for(int k = 0; k < 3; ++k) {
-    //            vertices[0].Normal[k] = n[k];
-    //            vertices[1].Normal[k] = n[k];
-    //            vertices[2].Normal[k] = n[k];
-    //          }
-    //        }
-
-    //        // Decode texture coordiantes
-    //        if(attrib.texcoords.size() > 0) {
-    //          int f0 = idx0.texcoord_index;
-    //          int f1 = idx1.texcoord_index;
-    //          int f2 = idx2.texcoord_index;
-
-    //          for(int k = 0; k < 2; ++k) {
-    //            vertices[0].TexCoord[k] = attrib.texcoords[2 * f0 + k];
-    //            vertices[1].TexCoord[k] = attrib.texcoords[2 * f1 + k];
-    //            vertices[2].TexCoord[k] = attrib.texcoords[2 * f2 + k];
-    //          }
-
-    //          if(param.TexCoordInvertV) {
-    //            vertices[0].TexCoord[1] = 1.0f - vertices[0].TexCoord[1];
-    //            vertices[1].TexCoord[1] = 1.0f - vertices[1].TexCoord[1];
-    //            vertices[2].TexCoord[1] = 1.0f - vertices[2].TexCoord[1];
-    //          }
-
-    //        } else {
-    //          for(int k = 0; k < 2; ++k) {
-    //            vertices[0].TexCoord[k] = 0.0f;
-    //            vertices[1].TexCoord[k] = 0.0f;
-    //            vertices[2].TexCoord[k] = 0.0f;
-    //          }
-    //        }
-
-    //        // Combine normal and diffuse to get color.
-    //        float normal_factor = 0.2;
-    //        float diffuse_factor = 1 - normal_factor;
-
-    //        int curMaterialID = shapes[s].mesh.material_ids[f];
-
-    //        if(curMaterialID < 0 || curMaterialID >= static_cast<int>(materials.size()))
-    //          // Invaid material ID. Use default material which is added to the last item in
-    //          // `materials`
-    //          curMaterialID = materials.size() - 1;
-
-    //        float diffuse[3];
-    //        for(int k = 0; k < 3; ++k)
-    //          diffuse[k] = materials[curMaterialID].diffuse[k];
-
-    //        constexpr auto maxRGBValue = std::numeric_limits<render::Vertex3D::ColorType>::max();
-
-    //        for(int i = 0; i < 3; ++i) {
-    //          math::vec3 color(vertices[i].Normal[0] * normal_factor + diffuse[0] *
-    //          diffuse_factor,
-    //                           vertices[i].Normal[1] * normal_factor + diffuse[1] *
-    //                           diffuse_factor,
-    //                           vertices[i].Normal[2] * normal_factor + diffuse[2] *
-    //                           diffuse_factor);
-
-    //          color = math::normalize(color);
-    //          color = 0.5f * color + 0.5f;
-
-    //          vertices[i].Color[0] = maxRGBValue * color[0];
-    //          vertices[i].Color[1] = maxRGBValue * color[1];
-    //          vertices[i].Color[2] = maxRGBValue * color[2];
-    //        }
-    //        vertices[0].Color[3] = vertices[1].Color[3] = vertices[2].Color[3] = maxRGBValue;
-
-    //        // Add vertices to the buffer and compute indices
-    //        for(int i = 0; i < 3; ++i) {
-    //          auto indexMapIt = indexMap.find(vertices[i]);
-    //          if(indexMapIt != indexMap.end()) {
-    //            indexBuffer.emplace_back(indexMapIt->second);
-    //          } else {
-    //            vertexBuffer.emplace_back(vertices[i]);
-    //            unsigned int index = vertexBuffer.size() - 1;
-    //            indexBuffer.emplace_back(index);
-    //            indexMap.emplace(vertices[i], index);
-    //          }
-    //        }
-    //      }
-    //    }
-
-    //    // Upload data to the GPU
-    //    render::VertexDataParameter vertexParam(render::VertexData::DM_Triangles,
-    //                                            render::Vertex3D::getLayout(),
-    //                                            vertexBuffer.size(),
-    //                                            indexBuffer.size(), usage);
-    //    vertexParam.IndexType = render::IndexBuffer::IT_UInt32;
-    //    vertexParam.UseVertexShadowBuffer = true;
-    //    vertexParam.UseIndexShadowBuffer = false;
-    //    vertexData = Game::getSingleton().getRenderSystem()->createVertexData(vertexParam);
-
-    //    vertexData->getVertexBuffer()->write(
-    //        vertexBuffer.data(), 0, vertexBuffer.size() * vertexData->getLayout()->SizeOf, true);
-    //    vertexData->writeIndex(indexBuffer.data(), indexBuffer.size());
-    //    vertexData->setAxisAlignedBox(aab);
-
-    //    // Register the data
-    //    vertexDataMutex_.lock();
-    //    vertexData_.emplace_back(vertexData);
-    //    record->Index = vertexData_.size() - 1;
-    //    vertexDataMutex_.unlock();
-#endif
+
+    importer_->FreeScene();
   }
 
-  record->Mutex.unlock();
+  if(imported->Meshes.empty())
+    SEQUOIA_THROW(GameException, "failed to load mesh \"{}\": no triangle meshes",
+                  file->getPath());
+  return imported;
+}
 
-  // TODO: Copy for modifieable
+MeshCache::Entry ShapeManager::processMeshes(std::shared_ptr<ImportedMeshes> imported,
+                                             const std::shared_ptr<File>& file,
+                                             const MeshParameter& param) {
+  // The bounding boxes of the original meshes are kept as the simplified meshes only reference a
+  // subset of the vertices
+  if(param.Simplify < 1.0f) {
+    for(ImportedMeshes::MeshData& data : imported->Meshes) {
+      const std::size_t numIndices = data.Indices.size();
+      const std::size_t targetNumIndices = 3 * std::max<std::size_t>(
+          static_cast<std::size_t>(std::max(param.Simplify, 0.0f) * (numIndices / 3)), 1);
+
+      // The error is not bounded as the simplified meshes are meant to be viewed from afar
+      float error = 0.0f;
+      data.Indices.resize(MeshSimplifier::simplify(
+          data.Indices.data(), numIndices, data.Vertices.front().Position, sizeof(ImportVertex),
+          data.Vertices.size(), targetNumIndices, 1.0f, &error));
+
+      if(!param.Optimize)
+        data.Vertices.resize(MeshOptimizer::optimizeVertexFetch(
+            data.Vertices.data(), data.Vertices.size(), sizeof(ImportVertex),
+            data.Indices.data(), data.Indices.size()));
+
+      Log::debug("Simplified mesh of \"{}\": {} -> {} triangles (error {:.4f})", file->getPath(),
+                 numIndices / 3, data.Indices.size() / 3, error);
+    }
+  }
+
+  if(param.Optimize) {
+    for(ImportedMeshes::MeshData& data : imported->Meshes) {
+      float acmr = MeshOptimizer::computeACMR(data.Indices.data(), data.Indices.size(),
+                                              data.Vertices.size());
+
+      MeshOptimizer::optimizeVertexCache(data.Indices.data(), data.Indices.size(),
+                                         data.Vertices.size());
+      MeshOptimizer::optimizeOverdraw(data.Indices.data(), data.Indices.size(),
+                                      data.Vertices.front().Position, sizeof(ImportVertex),
+                                      data.Vertices.size());
+      data.Vertices.resize(MeshOptimizer::optimizeVertexFetch(
+          data.Vertices.data(), data.Vertices.size(), sizeof(ImportVertex), data.Indices.data(),
+          data.Indices.size()));
+
+      Log::debug("Optimized mesh of \"{}\": ACMR {:.3f} -> {:.3f}", file->getPath(), acmr,
+                 MeshOptimizer::computeACMR(data.Indices.data(), data.Indices.size(),
+                                            data.Vertices.size()));
+    }
+  }
+
+  const render::VertexLayout layout = ImportVertex::getLayout();
+
+  MeshCache::Entry entry;
+  for(ImportedMeshes::MeshData& data : imported->Meshes) {
+    MeshCache::MeshView mesh;
+    mesh.LayoutID = layout.ID;
+    mesh.SizeOf = layout.SizeOf;
+    mesh.NumVertices = data.Vertices.size();
+    mesh.NumIndices = data.Indices.size();
+    mesh.Vertices = reinterpret_cast<const Byte*>(data.Vertices.data());
+    mesh.AxisAlignedBox = data.AxisAlignedBox;
+
+    // Narrow the indices to 16-bit if possible (halves the index memory and bandwidth). This is
+    // done once on import, the cached meshes are copied as is into the index buffer.
+    if(data.Vertices.size() <= std::size_t(std::numeric_limits<std::uint16_t>::max()) + 1) {
+      data.NarrowIndices.assign(data.Indices.begin(), data.Indices.end());
+      std::vector<std::uint32_t>().swap(data.Indices);
+      mesh.SizeOfIndex = sizeof(std::uint16_t);
+      mesh.Indices = data.NarrowIndices.data();
+    } else {
+      mesh.SizeOfIndex = sizeof(std::uint32_t);
+      mesh.Indices = data.Indices.data();
+    }
+    entry.Meshes.emplace_back(mesh);
+  }
+  entry.Storage = std::move(imported);
+  return entry;
+}
+
+std::shared_ptr<render::VertexData>
+ShapeManager::createVertexData(const MeshCache::MeshView& mesh, core::Buffer::UsageHint usage) {
+  render::VertexLayout layout = ImportVertex::getLayout();
+  SEQUOIA_ASSERT_MSG(mesh.LayoutID == layout.ID, "invalid vertex layout");
+
+  const bool useUInt16 = mesh.SizeOfIndex == sizeof(std::uint16_t);
+
+  render::VertexDataParameter vertexParam(render::VertexData::DM_Triangles, layout,
+                                          mesh.NumVertices, mesh.NumIndices, usage);
+  vertexParam.IndexType =
+      useUInt16 ? render::IndexBuffer::IT_UInt16 : render::IndexBuffer::IT_UInt32;
+  vertexParam.UseVertexShadowBuffer = true;
+  vertexParam.UseIndexShadowBuffer = false;
+
+  std::shared_ptr<render::VertexData> vertexData =
+      Game::getSingleton().getRenderSystem()->createVertexData(vertexParam);
 
-  Log::debug("Successfully loaded obj mesh \"{}\" from \"{}\"", name, file->getPath());
-  return std::make_shared<Mesh>(name, vertexData, modifiable);
+  // The vertices and indices are already in their final representation
+  vertexData->getVertexBuffer()->write(mesh.Vertices, 0, mesh.NumVertices * layout.SizeOf);
+  vertexData->getIndexBuffer()->write(mesh.Indices, 0, mesh.NumIndices * mesh.SizeOfIndex);
+  vertexData->setAxisAlignedBox(mesh.AxisAlignedBox);
+  return vertexData;
 }
-*/
 
 //===------------------------------------------------------------------------------------------===//
 //    Cube
@@ -499,7 +531,7 @@ std::shared_ptr<Shape> ShapeManager::createCube(const std::string& name, bool mo
 
   if(record->Index != -1) {
     shapeDataMutex_.lock_read();
-    vertexData = shapeData_[record->Index]->Data;
+    vertexData = shapeData_[record->Index]->Data.front();
     shapeDataMutex_.unlock();
   } else {
     std::size_t numVertices = 24;
@@ -558,6 +590,7 @@ std::shared_ptr<Shape> ShapeManager::createCube(const std::string& name, bool mo
     // Register the data
     shapeDataMutex_.lock();
     auto shapeData = std::make_unique<ShapeData>();
+    shapeData->Data = {vertexData};
     shapeData_.emplace_back(std::move(shapeData));
     record->Index = shapeData_.size() - 1;
     shapeDataMutex_.unlock();
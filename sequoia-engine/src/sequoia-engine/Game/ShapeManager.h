@@ -23,6 +23,7 @@
 #include "sequoia-engine/Core/Mutex.h"
 #include "sequoia-engine/Game/Material.h"
 #include "sequoia-engine/Game/Mesh.h"
+#include "sequoia-engine/Game/MeshCache.h"
 #include "sequoia-engine/Game/Shape.h"
 #include "sequoia-engine/Render/RenderFwd.h"
 #include "sequoia-engine/Render/Texture.h"
@@ -40,14 +41,14 @@ namespace game {
 
 namespace internal {
 
-// struct MeshInfo {
-//  std::shared_ptr<core::File> File;
-//  MeshParameter Param;
+struct MeshInfo {
+  std::shared_ptr<core::File> File;
+  MeshParameter Param;
 
-//  bool operator==(const MeshInfo& other) const noexcept {
-//    return *File == *other.File && Param == other.Param;
-//  }
-//};
+  bool operator==(const MeshInfo& other) const noexcept {
+    return *File == *other.File && Param == other.Param;
+  }
+};
 
 struct CubeInfo {
   MeshParameter Param;
@@ -70,7 +71,7 @@ struct CubeInfo {
 
 } // namespace sequoia
 
-// SEQUOIA_DECLARE_STD_HASH(sequoia::game::internal::MeshInfo, value, value.File, value.Param)
+SEQUOIA_DECLARE_STD_HASH(sequoia::game::internal::MeshInfo, value, value.File, value.Param)
 SEQUOIA_DECLARE_STD_HASH(sequoia::game::internal::CubeInfo, value, value.Param)
 // SEQUOIA_DECLARE_STD_HASH(sequoia::game::internal::GridInfo, value, value.N, value.Param)
 
@@ -82,25 +83,64 @@ namespace game {
 /// @ingroup game
 class SEQUOIA_API ShapeManager : public NonCopyable {
 public:
-  ShapeManager();
+  /// @brief Initialize the manager
+  ///
+  /// @param meshCache    Cache of the imported meshes (`nullptr` disables caching)
+  ShapeManager(std::unique_ptr<MeshCache> meshCache = nullptr);
   ~ShapeManager();
 
-  //  /// @brief Load mesh from disk
-  //  ///
-  //  /// @param name         Name of the mesh
-  //  /// @param file         Path to the object file
-  //  /// @param modifiable   Request a copy of the mesh which allows to modify the vertex data
-  //  /// @param param        Parameter used to initialize the mesh
-  //  /// @param usage        Buffer usage of the hardware vertex buffers
-  //  ///
-  //  /// @throws GameException   Unable to load the mesh (invalid format)
-  //  ///
-  //  /// @remark Thread-safe
-  //  std::shared_ptr<Mesh> load(const std::string& name, const std::shared_ptr<File>& file,
-  //                             bool modifiable = false, const MeshParameter& param =
-  //                             MeshParameter(),
-  //                             render::Buffer::UsageHint usage =
-  //                             render::Buffer::UH_StaticWriteOnly);
+  /// @brief Load the shape from disk
+  ///
+  /// The file is imported with Assimp, each mesh of the file is converted to the standard 3D
+  /// vertex (`render::Vertex_posf3_norf3_texf2_colu4`). The converted meshes are stored in the
+  /// mesh cache which allows subsequent loads of the same file to skip the import.
+  ///
+  /// @param name         Name of the shape
+  /// @param file         Object file (e.g `.obj`)
+  /// @param modifiable   Request a copy of the mesh which allows to modify the vertex data
+  /// @param param        Parameter used to initialize the mesh
+  /// @param usage        Buffer usage of the hardware vertex buffers
+  ///
+  /// @throws GameException   Unable to load the mesh (invalid format)
+  ///
+  /// @remark Thread-safe
+  std::shared_ptr<Shape>
+  load(const std::string& name, const std::shared_ptr<File>& file, bool modifiable = false,
+       const MeshParameter& param = MeshParameter(),
+       core::Buffer::UsageHint usage = core::Buffer::UH_StaticWriteOnly);
+
+  /// @brief Load the shape from disk and generate the levels of detail of the shape
+  ///
+  /// The meshes of level `i` are simplified to `reduction^i` of the triangles of the shape (see
+  /// `MeshParameter::Simplify`). Each level is loaded (and cached) like a shape returned by `load`,
+  /// the file is imported at most once and all levels are simplified from the imported meshes.
+  ///
+  /// @param name         Name of the shape (the levels `i > 0` are called `name#LODi`)
+  /// @param file         Object file (e.g `.obj`)
+  /// @param numLods      Number of levels of detail (including the original shape)
+  /// @param reduction    Fraction of the triangles kept by each successive level
+  /// @param param        Parameter used to initialize the meshes
+  /// @param usage        Buffer usage of the hardware vertex buffers
+  /// @returns the levels of detail from the finest (the original shape) to the coarsest
+  ///
+  /// @throws GameException   Unable to load the mesh (invalid format)
+  ///
+  /// @remark Thread-safe
+  std::vector<std::shared_ptr<Shape>>
+  loadLods(const std::string& name, const std::shared_ptr<File>& file, int numLods,
+           float reduction = 0.5f, const MeshParameter& param = MeshParameter(),
+           core::Buffer::UsageHint usage = core::Buffer::UH_StaticWriteOnly);
+
+  /// @brief Read the meshes of `file` without uploading them to the GPU
+  ///
+  /// The meshes are read from the mesh cache if possible, otherwise the file is imported and the
+  /// result is stored in the cache.
+  ///
+  /// @throws GameException   Unable to import the file (invalid format)
+  ///
+  /// @remark Thread-safe
+  MeshCache::Entry readMeshes(const std::shared_ptr<File>& file,
+                              const MeshParameter& param = MeshParameter());
 
   /// @brief Create a unit cube, centered at `(0, 0, 0)`, spanning
   /// `{-0.5, 0.5} x {-0.5, 0.5} x {-0.5, 0.5}`
@@ -166,6 +206,9 @@ public:
   /// @brief Get number of registered meshes
   std::size_t getNumShapes() const;
 
+  /// @brief Get the mesh cache (may be `nullptr`)
+  MeshCache* getMeshCache() const noexcept { return meshCache_.get(); }
+
   /// @brief Free all unused shapes
   /// 
   /// @remark Thread-safe
@@ -181,14 +224,46 @@ private:
     core::Mutex Mutex; ///< Access mutex for modifying the shape data
   };
 
-  /// @brief Data of the Mesh and Material
+  /// @brief Data of the Meshes and Materials
   struct ShapeData {
-    std::shared_ptr<render::VertexData> Data;
+    std::vector<std::shared_ptr<render::VertexData>> Data;
     std::unordered_map<int, std::shared_ptr<render::Texture>> Textures;
     std::unordered_map<std::string, render::UniformVariable> Uniforms;
   };
 
+  /// @brief Converted (but not yet processed) meshes of an imported file
+  struct ImportedMeshes;
+
+  /// @brief Implementation of `load`
+  ///
+  /// @param source   Imported meshes of `file` shared by the levels of detail (imported on the
+  ///                 first miss of the mesh cache) or `nullptr` if the meshes are not shared
+  std::shared_ptr<Shape> loadImpl(const std::string& name, const std::shared_ptr<File>& file,
+                                  bool modifiable, const MeshParameter& param,
+                                  core::Buffer::UsageHint usage,
+                                  std::shared_ptr<const ImportedMeshes>* source);
+
+  /// @brief Implementation of `readMeshes` (see `loadImpl` for `source`)
+  MeshCache::Entry readMeshesImpl(const std::shared_ptr<File>& file, const MeshParameter& param,
+                                  std::shared_ptr<const ImportedMeshes>* source);
+
+  /// @brief Import `file` with Assimp and convert the meshes
+  std::shared_ptr<ImportedMeshes> importMeshes(const std::shared_ptr<File>& file,
+                                               const MeshParameter& param);
+
+  /// @brief Simplify, optimize and narrow the `imported` meshes of `file` as requested by `param`
+  static MeshCache::Entry processMeshes(std::shared_ptr<ImportedMeshes> imported,
+                                        const std::shared_ptr<File>& file,
+                                        const MeshParameter& param);
+
+  /// @brief Upload `mesh` to the GPU
+  std::shared_ptr<render::VertexData> createVertexData(const MeshCache::MeshView& mesh,
+                                                       core::Buffer::UsageHint usage);
+
 private:
+  /// Cache of the imported meshes
+  std::unique_ptr<MeshCache> meshCache_;
+
   /// Assimp context
   std::shared_ptr<Assimp::Importer> importer_;
   Mutex importerMutex_;
@@ -197,10 +272,9 @@ private:
   std::vector<std::unique_ptr<ShapeData>> shapeData_;
   ReadWriteMutex shapeDataMutex_;
 
-  //  /// Loaded mesh record
-  //  std::unordered_map<internal::MeshInfo, std::unique_ptr<AccessRecord>>
-  //  meshLookupMap_;
-  //  Mutex meshMutex_;
+  /// Loaded mesh record
+  std::unordered_map<internal::MeshInfo, std::unique_ptr<ShapeAccessRecord>> meshLookupMap_;
+  Mutex meshMutex_;
 
   /// Cube mesh record
   std::unordered_map<internal::CubeInfo, std::unique_ptr<ShapeAccessRecord>> cubeMeshLookupMap_;
@@ -0,0 +1,121 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                         _____                        _
+//                        / ____|                      (_)
+//                       | (___   ___  __ _ _   _  ___  _  __ _
+//                        \___ \ / _ \/ _` | | | |/ _ \| |/ _` |
+//                        ____) |  __/ (_| | |_| | (_) | | (_| |
+//                       |_____/ \___|\__, |\__,_|\___/|_|\__,_| - Game Engine (2016-2017)
+//                                       | |
+//                                       |_|
+//
+// This file is distributed under the MIT License (MIT).
+// See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#include "sequoia-engine/Core/Assert.h"
+#include "sequoia-engine/Game/TransformStore.h"
+
+namespace sequoia {
+
+namespace game {
+
+TransformStore::TransformStore() : nextHandle_(0) {}
+
+TransformStore::~TransformStore() {}
+
+TransformStore& TransformStore::getGlobal() {
+  static TransformStore store;
+  return store;
+}
+
+TransformStore::Handle TransformStore::allocate() {
+  Handle handle;
+  {
+    SEQUOIA_LOCK_GUARD(mutex_);
+    if(!freeHandles_.empty()) {
+      handle = freeHandles_.back();
+      freeHandles_.pop_back();
+    } else {
+      handle = nextHandle_++;
+      if(handle / ChunkSize >= chunks_.size())
+        chunks_.push_back(std::make_unique<Chunk>());
+    }
+    chunks_[handle / ChunkSize]->Allocated.set(handle % ChunkSize);
+  }
+
+  getPosition(handle) = math::vec3(0.0f);
+  getOrientation(handle) = math::quat();
+  getScale(handle) = 1.0f;
+  getModelMatrix(handle) = math::mat4(1.0f);
+  getWorldMatrix(handle) = math::mat4(1.0f);
+  getPreviousWorldMatrix(handle) = math::mat4(1.0f);
+  return handle;
+}
+
+void TransformStore::free(Handle handle) {
+  SEQUOIA_LOCK_GUARD(mutex_);
+  SEQUOIA_ASSERT_MSG(handle < nextHandle_, "invalid handle");
+  chunks_[handle / ChunkSize]->Allocated.reset(handle % ChunkSize);
+  freeHandles_.push_back(handle);
+}
+
+std::size_t TransformStore::size() const {
+  SEQUOIA_LOCK_GUARD(mutex_);
+  return nextHandle_ - freeHandles_.size();
+}
+
+void TransformStore::computeModelMatrix(Handle handle) noexcept {
+  Chunk& chunk = *chunks_[handle / ChunkSize];
+  const std::size_t i = handle % ChunkSize;
+  computeModelMatrices(1, &chunk.Position[i], &chunk.Orientation[i], &chunk.Scale[i],
+                       &chunk.ModelMatrix[i]);
+}
+
+void TransformStore::computeModelMatrices() noexcept {
+  for(std::size_t c = 0; c < chunks_.size(); ++c) {
+    Chunk& chunk = *chunks_[c];
+    if(chunk.Allocated.none())
+      continue;
+
+    // Process each run of allocated transformations as one batch
+    for(std::size_t first = 0; first < ChunkSize;) {
+      if(!chunk.Allocated[first]) {
+        ++first;
+        continue;
+      }
+
+      std::size_t last = first + 1;
+      while(last < ChunkSize && chunk.Allocated[last])
+        ++last;
+
+      computeModelMatrices(last - first, &chunk.Position[first], &chunk.Orientation[first],
+                           &chunk.Scale[first], &chunk.ModelMatrix[first]);
+      first = last;
+    }
+  }
+}
+
+void TransformStore::storePreviousWorldMatrices() noexcept {
+  for(std::size_t c = 0; c < chunks_.size(); ++c) {
+    Chunk& chunk = *chunks_[c];
+    chunk.PreviousWorldMatrix = chunk.WorldMatrix;
+  }
+}
+
+void TransformStore::computeModelMatrices(std::size_t n, const math::vec3* positions,
+                                          const math::quat* orientations, const float* scales,
+                                          math::mat4* modelMatrices) noexcept {
+  for(std::size_t i = 0; i < n; ++i) {
+    math::mat4 m = math::mat4_cast(orientations[i]);
+    m[0] *= scales[i];
+    m[1] *= scales[i];
+    m[2] *= scales[i];
+    m[3] = math::vec4(positions[i], 1.0f);
+    modelMatrices[i] = m;
+  }
+}
+
+} // namespace game
+
+} // namespace sequoia
@@ -0,0 +1,144 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                         _____                        _
+//                        / ____|                      (_)
+//                       | (___   ___  __ _ _   _  ___  _  __ _
+//                        \___ \ / _ \/ _` | | | |/ _ \| |/ _` |
+//                        ____) |  __/ (_| | |_| | (_) | | (_| |
+//                       |_____/ \___|\__, |\__,_|\___/|_|\__,_| - Game Engine (2016-2017)
+//                                       | |
+//                                       |_|
+//
+// This file is distributed under the MIT License (MIT).
+// See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#ifndef SEQUOIA_ENGINE_GAME_TRANSFORMSTORE_H
+#define SEQUOIA_ENGINE_GAME_TRANSFORMSTORE_H
+
+#include "sequoia-engine/Core/ConcurrentADT.h"
+#include "sequoia-engine/Core/Export.h"
+#include "sequoia-engine/Core/Mutex.h"
+#include "sequoia-engine/Core/NonCopyable.h"
+#include "sequoia-engine/Math/Math.h"
+#include <array>
+#include <bitset>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace sequoia {
+
+namespace game {
+
+/// @brief Structure-of-arrays storage of the transformations of the SceneNodes
+///
+/// The positions, orientations, scaling factors, model and (previous) world matrices are stored in
+/// separate contiguous arrays which allows batch operations (e.g `computeModelMatrices`) to stream
+/// linearly through memory. Transformations are referred to by a stable `Handle`.
+///
+/// The arrays are split into fixed-size chunks which are never moved, hence references to the
+/// elements remain valid until the handle is freed. Allocating and freeing handles is thread-safe
+/// and accessing distinct handles concurrently is safe as well.
+///
+/// @ingroup game
+class SEQUOIA_API TransformStore : public NonCopyable {
+public:
+  /// @brief Stable handle to a transformation
+  using Handle = std::uint32_t;
+
+  /// Number of transformations per chunk (power of 2)
+  static constexpr std::uint32_t ChunkSize = 1024;
+
+  /// @brief Chunk of transformations
+  struct Chunk {
+    std::array<math::vec3, ChunkSize> Position;
+    std::array<math::quat, ChunkSize> Orientation;
+    std::array<float, ChunkSize> Scale;
+    std::array<math::mat4, ChunkSize> ModelMatrix;
+    std::array<math::mat4, ChunkSize> WorldMatrix;
+    std::array<math::mat4, ChunkSize> PreviousWorldMatrix;
+
+    /// Is the transformation allocated (free slots are skipped by the batch operations)?
+    std::bitset<ChunkSize> Allocated;
+  };
+
+  TransformStore();
+  ~TransformStore();
+
+  /// @brief Get the process-wide store used by the SceneNodes
+  static TransformStore& getGlobal();
+
+  /// @brief Allocate a new transformation (initialized to the identity)
+  Handle allocate();
+
+  /// @brief Free the transformation `handle`
+  void free(Handle handle);
+
+  /// @brief Get the number of allocated transformations
+  std::size_t size() const;
+
+  /// @name Element access
+  /// @{
+  math::vec3& getPosition(Handle handle) noexcept { return get(handle, &Chunk::Position); }
+  math::quat& getOrientation(Handle handle) noexcept { return get(handle, &Chunk::Orientation); }
+  float& getScale(Handle handle) noexcept { return get(handle, &Chunk::Scale); }
+  math::mat4& getModelMatrix(Handle handle) noexcept { return get(handle, &Chunk::ModelMatrix); }
+  math::mat4& getWorldMatrix(Handle handle) noexcept { return get(handle, &Chunk::WorldMatrix); }
+  math::mat4& getPreviousWorldMatrix(Handle handle) noexcept {
+    return get(handle, &Chunk::PreviousWorldMatrix);
+  }
+  /// @}
+
+  /// @brief Get the number of chunks
+  std::size_t getNumChunks() const noexcept { return chunks_.size(); }
+
+  /// @brief Get the chunk `index`
+  Chunk& getChunk(std::size_t index) noexcept { return *chunks_[index]; }
+
+  /// @brief Compute the model matrix of the transformation `handle`
+  void computeModelMatrix(Handle handle) noexcept;
+
+  /// @brief Recompute the model matrices of *all* allocated transformations in a single linear pass
+  ///
+  /// Consecutive allocated transformations are processed as one batch, free slots are skipped. This
+  /// must not be called concurrently with `allocate` or `free`.
+  void computeModelMatrices() noexcept;
+
+  /// @brief Store the world matrices of *all* transformations as the previous world matrices
+  ///
+  /// This is called at the beginning of each time-step to allow interpolating between the state of
+  /// the previous and the current time-step.
+  void storePreviousWorldMatrices() noexcept;
+
+  /// @brief Compute `n` model matrices from the given arrays
+  ///
+  /// The model matrix is computed as `TranslationMatrix * RotationMatrix * ScaleMatrix`.
+  static void computeModelMatrices(std::size_t n, const math::vec3* positions,
+                                   const math::quat* orientations, const float* scales,
+                                   math::mat4* modelMatrices) noexcept;
+
+private:
+  template <class T>
+  T& get(Handle handle, std::array<T, ChunkSize> Chunk::*array) noexcept {
+    return ((*chunks_[handle / ChunkSize]).*array)[handle % ChunkSize];
+  }
+
+  /// Chunks of transformations (growing the vector does not invalidate existing chunks)
+  core::concurrent_vector<std::unique_ptr<Chunk>> chunks_;
+
+  /// Handles which have been freed and can be reused
+  std::vector<Handle> freeHandles_;
+
+  /// Next never used handle
+  Handle nextHandle_;
+
+  /// Protect allocation and freeing of handles
+  mutable SpinMutex mutex_;
+};
+
+} // namespace game
+
+} // namespace sequoia
+
+#endif
@@ -169,6 +169,28 @@ public:
     }
   }
 
+  /// @brief Transforms the box according to the affine matrix `m`
+  ///
+  /// The result is the axis aligned box which encompasses the transformed box (the box thus
+  /// generally grows under rotations).
+  inline void transform(const mat4& m) {
+    if(extent_ != EK_Finite)
+      return;
+
+    vec3 center = 0.5f * (maximum_ + minimum_);
+    vec3 halfSize = 0.5f * (maximum_ - minimum_);
+
+    vec3 newCenter = vec3(m * vec4(center, 1.0f));
+    vec3 newHalfSize = vec3(math::abs(m[0][0]) * halfSize.x + math::abs(m[1][0]) * halfSize.y +
+                                math::abs(m[2][0]) * halfSize.z,
+                            math::abs(m[0][1]) * halfSize.x + math::abs(m[1][1]) * halfSize.y +
+                                math::abs(m[2][1]) * halfSize.z,
+                            math::abs(m[0][2]) * halfSize.x + math::abs(m[1][2]) * halfSize.y +
+                                math::abs(m[2][2]) * halfSize.z);
+
+    setExtents(newCenter - newHalfSize, newCenter + newHalfSize);
+  }
+
   /// @brief Sets the box to a `null` value i.e. not a box
   inline void setNull() { extent_ = EK_Null; }
 
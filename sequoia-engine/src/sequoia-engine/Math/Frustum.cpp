@@ -0,0 +1,65 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                         _____                        _
+//                        / ____|                      (_)
+//                       | (___   ___  __ _ _   _  ___  _  __ _
+//                        \___ \ / _ \/ _` | | | |/ _ \| |/ _` |
+//                        ____) |  __/ (_| | |_| | (_) | | (_| |
+//                       |_____/ \___|\__, |\__,_|\___/|_|\__,_| - Game Engine (2016-2017)
+//                                       | |
+//                                       |_|
+//
+// This file is distributed under the MIT License (MIT).
+// See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#include "sequoia-engine/Math/Frustum.h"
+#include "sequoia-engine/Core/Format.h"
+
+namespace sequoia {
+
+namespace math {
+
+Frustum::Frustum() { planes_.fill(vec4(0.0f, 0.0f, 0.0f, 1.0f)); }
+
+Frustum::Frustum(const mat4& matViewProj) { update(matViewProj); }
+
+void Frustum::update(const mat4& m) {
+  // Rows of the (column-major) matrix
+  const vec4 row0(m[0][0], m[1][0], m[2][0], m[3][0]);
+  const vec4 row1(m[0][1], m[1][1], m[2][1], m[3][1]);
+  const vec4 row2(m[0][2], m[1][2], m[2][2], m[3][2]);
+  const vec4 row3(m[0][3], m[1][3], m[2][3], m[3][3]);
+
+  // Clip space is [-w, w] in all dimensions (OpenGL convention)
+  planes_[PK_Left] = row3 + row0;
+  planes_[PK_Right] = row3 - row0;
+  planes_[PK_Bottom] = row3 + row1;
+  planes_[PK_Top] = row3 - row1;
+  planes_[PK_Near] = row3 + row2;
+  planes_[PK_Far] = row3 - row2;
+
+  // Normalize the planes such that `dot(n, p) + d` is the signed distance to the plane
+  for(vec4& plane : planes_) {
+    float len = length(vec3(plane));
+    if(len > 0.0f)
+      plane /= len;
+  }
+}
+
+std::string Frustum::toString() const {
+  return core::format("Frustum[\n"
+                      "  left = {},\n"
+                      "  right = {},\n"
+                      "  bottom = {},\n"
+                      "  top = {},\n"
+                      "  near = {},\n"
+                      "  far = {}\n"
+                      "]",
+                      planes_[PK_Left], planes_[PK_Right], planes_[PK_Bottom], planes_[PK_Top],
+                      planes_[PK_Near], planes_[PK_Far]);
+}
+
+} // namespace math
+
+} // namespace sequoia
@@ -0,0 +1,111 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                         _____                        _
+//                        / ____|                      (_)
+//                       | (___   ___  __ _ _   _  ___  _  __ _
+//                        \___ \ / _ \/ _` | | | |/ _ \| |/ _` |
+//                        ____) |  __/ (_| | |_| | (_) | | (_| |
+//                       |_____/ \___|\__, |\__,_|\___/|_|\__,_| - Game Engine (2016-2017)
+//                                       | |
+//                                       |_|
+//
+// This file is distributed under the MIT License (MIT).
+// See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#ifndef SEQUOIA_ENGINE_MATH_FRUSTUM_H
+#define SEQUOIA_ENGINE_MATH_FRUSTUM_H
+
+#include "sequoia-engine/Core/Export.h"
+#include "sequoia-engine/Math/AxisAlignedBox.h"
+#include "sequoia-engine/Math/Math.h"
+#include <array>
+#include <string>
+
+namespace sequoia {
+
+namespace math {
+
+/// @brief Convex volume bounded by 6 planes used for visibility determination
+///
+/// The planes are extracted from a view-projection matrix (Gribb-Hartmann method) and stored as
+/// `(n, d)` where the normal `n` points *inside* the frustum. A point `p` is thus inside the
+/// frustum if `dot(n, p) + d >= 0` holds for all planes.
+///
+/// @code{.cpp}
+///   math::Frustum frustum(camera->getViewProjectionMatrix());
+///   if(frustum.intersects(worldBox))
+///     // Object is (potentially) visible ...
+/// @endcode
+///
+/// @ingroup math
+class SEQUOIA_API Frustum {
+public:
+  /// @brief Enumeration of the planes
+  enum PlaneKind { PK_Left = 0, PK_Right, PK_Bottom, PK_Top, PK_Near, PK_Far, PK_NumPlanes };
+
+  /// @brief Infinite frustum (everything is inside)
+  Frustum();
+
+  /// @brief Extract the planes from the view-projection matrix `matViewProj`
+  ///
+  /// If `matViewProj` is only a projection matrix, the planes are in view space. If it is a
+  /// view-projection matrix, the planes are in world space.
+  explicit Frustum(const mat4& matViewProj);
+
+  Frustum(const Frustum&) = default;
+  Frustum(Frustum&&) = default;
+
+  Frustum& operator=(const Frustum&) = default;
+  Frustum& operator=(Frustum&&) = default;
+
+  /// @brief Recompute the planes from `matViewProj`
+  void update(const mat4& matViewProj);
+
+  /// @brief Get the plane `plane` as `(n.x, n.y, n.z, d)`
+  const vec4& getPlane(PlaneKind plane) const noexcept { return planes_[plane]; }
+
+  /// @brief Check if the point `point` is inside the frustum
+  inline bool contains(const vec3& point) const noexcept {
+    for(const vec4& plane : planes_)
+      if(dot(vec3(plane), point) + plane.w < 0.0f)
+        return false;
+    return true;
+  }
+
+  /// @brief Check if `box` is at least partially inside the frustum
+  ///
+  /// For each plane, only the corner of the box which is farthest along the plane normal (the
+  /// "positive vertex") is tested. The test is conservative i.e boxes which are close to the
+  /// corners of the frustum may be reported as intersecting even if they are outside.
+  inline bool intersects(const AxisAlignedBox& box) const noexcept {
+    if(box.isNull())
+      return false;
+
+    if(box.isInfinite())
+      return true;
+
+    const vec3& min = box.getMinimum();
+    const vec3& max = box.getMaximum();
+
+    for(const vec4& plane : planes_) {
+      vec3 positive(plane.x >= 0.0f ? max.x : min.x, plane.y >= 0.0f ? max.y : min.y,
+                    plane.z >= 0.0f ? max.z : min.z);
+      if(dot(vec3(plane), positive) + plane.w < 0.0f)
+        return false;
+    }
+    return true;
+  }
+
+  /// @brief Convert to string
+  std::string toString() const;
+
+private:
+  std::array<vec4, PK_NumPlanes> planes_;
+};
+
+} // namespace math
+
+} // namespace sequoia
+
+#endif
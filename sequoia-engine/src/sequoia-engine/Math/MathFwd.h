@@ -22,6 +22,7 @@ namespace math {
 
 class AxisAlignedBox;
 class Degree;
+class Frustum;
 class Radian;
 
 } // namespace math
@@ -0,0 +1,108 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                         _____                        _
+//                        / ____|                      (_)
+//                       | (___   ___  __ _ _   _  ___  _  __ _
+//                        \___ \ / _ \/ _` | | | |/ _ \| |/ _` |
+//                        ____) |  __/ (_| | |_| | (_) | | (_| |
+//                       |_____/ \___|\__, |\__,_|\___/|_|\__,_| - Game Engine (2016-2017)
+//                                       | |
+//                                       |_|
+//
+// This file is distributed under the MIT License (MIT).
+// See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#include "sequoia-engine/Core/Assert.h"
+#include "sequoia-engine/Core/Format.h"
+#include "sequoia-engine/Core/StringUtil.h"
+#include "sequoia-engine/Render/ArenaAllocator.h"
+#include <algorithm>
+#include <iterator>
+
+namespace sequoia {
+
+namespace render {
+
+constexpr std::size_t ArenaAllocator::InvalidOffset;
+
+ArenaAllocator::ArenaAllocator(std::size_t capacity) : capacity_(capacity), numAllocated_(0) {
+  if(capacity_ > 0)
+    freeRanges_.emplace(0, capacity_);
+}
+
+std::size_t ArenaAllocator::allocate(std::size_t size) {
+  if(size == 0)
+    return 0;
+
+  for(auto it = freeRanges_.begin(); it != freeRanges_.end(); ++it) {
+    if(it->second < size)
+      continue;
+
+    // Take the allocation from the front of the free range
+    std::size_t offset = it->first;
+    std::size_t remaining = it->second - size;
+    freeRanges_.erase(it);
+    if(remaining > 0)
+      freeRanges_.emplace(offset + size, remaining);
+
+    numAllocated_ += size;
+    return offset;
+  }
+  return InvalidOffset;
+}
+
+void ArenaAllocator::deallocate(std::size_t offset, std::size_t size) {
+  if(size == 0)
+    return;
+
+  SEQUOIA_ASSERT_MSG(offset + size <= capacity_, "range out of bounds");
+  SEQUOIA_ASSERT_MSG(size <= numAllocated_, "range was not allocated");
+
+  numAllocated_ -= size;
+
+  auto next = freeRanges_.lower_bound(offset);
+  SEQUOIA_ASSERT_MSG(next == freeRanges_.end() || offset + size <= next->first,
+                     "range overlaps a free range");
+
+  // Coalesce with the succeeding free range
+  if(next != freeRanges_.end() && offset + size == next->first) {
+    size += next->second;
+    next = freeRanges_.erase(next);
+  }
+
+  // Coalesce with the preceding free range
+  if(next != freeRanges_.begin()) {
+    auto prev = std::prev(next);
+    SEQUOIA_ASSERT_MSG(prev->first + prev->second <= offset, "range overlaps a free range");
+    if(prev->first + prev->second == offset) {
+      prev->second += size;
+      return;
+    }
+  }
+
+  freeRanges_.emplace_hint(next, offset, size);
+}
+
+std::size_t ArenaAllocator::getLargestFreeRange() const noexcept {
+  std::size_t largest = 0;
+  for(const auto& range : freeRanges_)
+    largest = std::max(largest, range.second);
+  return largest;
+}
+
+std::string ArenaAllocator::toString() const {
+  return core::format("ArenaAllocator[\n"
+                      "  capacity = {},\n"
+                      "  numAllocated = {},\n"
+                      "  freeRanges = {}\n"
+                      "]",
+                      capacity_, numAllocated_,
+                      core::indent(core::toStringRange(freeRanges_, [](const auto& range) {
+                        return core::format("[{}, {})", range.first, range.first + range.second);
+                      })));
+}
+
+} // namespace render
+
+} // namespace sequoia
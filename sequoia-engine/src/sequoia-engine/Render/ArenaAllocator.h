@@ -0,0 +1,86 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                         _____                        _
+//                        / ____|                      (_)
+//                       | (___   ___  __ _ _   _  ___  _  __ _
+//                        \___ \ / _ \/ _` | | | |/ _ \| |/ _` |
+//                        ____) |  __/ (_| | |_| | (_) | | (_| |
+//                       |_____/ \___|\__, |\__,_|\___/|_|\__,_| - Game Engine (2016-2017)
+//                                       | |
+//                                       |_|
+//
+// This file is distributed under the MIT License (MIT).
+// See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#ifndef SEQUOIA_ENGINE_RENDER_ARENAALLOCATOR_H
+#define SEQUOIA_ENGINE_RENDER_ARENAALLOCATOR_H
+
+#include "sequoia-engine/Core/Export.h"
+#include "sequoia-engine/Core/NonCopyable.h"
+#include <cstddef>
+#include <limits>
+#include <map>
+#include <string>
+
+namespace sequoia {
+
+namespace render {
+
+/// @brief First-fit allocator of ranges within an arena of fixed capacity
+///
+/// The allocator only does the bookkeeping of the ranges (in arbitrary units, e.g vertices or
+/// indices), the memory itself is owned by the user. Free ranges are kept sorted by their offset
+/// and adjacent free ranges are coalesced on deallocation.
+///
+/// @note The allocator is not thread-safe.
+/// @ingroup render
+class SEQUOIA_API ArenaAllocator : public NonCopyable {
+public:
+  /// @brief Offset returned if an allocation can not be satisfied
+  static constexpr std::size_t InvalidOffset = std::numeric_limits<std::size_t>::max();
+
+  /// @brief Create an arena of `capacity` units
+  ArenaAllocator(std::size_t capacity);
+
+  /// @brief Allocate `size` units
+  /// @returns offset of the first unit or `InvalidOffset` if there is no free range large enough
+  std::size_t allocate(std::size_t size);
+
+  /// @brief Return the range `[offset, offset + size)` to the arena
+  void deallocate(std::size_t offset, std::size_t size);
+
+  /// @brief Get the capacity of the arena
+  std::size_t getCapacity() const noexcept { return capacity_; }
+
+  /// @brief Get the number of allocated units
+  std::size_t getNumAllocated() const noexcept { return numAllocated_; }
+
+  /// @brief Get the number of free ranges (i.e the fragmentation of the arena)
+  std::size_t getNumFreeRanges() const noexcept { return freeRanges_.size(); }
+
+  /// @brief Get the size of the largest free range
+  std::size_t getLargestFreeRange() const noexcept;
+
+  /// @brief Check if nothing is allocated
+  bool isEmpty() const noexcept { return numAllocated_ == 0; }
+
+  /// @brief Convert to string
+  std::string toString() const;
+
+private:
+  /// Number of units in the arena
+  std::size_t capacity_;
+
+  /// Number of allocated units
+  std::size_t numAllocated_;
+
+  /// Free ranges given as offset/size pairs (ordered by offset)
+  std::map<std::size_t, std::size_t> freeRanges_;
+};
+
+} // namespace render
+
+} // namespace sequoia
+
+#endif
@@ -0,0 +1,80 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                         _____                        _
+//                        / ____|                      (_)
+//                       | (___   ___  __ _ _   _  ___  _  __ _
+//                        \___ \ / _ \/ _` | | | |/ _ \| |/ _` |
+//                        ____) |  __/ (_| | |_| | (_) | | (_| |
+//                       |_____/ \___|\__, |\__,_|\___/|_|\__,_| - Game Engine (2016-2017)
+//                                       | |
+//                                       |_|
+//
+// This file is distributed under the MIT License (MIT).
+// See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#include "sequoia-engine/Core/Format.h"
+#include "sequoia-engine/Core/Hash.h"
+#include "sequoia-engine/Core/StringUtil.h"
+#include "sequoia-engine/Render/BindingSet.h"
+#include "sequoia-engine/Render/Texture.h"
+#include <algorithm>
+
+namespace sequoia {
+
+namespace render {
+
+BindingSet::BindingSet(std::vector<TextureBinding> textures, std::vector<UniformBinding> uniforms,
+                       std::vector<std::shared_ptr<Texture>> ownedTextures)
+    : textures_(std::move(textures)), uniforms_(std::move(uniforms)),
+      ownedTextures_(std::move(ownedTextures)), textureHash_(0) {
+  std::sort(textures_.begin(), textures_.end(),
+            [](const TextureBinding& a, const TextureBinding& b) { return a.first < b.first; });
+
+  for(const TextureBinding& texPair : textures_)
+    core::hashCombine(textureHash_, texPair.first, texPair.second);
+}
+
+std::shared_ptr<BindingSet>
+BindingSet::create(const std::unordered_map<int, Texture*>& textures,
+                   const std::unordered_map<std::string, UniformVariable>& uniforms) {
+  UniformNameTable& nameTable = UniformNameTable::getGlobal();
+
+  std::vector<UniformBinding> uniformBindings;
+  uniformBindings.reserve(uniforms.size());
+  for(const auto& nameVariablePair : uniforms)
+    uniformBindings.emplace_back(nameTable.intern(nameVariablePair.first), nameVariablePair.second);
+
+  return std::make_shared<BindingSet>(std::vector<TextureBinding>(textures.begin(), textures.end()),
+                                      std::move(uniformBindings));
+}
+
+std::string BindingSet::toString() const {
+  return core::format(
+      "BindingSet[\n"
+      "  textures = {},\n"
+      "  uniforms = {}\n"
+      "]",
+      textures_.empty() ? "null" : core::indent(core::toStringRange(
+                                       textures_,
+                                       [](const auto& var) {
+                                         return core::indent(core::format(
+                                             "texture = {{\n"
+                                             "  unit = {},\n"
+                                             "  texture = {}\n"
+                                             "}}",
+                                             var.first, core::indent(var.second->toString())));
+                                       })),
+      uniforms_.empty() ? "null" : core::indent(core::toStringRange(uniforms_, [](const auto& var) {
+        return core::indent(core::format("uniform = {{\n"
+                                         "  name = {},\n"
+                                         "  variable = {}\n"
+                                         "}}",
+                                         UniformNameTable::getGlobal().getName(var.first),
+                                         core::indent(var.second.toString())));
+      })));
+}
+
+} // namespace render
+
+} // namespace sequoia
@@ -0,0 +1,89 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                         _____                        _
+//                        / ____|                      (_)
+//                       | (___   ___  __ _ _   _  ___  _  __ _
+//                        \___ \ / _ \/ _` | | | |/ _ \| |/ _` |
+//                        ____) |  __/ (_| | |_| | (_) | | (_| |
+//                       |_____/ \___|\__, |\__,_|\___/|_|\__,_| - Game Engine (2016-2017)
+//                                       | |
+//                                       |_|
+//
+// This file is distributed under the MIT License (MIT).
+// See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#ifndef SEQUOIA_ENGINE_RENDER_BINDINGSET_H
+#define SEQUOIA_ENGINE_RENDER_BINDINGSET_H
+
+#include "sequoia-engine/Core/ArrayRef.h"
+#include "sequoia-engine/Core/Export.h"
+#include "sequoia-engine/Core/NonCopyable.h"
+#include "sequoia-engine/Render/RenderFwd.h"
+#include "sequoia-engine/Render/UniformNameTable.h"
+#include "sequoia-engine/Render/UniformVariable.h"
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace sequoia {
+
+namespace render {
+
+/// @brief Immutable set of texture and uniform variable bindings
+///
+/// BindingSets are created once per material (and whenever the material is modified) and shared
+/// among all `DrawCommand`s using the material. This makes the generation of `DrawCommand`s
+/// allocation free.
+///
+/// The textures are sorted by their texture unit and the names of the uniform variables are
+/// interned in the `UniformNameTable` on construction.
+///
+/// @ingroup render
+class SEQUOIA_API BindingSet : public NonCopyable {
+public:
+  using TextureBinding = std::pair<int, Texture*>;
+  using UniformBinding = std::pair<UniformID, UniformVariable>;
+
+  /// @brief Create the BindingSet
+  ///
+  /// @param textures         Texture-unit/texture pairs
+  /// @param uniforms         ID/uniform-variable pairs
+  /// @param ownedTextures    Textures kept alive as long as the BindingSet (e.g the textures of the
+  ///                         material which may be replaced while the BindingSet is in flight)
+  BindingSet(std::vector<TextureBinding> textures, std::vector<UniformBinding> uniforms,
+             std::vector<std::shared_ptr<Texture>> ownedTextures = {});
+
+  /// @brief Create a BindingSet from a texture-unit/texture and name/uniform-variable map
+  static std::shared_ptr<BindingSet>
+  create(const std::unordered_map<int, Texture*>& textures,
+         const std::unordered_map<std::string, UniformVariable>& uniforms);
+
+  /// @brief Get the texture-unit/texture pairs (sorted by texture unit)
+  ArrayRef<TextureBinding> getTextures() const noexcept { return textures_; }
+
+  /// @brief Get the ID/uniform-variable pairs
+  ArrayRef<UniformBinding> getUniforms() const noexcept { return uniforms_; }
+
+  /// @brief Get the hash of the texture-unit/texture pairs
+  ///
+  /// BindingSets which bind the same textures to the same units have an equal hash.
+  std::size_t getTextureHash() const noexcept { return textureHash_; }
+
+  /// @brief Convert to string
+  std::string toString() const;
+
+private:
+  std::vector<TextureBinding> textures_;
+  std::vector<UniformBinding> uniforms_;
+  std::vector<std::shared_ptr<Texture>> ownedTextures_;
+  std::size_t textureHash_;
+};
+
+} // namespace render
+
+} // namespace sequoia
+
+#endif
@@ -74,9 +74,7 @@ math::vec3 Camera::getUp() const {
 }
 
 math::mat4 Camera::getViewProjectionMatrix() const {
-  return (math::perspective(math::Degree(getFieldOfViewY()).inRadians(), getAspectRatio(),
-                            getZNearClipping(), getZFarClipping()) *
-          math::lookAt(getEye(), getCenter(), getUp()));
+  return getProjectionMatrix() * getViewMatrix();
 }
 
 math::mat4 Camera::getProjectionMatrix() const {
@@ -84,6 +82,10 @@ math::mat4 Camera::getProjectionMatrix() const {
                            getZNearClipping(), getZFarClipping());
 }
 
+math::mat4 Camera::getViewMatrix() const { return math::lookAt(getEye(), getCenter(), getUp()); }
+
+math::Frustum Camera::getFrustum() const { return math::Frustum(getViewProjectionMatrix()); }
+
 void Camera::setPosition(const math::vec3& position) {
   modelMatrixIsDirty_ = true;
   position_ = position;
@@ -18,6 +18,7 @@
 
 #include "sequoia-engine/Core/Assert.h"
 #include "sequoia-engine/Core/Export.h"
+#include "sequoia-engine/Math/Frustum.h"
 #include "sequoia-engine/Math/Math.h"
 #include "sequoia-engine/Render/ViewFrustum.h"
 #include "sequoia-engine/Render/Viewport.h"
@@ -121,6 +122,14 @@ public:
   /// @brief Compute the view-projection matrix
   math::mat4 getProjectionMatrix() const;
 
+  /// @brief Compute the view matrix
+  math::mat4 getViewMatrix() const;
+
+  /// @brief Compute the clipping planes of the view frustum (in world space)
+  ///
+  /// The planes are extracted from `getViewProjectionMatrix()`.
+  math::Frustum getFrustum() const;
+
   /// @brief Set the position of the camera (equivalent to `setEye()`)
   void setPosition(const math::vec3& position);
 
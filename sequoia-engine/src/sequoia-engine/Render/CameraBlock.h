@@ -0,0 +1,48 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                         _____                        _
+//                        / ____|                      (_)
+//                       | (___   ___  __ _ _   _  ___  _  __ _
+//                        \___ \ / _ \/ _` | | | |/ _ \| |/ _` |
+//                        ____) |  __/ (_| | |_| | (_) | | (_| |
+//                       |_____/ \___|\__, |\__,_|\___/|_|\__,_| - Game Engine (2016-2017)
+//                                       | |
+//                                       |_|
+//
+// This file is distributed under the MIT License (MIT).
+// See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#ifndef SEQUOIA_ENGINE_RENDER_CAMERABLOCK_H
+#define SEQUOIA_ENGINE_RENDER_CAMERABLOCK_H
+
+#include "sequoia-engine/Math/Math.h"
+#include "sequoia-engine/Render/UniformBlock.h"
+
+namespace sequoia {
+
+namespace render {
+
+/// @brief Per-pass camera data, declared in the GPU programs as
+///
+/// @code
+///   layout(std140) uniform CameraBlock {
+///     mat4 matView;
+///     mat4 matProj;
+///     mat4 matViewProj;
+///   };
+/// @endcode
+///
+/// The block is written once per `RenderPass` by the `Renderer` (unless the pass sets it itself)
+/// and shared by all `DrawCommand`s of the pass. Programs which support instancing transform the
+/// per-instance model matrices with it.
+///
+/// @ingroup render
+SEQUOIA_UNIFORM_BLOCK(CameraBlock,
+                      (math::mat4, matView, 1)(math::mat4, matProj, 1)(math::mat4, matViewProj, 1));
+
+} // namespace render
+
+} // namespace sequoia
+
+#endif
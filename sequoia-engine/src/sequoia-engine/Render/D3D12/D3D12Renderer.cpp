@@ -32,7 +32,7 @@ bool D3D12Renderer::VertexDataChanged(VertexData* data) { return true; }
 
 bool D3D12Renderer::TextureChanged(int textureUnit, Texture* texture, bool enable) { return true; }
 
-bool D3D12Renderer::UniformVariableChanged(Program* program, const std::string& name,
+bool D3D12Renderer::UniformVariableChanged(Program* program, UniformID id,
                                           const UniformVariable& value) {
   return true;
 }
@@ -44,8 +44,26 @@ bool D3D12Renderer::clearRenderBuffers(
   return true;
 }
 
+bool D3D12Renderer::bindUniformBlock(const std::string& name, const std::vector<Byte>& data) {
+  return true;
+}
+
 bool D3D12Renderer::draw(const DrawCommand& drawCommand) { return true; }
 
+bool D3D12Renderer::supportsInstancing(Program* program) const { return false; }
+
+bool D3D12Renderer::drawInstanced(const DrawCommand& drawCommand, ArrayRef<math::mat4> matModels) {
+  return true;
+}
+
+bool D3D12Renderer::supportsMultiDrawIndirect() const { return false; }
+
+bool D3D12Renderer::drawIndirect(const DrawCommand& drawCommand,
+                                 ArrayRef<DrawIndirectCommand> commands,
+                                 ArrayRef<math::mat4> matModels) {
+  return true;
+}
+
 std::pair<std::string, std::string> D3D12Renderer::toStringImpl() const {
   return std::make_pair("D3D12Renderer", core::format("{}", Base::toStringImpl().second));
 }
@@ -42,7 +42,7 @@ protected:
   virtual bool TextureChanged(int textureUnit, Texture* texture, bool enable) override;
 
   /// @copydoc Renderer::UniformVariableChanged
-  virtual bool UniformVariableChanged(Program* program, const std::string& name,
+  virtual bool UniformVariableChanged(Program* program, UniformID id,
                                       const UniformVariable& value) override;
 
   /// @copydoc Renderer::ViewportChanged
@@ -51,9 +51,26 @@ protected:
   virtual bool
   clearRenderBuffers(const std::set<RenderBuffer::RenderBufferKind>& buffersToClear) override;
 
+  /// @copydoc Renderer::bindUniformBlock
+  virtual bool bindUniformBlock(const std::string& name, const std::vector<Byte>& data) override;
+
   /// @copydoc Renderer::draw
   virtual bool draw(const DrawCommand& drawCommand) override;
 
+  /// @copydoc Renderer::supportsInstancing
+  virtual bool supportsInstancing(Program* program) const override;
+
+  /// @copydoc Renderer::drawInstanced
+  virtual bool drawInstanced(const DrawCommand& drawCommand,
+                             ArrayRef<math::mat4> matModels) override;
+
+  /// @copydoc Renderer::supportsMultiDrawIndirect
+  virtual bool supportsMultiDrawIndirect() const override;
+
+  /// @copydoc Renderer::drawIndirect
+  virtual bool drawIndirect(const DrawCommand& drawCommand, ArrayRef<DrawIndirectCommand> commands,
+                            ArrayRef<math::mat4> matModels) override;
+
   /// @copydoc Renderer::toStringImpl
   std::pair<std::string, std::string> toStringImpl() const override;
 
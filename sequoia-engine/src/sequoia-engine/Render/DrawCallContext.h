@@ -16,6 +16,7 @@
 #ifndef SEQUOIA_ENGINE_RENDER_DRAWCALLCONTEXT_H
 #define SEQUOIA_ENGINE_RENDER_DRAWCALLCONTEXT_H
 
+#include "sequoia-engine/Core/Byte.h"
 #include "sequoia-engine/Core/Export.h"
 #include "sequoia-engine/Core/NonCopyable.h"
 #include "sequoia-engine/Render/RenderBuffer.h"
@@ -25,6 +26,7 @@
 #include <set>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 namespace sequoia {
 
@@ -38,8 +40,10 @@ namespace render {
 /// @ingroup render
 struct SEQUOIA_API DrawCallContext : public NonCopyable {
   DrawCallContext(render::Viewport* viewport, const RenderTarget* target, const DrawScene* scene,
-                  const std::vector<DrawCommand>* drawCommands)
-      : Viewport(viewport), Target(target), Scene(scene), DrawCommands(drawCommands) {
+                  const std::vector<DrawCommand>* drawCommands,
+                  std::unordered_map<std::string, std::vector<Byte>>& uniformBlocks)
+      : Viewport(viewport), UniformBlocks(uniformBlocks), Target(target), Scene(scene),
+        DrawCommands(drawCommands) {
     BuffersToClear = {RenderBuffer::RK_Color, RenderBuffer::RK_Depth, RenderBuffer::RK_Stencil};
   }
 
@@ -58,6 +62,14 @@ struct SEQUOIA_API DrawCallContext : public NonCopyable {
   /// automatically to the program.
   std::unordered_map<std::string, UniformVariable> Uniforms;
 
+  /// Uniform blocks (in std140 layout) which are going to be bound to the GPU program of
+  /// `Pipeline`, indexed by the name of the block (empty blocks are not bound)
+  ///
+  /// The blocks are uploaded once per pass and shared by all `DrawCommand`s of the pass. The
+  /// storage is owned by the Renderer and merely cleared in between passes, hence setting a block
+  /// does not allocate once it has been set in a previous frame.
+  std::unordered_map<std::string, std::vector<Byte>>& UniformBlocks;
+
   /// Clear the specified `RenderBuffer`s
   std::set<RenderBuffer::RenderBufferKind> BuffersToClear;
 
@@ -69,6 +81,21 @@ struct SEQUOIA_API DrawCallContext : public NonCopyable {
 
   /// Sequence of `DrawCommand`s which are going to be invoked
   const std::vector<DrawCommand>* DrawCommands;
+
+  /// @brief Check if the uniform block `BlockType` has been set
+  template <class BlockType>
+  bool hasUniformBlock() const {
+    auto it = UniformBlocks.find(BlockType::GetName());
+    return it != UniformBlocks.end() && !it->second.empty();
+  }
+
+  /// @brief Set the uniform block `block` (see `SEQUOIA_UNIFORM_BLOCK`)
+  template <class BlockType>
+  void setUniformBlock(const BlockType& block) {
+    std::vector<Byte>& data = UniformBlocks[BlockType::GetName()];
+    data.resize(BlockType::GetLayout().getNumBytes());
+    block.pack(data.data());
+  }
 };
 
 } // namespace render
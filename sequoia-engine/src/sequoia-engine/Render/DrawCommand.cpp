@@ -29,27 +29,21 @@ std::string DrawCommand::toString() const {
       "DrawCommand[\n"
       "  data = {},\n"
       "  modelMatrix = Mat4[{}\n  ],\n"
-      "  textures = {},\n"
+      "  bindingSet = {},\n"
       "  uniforms = {}\n"
       "]",
       data_ ? core::indent(data_->toString()) : "null", core::indent(ss.str(), 4),
-      textures_.empty() ? "null" : core::indent(core::toStringRange(
-                                       textures_,
-                                       [](const auto& var) {
-                                         return core::indent(core::format(
-                                             "texture = {{\n"
-                                             "  unit = {},\n"
-                                             "  texture = {}\n"
-                                             "}}",
-                                             var.first, core::indent(var.second->toString())));
-                                       })),
-      uniforms_.empty() ? "null" : core::indent(core::toStringRange(uniforms_, [](const auto& var) {
-        return core::indent(core::format("uniform = {{\n"
-                                         "  name = {},\n"
-                                         "  variable = {}\n"
-                                         "}}",
-                                         var.first, core::indent(var.second.toString())));
-      })));
+      bindingSet_ ? core::indent(bindingSet_->toString()) : "null",
+      numUniforms_ == 0
+          ? "null"
+          : core::indent(core::toStringRange(getUniforms(), [](const auto& var) {
+              return core::indent(core::format("uniform = {{\n"
+                                               "  name = {},\n"
+                                               "  variable = {}\n"
+                                               "}}",
+                                               UniformNameTable::getGlobal().getName(var.first),
+                                               core::indent(var.second.toString())));
+            })));
 }
 
 } // namespace render
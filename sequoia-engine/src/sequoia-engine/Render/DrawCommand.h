@@ -16,13 +16,20 @@
 #ifndef SEQUOIA_ENGINE_RENDER_DRAWCOMMAND_H
 #define SEQUOIA_ENGINE_RENDER_DRAWCOMMAND_H
 
+#include "sequoia-engine/Core/ArrayRef.h"
+#include "sequoia-engine/Core/Assert.h"
 #include "sequoia-engine/Core/Export.h"
 #include "sequoia-engine/Math/Math.h"
-#include "sequoia-engine/Render/Texture.h"
+#include "sequoia-engine/Render/BindingSet.h"
+#include "sequoia-engine/Render/UniformNameTable.h"
 #include "sequoia-engine/Render/UniformVariable.h"
 #include "sequoia-engine/Render/VertexData.h"
+#include <array>
+#include <cstdint>
+#include <memory>
 #include <string>
 #include <unordered_map>
+#include <utility>
 
 namespace sequoia {
 
@@ -30,70 +37,102 @@ namespace render {
 
 /// @brief Encapsulate all information required by a draw command to render a `game::Shape`
 ///
-/// Note that the DrawCommand of Shape can be extracted via `game::Drawable::makeDrawCommand()`.
+/// The textures and uniform variables of the material are referenced via a shared, immutable
+/// BindingSet. Uniform variables which are specific to a single draw are stored in a small inline
+/// array, hence creating a DrawCommand does not allocate any memory.
+///
+/// The DrawCommand shares the ownership of the VertexData and the BindingSet. This keeps them alive
+/// while the command is in flight (e.g rendered while the next frame is prepared concurrently),
+/// even if the scene drops the mesh or modifies the material in the meantime.
+///
+/// Note that the DrawCommand of Shape can be extracted via `game::Drawable::prepareDrawCommands()`.
 ///
 /// @ingroup render
 class SEQUOIA_API DrawCommand {
 public:
+  /// Maximum number of per-draw uniform variables
+  static constexpr std::size_t MaxUniformVariables = 4;
+
+  using UniformBinding = BindingSet::UniformBinding;
+
   DrawCommand() = default;
-  DrawCommand(VertexData* data, const math::mat4& modelMatrix)
-      : data_(data), modelMatrix_(modelMatrix) {}
+
+  /// @brief Create the DrawCommand sharing the ownership of `data` and `bindingSet`
+  DrawCommand(std::shared_ptr<VertexData> data, const math::mat4& modelMatrix,
+              std::shared_ptr<const BindingSet> bindingSet = nullptr)
+      : data_(std::move(data)), modelMatrix_(modelMatrix), bindingSet_(std::move(bindingSet)) {}
+
+  /// @brief Create the DrawCommand referencing `data` and `bindingSet` *without* owning them, i.e
+  /// both need to outlive the DrawCommand
+  DrawCommand(VertexData* data, const math::mat4& modelMatrix,
+              const BindingSet* bindingSet = nullptr)
+      : data_(std::shared_ptr<VertexData>(), data), modelMatrix_(modelMatrix),
+        bindingSet_(std::shared_ptr<const BindingSet>(), bindingSet) {}
 
   /// @brief Get/Set the vertex data
-  VertexData* getVertexData() const noexcept { return data_; }
-  void setVertexData(VertexData* data) noexcept { data_ = data; }
+  VertexData* getVertexData() const noexcept { return data_.get(); }
+  void setVertexData(std::shared_ptr<VertexData> data) noexcept { data_ = std::move(data); }
 
   /// @brief Get/Set the model matrix
   const math::mat4& getModelMatrix() const noexcept { return modelMatrix_; }
   void setModelMatrix(const math::mat4& modelMatrix) noexcept { modelMatrix_ = modelMatrix; }
 
-  /// @brief Bind `texture` to `textureUnit`
-  ///
-  /// This binds the sampler, associated with `textureUnit`, to the specified `texture`. Note that
-  /// if a texture has already been bound to the specific `textureUnit`, the texture is replaced
-  /// with the newly provided one.
-  ///
-  /// @param textureUnit    ID of the texture unit starting from 0.
-  /// @param texture        Texture to bind
-  void setTexture(int textureUnit, Texture* texture) noexcept { textures_[textureUnit] = texture; }
+  /// @brief Get/Set the shared textures and uniform variables (e.g of the material)
+  const BindingSet* getBindingSet() const noexcept { return bindingSet_.get(); }
+  void setBindingSet(std::shared_ptr<const BindingSet> bindingSet) noexcept {
+    bindingSet_ = std::move(bindingSet);
+  }
 
-  /// @brief Get the texture map
-  const std::unordered_map<int, Texture*>& getTextures() const noexcept { return textures_; }
+  /// @brief Get the texture-unit/texture pairs of the BindingSet (sorted by texture unit)
+  ArrayRef<BindingSet::TextureBinding> getTextures() const noexcept {
+    return bindingSet_ ? bindingSet_->getTextures() : ArrayRef<BindingSet::TextureBinding>();
+  }
 
-  /// @brief Set the uniform variable `name` to `value`
+  /// @brief Set the per-draw uniform variable `name` to `value`
   ///
-  /// Note that if the uniform variable has already been set, the existing value is overriden.
-  void setUniformVariable(const std::string& name, const UniformVariable& value) noexcept {
-    uniforms_[name] = value;
+  /// The per-draw uniform variables are set *after* the ones of the BindingSet and thus override
+  /// them. Note that if the uniform variable has already been set, the existing value is overriden.
+  ///
+  /// Prefer the overload taking the `UniformID` in hot loops as this one needs to look up the name
+  /// in the `UniformNameTable`.
+  /// @{
+  void setUniformVariable(UniformID id, const UniformVariable& value) {
+    for(std::size_t i = 0; i < numUniforms_; ++i) {
+      if(uniforms_[i].first == id) {
+        uniforms_[i].second = value;
+        return;
+      }
+    }
+    SEQUOIA_ASSERT_MSG(numUniforms_ < MaxUniformVariables, "too many per-draw uniform variables");
+    uniforms_[numUniforms_].first = id;
+    uniforms_[numUniforms_].second = value;
+    numUniforms_++;
+  }
+
+  void setUniformVariable(const std::string& name, const UniformVariable& value) {
+    setUniformVariable(UniformNameTable::getGlobal().intern(name), value);
   }
+  /// @}
 
-  /// @brief Set the uniform struct `name` to `value`
+  /// @brief Set the per-draw uniform struct `name` to `value`
   ///
   /// @param name     Name of the uniform variable
   /// @param value    Struct to upload to the GPU
   /// @param index    If the struct is part of an array, the index of this struct or -1 to indicate
   ///                 this is a scalar struct
   ///
-  /// This calls `StructType::toUniformVariableMap` to retrive all the uniform variables of the
-  /// struct. The synopsis of `StructType::toUniformVariableMap` is:
-  ///
-  /// @code{.cpp}
-  /// void toUniformVariableMap(
-  ///   const std::string& name,
-  ///   std::unordered_map<std::string, UniformVariable>& map,
-  ///   int index) const;
-  /// @endcode
-  ///
-  /// In general, the struct should be defined via the `SEQUOIA_UNIFORM_STRUCT` macro which
-  /// generates the appropriate member function.
+  /// @see game::Material::setUniformStruct
   template <class StructType>
   void setUniformStruct(const std::string& name, const StructType& value, int index = -1) {
-    value.toUniformVariableMap(name, uniforms_, index);
+    std::unordered_map<std::string, UniformVariable> map;
+    value.toUniformVariableMap(name, map, index);
+    for(const auto& nameVariablePair : map)
+      setUniformVariable(nameVariablePair.first, nameVariablePair.second);
   }
 
-  /// @brief Get the uniform variable map
-  const std::unordered_map<std::string, UniformVariable>& getUniforms() const noexcept {
-    return uniforms_;
+  /// @brief Get the per-draw uniform variables
+  ArrayRef<UniformBinding> getUniforms() const noexcept {
+    return ArrayRef<UniformBinding>(uniforms_.data(), numUniforms_);
   }
 
   /// @brief Convert draw command to string
@@ -101,16 +140,19 @@ public:
 
 private:
   /// Vertex data of the mesh
-  VertexData* data_ = nullptr;
+  std::shared_ptr<VertexData> data_;
 
   /// Matrix used to construct the world transformation of vertex data
   math::mat4 modelMatrix_ = math::mat4(1.0f);
 
-  /// Texture data of the material (associate texture units to actual textures)
-  std::unordered_map<int, Texture*> textures_;
+  /// Textures and uniform variables shared among several DrawCommands (mostly the material)
+  std::shared_ptr<const BindingSet> bindingSet_;
+
+  /// Uniform variables which are *specific* to this DrawCommand
+  std::array<UniformBinding, MaxUniformVariables> uniforms_;
 
-  /// Uniform variables which are *specific* to this DrawCommand (mostly material properties)
-  std::unordered_map<std::string, UniformVariable> uniforms_;
+  /// Number of per-draw uniform variables
+  std::size_t numUniforms_ = 0;
 };
 
 } // namespace render
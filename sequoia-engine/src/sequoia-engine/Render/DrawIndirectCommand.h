@@ -0,0 +1,54 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                         _____                        _
+//                        / ____|                      (_)
+//                       | (___   ___  __ _ _   _  ___  _  __ _
+//                        \___ \ / _ \/ _` | | | |/ _ \| |/ _` |
+//                        ____) |  __/ (_| | |_| | (_) | | (_| |
+//                       |_____/ \___|\__, |\__,_|\___/|_|\__,_| - Game Engine (2016-2017)
+//                                       | |
+//                                       |_|
+//
+// This file is distributed under the MIT License (MIT).
+// See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#ifndef SEQUOIA_ENGINE_RENDER_DRAWINDIRECTCOMMAND_H
+#define SEQUOIA_ENGINE_RENDER_DRAWINDIRECTCOMMAND_H
+
+#include "sequoia-engine/Core/Export.h"
+#include "sequoia-engine/Render/VertexData.h"
+#include <cstdint>
+
+namespace sequoia {
+
+namespace render {
+
+/// @brief Parameters of a single draw of a multi-draw (i.e `glMultiDrawElementsIndirect`)
+///
+/// The layout matches the `DrawElementsIndirectCommand` of OpenGL. For VertexData without indices,
+/// `First` refers to the first vertex and `BaseVertex` is unused.
+///
+/// @ingroup render
+struct SEQUOIA_API DrawIndirectCommand {
+  std::uint32_t Count;         ///< Number of indices (or vertices) to draw
+  std::uint32_t InstanceCount; ///< Number of instances to draw
+  std::uint32_t First;         ///< First index (or vertex) within the buffers of the storage
+  std::int32_t BaseVertex;     ///< Constant added to each index
+  std::uint32_t BaseInstance;  ///< Index of the first instance in the per-instance attributes
+
+  /// @brief Create the command drawing one instance of the range of `data` within its storage
+  static DrawIndirectCommand create(const VertexData* data, std::uint32_t baseInstance) noexcept {
+    VertexData::DrawRange range = data->getDrawRange();
+    if(data->hasIndices())
+      return DrawIndirectCommand{range.NumIndices, 1, range.FirstIndex,
+                                 static_cast<std::int32_t>(range.FirstVertex), baseInstance};
+    return DrawIndirectCommand{range.NumVertices, 1, range.FirstVertex, 0, baseInstance};
+  }
+};
+
+} // namespace render
+
+} // namespace sequoia
+
+#endif
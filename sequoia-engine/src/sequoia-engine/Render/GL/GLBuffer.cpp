@@ -19,6 +19,7 @@
 #include "sequoia-engine/Core/Unreachable.h"
 #include "sequoia-engine/Render/GL/GL.h"
 #include "sequoia-engine/Render/GL/GLBuffer.h"
+#include "sequoia-engine/Render/GL/GLRenderer.h"
 #include <cstring>
 
 // TODO: convert everything to DSA
@@ -42,14 +43,38 @@ static GLenum getGLBufferUsage(Buffer::UsageHint hint) {
   }
 }
 
+/// @brief Get the ring buffer to stage an update of `numBytes` of a buffer with usage `hint`
+///
+/// Returns `nullptr` if the update has to go through the buffer itself, i.e the buffer is static
+/// or the update does not fit into the current frame of the ring buffer.
+static GLRingBuffer* getUploadBuffer(GLenum hint, std::size_t numBytes) {
+  if(hint == GL_STATIC_DRAW || numBytes == 0)
+    return nullptr;
+
+  GLRenderer* renderer = getGLRendererPtr();
+  GLRingBuffer* uploadBuffer = renderer ? renderer->getUploadBuffer() : nullptr;
+  return (uploadBuffer && uploadBuffer->canAllocate(numBytes)) ? uploadBuffer : nullptr;
+}
+
 GLBuffer::GLBuffer(GLenum target)
-    : id_(0), target_(target), hint_(GL_INVALID_ENUM), numBytes_(0), isLocked_(false) {
+    : id_(0), target_(target), hint_(GL_INVALID_ENUM), numBytes_(0), isLocked_(false),
+      storage_(nullptr), offset_(0) {
 
   // TODO: for DSA replace with glCreateBuffers
   glGenBuffers(1, &id_);
 }
 
-GLBuffer::~GLBuffer() { glDeleteBuffers(1, &id_); }
+GLBuffer::GLBuffer(GLBuffer* storage, std::size_t offset)
+    : id_(storage->id_), target_(storage->target_), hint_(storage->hint_), numBytes_(0),
+      isLocked_(false), storage_(storage), offset_(offset) {
+  SEQUOIA_ASSERT_MSG(!storage->isView(), "views of views are not supported");
+  SEQUOIA_ASSERT_MSG(offset_ <= storage->numBytes_, "view out of bounds");
+}
+
+GLBuffer::~GLBuffer() {
+  if(!isView())
+    glDeleteBuffers(1, &id_);
+}
 
 void GLBuffer::bind() { glBindBuffer(target_, id_); }
 
@@ -58,8 +83,40 @@ void GLBuffer::unbind() { glBindBuffer(target_, 0); }
 void* GLBuffer::lock(Buffer::LockOption option) {
   SEQUOIA_ASSERT_MSG(!isLocked(), "buffer already locked");
   isLocked_ = true;
-  
-  bind();  
+
+  // Views map their range of the shared buffer (discarding only invalidates the range)
+  if(isView()) {
+    BufferAccessMask access = GL_MAP_WRITE_BIT;
+    switch(option) {
+    case Buffer::LO_Normal:
+      access = GL_MAP_READ_BIT | GL_MAP_WRITE_BIT;
+      break;
+    case Buffer::LO_ReadOnly:
+      access = GL_MAP_READ_BIT;
+      break;
+    case Buffer::LO_Discard:
+      access = GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT;
+      break;
+    default: // LO_WriteOnly
+      access = GL_MAP_WRITE_BIT;
+    }
+
+    bind();
+    void* data = glMapBufferRange(target_, offset_, numBytes_, access);
+    unbind();
+    return data;
+  }
+
+  // Discarding locks of dynamic buffers return memory of the upload ring buffer which is copied
+  // to the buffer on `unlock`. This neither orphans the buffer nor waits for the GPU.
+  if(option == Buffer::LO_Discard) {
+    if(GLRingBuffer* uploadBuffer = getUploadBuffer(hint_, numBytes_)) {
+      staging_ = uploadBuffer->allocate(numBytes_);
+      return staging_.Data;
+    }
+  }
+
+  bind();
 
   // Discard the buffer if requested
   if(option == Buffer::LO_Discard)
@@ -77,8 +134,6 @@ void* GLBuffer::lock(Buffer::LockOption option) {
     access = GL_WRITE_ONLY;
   }
 
-  // TODO: allow returning a scratchpad memory for small buffers
-
   // Initiate the DMA
   void* data = glMapBuffer(target_, access);
   unbind();
@@ -89,12 +144,26 @@ void GLBuffer::unlock() {
   SEQUOIA_ASSERT_MSG(isLocked(), "buffer not locked");
   isLocked_ = false;
 
+  // Copy the staged data (see `lock`)
+  if(staging_.Data) {
+    glCopyNamedBufferSubData(getGLRenderer().getUploadBuffer()->getID(), id_, staging_.Offset, 0,
+                             staging_.NumBytes);
+    staging_ = RingBuffer::Allocation();
+    return;
+  }
+
   bind();
   glUnmapBuffer(target_);
   unbind();
 }
 
 void GLBuffer::allocate(std::size_t numBytes, Buffer::UsageHint hint) {
+  if(isView()) {
+    SEQUOIA_ASSERT_MSG(offset_ + numBytes <= storage_->numBytes_, "view out of bounds");
+    numBytes_ = numBytes;
+    return;
+  }
+
   numBytes_ = numBytes;
   hint_ = getGLBufferUsage(hint);
   bind();
@@ -104,7 +173,22 @@ void GLBuffer::allocate(std::size_t numBytes, Buffer::UsageHint hint) {
 
 void GLBuffer::write(const void* src, std::size_t offset, std::size_t length, bool discardBuffer) {
   SEQUOIA_ASSERT_MSG((offset + length) <= numBytes_, "out of bound writing");
-  
+
+  if(isView()) {
+    bind();
+    glBufferSubData(target_, offset_ + offset, length, src);
+    unbind();
+    return;
+  }
+
+  // Dynamic buffers copy the data from the upload ring buffer. The copy is executed in order with
+  // the previous draw commands on the GPU, hence there is no need to discard the buffer.
+  if(GLRingBuffer* uploadBuffer = getUploadBuffer(hint_, length)) {
+    RingBuffer::Allocation allocation = uploadBuffer->write(src, length);
+    glCopyNamedBufferSubData(uploadBuffer->getID(), id_, allocation.Offset, offset, length);
+    return;
+  }
+
   bind();
 
   if(discardBuffer)
@@ -122,6 +206,13 @@ void GLBuffer::write(const void* src, std::size_t offset, std::size_t length, bo
 void GLBuffer::read(std::size_t offset, std::size_t length, void* dest) {
   SEQUOIA_ASSERT_MSG((offset + length) <= numBytes_, "out of bound reading");
 
+  if(isView()) {
+    bind();
+    glGetBufferSubData(target_, offset_ + offset, length, dest);
+    unbind();
+    return;
+  }
+
   bind();
   
   // TODO: figure out when using glGetNamedBufferSubData vs. glMapBuffer
@@ -140,9 +231,10 @@ std::string GLBuffer::toString() const {
                       "  id = {},\n"
                       "  target = {},\n"
                       "  hint = {},\n"
-                      "  numBytes = {}\n"
+                      "  numBytes = {},\n"
+                      "  offset = {}\n"
                       "]",
-                      id_, target_, hint_, numBytes_);
+                      id_, target_, hint_, numBytes_, offset_);
 }
 
 } // namespace render
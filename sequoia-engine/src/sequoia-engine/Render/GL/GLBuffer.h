@@ -20,6 +20,7 @@
 #include "sequoia-engine/Core/DoubleBuffered.h"
 #include "sequoia-engine/Core/Export.h"
 #include "sequoia-engine/Render/GL/GLFwd.h"
+#include "sequoia-engine/Render/RingBuffer.h"
 #include "sequoia-engine/Render/VertexData.h"
 #include <vector>
 
@@ -51,12 +52,32 @@ class SEQUOIA_API GLBuffer {
   /// Check if the buffer is locked
   bool isLocked_;
 
+  /// Buffer owning the OpenGL buffer if this is a view (`nullptr` otherwise)
+  GLBuffer* storage_;
+
+  /// Byte offset of the view within the storage
+  std::size_t offset_;
+
+  /// Memory of the upload ring buffer handed out by a discarding lock (`Data` is `nullptr` if the
+  /// buffer is mapped directly)
+  RingBuffer::Allocation staging_;
+
 public:
   /// @brief Create the buffer(s)
   ///
   /// @param target       Target of the buffer(s)
   GLBuffer(GLenum target);
 
+  /// @brief Create a view of the range starting at the byte `offset` of `storage`
+  ///
+  /// The view shares the OpenGL buffer of `storage` (which needs to outlive the view). Allocating
+  /// a view only sets its size while locks, writes and reads are restricted to the range of the
+  /// view and never discard the content of the shared buffer.
+  ///
+  /// @param storage      Buffer owning the OpenGL buffer
+  /// @param offset       Byte offset of the view within `storage`
+  GLBuffer(GLBuffer* storage, std::size_t offset);
+
   /// @brief Destroy buffer(s)
   ~GLBuffer();
 
@@ -68,12 +89,13 @@ public:
 
   /// @brief Lock the buffer
   ///
-  /// This will bind the modify buffer.
+  /// Discarding locks of dynamic buffers return memory of the upload ring buffer of the renderer
+  /// (if it fits), otherwise the buffer is mapped.
   void* lock(Buffer::LockOption option);
 
   /// @brief Unlock the buffer
   ///
-  /// This will bind the modify buffer.
+  /// If the lock returned memory of the upload ring buffer, the data is copied to the buffer.
   void unlock();
 
   /// @brief Check if the buffer is locked
@@ -90,7 +112,8 @@ public:
   /// @brief Write `length` bytes, starting at `offset`, from `src` to the buffer currently set for
   /// modification
   ///
-  /// This will bind the modify buffer.
+  /// Dynamic buffers copy the data from the upload ring buffer of the renderer (if it fits) and
+  /// never discard their content.
   ///
   /// @param src            Data pointer of size `numBytes`
   /// @param offset         The *byte* offset from the start of the buffer to start writing
@@ -113,6 +136,15 @@ public:
   /// @brief Get the OpenGL buffer ID
   unsigned int getID() const;
 
+  /// @brief Check if the buffer is a view of another buffer
+  bool isView() const noexcept { return storage_ != nullptr; }
+
+  /// @brief Get the byte offset of the view within its storage (0 if this is not a view)
+  std::size_t getOffset() const noexcept { return offset_; }
+
+  /// @brief Get the number of allocated bytes
+  std::size_t getNumBytes() const noexcept { return numBytes_; }
+
   /// @brief Convert buffer to string
   std::string toString() const;
 };
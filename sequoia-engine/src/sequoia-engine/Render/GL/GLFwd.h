@@ -38,12 +38,16 @@ class GLProgramManager;
 class GLRenderer;
 class GLRenderSystem;
 class GLRenderWindow;
+class GLRingBuffer;
 class GLShader;
 class GLShaderManager;
 class GLStateCacheManager;
 class GLTexture;
 class GLTextureManager;
+class GLTextureStreamer;
 class GLVertexArrayObject;
+class GLVertexData;
+class GLVertexDataArena;
 struct GLFragmentData;
 struct GLVertexAttribute;
 
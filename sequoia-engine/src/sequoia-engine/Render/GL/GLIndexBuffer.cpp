@@ -25,6 +25,10 @@ namespace render {
 GLIndexBuffer::GLIndexBuffer(IndexBuffer::IndexType type)
     : IndexBuffer(BK_GLIndexBuffer, type), glBuffer_(GL_ELEMENT_ARRAY_BUFFER) {}
 
+GLIndexBuffer::GLIndexBuffer(IndexBuffer::IndexType type, GLIndexBuffer* storage,
+                             std::size_t offset)
+    : IndexBuffer(BK_GLIndexBuffer, type), glBuffer_(storage->getGLBuffer(), offset) {}
+
 GLIndexBuffer::~GLIndexBuffer() {}
 
 void GLIndexBuffer::writeImpl(const void* src, std::size_t offset, std::size_t length,
@@ -32,12 +32,19 @@ class SEQUOIA_API GLIndexBuffer final : public IndexBuffer {
 public:
   GLIndexBuffer(IndexBuffer::IndexType type);
 
+  /// @brief Create a view of the range starting at the byte `offset` of `storage` (see
+  /// `GLBuffer::GLBuffer(GLBuffer*, std::size_t)`)
+  GLIndexBuffer(IndexBuffer::IndexType type, GLIndexBuffer* storage, std::size_t offset);
+
   /// @brief Free all memory
   ~GLIndexBuffer();
 
   /// @brief Bind the buffer
   void bind();
 
+  /// @brief Get the OpenGL buffer
+  GLBuffer* getGLBuffer() noexcept { return &glBuffer_; }
+
   /// @brief Get the `GLenum` of the index type
   GLenum getGLIndexType() const;
 
@@ -34,7 +34,8 @@ namespace render {
 const std::string GLProgram::EmptyString;
 
 GLProgram::GLProgram(const std::set<std::shared_ptr<Shader>>& shaders)
-    : Program(RK_OpenGL), id_(0), allUniformVariablesSet_(false), shaders_(shaders) {}
+    : Program(RK_OpenGL), id_(0), allUniformVariablesSet_(false), supportsInstancing_(false),
+      shaders_(shaders) {}
 
 GLProgram::~GLProgram() { destroyGLProgram(this); }
 
@@ -83,7 +84,13 @@ bool GLProgram::isTextureSampler(const std::string& name) const {
 
 const std::string& GLProgram::getTextureSampler(int textureUnit) const {
   auto it = textureSamplers_.find(textureUnit);
-  return (it != textureSamplers_.end() ? it->second : GLProgram::EmptyString);
+  return (it != textureSamplers_.end() ? UniformNameTable::getGlobal().getName(it->second)
+                                       : GLProgram::EmptyString);
+}
+
+UniformID GLProgram::getTextureSamplerID(int textureUnit) const {
+  auto it = textureSamplers_.find(textureUnit);
+  return (it != textureSamplers_.end() ? it->second : UniformNameTable::InvalidID);
 }
 
 std::string GLProgram::toString() const {
@@ -109,7 +116,9 @@ std::string GLProgram::toString() const {
           ? core::indent(core::toStringRange(textureSamplers_,
                                              [](const auto& pair) {
                                                std::stringstream s;
-                                               s << "name = " << pair.second
+                                               s << "name = "
+                                                 << UniformNameTable::getGlobal().getName(
+                                                        pair.second)
                                                  << ", textureUnit = " << pair.first;
                                                return s.str();
                                              }))
@@ -237,23 +246,22 @@ struct UniformVariableSetter {};
   template <>                                                                                      \
   struct UniformVariableSetter<TYPE> {                                                             \
     template <class DataType = typename ComputeValueType<TYPE>::type>                              \
-    static bool apply(GLProgram* program, const std::string& name, const DataType* data,           \
-                      std::size_t rank) {                                                          \
-      auto it = program->getUniformVariables().find(name);                                         \
-      if(it == program->getUniformVariables().end()) {                                             \
+    static bool apply(GLProgram* program, UniformID id, const DataType* data, std::size_t rank) {  \
+      GLProgram::GLUniformInfo* info = program->getUniformInfo(id);                                \
+      if(!info)                                                                                    \
         return false;                                                                              \
-      }                                                                                            \
-      GLProgram::GLUniformInfo& info = it->second;                                                 \
-      if(!GLTypeCompat<TYPE>::isCompatible(info.Type))                                             \
+      if(!GLTypeCompat<TYPE>::isCompatible(info->Type))                                            \
         SEQUOIA_THROW(RenderSystemException, "failed to set uniform variable '{}' in program "     \
                                              "(ID={}), cannot convert type '{}' to '{}'",          \
-                      name, program->getID(), GLTypeCompat<TYPE>::getTypeName(), info.Type);       \
-      if(info.Rank != rank)                                                                        \
+                      UniformNameTable::getGlobal().getName(id), program->getID(),                 \
+                      GLTypeCompat<TYPE>::getTypeName(), info->Type);                              \
+      if(info->Rank != rank)                                                                       \
         SEQUOIA_THROW(RenderSystemException, "invalid rank (size of array) '{}' of uniform "       \
                                              "variable '{}' in program (ID={}), expected '{}'",    \
-                      1, name, program->getID(), info.Rank);                                       \
-      FUNC(program->getID(), info.Location, info.Rank, data);                                      \
-      info.ValueSet = true;                                                                        \
+                      rank, UniformNameTable::getGlobal().getName(id), program->getID(),           \
+                      info->Rank);                                                                 \
+      FUNC(program->getID(), info->Location, info->Rank, data);                                    \
+      info->ValueSet = true;                                                                       \
       return true;                                                                                 \
     }                                                                                              \
   };
@@ -290,17 +298,17 @@ SEQUOIA_SET_UNIFORM_VARIABLE_IMPL(math::mat4, ([](GLuint p, GLint l, GLsizei c,
 
 } // anonymous namespace
 
-bool GLProgram::setUniformVariable(const std::string& name, const UniformVariable& variable) {
+bool GLProgram::setUniformVariable(UniformID id, const UniformVariable& variable) {
   SEQUOIA_ASSERT_MSG(isValid(), "setting uniform variable of invalid program");
   allUniformVariablesSet_ = false;
 
   switch(variable.getType()) {
 #define UNIFORM_VARIABLE_TYPE(Type, Name)                                                          \
   case UniformType::Name:                                                                          \
-    return UniformVariableSetter<Type>::apply(this, name, addressOf(variable.get<Type>()), 1);     \
+    return UniformVariableSetter<Type>::apply(this, id, addressOf(variable.get<Type>()), 1);       \
   case UniformType::VectorOf##Name: {                                                              \
     VectorWrapper<Type> vec(variable.get<std::vector<Type>>());                                    \
-    return UniformVariableSetter<Type>::apply(this, name + "[0]", vec.data(), vec.size());         \
+    return UniformVariableSetter<Type>::apply(this, id, vec.data(), vec.size());                   \
   }
 #include "sequoia-engine/Render/UniformVariable.inc"
 #undef UNIFORM_VARIABLE_TYPE
@@ -310,6 +318,12 @@ bool GLProgram::setUniformVariable(const std::string& name, const UniformVariabl
   return false;
 }
 
+bool GLProgram::setUniformVariable(const std::string& name, const UniformVariable& variable) {
+  // Variables which are not interned can't be referenced by the program
+  UniformID id = UniformNameTable::getGlobal().lookup(name);
+  return id != UniformNameTable::InvalidID ? setUniformVariable(id, variable) : false;
+}
+
 void destroyGLProgram(GLProgram* program) noexcept {
   if(!program->isValid())
     return;
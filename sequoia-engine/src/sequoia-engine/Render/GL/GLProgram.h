@@ -18,9 +18,11 @@
 
 #include "sequoia-engine/Render/GL/GLFwd.h"
 #include "sequoia-engine/Render/Program.h"
+#include "sequoia-engine/Render/UniformNameTable.h"
 #include "sequoia-engine/Render/UniformVariable.h"
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 namespace sequoia {
 
@@ -65,11 +67,25 @@ public:
   const std::unordered_map<std::string, GLUniformInfo>& getUniformVariables() const;
   std::unordered_map<std::string, GLUniformInfo>& getUniformVariables();
 
-  /// @brief Set the uniform variable `name` to `value`
+  /// @brief Get the uniform variable `id` (`nullptr` if the program does not reference it)
+  ///
+  /// Array variables are identified by their name *without* the `[0]` suffix.
+  GLUniformInfo* getUniformInfo(UniformID id) noexcept {
+    return id < uniformInfoTable_.size() ? uniformInfoTable_[id] : nullptr;
+  }
+
+  /// @brief Set the uniform variable `id` (or `name`) to `value`
   ///
   /// @throws RenderSystemException   Variable `name` has incompatible type
   /// @returns `true` if variable has been successfully set, `false` if variable does not exist
+  /// @{
+  bool setUniformVariable(UniformID id, const UniformVariable& variable);
   bool setUniformVariable(const std::string& name, const UniformVariable& variable);
+  /// @}
+
+  /// @brief Check if the program reads the per-instance model matrix (`in_InstanceMatModel`) and
+  /// can thus be used for instanced rendering
+  bool supportsInstancing() const noexcept { return supportsInstancing_; }
 
   /// @brief Check if all uniform variables have been set
   bool checkUniformVariables(bool output = true);
@@ -81,6 +97,10 @@ public:
   /// sampler is found)
   const std::string& getTextureSampler(int textureUnit) const;
 
+  /// @brief Get the ID of the texture sampler associated with `textureUnit`
+  /// (`UniformNameTable::InvalidID` if no sampler is found)
+  UniformID getTextureSamplerID(int textureUnit) const;
+
   /// @copydoc Program::getShaders
   virtual const std::set<std::shared_ptr<Shader>>& getShaders() const override;
 
@@ -107,12 +127,18 @@ private:
   /// Map of uniform variables referenced in this program
   std::unordered_map<std::string, GLUniformInfo> uniformInfoMap_;
 
+  /// Uniform variables of `uniformInfoMap_` indexed by their `UniformID` (computed at link time)
+  std::vector<GLUniformInfo*> uniformInfoTable_;
+
   /// Set of uniform variables which correspond to texture samplers
-  std::unordered_map<int, std::string> textureSamplers_;
+  std::unordered_map<int, UniformID> textureSamplers_;
 
   /// Cache if all uniform variables have been set
   bool allUniformVariablesSet_;
 
+  /// Does the program read `in_InstanceMatModel`?
+  bool supportsInstancing_;
+
   /// Shaders compiled into the program
   std::set<std::shared_ptr<Shader>> shaders_;
 };
@@ -32,8 +32,32 @@ namespace sequoia {
 
 namespace render {
 
+GLProgramManager::GLProgramManager(std::unique_ptr<ProgramBinaryCache> binaryCache)
+    : binaryCache_(std::move(binaryCache)) {
+  int maxUniformBlockBindings = 0;
+  glGetIntegerv(GL_MAX_UNIFORM_BUFFER_BINDINGS, &maxUniformBlockBindings);
+  maxUniformBlockBindings_ = static_cast<unsigned int>(maxUniformBlockBindings);
+}
+
 GLProgramManager::~GLProgramManager() {}
 
+/// @brief Throw a RenderSystemException with the info log of `program` if `statusParam` is not set
+static void checkStatus(GLProgram* program, GLenum statusParam, const char* action) {
+  GLint status = 0;
+  glGetProgramiv(program->getID(), statusParam, &status);
+  if(!status) {
+    GLint infoLogLength = 0;
+    glGetProgramiv(program->getID(), GL_INFO_LOG_LENGTH, &infoLogLength);
+
+    std::vector<char> infoLog(infoLogLength + 1);
+    glGetProgramInfoLog(program->getID(), infoLogLength, NULL, &infoLog[0]);
+    std::string reason(infoLog.data(), infoLog.size());
+
+    SEQUOIA_THROW(RenderSystemException, "failed to {} program (ID={}):\n{}", action,
+                  program->getID(), reason);
+  }
+}
+
 void GLProgramManager::makeValid(GLProgram* program) {
   SEQUOIA_ASSERT_MSG(!program->isValid(), "program already initialized");
 
@@ -44,6 +68,41 @@ void GLProgramManager::makeValid(GLProgram* program) {
 
   Log::debug("Created program (ID={})", program->id_);
 
+  // Try the cached binary first and fall back to linking (which replaces an invalid entry)
+  std::uint64_t key = 0;
+  bool loaded = false;
+  if(binaryCache_) {
+    key = binaryCache_->makeKey(program->getShaders());
+    loaded = loadBinary(program, key);
+  }
+
+  if(!loaded) {
+    link(program);
+    if(binaryCache_)
+      storeBinary(program, key);
+  }
+
+  // Validate program
+  glValidateProgram(program->id_);
+  checkStatus(program, GL_VALIDATE_STATUS, "validate");
+
+  // Get the uniform variables (the uniform block bindings are not part of the binary)
+  getUniforms(program);
+  setUniformBlockBindings(program);
+
+  // Check all vertex attributes and fragment data
+  SEQUOIA_ASSERT(checkVertexAttributes(program));
+  SEQUOIA_ASSERT(checkFragmentData(program));
+
+  // Programs reading the per-instance matrix are rendered instanced
+  program->supportsInstancing_ =
+      glGetAttribLocation(program->id_,
+                          GLVertexAttribute::name(GLVertexAttribute::InstanceMatModel)) != -1;
+
+  Log::debug("Successfully {} program (ID={})", loaded ? "loaded" : "linked", program->id_);
+}
+
+void GLProgramManager::link(GLProgram* program) const {
   Log::debug("Linking program (ID={}) ...", program->id_);
 
   for(const std::shared_ptr<Shader>& shader : program->getShaders()) {
@@ -60,43 +119,63 @@ void GLProgramManager::makeValid(GLProgram* program) {
   setVertexAttributes(program);
   setFragmentData(program);
 
-  auto checkStatus = [&program](GLenum statusParam, const char* action) {
-    GLint status = 0;
-    glGetProgramiv(program->id_, statusParam, &status);
-    if(!status) {
-      GLint infoLogLength = 0;
-      glGetProgramiv(program->id_, GL_INFO_LOG_LENGTH, &infoLogLength);
-
-      std::vector<char> infoLog(infoLogLength + 1);
-      glGetProgramInfoLog(program->id_, infoLogLength, NULL, &infoLog[0]);
-      std::string reason(infoLog.data(), infoLog.size());
-
-      SEQUOIA_THROW(RenderSystemException, "failed to {} program (ID={}):\n{}", action,
-                    program->id_, reason);
-    }
-  };
+  // Allow to retrieve the binary after linking
+  if(binaryCache_)
+    glProgramParameteri(program->id_, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
 
   // Link the program
   glLinkProgram(program->id_);
-  checkStatus(GL_LINK_STATUS, "link");
-
-  // Validate program
-  glValidateProgram(program->id_);
-  checkStatus(GL_VALIDATE_STATUS, "validate");
+  checkStatus(program, GL_LINK_STATUS, "link");
 
   for(const auto& shader : program->getShaders()) {
     GLShader* glshader = core::dyn_cast<GLShader>(shader.get());
     glDetachShader(program->id_, glshader->getID());
   }
+}
 
-  // Get the uniform variables
-  getUniforms(program);
+bool GLProgramManager::loadBinary(GLProgram* program, std::uint64_t key) const {
+  ProgramBinaryCache::ProgramBinary binary;
+  if(!binaryCache_->load(key, binary))
+    return false;
 
-  // Check all vertex attributes and fragment data
-  SEQUOIA_ASSERT(checkVertexAttributes(program));
-  SEQUOIA_ASSERT(checkFragmentData(program));
+  Log::debug("Loading program (ID={}) from binary \"{}\" ...", program->id_,
+             ProgramBinaryCache::getPath(key));
+
+  glProgramBinary(program->id_, static_cast<GLenum>(binary.Format), binary.Data.data(),
+                  binary.Data.size());
+
+  // The driver may reject binaries (e.g after an update which did not change the version string)
+  GLint status = 0;
+  glGetProgramiv(program->id_, GL_LINK_STATUS, &status);
+  if(!status) {
+    Log::warn("Cached binary \"{}\" was rejected by the driver, relinking program (ID={})",
+              ProgramBinaryCache::getPath(key), program->id_);
+    return false;
+  }
+  return true;
+}
+
+void GLProgramManager::storeBinary(GLProgram* program, std::uint64_t key) const {
+  GLint numBytes = 0;
+  glGetProgramiv(program->id_, GL_PROGRAM_BINARY_LENGTH, &numBytes);
+  if(numBytes <= 0)
+    return;
 
-  Log::debug("Successfully linked program (ID={})", program->id_);
+  ProgramBinaryCache::ProgramBinary binary;
+  binary.Data.resize(numBytes);
+
+  GLenum format;
+  GLsizei length = 0;
+  glGetProgramBinary(program->id_, numBytes, &length, &format, binary.Data.data());
+  if(length <= 0)
+    return;
+
+  binary.Data.resize(length);
+  binary.Format = static_cast<std::uint32_t>(format);
+
+  if(binaryCache_->store(key, binary))
+    Log::debug("Stored binary of program (ID={}) in \"{}\"", program->id_,
+               ProgramBinaryCache::getPath(key));
 }
 
 std::shared_ptr<GLProgram>
@@ -134,6 +213,7 @@ void GLProgramManager::getUniforms(GLProgram* program) const {
   Log::debug("Getting uniform variables of program (ID={}) ...", program->id_);
 
   program->uniformInfoMap_.clear();
+  program->uniformInfoTable_.clear();
   program->textureSamplers_.clear();
   program->allUniformVariablesSet_ = false;
 
@@ -174,15 +254,24 @@ void GLProgramManager::getUniforms(GLProgram* program) const {
                (textureUnit != -1 ? core::format(", textureUnit={}", textureUnit) : ""), location);
 
     if(location != -1) {
-      program->uniformInfoMap_.emplace(
-          name.get(), GLProgram::GLUniformInfo{type, rank, location, false, textureUnit});
+      GLProgram::GLUniformInfo info{type, rank, location, false, textureUnit};
+      auto infoIt = program->uniformInfoMap_.emplace(name.get(), info).first;
+
+      // Intern the name (array variables are reported as `name[0]` and are referred to by `name`)
+      UniformID id = UniformNameTable::getGlobal().intern(
+          nameRef.endswith("[0]") ? nameRef.drop_back(3).str() : nameRef.str());
+
+      if(id >= program->uniformInfoTable_.size())
+        program->uniformInfoTable_.resize(id + 1, nullptr);
+      program->uniformInfoTable_[id] = &infoIt->second;
 
       if(textureUnit != -1) {
-        auto ret = program->textureSamplers_.emplace(textureUnit, name.get());
+        auto ret = program->textureSamplers_.emplace(textureUnit, id);
         if(!ret.second)
           Log::warn("Texture sampler \"{}\" mapped to already existing texture unit '{}' which is "
                     "mapped to \"{}\"",
-                    name.get(), textureUnit, ret.first->second);
+                    name.get(), textureUnit,
+                    UniformNameTable::getGlobal().getName(ret.first->second));
       }
     }
   }
@@ -190,6 +279,41 @@ void GLProgramManager::getUniforms(GLProgram* program) const {
   Log::debug("Successfully got uniform variables of program (ID={})", program->id_);
 }
 
+unsigned int GLProgramManager::getUniformBlockBinding(const std::string& name) {
+  SEQUOIA_LOCK_GUARD(mutex_);
+  auto it = uniformBlockBindings_.find(name);
+  if(it != uniformBlockBindings_.end())
+    return it->second;
+
+  if(uniformBlockBindings_.size() >= maxUniformBlockBindings_)
+    SEQUOIA_THROW(RenderSystemException, "uniform block '{}' exceeds the {} binding points", name,
+                  maxUniformBlockBindings_);
+
+  unsigned int binding = static_cast<unsigned int>(uniformBlockBindings_.size());
+  uniformBlockBindings_.emplace(name, binding);
+  return binding;
+}
+
+void GLProgramManager::setUniformBlockBindings(GLProgram* program) {
+  int numActiveUniformBlocks = 0;
+  glGetProgramiv(program->id_, GL_ACTIVE_UNIFORM_BLOCKS, &numActiveUniformBlocks);
+  if(numActiveUniformBlocks == 0)
+    return;
+
+  int activeUniformBlockMaxLength = 0;
+  glGetProgramiv(program->id_, GL_ACTIVE_UNIFORM_BLOCK_MAX_NAME_LENGTH,
+                 &activeUniformBlockMaxLength);
+  auto name = std::make_unique<char[]>(activeUniformBlockMaxLength);
+
+  for(int index = 0; index < numActiveUniformBlocks; ++index) {
+    glGetActiveUniformBlockName(program->id_, index, activeUniformBlockMaxLength, nullptr,
+                                name.get());
+    unsigned int binding = getUniformBlockBinding(name.get());
+    glUniformBlockBinding(program->id_, index, binding);
+    Log::debug("Active uniform block: name={}, binding={}", name.get(), binding);
+  }
+}
+
 void GLProgramManager::setVertexAttributes(GLProgram* program) const {
   Log::debug("Setting vertex attributes of program (ID={}) ...", program->id_);
 
@@ -20,6 +20,7 @@
 #include "sequoia-engine/Core/Mutex.h"
 #include "sequoia-engine/Core/NonCopyable.h"
 #include "sequoia-engine/Render/GL/GLProgram.h"
+#include "sequoia-engine/Render/ProgramBinaryCache.h"
 #include <memory>
 #include <unordered_map>
 #include <vector>
@@ -40,7 +41,22 @@ class SEQUOIA_API GLProgramManager : public NonCopyable {
   /// Lookup map for programs (hash of the shader set to index in programList)
   std::unordered_map<std::size_t, std::size_t> shaderSetLookupMap_;
 
+  /// Binding points of the uniform blocks (shared by all programs)
+  std::unordered_map<std::string, unsigned int> uniformBlockBindings_;
+
+  /// Number of available binding points (`GL_MAX_UNIFORM_BUFFER_BINDINGS`)
+  unsigned int maxUniformBlockBindings_;
+
+  /// On-disk cache of the linked program binaries (may be `nullptr`)
+  std::unique_ptr<ProgramBinaryCache> binaryCache_;
+
 public:
+  /// @brief Initialize the manager
+  ///
+  /// @param binaryCache   Cache of the program binaries used to skip linking of programs which
+  ///                      were linked in a previous run (pass `nullptr` to disable caching)
+  GLProgramManager(std::unique_ptr<ProgramBinaryCache> binaryCache = nullptr);
+
   /// @brief Destroy all remaining programs
   ~GLProgramManager();
 
@@ -56,19 +72,49 @@ public:
   std::shared_ptr<GLProgram> create(const std::set<std::shared_ptr<Shader>>& shaders);
 
   /// @brief Make the program valid
+  ///
+  /// If a binary cache is available, the program is loaded from the cached binary and only linked
+  /// if there is no (or no compatible) binary, in which case the new binary is stored in the
+  /// cache.
+  ///
   /// @throws RenderSystemExcption  Failed to initialize the program
   void makeValid(GLProgram* program);
 
   /// @brief Remove the `program` (do nothing if the program does not exist)
   void remove(const std::shared_ptr<GLProgram>& program) noexcept;
 
+  /// @brief Get the binding point of the uniform block `name`
+  ///
+  /// Each uniform block name is assigned a unique binding point which is used by all programs,
+  /// hence a bound uniform block stays valid across program changes.
+  ///
+  /// @throws RenderSystemException   All binding points are assigned to other uniform blocks
+  /// @remark Thread-safe
+  unsigned int getUniformBlockBinding(const std::string& name);
+
+  /// @brief Get the cache of the program binaries (may be `nullptr`)
+  ProgramBinaryCache* getBinaryCache() const noexcept { return binaryCache_.get(); }
+
   /// @brief Compute hash of the set of shaders
   static std::size_t hash(const std::set<std::shared_ptr<Shader>>& shaders) noexcept;
 
 private:
+  /// @brief Link the program from its shaders
+  void link(GLProgram* program) const;
+
+  /// @brief Try to load the program from the binary cache
+  /// @returns `true` if the driver accepted the cached binary
+  bool loadBinary(GLProgram* program, std::uint64_t key) const;
+
+  /// @brief Store the binary of the linked program in the binary cache
+  void storeBinary(GLProgram* program, std::uint64_t key) const;
+
   /// @brief Query the uniform variables of the program
   void getUniforms(GLProgram* program) const;
 
+  /// @brief Assign the binding points of the uniform blocks of the program
+  void setUniformBlockBindings(GLProgram* program);
+
   /// @brief Set the `location` of all the known vertex attributes (called pre-link)
   void setVertexAttributes(GLProgram* program) const;
 
@@ -26,7 +26,9 @@
 #include "sequoia-engine/Render/GL/GLShaderManager.h"
 #include "sequoia-engine/Render/GL/GLTextureManager.h"
 #include "sequoia-engine/Render/GL/GLVertexData.h"
+#include "sequoia-engine/Render/GL/GLVertexDataArena.h"
 #include "sequoia-engine/Render/GL/Native.h"
+#include <algorithm>
 
 namespace sequoia {
 
@@ -88,6 +90,7 @@ RenderWindow* GLRenderSystem::createMainWindow(const RenderWindow::WindowHint& h
 
   // Initialize OpenGL renderer
   renderer_ = std::make_unique<GLRenderer>(mainWindow_.get(), getOptions());
+  addListener<FrameListener>(renderer_.get());
 
   return mainWindow_.get();
 }
@@ -101,7 +104,17 @@ GLRenderWindow* GLRenderSystem::getMainGLWindow() const {
 
 void GLRenderSystem::destroyMainWindow() noexcept {
   // Order matters here!
+  {
+    SEQUOIA_LOCK_GUARD(vertexDataArenasMutex_);
+    for(const auto& layoutArenasPair : vertexDataArenas_)
+      for(const auto& arena : layoutArenasPair.second)
+        SEQUOIA_ASSERT_MSG(arena.use_count() == 1,
+                           "VertexData allocated from an arena outlive the main-window");
+    vertexDataArenas_.clear();
+  }
+
   if(renderer_) {
+    removeListener<FrameListener>(renderer_.get());
     renderer_.reset();
     renderer_ = nullptr;
   }
@@ -145,7 +158,42 @@ std::shared_ptr<Texture> GLRenderSystem::createTexture(const std::shared_ptr<Ima
 }
 
 std::shared_ptr<VertexData> GLRenderSystem::createVertexData(const VertexDataParameter& param) {
-  return std::make_shared<GLVertexData>(param);
+  const std::size_t maxNumVertices = getOptions().getInt("Render.VertexDataArenaNumVertices");
+  const std::size_t maxNumIndices = getOptions().getInt("Render.VertexDataArenaNumIndices");
+
+  if(!getOptions().getBool("Render.VertexDataArenas") || !GLVertexDataArena::isSuitable(param) ||
+     param.NumVertices > maxNumVertices || param.NumIndices > maxNumIndices)
+    return std::make_shared<GLVertexData>(param);
+
+  SEQUOIA_LOCK_GUARD(vertexDataArenasMutex_);
+
+  auto& arenas = vertexDataArenas_[(param.Layout.ID << 8) | param.IndexType];
+  for(const auto& arena : arenas)
+    if(std::shared_ptr<GLVertexData> data = arena->allocate(param))
+      return data;
+
+  // Each new arena of the layout doubles the capacity of the previous one (up to the maximum) such
+  // that layouts with few meshes don't reserve the full size
+  std::size_t numVertices = std::max<std::size_t>(
+      1, getOptions().getInt("Render.VertexDataArenaInitialNumVertices"));
+  std::size_t numIndices =
+      std::max<std::size_t>(1, getOptions().getInt("Render.VertexDataArenaInitialNumIndices"));
+  if(!arenas.empty()) {
+    numVertices = 2 * arenas.back()->getVertexAllocator().getCapacity();
+    numIndices = 2 * arenas.back()->getIndexAllocator().getCapacity();
+  }
+  while(numVertices < param.NumVertices || numIndices < param.NumIndices) {
+    numVertices *= 2;
+    numIndices *= 2;
+  }
+  numVertices = std::min(numVertices, maxNumVertices);
+  numIndices = std::min(numIndices, maxNumIndices);
+
+  arenas.emplace_back(
+      std::make_shared<GLVertexDataArena>(param.Layout, param.IndexType, numVertices, numIndices));
+  Log::debug("Allocated arena #{} of vertex layout {} ({} vertices, {} indices)", arenas.size(),
+             param.Layout.getName(), numVertices, numIndices);
+  return arenas.back()->allocate(param);
 }
 
 void GLRenderSystem::addKeyboardListener(KeyboardListener* listener) {
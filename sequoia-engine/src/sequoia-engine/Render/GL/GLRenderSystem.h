@@ -16,7 +16,9 @@
 #ifndef SEQUOIA_ENGINE_RENDER_GL_GLRENDERSYSTEM_H
 #define SEQUOIA_ENGINE_RENDER_GL_GLRENDERSYSTEM_H
 
+#include "sequoia-engine/Core/Mutex.h"
 #include "sequoia-engine/Render/RenderSystem.h"
+#include <cstdint>
 #include <memory>
 #include <unordered_map>
 #include <vector>
@@ -28,6 +30,7 @@ namespace render {
 class GLRenderer;
 class GLRenderWindow;
 class GLStateCacheManager;
+class GLVertexDataArena;
 class NativeGLContext;
 
 /// @brief OpenGL render-system
@@ -43,6 +46,13 @@ class SEQUOIA_API GLRenderSystem final : public RenderSystem {
   /// OpenGL renderer
   std::unique_ptr<GLRenderer> renderer_;
 
+  /// Arenas of the VertexData (indexed by the ID of the vertex layout and the index type)
+  std::unordered_map<std::uint16_t, std::vector<std::shared_ptr<GLVertexDataArena>>>
+      vertexDataArenas_;
+
+  /// Protect the arenas (VertexData are created concurrently by the ShapeManager)
+  Mutex vertexDataArenasMutex_;
+
 public:
   GLRenderSystem(const std::shared_ptr<Options>& options);
 
@@ -77,7 +87,15 @@ public:
   createTexture(const std::shared_ptr<Image>& image,
                 const TextureParameter& param = TextureParameter()) override;
 
-  /// @copydoc RenderSystem::createVertexData
+  /// @brief Create the VertexData of `param`
+  ///
+  /// If enabled (`Render.VertexDataArenas`), VertexData of static meshes are sub-allocated from an
+  /// arena of their vertex layout (see `GLVertexDataArena`). A new arena is created once all arenas
+  /// of the layout are full. The first arena of a layout has the initial size
+  /// (`Render.VertexDataArenaInitial{NumVertices,NumIndices}`) and each further arena doubles the
+  /// size of the previous one up to `Render.VertexDataArena{NumVertices,NumIndices}`.
+  ///
+  /// @remark Thread-safe
   virtual std::shared_ptr<VertexData> createVertexData(const VertexDataParameter& param) override;
 
   /// @copydoc RenderSystem::addKeyboardListener
@@ -16,6 +16,8 @@
 #include "sequoia-engine/Core/Casting.h"
 #include "sequoia-engine/Core/Logging.h"
 #include "sequoia-engine/Core/Options.h"
+#include "sequoia-engine/Core/Platform.h"
+#include "sequoia-engine/Core/RealFileSystem.h"
 #include "sequoia-engine/Core/StringUtil.h"
 #include "sequoia-engine/Math/CoordinateSystem.h"
 #include "sequoia-engine/Render/Camera.h"
@@ -30,6 +32,7 @@
 #include "sequoia-engine/Render/GL/GLTextureManager.h"
 #include "sequoia-engine/Render/GL/GLVertexData.h"
 #include "sequoia-engine/Render/GL/Native.h"
+#include "sequoia-engine/Render/ProgramBinaryCache.h"
 #include "sequoia-engine/Render/RenderSystem.h"
 #include <glbinding/Binding.h>
 #include <glbinding/ContextInfo.h>
@@ -100,6 +103,38 @@ static void setCapability(bool enable, GLenum cap) noexcept {
     glDisable(cap);
 }
 
+/// @brief Create the on-disk cache of the program binaries (`nullptr` if the cache is disabled or
+/// the driver does not support program binaries)
+static std::unique_ptr<ProgramBinaryCache> makeProgramBinaryCache(const Options& options) {
+  const std::string dir = options.getString("Render.GL.ProgramCacheDir");
+  if(!options.getBool("Render.GL.ProgramCache") || dir.empty())
+    return nullptr;
+
+  GLint numFormats = 0;
+  glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &numFormats);
+  if(numFormats == 0) {
+    Log::info("Program binaries are not supported by the driver, disabling program cache");
+    return nullptr;
+  }
+
+  try {
+    platform::filesystem::create_directories(platform::asPath(dir));
+  } catch(std::exception& e) {
+    Log::warn("Failed to create program cache directory \"{}\": {}", dir, e.what());
+    return nullptr;
+  }
+
+  // Binaries are only guaranteed to be compatible with the exact same driver
+  std::string driver =
+      core::format("{}; {}; {}", glbinding::ContextInfo::vendor(),
+                   glbinding::ContextInfo::renderer(),
+                   reinterpret_cast<const char*>(glGetString(GL_VERSION)));
+
+  Log::info("Using program cache \"{}\"", dir);
+  return std::make_unique<ProgramBinaryCache>(std::make_shared<core::RealFileSystem>(dir),
+                                              driver);
+}
+
 } // anonymous namespace
 
 bool GLRenderer::DepthTestChanged(bool DepthTest) {
@@ -176,8 +211,9 @@ bool GLRenderer::TextureChanged(int textureUnit, Texture* texture, bool enable)
     Program* program = pipeline_.Program;
     if(program) {
       GLProgram* glprogram = core::dyn_cast<GLProgram>(program);
-      const std::string& name = glprogram->getTextureSampler(textureUnit);
-      setUniformVariable(glprogram, name, UniformVariable(textureUnit));
+      UniformID id = glprogram->getTextureSamplerID(textureUnit);
+      if(id != UniformNameTable::InvalidID)
+        setUniformVariable(glprogram, id, UniformVariable(textureUnit));
     }
   } else {
     core::dyn_cast<GLTexture>(texture)->unbind();
@@ -186,7 +222,7 @@ bool GLRenderer::TextureChanged(int textureUnit, Texture* texture, bool enable)
   return true;
 }
 
-bool GLRenderer::UniformVariableChanged(Program* program, const std::string& name,
+bool GLRenderer::UniformVariableChanged(Program* program, UniformID id,
                                         const UniformVariable& value) {
   SEQUOIA_ASSERT(program);
 
@@ -194,7 +230,7 @@ bool GLRenderer::UniformVariableChanged(Program* program, const std::string& nam
     return false;
 
   GLProgram* glprogram = core::dyn_cast<GLProgram>(program);
-  glprogram->setUniformVariable(name, value);
+  glprogram->setUniformVariable(id, value);
   return true;
 }
 
@@ -237,6 +273,58 @@ bool GLRenderer::draw(const DrawCommand& drawCommand) {
   return true;
 }
 
+bool GLRenderer::bindUniformBlock(const std::string& name, const std::vector<Byte>& data) {
+  // Write the block once and bind its range to the binding point shared by all programs
+  RingBuffer::Allocation allocation =
+      uniformBuffer_->write(data.data(), data.size(), uniformBufferOffsetAlignment_);
+  glBindBufferRange(GL_UNIFORM_BUFFER, programManager_->getUniformBlockBinding(name),
+                    uniformBuffer_->getID(), allocation.Offset, allocation.NumBytes);
+  return true;
+}
+
+bool GLRenderer::supportsInstancing(Program* program) const {
+  return core::dyn_cast<GLProgram>(program)->supportsInstancing();
+}
+
+bool GLRenderer::drawInstanced(const DrawCommand& drawCommand, ArrayRef<math::mat4> matModels) {
+  SEQUOIA_ASSERT(drawCommand.getVertexData() == vertexData_);
+
+  // Check all uniform variables are set
+  if(debugMode_)
+    core::dyn_cast<GLProgram>(pipeline_.Program)->checkUniformVariables();
+
+  // Stream the per-instance matrices into the ring buffer (aligned to whole matrices, such that the
+  // offset maps to the base instance)
+  RingBuffer::Allocation allocation = instanceBuffer_->write(
+      matModels.data(), matModels.size() * sizeof(math::mat4), sizeof(math::mat4));
+
+  // Draw the instances of the vertex-data
+  core::dyn_cast<GLVertexData>(vertexData_)
+      ->drawInstanced(allocation.Offset / sizeof(math::mat4), matModels.size());
+  return true;
+}
+
+bool GLRenderer::supportsMultiDrawIndirect() const { return true; }
+
+bool GLRenderer::drawIndirect(const DrawCommand& drawCommand,
+                              ArrayRef<DrawIndirectCommand> commands,
+                              ArrayRef<math::mat4> matModels) {
+  SEQUOIA_ASSERT(drawCommand.getVertexData() == vertexData_);
+
+  // Check all uniform variables are set
+  if(debugMode_)
+    core::dyn_cast<GLProgram>(pipeline_.Program)->checkUniformVariables();
+
+  // Stream the per-instance matrices of all commands into the ring buffer
+  RingBuffer::Allocation allocation = instanceBuffer_->write(
+      matModels.data(), matModels.size() * sizeof(math::mat4), sizeof(math::mat4));
+
+  // Draw from the buffers of the storage (all VertexData of the commands share its VAO)
+  core::dyn_cast<GLVertexData>(vertexData_)
+      ->drawIndirect(allocation.Offset / sizeof(math::mat4), indirectBuffer_.get(), commands);
+  return true;
+}
+
 std::pair<std::string, std::string> GLRenderer::toStringImpl() const {
   return std::make_pair("GLRenderer", core::format("{}"
                                                    "activeTextureUnit = {},\n"
@@ -287,10 +375,21 @@ GLRenderer::GLRenderer(GLRenderWindow* window, Options& options)
 
   // Initialize OpenGL related managers
   shaderManager_ = std::make_unique<GLShaderManager>();
-  programManager_ = std::make_unique<GLProgramManager>();
-  textureManager_ = std::make_unique<GLTextureManager>();
+  programManager_ = std::make_unique<GLProgramManager>(
+      makeProgramBinaryCache(getGLRenderSystem().getOptions()));
+  textureManager_ = std::make_unique<GLTextureManager>(
+      getGLRenderSystem().getOptions().getInt("Render.TextureStreamingBudget"));
   extensionManager_ = std::make_unique<GLExtensionManager>();
 
+  // Allocate the ring buffers of the per-instance matrices, the multi-draws, the uniform blocks
+  // and the staged updates of dynamic buffers
+  const int streamBufferSize = getGLRenderSystem().getOptions().getInt("Render.StreamBufferSize");
+  instanceBuffer_ = std::make_unique<GLRingBuffer>(GL_ARRAY_BUFFER, streamBufferSize);
+  indirectBuffer_ = std::make_unique<GLRingBuffer>(GL_DRAW_INDIRECT_BUFFER, streamBufferSize);
+  uniformBuffer_ = std::make_unique<GLRingBuffer>(GL_UNIFORM_BUFFER, streamBufferSize);
+  uniformBufferOffsetAlignment_ = get<int>(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT);
+  uploadBuffer_ = std::make_unique<GLRingBuffer>(GL_COPY_READ_BUFFER, streamBufferSize);
+
   // Query the default pixel format
   auto getAndSetPixelFormat = [this](GLenum param) {
     int value = get<int>(param);
@@ -317,6 +416,10 @@ GLRenderer::~GLRenderer() {
 
   window_->getContext()->makeCurrent();
 
+  instanceBuffer_.reset();
+  indirectBuffer_.reset();
+  uniformBuffer_.reset();
+  uploadBuffer_.reset();
   programManager_.reset();
   shaderManager_.reset();
   textureManager_.reset();
@@ -325,6 +428,17 @@ GLRenderer::~GLRenderer() {
   Log::info("Done terminating OpenGL renderer {} ... ", core::ptrToStr(this));
 }
 
+void GLRenderer::frameListenerRenderingBegin(const RenderCommand& command) {
+  textureManager_->update();
+}
+
+void GLRenderer::frameListenerRenderingEnd(const RenderCommand& command) {
+  instanceBuffer_->endFrame();
+  indirectBuffer_->endFrame();
+  uniformBuffer_->endFrame();
+  uploadBuffer_->endFrame();
+}
+
 GLShaderManager* GLRenderer::getShaderManager() { return shaderManager_.get(); }
 
 GLProgramManager* GLRenderer::getProgramManager() { return programManager_.get(); }
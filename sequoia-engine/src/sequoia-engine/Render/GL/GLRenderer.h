@@ -19,9 +19,10 @@
 #include "sequoia-engine/Core/Export.h"
 #include "sequoia-engine/Core/NonCopyable.h"
 #include "sequoia-engine/Core/Options.h"
-#include "sequoia-engine/Render/GL/GLBuffer.h"
+#include "sequoia-engine/Render/FrameListener.h"
 #include "sequoia-engine/Render/GL/GLFwd.h"
 #include "sequoia-engine/Render/GL/GLPixelFormat.h"
+#include "sequoia-engine/Render/GL/GLRingBuffer.h"
 #include "sequoia-engine/Render/RenderFwd.h"
 #include "sequoia-engine/Render/Renderer.h"
 #include "sequoia-engine/Render/Viewport.h"
@@ -41,7 +42,10 @@ namespace render {
 /// (direct-state-access) outside of the Renderer.
 ///
 /// @ingroup gl
-class SEQUOIA_API GLRenderer final : public Renderer, public ViewportListener, public NonCopyable {
+class SEQUOIA_API GLRenderer final : public Renderer,
+                                      public ViewportListener,
+                                      public FrameListener,
+                                      public NonCopyable {
   /// Reference to the main-window
   GLRenderWindow* window_;
 
@@ -61,6 +65,19 @@ class SEQUOIA_API GLRenderer final : public Renderer, public ViewportListener, p
   /// Default pixel format
   GLPixelFormat defaultPixelFormat_;
 
+  /// Persistently mapped buffer streaming the per-instance model-view-projection matrices
+  std::unique_ptr<GLRingBuffer> instanceBuffer_;
+
+  /// Persistently mapped buffer streaming the commands of the multi-draws
+  std::unique_ptr<GLRingBuffer> indirectBuffer_;
+
+  /// Persistently mapped buffer streaming the uniform blocks (and the required offset alignment)
+  std::unique_ptr<GLRingBuffer> uniformBuffer_;
+  int uniformBufferOffsetAlignment_;
+
+  /// Persistently mapped buffer staging the updates of dynamic buffers (see `GLBuffer::lock`)
+  std::unique_ptr<GLRingBuffer> uploadBuffer_;
+
 public:
   /// @brief Initialize the OpenGL context and bind it to the calling thread
   ///
@@ -82,6 +99,12 @@ public:
   /// @brief Get the texture manager
   GLTextureManager* getTextureManager();
 
+  /// @brief Get the ring buffer of the per-instance model matrices
+  GLRingBuffer* getInstanceBuffer() noexcept { return instanceBuffer_.get(); }
+
+  /// @brief Get the ring buffer staging the updates of dynamic buffers
+  GLRingBuffer* getUploadBuffer() noexcept { return uploadBuffer_.get(); }
+
   /// @brief Return the value of `param` of type `T`
   ///
   /// Type conversion is performed if `param` has a different type than the state variable value
@@ -145,7 +168,7 @@ protected:
   virtual bool TextureChanged(int textureUnit, Texture* texture, bool enable) override;
 
   /// @copydoc Renderer::UniformVariableChanged
-  virtual bool UniformVariableChanged(Program* program, const std::string& name,
+  virtual bool UniformVariableChanged(Program* program, UniformID id,
                                       const UniformVariable& value) override;
 
   /// @copydoc Renderer::ViewportChanged
@@ -155,11 +178,34 @@ protected:
   virtual bool
   clearRenderBuffers(const std::set<RenderBuffer::RenderBufferKind>& buffersToClear) override;
 
+  /// @copydoc Renderer::bindUniformBlock
+  virtual bool bindUniformBlock(const std::string& name, const std::vector<Byte>& data) override;
+
   /// @copydoc Renderer::draw
   virtual bool draw(const DrawCommand& drawCommand) override;
 
+  /// @copydoc Renderer::supportsInstancing
+  virtual bool supportsInstancing(Program* program) const override;
+
+  /// @copydoc Renderer::drawInstanced
+  virtual bool drawInstanced(const DrawCommand& drawCommand,
+                             ArrayRef<math::mat4> matModels) override;
+
+  /// @copydoc Renderer::supportsMultiDrawIndirect
+  virtual bool supportsMultiDrawIndirect() const override;
+
+  /// @copydoc Renderer::drawIndirect
+  virtual bool drawIndirect(const DrawCommand& drawCommand, ArrayRef<DrawIndirectCommand> commands,
+                            ArrayRef<math::mat4> matModels) override;
+
   /// @copydoc Renderer::toStringImpl
   std::pair<std::string, std::string> toStringImpl() const override;
+
+  /// @brief Nothing to do at the beginning of a frame
+  virtual void frameListenerRenderingBegin(const RenderCommand& command) override;
+
+  /// @brief Guard the streamed data of the frame by fences
+  virtual void frameListenerRenderingEnd(const RenderCommand& command) override;
 };
 
 // TODO: this doesn't play nicely with multiple contexts
@@ -0,0 +1,78 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                         _____                        _
+//                        / ____|                      (_)
+//                       | (___   ___  __ _ _   _  ___  _  __ _
+//                        \___ \ / _ \/ _` | | | |/ _ \| |/ _` |
+//                        ____) |  __/ (_| | |_| | (_) | | (_| |
+//                       |_____/ \___|\__, |\__,_|\___/|_|\__,_| - Game Engine (2016-2017)
+//                                       | |
+//                                       |_|
+//
+// This file is distributed under the MIT License (MIT).
+// See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#include "sequoia-engine/Core/Assert.h"
+#include "sequoia-engine/Render/GL/GLRingBuffer.h"
+
+namespace sequoia {
+
+namespace render {
+
+GLRingBuffer::GLRingBuffer(GLenum target, std::size_t numBytes, std::size_t maxFramesInFlight)
+    : RingBuffer(numBytes, maxFramesInFlight), id_(0), target_(target),
+      fences_(maxFramesInFlight, nullptr) {
+  glCreateBuffers(1, &id_);
+
+  const BufferStorageMask flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+  glNamedBufferStorage(id_, numBytes, nullptr, flags);
+  setData(glMapNamedBufferRange(id_, 0, numBytes,
+                                GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT));
+}
+
+GLRingBuffer::~GLRingBuffer() {
+  for(GLsync& fence : fences_)
+    if(fence)
+      glDeleteSync(fence);
+
+  glUnmapNamedBuffer(id_);
+  glDeleteBuffers(1, &id_);
+}
+
+void GLRingBuffer::bind() { glBindBuffer(target_, id_); }
+
+void GLRingBuffer::unbind() { glBindBuffer(target_, 0); }
+
+void GLRingBuffer::insertFence(std::uint64_t frame) {
+  GLsync& fence = fences_[frame % fences_.size()];
+  SEQUOIA_ASSERT_MSG(!fence, "fence of the frame is still pending");
+  fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, UnusedMask::GL_NONE_BIT);
+}
+
+bool GLRingBuffer::waitFence(std::uint64_t frame, bool block) {
+  GLsync& fence = fences_[frame % fences_.size()];
+  if(!fence)
+    return true;
+
+  GLenum status = glClientWaitSync(fence, SyncObjectMask::GL_NONE_BIT, 0);
+  if(block) {
+    // Flush the fence on the first wait and poll in intervals of 1ms
+    SyncObjectMask flags = GL_SYNC_FLUSH_COMMANDS_BIT;
+    while(status == GL_TIMEOUT_EXPIRED) {
+      status = glClientWaitSync(fence, flags, 1000000);
+      flags = SyncObjectMask::GL_NONE_BIT;
+    }
+  }
+
+  if(status == GL_TIMEOUT_EXPIRED)
+    return false;
+
+  glDeleteSync(fence);
+  fence = nullptr;
+  return true;
+}
+
+} // namespace render
+
+} // namespace sequoia
@@ -0,0 +1,77 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                         _____                        _
+//                        / ____|                      (_)
+//                       | (___   ___  __ _ _   _  ___  _  __ _
+//                        \___ \ / _ \/ _` | | | |/ _ \| |/ _` |
+//                        ____) |  __/ (_| | |_| | (_) | | (_| |
+//                       |_____/ \___|\__, |\__,_|\___/|_|\__,_| - Game Engine (2016-2017)
+//                                       | |
+//                                       |_|
+//
+// This file is distributed under the MIT License (MIT).
+// See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#ifndef SEQUOIA_ENGINE_RENDER_GL_GLRINGBUFFER_H
+#define SEQUOIA_ENGINE_RENDER_GL_GLRINGBUFFER_H
+
+#include "sequoia-engine/Render/GL/GL.h"
+#include "sequoia-engine/Render/RingBuffer.h"
+#include <vector>
+
+namespace sequoia {
+
+namespace render {
+
+/// @brief OpenGL ring buffer
+///
+/// The buffer is allocated with immutable storage (`glBufferStorage`) and stays persistently and
+/// coherently mapped for its entire lifetime, hence writing to it requires neither binding nor
+/// mapping. Frames are guarded by `glFenceSync`.
+///
+/// @ingroup gl
+class SEQUOIA_API GLRingBuffer final : public RingBuffer {
+public:
+  /// @brief Allocate and map the buffer
+  ///
+  /// @param target               Target of the buffer
+  /// @param numBytes             Capacity of the buffer in bytes
+  /// @param maxFramesInFlight    Maximum number of frames which can be in flight at the same time
+  GLRingBuffer(GLenum target, std::size_t numBytes, std::size_t maxFramesInFlight = 3);
+
+  /// @brief Unmap and destroy the buffer (and all pending fences)
+  ~GLRingBuffer();
+
+  /// @brief Bind the buffer
+  void bind();
+
+  /// @brief Unbind the buffer
+  void unbind();
+
+  /// @brief Get the OpenGL buffer ID
+  unsigned int getID() const noexcept { return id_; }
+
+protected:
+  /// @copydoc RingBuffer::insertFence
+  virtual void insertFence(std::uint64_t frame) override;
+
+  /// @copydoc RingBuffer::waitFence
+  virtual bool waitFence(std::uint64_t frame, bool block) override;
+
+private:
+  /// OpenGL buffer id
+  unsigned int id_;
+
+  /// Target of the buffer
+  GLenum target_;
+
+  /// Fences of the frames in flight (indexed by `frame % maxFramesInFlight`)
+  std::vector<GLsync> fences_;
+};
+
+} // namespace render
+
+} // namespace sequoia
+
+#endif
@@ -29,7 +29,8 @@ namespace render {
 
 GLTexture::GLTexture(const std::shared_ptr<Image>& image,
                      const std::shared_ptr<TextureParameter>& param)
-    : Texture(RK_OpenGL), id_(0), target_(GL_INVALID_ENUM), param_(param), image_(image) {
+    : Texture(RK_OpenGL), id_(0), target_(GL_INVALID_ENUM), param_(param), streaming_(false),
+      image_(image) {
   width_ = image->getWidth();
   height_ = image->getHeight();
 }
@@ -44,10 +45,12 @@ std::string GLTexture::toString() const {
   return core::format("GLTexture[\n"
                       "  valid = {}\n"
                       "  id = {},\n"
+                      "  streaming = {},\n"
                       "  image = {},\n"
                       "  param = {}\n"
                       "]",
                       isValid() ? "true" : "false", id_,
+                      streaming_ ? "true" : "false",
                       image_ ? core::indent(image_->toString()) : "null",
                       core::indent(param_->toString()));
 }
@@ -29,6 +29,7 @@ namespace render {
 class SEQUOIA_API GLTexture final : public Texture {
 public:
   friend class GLTextureManager;
+  friend class GLTextureStreamer;
 
   GLTexture(const std::shared_ptr<Image>& image, const std::shared_ptr<TextureParameter>& param);
   ~GLTexture();
@@ -53,6 +54,11 @@ public:
   /// @brief Get the target of the texture
   GLenum getTarget() const;
 
+  /// @brief Check if the image of the texture is still being streamed (the texture contains a
+  /// placeholder until then)
+  /// @see GLTextureStreamer
+  bool isStreaming() const { return streaming_; }
+
   /// @brief Bind the texture to the current render pipline
   /// @note Do not call this function directly, use `GLStateCacheManager::bindTexture` instead.
   void bind();
@@ -104,6 +110,9 @@ private:
   /// Texture size
   unsigned int width_, height_;
 
+  /// Is the image still being uploaded?
+  bool streaming_;
+
   /// Image used as basis of the texture (if any)
   std::shared_ptr<Image> image_;
 };
@@ -13,6 +13,7 @@
 //
 //===------------------------------------------------------------------------------------------===//
 
+#include "sequoia-engine/Core/Assert.h"
 #include "sequoia-engine/Core/Casting.h"
 #include "sequoia-engine/Core/Logging.h"
 #include "sequoia-engine/Core/Unreachable.h"
@@ -20,6 +21,8 @@
 #include "sequoia-engine/Render/GL/GL.h"
 #include "sequoia-engine/Render/GL/GLRenderer.h"
 #include "sequoia-engine/Render/GL/GLTextureManager.h"
+#include <algorithm>
+#include <array>
 #include <gli/gli.hpp>
 #include <opencv2/opencv.hpp>
 
@@ -86,6 +89,21 @@ static void allocateTexture(GLenum target, int width, int height, GLenum interna
   }
 }
 
+/// @brief Allocate the immutable storage of a streamed 2D texture `id` of size `width x height` and
+/// fill all levels with a placeholder
+static void allocateStreamedTexture(unsigned int id, int width, int height, bool useMipmap) {
+  int numLevels = 1;
+  if(useMipmap)
+    while((std::max(width, height) >> numLevels) > 0)
+      ++numLevels;
+
+  glTexStorage2D(GL_TEXTURE_2D, numLevels, GL_RGBA8, width, height);
+
+  const std::array<Byte, 4> placeholder = {{128, 128, 128, 255}};
+  for(int level = 0; level < numLevels; ++level)
+    glClearTexImage(id, level, GL_BGRA, GL_UNSIGNED_BYTE, placeholder.data());
+}
+
 /// @brief Upload regular image to device
 ///
 /// https://stackoverflow.com/questions/16809833/opencv-image-loading-for-opengl-texture
@@ -210,6 +228,11 @@ static void uploadTextureImage(GLenum target, const TextureImage* image) {
 
 } // anonymous namespace
 
+GLTextureManager::GLTextureManager(std::size_t streamingBudget) {
+  if(streamingBudget > 0)
+    streamer_ = std::make_unique<GLTextureStreamer>(streamingBudget);
+}
+
 GLTextureManager::~GLTextureManager() {}
 
 void GLTextureManager::makeValid(GLTexture* texture) {
@@ -233,7 +256,12 @@ void GLTextureManager::makeValid(GLTexture* texture) {
   
   if(texture->hasImage()) {
     // Uploade image to device
-    if(RegularImage* regularImage = core::dyn_cast<RegularImage>(texture->getImage().get())) {
+    if(streamer_ && GLTextureStreamer::isSuitable(texture)) {
+      allocateStreamedTexture(texture->id_, texture->width_, texture->height_, param.UseMipmap);
+      texture->streaming_ = true;
+      streamer_->stream(find(texture));
+    } else if(RegularImage* regularImage =
+                  core::dyn_cast<RegularImage>(texture->getImage().get())) {
       uploadRegularImage(texture->target_, regularImage);
       if(param.UseMipmap)
         glGenerateMipmap(texture->target_);
@@ -271,6 +299,21 @@ void GLTextureManager::makeValid(GLTexture* texture) {
   Log::debug("Successfully uploaded texture (ID={})", texture->id_);
 }
 
+void GLTextureManager::update() {
+  if(streamer_)
+    streamer_->update();
+}
+
+std::shared_ptr<GLTexture> GLTextureManager::find(GLTexture* texture) {
+  SEQUOIA_LOCK_GUARD(mutex_);
+
+  // Textures are made valid right after their creation, hence we search from the back
+  auto it = std::find_if(textureList_.rbegin(), textureList_.rend(),
+                         [&texture](const auto& t) { return t.get() == texture; });
+  SEQUOIA_ASSERT_MSG(it != textureList_.rend(), "texture not registered");
+  return *it;
+}
+
 std::shared_ptr<GLTexture>
 GLTextureManager::create(const std::shared_ptr<Image>& image,
                          const std::shared_ptr<TextureParameter>& param) {
@@ -17,6 +17,7 @@
 #define SEQUOIA_ENGINE_RENDER_GL_GLTEXTUREMANAGER_H
 
 #include "sequoia-engine/Render/GL/GLTexture.h"
+#include "sequoia-engine/Render/GL/GLTextureStreamer.h"
 #include <memory>
 #include <unordered_map>
 #include <vector>
@@ -41,7 +42,16 @@ class SEQUOIA_API GLTextureManager : public NonCopyable {
   /// description i.e Parameter + Image)
   std::unordered_map<GLTexture::Desc, std::size_t> descLookupMap_;
 
+  /// Asynchronous upload of textures (may be `nullptr`)
+  std::unique_ptr<GLTextureStreamer> streamer_;
+
 public:
+  /// @brief Initialize the manager
+  ///
+  /// @param streamingBudget    Number of bytes of streamed textures uploaded per frame, textures
+  ///                           are uploaded synchronously if `0`
+  GLTextureManager(std::size_t streamingBudget = 0);
+
   /// @brief Destroy all remaining textures
   ~GLTextureManager();
 
@@ -57,14 +67,28 @@ public:
                                     const std::shared_ptr<TextureParameter>& param);
 
   /// @brief Make the texture valid
+  ///
+  /// If streaming is enabled and the texture is suitable for streaming, the texture is valid
+  /// immediately but contains a placeholder until its image has been uploaded by `update`.
+  ///
   /// @throws RenderSystemExcption  Failed to initialize the texture
   void makeValid(GLTexture* texture);
 
+  /// @brief Upload the streamed textures within the budget of the frame
+  void update();
+
+  /// @brief Get the texture streamer (may be `nullptr`)
+  GLTextureStreamer* getStreamer() const noexcept { return streamer_.get(); }
+
   /// @brief Remove the `texture` (do nothing if the texute does not exist)
   void remove(const std::shared_ptr<GLTexture>& texture) noexcept;
 
   /// @brief Get a copy of the `texture` as an `image`
   std::shared_ptr<Image> getTextureAsImage(GLTexture* texture);
+
+private:
+  /// @brief Get the registered `texture`
+  std::shared_ptr<GLTexture> find(GLTexture* texture);
 };
 
 } // namespace render
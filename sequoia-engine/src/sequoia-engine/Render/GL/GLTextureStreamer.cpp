@@ -0,0 +1,243 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                         _____                        _
+//                        / ____|                      (_)
+//                       | (___   ___  __ _ _   _  ___  _  __ _
+//                        \___ \ / _ \/ _` | | | |/ _ \| |/ _` |
+//                        ____) |  __/ (_| | |_| | (_) | | (_| |
+//                       |_____/ \___|\__, |\__,_|\___/|_|\__,_| - Game Engine (2016-2017)
+//                                       | |
+//                                       |_|
+//
+// This file is distributed under the MIT License (MIT).
+// See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#include "sequoia-engine/Core/Assert.h"
+#include "sequoia-engine/Core/Casting.h"
+#include "sequoia-engine/Core/Image.h"
+#include "sequoia-engine/Core/Logging.h"
+#include "sequoia-engine/Render/GL/GL.h"
+#include "sequoia-engine/Render/GL/GLRenderSystem.h"
+#include "sequoia-engine/Render/GL/GLRenderer.h"
+#include "sequoia-engine/Render/GL/GLRingBuffer.h"
+#include "sequoia-engine/Render/GL/GLTexture.h"
+#include "sequoia-engine/Render/GL/GLTextureStreamer.h"
+#include "sequoia-engine/Render/RenderServer.h"
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <opencv2/opencv.hpp>
+#include <thread>
+
+namespace sequoia {
+
+namespace render {
+
+struct GLTextureStreamer::Request {
+  /// Texture to upload (the upload is discarded if the texture is destroyed in the meantime)
+  std::weak_ptr<GLTexture> Texture;
+
+  /// Decoded BGRA pixels (first row is the bottom row of the image)
+  cv::Mat Pixels;
+
+  /// Exception thrown during decoding (if any)
+  std::exception_ptr Error;
+
+  /// Set by the `RenderServer` once `Pixels` (or `Error`) is available
+  std::atomic<bool> Decoded;
+
+  /// Next row to upload
+  int NextRow;
+
+  /// Next column to upload of `NextRow` (non-zero while a row is uploaded in spans)
+  int NextColumn;
+};
+
+GLTextureStreamer::GLTextureStreamer(std::size_t budget) : budget_(budget), numBytesUploaded_(0) {
+  SEQUOIA_ASSERT_MSG(budget_ >= 4, "budget needs to hold at least one BGRA pixel");
+
+  // Ring of the frames in flight plus the frame currently being recorded
+  pixelBuffer_ = std::make_unique<GLRingBuffer>(GL_PIXEL_UNPACK_BUFFER, 4 * budget_);
+}
+
+GLTextureStreamer::~GLTextureStreamer() {}
+
+bool GLTextureStreamer::isSuitable(GLTexture* texture) noexcept {
+  if(texture->getParameter()->Kind != TextureParameter::TK_2D)
+    return false;
+
+  const RegularImage* image = core::dyn_cast_or_null<RegularImage>(texture->getImage().get());
+  if(!image || image->getMat().depth() != CV_8U ||
+     (image->getNumChannels() != 3 && image->getNumChannels() != 4))
+    return false;
+
+  return getGLRenderer().isExtensionSupported(GLextension::GL_ARB_clear_texture);
+}
+
+void GLTextureStreamer::stream(const std::shared_ptr<GLTexture>& texture) {
+  SEQUOIA_ASSERT_MSG(isSuitable(texture.get()), "texture cannot be streamed");
+
+  auto request = std::make_shared<Request>();
+  request->Texture = texture;
+  request->Decoded = false;
+  request->NextRow = 0;
+  request->NextColumn = 0;
+  requests_.push_back(request);
+
+  Log::debug("Streaming texture (ID={}) ...", texture->getID());
+
+  // Decode the image asynchronously, the request keeps the image alive until it is decoded
+  std::shared_ptr<Image> image = texture->getImage();
+  getGLRenderSystem().getRenderServer()->spawnRessourceTask([request, image]() {
+    try {
+      const RegularImage* regularImage = core::dyn_cast<RegularImage>(image.get());
+
+      // OpenCV images are stored top-down while OpenGL expects the bottom row first
+      cv::Mat flipped;
+      cv::flip(regularImage->getMat(), flipped, 0);
+
+      if(regularImage->getNumChannels() == 3)
+        cv::cvtColor(flipped, request->Pixels, cv::COLOR_BGR2BGRA);
+      else
+        request->Pixels = flipped;
+    } catch(...) {
+      request->Error = std::current_exception();
+    }
+    request->Decoded.store(true, std::memory_order_release);
+  });
+}
+
+void GLTextureStreamer::update() {
+  if(!requests_.empty())
+    uploadImpl(budget_, false);
+}
+
+void GLTextureStreamer::flush() {
+  while(!requests_.empty())
+    uploadImpl(budget_, true);
+}
+
+void GLTextureStreamer::uploadImpl(std::size_t budget, bool wait) {
+  std::size_t numBytes = 0;
+
+  for(auto it = requests_.begin(); it != requests_.end() && numBytes < budget;) {
+    Request& request = **it;
+
+    std::shared_ptr<GLTexture> texture = request.Texture.lock();
+    if(!texture) {
+      it = requests_.erase(it);
+      continue;
+    }
+
+    if(!request.Decoded.load(std::memory_order_acquire)) {
+      if(!wait) {
+        ++it;
+        continue;
+      }
+      while(!request.Decoded.load(std::memory_order_acquire))
+        std::this_thread::yield();
+    }
+
+    if(request.Error) {
+      try {
+        std::rethrow_exception(request.Error);
+      } catch(std::exception& e) {
+        Log::warn("Failed to decode texture (ID={}), keeping placeholder: {}", texture->getID(),
+                  e.what());
+      }
+      texture->streaming_ = false;
+      it = requests_.erase(it);
+      continue;
+    }
+
+    // Upload as many rows as the remaining budget permits. Rows exceeding the budget are uploaded
+    // in spans of pixels, hence a frame never stages more than the budget (the staging memory only
+    // holds the budget of a few frames).
+    const std::size_t rowBytes = request.Pixels.step[0];
+    const std::size_t pixelBytes = request.Pixels.elemSize();
+    const std::size_t available = budget - numBytes;
+
+    if(request.NextColumn == 0 && rowBytes <= available)
+      numBytes += uploadRows(request, available / rowBytes);
+    else if((request.NextColumn != 0 || rowBytes > budget) && available >= pixelBytes)
+      numBytes += uploadSpan(request, available / pixelBytes);
+    else
+      break;
+
+    if(request.NextRow < request.Pixels.rows) {
+      ++it;
+      continue;
+    }
+
+    // Upload is complete (the texture is never bound, which keeps the bindings cached by the
+    // renderer valid)
+    if(texture->getParameter()->UseMipmap)
+      glGenerateTextureMipmap(texture->getID());
+    texture->streaming_ = false;
+
+    Log::debug("Successfully streamed texture (ID={})", texture->getID());
+    it = requests_.erase(it);
+  }
+
+  // Guard the staging memory of this frame until the GPU consumed it
+  if(numBytes > 0)
+    pixelBuffer_->endFrame();
+
+  numBytesUploaded_ += numBytes;
+}
+
+std::size_t GLTextureStreamer::uploadRows(Request& request, std::size_t numRows) {
+  const cv::Mat& pixels = request.Pixels;
+
+  numRows = std::min<std::size_t>(numRows, pixels.rows - request.NextRow);
+  const std::size_t numBytes = numRows * pixels.step[0];
+
+  uploadRect(request, 0, request.NextRow, pixels.cols, numRows, pixels.ptr(request.NextRow),
+             numBytes);
+
+  request.NextRow += numRows;
+  return numBytes;
+}
+
+std::size_t GLTextureStreamer::uploadSpan(Request& request, std::size_t numPixels) {
+  const cv::Mat& pixels = request.Pixels;
+
+  numPixels = std::min<std::size_t>(numPixels, pixels.cols - request.NextColumn);
+  const std::size_t numBytes = numPixels * pixels.elemSize();
+
+  uploadRect(request, request.NextColumn, request.NextRow, numPixels, 1,
+             pixels.ptr(request.NextRow, request.NextColumn), numBytes);
+
+  request.NextColumn += numPixels;
+  if(request.NextColumn == pixels.cols) {
+    request.NextColumn = 0;
+    request.NextRow += 1;
+  }
+  return numBytes;
+}
+
+void GLTextureStreamer::uploadRect(Request& request, int x, int y, std::size_t width,
+                                   std::size_t height, const void* data, std::size_t numBytes) {
+  std::shared_ptr<GLTexture> texture = request.Texture.lock();
+
+  RingBuffer::Allocation allocation = pixelBuffer_->write(data, numBytes, 4);
+
+  // Rows of BGRA pixels are always 4-byte aligned and tightly packed (the pixel format is set
+  // through the renderer as other uploads may have changed it)
+  GLPixelFormat format = getGLRenderer().getDefaultPixelFormat();
+  format.set(GL_UNPACK_ALIGNMENT, 4);
+  format.set(GL_UNPACK_ROW_LENGTH, 0);
+  getGLRenderer().setPixelFormat(format);
+
+  // Upload via direct state access, binding the texture would invalidate the texture bindings
+  // cached by the renderer
+  pixelBuffer_->bind();
+  glTextureSubImage2D(texture->getID(), 0, x, y, width, height, GL_BGRA, GL_UNSIGNED_BYTE,
+                      reinterpret_cast<const void*>(allocation.Offset));
+  pixelBuffer_->unbind();
+}
+
+} // namespace render
+
+} // namespace sequoia
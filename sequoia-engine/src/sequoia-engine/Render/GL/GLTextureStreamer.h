@@ -0,0 +1,107 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                         _____                        _
+//                        / ____|                      (_)
+//                       | (___   ___  __ _ _   _  ___  _  __ _
+//                        \___ \ / _ \/ _` | | | |/ _ \| |/ _` |
+//                        ____) |  __/ (_| | |_| | (_) | | (_| |
+//                       |_____/ \___|\__, |\__,_|\___/|_|\__,_| - Game Engine (2016-2017)
+//                                       | |
+//                                       |_|
+//
+// This file is distributed under the MIT License (MIT).
+// See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#ifndef SEQUOIA_ENGINE_RENDER_GL_GLTEXTURESTREAMER_H
+#define SEQUOIA_ENGINE_RENDER_GL_GLTEXTURESTREAMER_H
+
+#include "sequoia-engine/Core/Export.h"
+#include "sequoia-engine/Core/NonCopyable.h"
+#include "sequoia-engine/Render/GL/GLFwd.h"
+#include <cstddef>
+#include <deque>
+#include <memory>
+
+namespace sequoia {
+
+namespace render {
+
+/// @brief Asynchronous upload of textures through pixel buffer objects
+///
+/// Streamed textures are allocated up front and filled with a placeholder, which makes them
+/// usable immediately. Decoding of the image (i.e flipping and conversion to BGRA) runs on the
+/// `RenderServer` while the upload is performed by `update`, which is called once per frame. The
+/// pixels are copied into a persistently mapped ring of pixel buffer objects and transfered to the
+/// texture in bands of rows such that at most `getBudget()` bytes are uploaded per frame (rows
+/// larger than the budget are split into spans of pixels). Once the last band has been uploaded,
+/// the mipmaps are generated and the texture is no longer streaming.
+///
+/// @ingroup gl
+class SEQUOIA_API GLTextureStreamer : public NonCopyable {
+public:
+  /// @brief Create the streamer
+  /// @param budget   Number of bytes uploaded per frame
+  GLTextureStreamer(std::size_t budget);
+
+  /// @brief Destroy the streamer (pending uploads are discarded)
+  ~GLTextureStreamer();
+
+  /// @brief Check if `texture` can be streamed (2D texture of an 8-bit BGR(A) image)
+  static bool isSuitable(GLTexture* texture) noexcept;
+
+  /// @brief Queue the (allocated but not yet uploaded) `texture` and start decoding its image
+  void stream(const std::shared_ptr<GLTexture>& texture);
+
+  /// @brief Upload the decoded textures within the budget of the frame
+  void update();
+
+  /// @brief Upload all pending textures, ignoring the budget (blocks until all images are decoded)
+  void flush();
+
+  /// @brief Get the number of bytes uploaded per frame
+  std::size_t getBudget() const noexcept { return budget_; }
+
+  /// @brief Get the number of textures which are not yet fully uploaded
+  std::size_t getNumPending() const noexcept { return requests_.size(); }
+
+  /// @brief Get the total number of bytes uploaded
+  std::size_t getNumBytesUploaded() const noexcept { return numBytesUploaded_; }
+
+private:
+  struct Request;
+
+  /// @brief Upload textures until `budget` bytes have been uploaded
+  void uploadImpl(std::size_t budget, bool wait);
+
+  /// @brief Upload the next band of at most `numRows` rows of `request`
+  /// @returns number of uploaded bytes
+  std::size_t uploadRows(Request& request, std::size_t numRows);
+
+  /// @brief Upload the next span of at most `numPixels` pixels of the current row of `request`
+  /// @returns number of uploaded bytes
+  std::size_t uploadSpan(Request& request, std::size_t numPixels);
+
+  /// @brief Stage `numBytes` of `data` and upload them to the rectangle of the texture
+  void uploadRect(Request& request, int x, int y, std::size_t width, std::size_t height,
+                  const void* data, std::size_t numBytes);
+
+private:
+  /// Number of bytes uploaded per frame
+  std::size_t budget_;
+
+  /// Pixel buffer objects used as staging memory
+  std::unique_ptr<GLRingBuffer> pixelBuffer_;
+
+  /// Textures which are decoded or uploaded (in the order they were queued)
+  std::deque<std::shared_ptr<Request>> requests_;
+
+  /// Statistics
+  std::size_t numBytesUploaded_;
+};
+
+} // namespace render
+
+} // namespace sequoia
+
+#endif
@@ -24,7 +24,8 @@ namespace render {
 namespace {
 
 static const char* AttributeNames[GLVertexAttribute::NumAttributes] = {
-    "in_Position", "in_Normal", "in_TexCoord", "in_Color", "in_Tangent", "in_Bitangent"};
+    "in_Position", "in_Normal",    "in_TexCoord",        "in_Color",
+    "in_Tangent",  "in_Bitangent", "in_InstanceMatModel"};
 
 } // anonymous namespace
 
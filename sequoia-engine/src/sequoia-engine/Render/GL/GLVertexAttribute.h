@@ -37,6 +37,7 @@ struct SEQUOIA_API GLVertexAttribute {
     Color,
     Tangent,
     Bitangent,
+    InstanceMatModel, ///< Per-instance model matrix (occupies 4 locations)
 
     NumAttributes
   };
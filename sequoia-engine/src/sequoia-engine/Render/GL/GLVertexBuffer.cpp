@@ -24,6 +24,10 @@ namespace render {
 GLVertexBuffer::GLVertexBuffer(const VertexLayout& layout)
     : VertexBuffer(BK_GLVertexBuffer, layout), glBuffer_(GL_ARRAY_BUFFER) {}
 
+GLVertexBuffer::GLVertexBuffer(const VertexLayout& layout, GLVertexBuffer* storage,
+                               std::size_t offset)
+    : VertexBuffer(BK_GLVertexBuffer, layout), glBuffer_(storage->getGLBuffer(), offset) {}
+
 GLVertexBuffer::~GLVertexBuffer() {}
 
 void GLVertexBuffer::writeImpl(const void* src, std::size_t offset, std::size_t length,
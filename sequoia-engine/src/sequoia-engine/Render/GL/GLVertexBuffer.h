@@ -31,12 +31,19 @@ class SEQUOIA_API GLVertexBuffer final : public VertexBuffer {
 public:
   GLVertexBuffer(const VertexLayout& layout);
 
+  /// @brief Create a view of the range starting at the byte `offset` of `storage` (see
+  /// `GLBuffer::GLBuffer(GLBuffer*, std::size_t)`)
+  GLVertexBuffer(const VertexLayout& layout, GLVertexBuffer* storage, std::size_t offset);
+
   /// @brief Free all memory
   ~GLVertexBuffer();
 
   /// @brief Bind the buffer
   void bind();
 
+  /// @brief Get the OpenGL buffer
+  GLBuffer* getGLBuffer() noexcept { return &glBuffer_; }
+
   static bool classof(const Buffer* buffer) { return buffer->getKind() == BK_GLIndexBuffer; }
 
 protected:
@@ -18,8 +18,12 @@
 #include "sequoia-engine/Core/StringUtil.h"
 #include "sequoia-engine/Core/Unreachable.h"
 #include "sequoia-engine/Render/GL/GL.h"
+#include "sequoia-engine/Render/GL/GLBuffer.h"
+#include "sequoia-engine/Render/GL/GLRenderer.h"
+#include "sequoia-engine/Render/GL/GLRingBuffer.h"
 #include "sequoia-engine/Render/GL/GLVertexAttribute.h"
 #include "sequoia-engine/Render/GL/GLVertexData.h"
+#include "sequoia-engine/Render/GL/GLVertexDataArena.h"
 
 // TODO: convert everything to DSA
 
@@ -50,6 +54,21 @@ struct TypeIDToGLEnum<VertexLayout::Float32> {
   static constexpr GLenum value = GL_FLOAT;
 };
 
+template <>
+struct TypeIDToGLEnum<VertexLayout::Int16> {
+  static constexpr GLenum value = GL_SHORT;
+};
+
+template <>
+struct TypeIDToGLEnum<VertexLayout::UInt16> {
+  static constexpr GLenum value = GL_UNSIGNED_SHORT;
+};
+
+template <>
+struct TypeIDToGLEnum<VertexLayout::Float16> {
+  static constexpr GLenum value = GL_HALF_FLOAT;
+};
+
 } // anonymous namespace
 
 static GLenum getGLDrawMode(VertexData::DrawModeKind mode) {
@@ -77,7 +96,7 @@ GLenum GLVertexData::getGLType(VertexLayout::TypeID type) {
 
 GLVertexData::GLVertexData(const VertexDataParameter& param)
     : VertexData(RK_OpenGL, param.DrawMode), vertexBuffer_(nullptr), indexBuffer_(nullptr),
-      vaoID_(0) {
+      vaoID_(0), arena_(nullptr), range_{0, 0, 0, 0} {
   const VertexLayout& layout = param.Layout;
 
   // Generate VAO, VBO and VEO
@@ -120,6 +139,43 @@ GLVertexData::GLVertexData(const VertexDataParameter& param)
                           reinterpret_cast<void*>(layout.Color.Offset));
   }
 
+  // Source the per-instance model matrices from the instance buffer of the renderer (instanced
+  // draws select their matrices via the base instance)
+  if(GLRenderer* renderer = getGLRendererPtr())
+    setInstanceAttributes(renderer->getInstanceBuffer());
+
+  allocateBuffers(param);
+
+  unbind();
+}
+
+GLVertexData::GLVertexData(const VertexDataParameter& param,
+                           std::shared_ptr<GLVertexDataArena> arena, const DrawRange& range)
+    : VertexData(RK_OpenGL, param.DrawMode), vertexBuffer_(nullptr), indexBuffer_(nullptr),
+      vaoID_(arena->getStorage()->getVAOID()), arena_(std::move(arena)), range_(range) {
+  GLVertexData* storage = arena_->getStorage();
+
+  // The buffers are views of the allocated range of the shared buffers
+  vertexBuffer_ = std::make_unique<GLVertexBuffer>(
+      param.Layout, storage->vertexBuffer_.get(), range_.FirstVertex * param.Layout.SizeOf);
+  if(param.NumIndices > 0)
+    indexBuffer_ = std::make_unique<GLIndexBuffer>(
+        param.IndexType, storage->indexBuffer_.get(),
+        range_.FirstIndex * storage->indexBuffer_->getSizeOfIndexType());
+
+  allocateBuffers(param);
+}
+
+GLVertexData::~GLVertexData() {
+  vertexBuffer_.reset();
+  indexBuffer_.reset();
+  if(arena_)
+    arena_->deallocate(range_);
+  else
+    glDeleteVertexArrays(1, &vaoID_);
+}
+
+void GLVertexData::allocateBuffers(const VertexDataParameter& param) {
   // Allocate buffers
   vertexBuffer_->allocateVertices(param.NumVertices, param.VertexBufferUsageHint);
   if(indexBuffer_)
@@ -131,17 +187,28 @@ GLVertexData::GLVertexData(const VertexDataParameter& param)
 
   if(indexBuffer_ && param.UseIndexShadowBuffer)
     indexBuffer_->setShadowBuffer(core::HostBuffer::create(indexBuffer_->getNumBytes()));
+}
 
-  unbind();
+const VertexData* GLVertexData::getStorage() const noexcept {
+  return arena_ ? arena_->getStorage() : this;
 }
 
-GLVertexData::~GLVertexData() {
-  vertexBuffer_.reset();
-  indexBuffer_.reset();
-  glDeleteVertexArrays(1, &vaoID_);
+VertexData::DrawRange GLVertexData::getDrawRange() const noexcept {
+  return arena_ ? range_ : VertexData::getDrawRange();
+}
+
+void* GLVertexData::getIndexPointer(const DrawRange& range) const noexcept {
+  return reinterpret_cast<void*>(range.FirstIndex * indexBuffer_->getSizeOfIndexType());
 }
 
 void GLVertexData::bind() {
+  // Views of an arena bind the shared buffers (binding the buffers of a view without indices would
+  // detach the shared index buffer from the VAO)
+  if(arena_) {
+    arena_->getStorage()->bind();
+    return;
+  }
+
   glBindVertexArray(vaoID_);
   vertexBuffer_->bind();
   if(indexBuffer_)
@@ -157,12 +224,79 @@ void GLVertexData::unbind() {
 }
 
 void GLVertexData::draw() const noexcept {
+  const DrawRange range = getDrawRange();
+  if(indexBuffer_) {
+    glDrawElementsBaseVertex(getGLDrawMode(getDrawMode()), range.NumIndices,
+                             indexBuffer_->getGLIndexType(), getIndexPointer(range),
+                             range.FirstVertex);
+  } else {
+    glDrawArrays(getGLDrawMode(getDrawMode()), range.FirstVertex, range.NumVertices);
+  }
+}
+
+void GLVertexData::setInstanceAttributes(GLRingBuffer* instanceBuffer) noexcept {
+  // Each column of the matrix is a separate attribute which advances once per instance
+  instanceBuffer->bind();
+  for(unsigned int col = 0; col < 4; ++col) {
+    GLuint location = GLVertexAttribute::InstanceMatModel + col;
+    glEnableVertexAttribArray(location);
+    glVertexAttribPointer(location, 4, GL_FLOAT, GL_FALSE, sizeof(math::mat4),
+                          reinterpret_cast<void*>(col * sizeof(math::vec4)));
+    glVertexAttribDivisor(location, 1);
+  }
+  instanceBuffer->unbind();
+}
+
+void GLVertexData::drawInstanced(std::uint32_t baseInstance,
+                                 std::size_t numInstances) const noexcept {
+  const DrawRange range = getDrawRange();
+  if(indexBuffer_) {
+    glDrawElementsInstancedBaseVertexBaseInstance(
+        getGLDrawMode(getDrawMode()), range.NumIndices, indexBuffer_->getGLIndexType(),
+        getIndexPointer(range), numInstances, range.FirstVertex, baseInstance);
+  } else {
+    glDrawArraysInstancedBaseInstance(getGLDrawMode(getDrawMode()), range.FirstVertex,
+                                      range.NumVertices, numInstances, baseInstance);
+  }
+}
+
+void GLVertexData::drawIndirect(std::uint32_t baseInstance, GLRingBuffer* indirectBuffer,
+                                ArrayRef<DrawIndirectCommand> commands) const {
+  // `BaseInstance` of the commands is relative to the first matrix of the multi-draw
+  RingBuffer::Allocation allocation;
+  if(indexBuffer_) {
+    allocation = indirectBuffer->allocate(commands.size() * sizeof(DrawIndirectCommand),
+                                          alignof(DrawIndirectCommand));
+    DrawIndirectCommand* elementsCommands = static_cast<DrawIndirectCommand*>(allocation.Data);
+    for(std::size_t i = 0; i < commands.size(); ++i) {
+      elementsCommands[i] = commands[i];
+      elementsCommands[i].BaseInstance += baseInstance;
+    }
+  } else {
+    // The commands of `glMultiDrawArraysIndirect` lack the `BaseVertex`
+    struct DrawArraysIndirectCommand {
+      std::uint32_t Count, InstanceCount, First, BaseInstance;
+    };
+
+    allocation = indirectBuffer->allocate(commands.size() * sizeof(DrawArraysIndirectCommand),
+                                          alignof(DrawArraysIndirectCommand));
+    DrawArraysIndirectCommand* arraysCommands =
+        static_cast<DrawArraysIndirectCommand*>(allocation.Data);
+    for(std::size_t i = 0; i < commands.size(); ++i)
+      arraysCommands[i] =
+          DrawArraysIndirectCommand{commands[i].Count, commands[i].InstanceCount,
+                                    commands[i].First, commands[i].BaseInstance + baseInstance};
+  }
+
+  indirectBuffer->bind();
   if(indexBuffer_) {
-    glDrawElements(getGLDrawMode(getDrawMode()), indexBuffer_->getNumIndices(),
-                   indexBuffer_->getGLIndexType(), (void*)0);
+    glMultiDrawElementsIndirect(getGLDrawMode(getDrawMode()), indexBuffer_->getGLIndexType(),
+                                reinterpret_cast<void*>(allocation.Offset), commands.size(), 0);
   } else {
-    glDrawArrays(getGLDrawMode(getDrawMode()), 0, vertexBuffer_->getNumVertices());
+    glMultiDrawArraysIndirect(getGLDrawMode(getDrawMode()),
+                              reinterpret_cast<void*>(allocation.Offset), commands.size(), 0);
   }
+  indirectBuffer->unbind();
 }
 
 std::pair<std::string, std::string> GLVertexData::toStringImpl() const {
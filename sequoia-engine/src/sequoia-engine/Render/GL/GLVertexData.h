@@ -16,10 +16,13 @@
 #ifndef SEQUOIA_ENGINE_RENDER_GL_GLVERTEXDATA_H
 #define SEQUOIA_ENGINE_RENDER_GL_GLVERTEXDATA_H
 
+#include "sequoia-engine/Core/ArrayRef.h"
+#include "sequoia-engine/Render/DrawIndirectCommand.h"
 #include "sequoia-engine/Render/GL/GLFwd.h"
 #include "sequoia-engine/Render/GL/GLIndexBuffer.h"
 #include "sequoia-engine/Render/GL/GLVertexBuffer.h"
 #include "sequoia-engine/Render/VertexData.h"
+#include <memory>
 
 namespace sequoia {
 
@@ -32,10 +35,17 @@ public:
   /// @brief Allocate a vertex array object (VAO) with a vertex and index buffer
   GLVertexData(const VertexDataParameter& param);
 
+  /// @brief Create the VertexData of `param` as a view of `range` of the buffers of `arena`
+  ///
+  /// The VertexData shares the VAO of the arena and returns its range on destruction.
+  /// @see GLVertexDataArena::allocate
+  GLVertexData(const VertexDataParameter& param, std::shared_ptr<GLVertexDataArena> arena,
+               const DrawRange& range);
+
   /// @brief Deallocate all memory
   ~GLVertexData();
 
-  /// @brief Bind the vertex array
+  /// @brief Bind the vertex array (of the arena, if allocated from one)
   void bind();
 
   /// @brief Unbind texture
@@ -47,10 +57,34 @@ public:
   /// @copydoc VertexData::getIndexBuffer
   virtual IndexBuffer* getIndexBuffer() const override { return indexBuffer_.get(); }
 
+  /// @copydoc VertexData::getStorage
+  virtual const VertexData* getStorage() const noexcept override;
+
+  /// @copydoc VertexData::getDrawRange
+  virtual DrawRange getDrawRange() const noexcept override;
+
+  /// @brief Get the arena the VertexData was allocated from (`nullptr` if it owns its buffers)
+  GLVertexDataArena* getArena() const noexcept { return arena_.get(); }
+
   /// @brief Draw the vertex-data
   //TODO: move this out of VertexData
   void draw() const noexcept;
 
+  /// @brief Draw `numInstances` instances of the vertex-data
+  ///
+  /// The per-instance model matrices are sourced from the instance buffer of the renderer (tightly
+  /// packed `math::mat4`) via the `GLVertexAttribute::InstanceMatModel` attribute, starting at the
+  /// matrix `baseInstance`.
+  void drawInstanced(std::uint32_t baseInstance, std::size_t numInstances) const noexcept;
+
+  /// @brief Draw all `commands` with a single multi-draw
+  ///
+  /// The per-instance matrices are sourced as in `drawInstanced` (the `BaseInstance` of the
+  /// commands is relative to `baseInstance`) while the commands are streamed through
+  /// `indirectBuffer` (which needs to be a `GL_DRAW_INDIRECT_BUFFER`).
+  void drawIndirect(std::uint32_t baseInstance, GLRingBuffer* indirectBuffer,
+                    ArrayRef<DrawIndirectCommand> commands) const;
+
   /// @brief Get the VAO ID
   unsigned int getVAOID() const noexcept { return vaoID_; }
 
@@ -63,6 +97,18 @@ protected:
   /// @brief Implementation of `toString` returns stringified members and title
   virtual std::pair<std::string, std::string> toStringImpl() const override;
 
+private:
+  /// @brief Allocate the vertex and index buffers (and their shadow buffers)
+  void allocateBuffers(const VertexDataParameter& param);
+
+  /// @brief Get the offset of the first index of `range` in the index buffer (as a pointer)
+  void* getIndexPointer(const DrawRange& range) const noexcept;
+
+  /// @brief Source the per-instance model matrices of the bound VAO from `instanceBuffer`
+  ///
+  /// The attributes are part of the state of the VAO and thus only set once at creation.
+  void setInstanceAttributes(GLRingBuffer* instanceBuffer) noexcept;
+
 private:
   /// Allocated VertexBuffer
   std::unique_ptr<GLVertexBuffer> vertexBuffer_;
@@ -70,9 +116,13 @@ private:
   /// Allocated IndexBuffer (possibly NULL)
   std::unique_ptr<GLIndexBuffer> indexBuffer_;
 
-  /// Vertex array object (VAO)
+  /// Vertex array object (VAO), owned by the arena if allocated from one
   unsigned int vaoID_;
 
+  /// Arena the VertexData was allocated from (possibly NULL) and the allocated range
+  std::shared_ptr<GLVertexDataArena> arena_;
+  DrawRange range_;
+
 private:
   using Base = VertexData;
 };
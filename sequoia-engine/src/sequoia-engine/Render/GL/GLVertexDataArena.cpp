@@ -0,0 +1,95 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                         _____                        _
+//                        / ____|                      (_)
+//                       | (___   ___  __ _ _   _  ___  _  __ _
+//                        \___ \ / _ \/ _` | | | |/ _ \| |/ _` |
+//                        ____) |  __/ (_| | |_| | (_) | | (_| |
+//                       |_____/ \___|\__, |\__,_|\___/|_|\__,_| - Game Engine (2016-2017)
+//                                       | |
+//                                       |_|
+//
+// This file is distributed under the MIT License (MIT).
+// See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#include "sequoia-engine/Core/Format.h"
+#include "sequoia-engine/Core/StringUtil.h"
+#include "sequoia-engine/Render/GL/GLVertexData.h"
+#include "sequoia-engine/Render/GL/GLVertexDataArena.h"
+
+namespace sequoia {
+
+namespace render {
+
+GLVertexDataArena::GLVertexDataArena(const VertexLayout& layout, IndexBuffer::IndexType indexType,
+                                     std::size_t numVertices, std::size_t numIndices)
+    : storage_(nullptr), indexType_(indexType), vertexAllocator_(numVertices),
+      indexAllocator_(numIndices) {
+  VertexDataParameter param(VertexData::DM_Triangles, layout, numVertices, numIndices,
+                            Buffer::UH_StaticWriteOnly);
+  param.IndexType = indexType;
+  param.UseVertexShadowBuffer = false;
+  param.UseIndexShadowBuffer = false;
+  storage_ = std::make_unique<GLVertexData>(param);
+}
+
+GLVertexDataArena::~GLVertexDataArena() {}
+
+bool GLVertexDataArena::isSuitable(const VertexDataParameter& param) noexcept {
+  return param.Layout.ID != 0 && param.NumVertices > 0 &&
+         (param.NumIndices == 0 || param.IndexType == IndexBuffer::IT_UInt16 ||
+          param.IndexType == IndexBuffer::IT_UInt32) &&
+         (param.VertexBufferUsageHint == Buffer::UH_Static ||
+          param.VertexBufferUsageHint == Buffer::UH_StaticWriteOnly);
+}
+
+std::shared_ptr<GLVertexData> GLVertexDataArena::allocate(const VertexDataParameter& param) {
+  SEQUOIA_ASSERT(isSuitable(param));
+  SEQUOIA_ASSERT(param.Layout.ID == getLayout().ID);
+  SEQUOIA_ASSERT(param.NumIndices == 0 || param.IndexType == getIndexType());
+
+  VertexData::DrawRange range;
+  {
+    SEQUOIA_LOCK_GUARD(mutex_);
+
+    std::size_t firstVertex = vertexAllocator_.allocate(param.NumVertices);
+    if(firstVertex == ArenaAllocator::InvalidOffset)
+      return nullptr;
+
+    std::size_t firstIndex = indexAllocator_.allocate(param.NumIndices);
+    if(firstIndex == ArenaAllocator::InvalidOffset) {
+      vertexAllocator_.deallocate(firstVertex, param.NumVertices);
+      return nullptr;
+    }
+
+    range = VertexData::DrawRange{static_cast<std::uint32_t>(firstVertex),
+                                  static_cast<std::uint32_t>(param.NumVertices),
+                                  static_cast<std::uint32_t>(firstIndex),
+                                  static_cast<std::uint32_t>(param.NumIndices)};
+  }
+
+  return std::make_shared<GLVertexData>(param, shared_from_this(), range);
+}
+
+void GLVertexDataArena::deallocate(const VertexData::DrawRange& range) {
+  SEQUOIA_LOCK_GUARD(mutex_);
+  vertexAllocator_.deallocate(range.FirstVertex, range.NumVertices);
+  indexAllocator_.deallocate(range.FirstIndex, range.NumIndices);
+}
+
+const VertexLayout& GLVertexDataArena::getLayout() const noexcept { return storage_->getLayout(); }
+
+std::string GLVertexDataArena::toString() const {
+  return core::format("GLVertexDataArena[\n"
+                      "  layout = {},\n"
+                      "  vertexAllocator = {},\n"
+                      "  indexAllocator = {}\n"
+                      "]",
+                      getLayout().getName(), core::indent(vertexAllocator_.toString()),
+                      core::indent(indexAllocator_.toString()));
+}
+
+} // namespace render
+
+} // namespace sequoia
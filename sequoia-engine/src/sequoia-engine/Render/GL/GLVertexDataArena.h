@@ -0,0 +1,104 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                         _____                        _
+//                        / ____|                      (_)
+//                       | (___   ___  __ _ _   _  ___  _  __ _
+//                        \___ \ / _ \/ _` | | | |/ _ \| |/ _` |
+//                        ____) |  __/ (_| | |_| | (_) | | (_| |
+//                       |_____/ \___|\__, |\__,_|\___/|_|\__,_| - Game Engine (2016-2017)
+//                                       | |
+//                                       |_|
+//
+// This file is distributed under the MIT License (MIT).
+// See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#ifndef SEQUOIA_ENGINE_RENDER_GL_GLVERTEXDATAARENA_H
+#define SEQUOIA_ENGINE_RENDER_GL_GLVERTEXDATAARENA_H
+
+#include "sequoia-engine/Core/Mutex.h"
+#include "sequoia-engine/Core/NonCopyable.h"
+#include "sequoia-engine/Render/ArenaAllocator.h"
+#include "sequoia-engine/Render/GL/GLFwd.h"
+#include "sequoia-engine/Render/VertexData.h"
+#include <memory>
+#include <string>
+
+namespace sequoia {
+
+namespace render {
+
+/// @brief Vertex and index buffers (and vertex array object) shared by the VertexData of many
+/// meshes of the same vertex layout
+///
+/// The VertexData allocated from the arena are views of a range of the shared buffers and are
+/// drawn via their base-vertex and first-index offsets. As all of them share the same VAO, no
+/// rebinding is needed between their draws and they can be merged into multi-draws. All indices of
+/// an arena are of the same type (16 or 32-bit).
+///
+/// @ingroup gl
+class SEQUOIA_API GLVertexDataArena : public std::enable_shared_from_this<GLVertexDataArena>,
+                                      public NonCopyable {
+public:
+  /// @brief Allocate the shared buffers of `numVertices` vertices of `layout` and `numIndices`
+  /// indices of `indexType`
+  GLVertexDataArena(const VertexLayout& layout, IndexBuffer::IndexType indexType,
+                    std::size_t numVertices, std::size_t numIndices);
+
+  /// @brief Free the shared buffers
+  ~GLVertexDataArena();
+
+  /// @brief Check if VertexData of `param` can be allocated from an arena
+  ///
+  /// This requires a layout defined via `SEQUOIA_DEFINE_VERTEX`, 16 or 32-bit indices (if any) and
+  /// a static usage hint (the shared buffers are never discarded as a whole).
+  static bool isSuitable(const VertexDataParameter& param) noexcept;
+
+  /// @brief Allocate the VertexData of `param` from the arena
+  /// @returns the VertexData or `nullptr` if the arena has no room for it
+  std::shared_ptr<GLVertexData> allocate(const VertexDataParameter& param);
+
+  /// @brief Get the VertexData owning the shared buffers
+  GLVertexData* getStorage() const noexcept { return storage_.get(); }
+
+  /// @brief Get the layout of the vertices
+  const VertexLayout& getLayout() const noexcept;
+
+  /// @brief Get the type of the indices
+  IndexBuffer::IndexType getIndexType() const noexcept { return indexType_; }
+
+  /// @brief Get the allocator of the vertices
+  const ArenaAllocator& getVertexAllocator() const noexcept { return vertexAllocator_; }
+
+  /// @brief Get the allocator of the indices
+  const ArenaAllocator& getIndexAllocator() const noexcept { return indexAllocator_; }
+
+  /// @brief Convert to string
+  std::string toString() const;
+
+private:
+  friend class GLVertexData;
+
+  /// @brief Return the range of a VertexData to the arena
+  void deallocate(const VertexData::DrawRange& range);
+
+private:
+  /// VertexData owning the shared buffers and VAO
+  std::unique_ptr<GLVertexData> storage_;
+
+  /// Type of the indices
+  IndexBuffer::IndexType indexType_;
+
+  /// Allocators of the vertices and indices
+  ArenaAllocator vertexAllocator_;
+  ArenaAllocator indexAllocator_;
+
+  /// Protect the allocators
+  SpinMutex mutex_;
+};
+
+} // namespace render
+
+} // namespace sequoia
+
+#endif
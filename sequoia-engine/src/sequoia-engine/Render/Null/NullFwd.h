@@ -31,6 +31,7 @@ class NullInputSystem;
 class NullProgram;
 class NullRenderer;
 class NullRenderWindow;
+class NullRingBuffer;
 class NullShader;
 class NullTexture;
 class NullVertexBuffer;
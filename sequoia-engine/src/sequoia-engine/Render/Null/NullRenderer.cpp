@@ -15,36 +15,99 @@
 
 #include "sequoia-engine/Core/Format.h"
 #include "sequoia-engine/Core/StringUtil.h"
+#include "sequoia-engine/Render/DrawCommand.h"
+#include "sequoia-engine/Render/DrawIndirectCommand.h"
 #include "sequoia-engine/Render/Null/NullRenderer.h"
+#include "sequoia-engine/Render/VertexData.h"
 
 namespace sequoia {
 
 namespace render {
 
+namespace {
+
+/// @brief Number of triangles drawn by one instance of `data`
+static std::size_t getNumTriangles(const VertexData* data) noexcept {
+  VertexData::DrawRange range = data->getDrawRange();
+  return (data->hasIndices() ? range.NumIndices : range.NumVertices) / 3;
+}
+
+} // anonymous namespace
+
 #define RENDER_STATE(Type, Name, DefaultValue)                                                     \
-  bool NullRenderer::Name##Changed(Type value) { return true; }
+  bool NullRenderer::Name##Changed(Type value) {                                                   \
+    statistics_.NumPipelineStateChanges++;                                                         \
+    return true;                                                                                   \
+  }
 #include "sequoia-engine/Render/RenderState.inc"
 #undef RENDER_STATE
 
-bool NullRenderer::ProgramChanged(Program* program) { return true; }
+bool NullRenderer::ProgramChanged(Program* program) {
+  statistics_.NumProgramChanges++;
+  return true;
+}
 
-bool NullRenderer::VertexDataChanged(VertexData* data) { return true; }
+bool NullRenderer::VertexDataChanged(VertexData* data) {
+  statistics_.NumVertexDataChanges++;
+  return true;
+}
 
-bool NullRenderer::TextureChanged(int textureUnit, Texture* texture, bool enable) { return true; }
+bool NullRenderer::TextureChanged(int textureUnit, Texture* texture, bool enable) {
+  statistics_.NumTextureChanges++;
+  return true;
+}
 
-bool NullRenderer::UniformVariableChanged(Program* program, const std::string& name,
+bool NullRenderer::UniformVariableChanged(Program* program, UniformID id,
                                           const UniformVariable& value) {
+  statistics_.NumUniformVariableChanges++;
   return true;
 }
 
-bool NullRenderer::ViewportChanged(int x, int y, int width, int height) { return true; }
+bool NullRenderer::ViewportChanged(int x, int y, int width, int height) {
+  statistics_.NumViewportChanges++;
+  return true;
+}
 
 bool NullRenderer::clearRenderBuffers(
     const std::set<RenderBuffer::RenderBufferKind>& buffersToClear) {
   return true;
 }
 
-bool NullRenderer::draw(const DrawCommand& drawCommand) { return true; }
+bool NullRenderer::bindUniformBlock(const std::string& name, const std::vector<Byte>& data) {
+  statistics_.NumUniformBlockBindings++;
+  return true;
+}
+
+bool NullRenderer::draw(const DrawCommand& drawCommand) {
+  statistics_.NumDrawCalls++;
+  statistics_.NumInstances++;
+  statistics_.NumTriangles += getNumTriangles(drawCommand.getVertexData());
+  return true;
+}
+
+bool NullRenderer::supportsInstancing(Program* program) const { return true; }
+
+bool NullRenderer::drawInstanced(const DrawCommand& drawCommand, ArrayRef<math::mat4> matModels) {
+  statistics_.NumDrawCalls++;
+  statistics_.NumInstancedDrawCalls++;
+  statistics_.NumInstances += matModels.size();
+  statistics_.NumTriangles += matModels.size() * getNumTriangles(drawCommand.getVertexData());
+  return true;
+}
+
+bool NullRenderer::supportsMultiDrawIndirect() const { return true; }
+
+bool NullRenderer::drawIndirect(const DrawCommand& drawCommand,
+                                ArrayRef<DrawIndirectCommand> commands,
+                                ArrayRef<math::mat4> matModels) {
+  statistics_.NumDrawCalls++;
+  statistics_.NumIndirectDrawCalls++;
+  statistics_.NumIndirectCommands += commands.size();
+  statistics_.NumInstances += matModels.size();
+  for(const DrawIndirectCommand& command : commands)
+    statistics_.NumTriangles += std::size_t(command.Count / 3) * command.InstanceCount;
+  return true;
+}
 
 std::pair<std::string, std::string> NullRenderer::toStringImpl() const {
   return std::make_pair("NullRenderer", core::format("{}", Base::toStringImpl().second));
@@ -25,6 +25,30 @@ namespace render {
 /// @brief Null Renderer implementation
 /// @ingroup null
 class SEQUOIA_API NullRenderer final : public Renderer {
+public:
+  /// @brief Number of state changes and draw calls issued to the NullRenderer
+  struct Statistics {
+    std::size_t NumPipelineStateChanges = 0;
+    std::size_t NumProgramChanges = 0;
+    std::size_t NumVertexDataChanges = 0;
+    std::size_t NumTextureChanges = 0;
+    std::size_t NumUniformVariableChanges = 0;
+    std::size_t NumViewportChanges = 0;
+    std::size_t NumUniformBlockBindings = 0;
+    std::size_t NumDrawCalls = 0;
+    std::size_t NumInstancedDrawCalls = 0; ///< Draw calls issued via `drawInstanced`
+    std::size_t NumIndirectDrawCalls = 0;  ///< Draw calls issued via `drawIndirect`
+    std::size_t NumIndirectCommands = 0;   ///< Commands of all multi-draws
+    std::size_t NumInstances = 0;          ///< Drawn instances (a regular draw draws one instance)
+    std::size_t NumTriangles = 0;          ///< Drawn triangles (summed over all instances)
+
+    /// @brief Get the total number of state changes
+    std::size_t getNumStateChanges() const noexcept {
+      return NumPipelineStateChanges + NumProgramChanges + NumVertexDataChanges +
+             NumTextureChanges + NumUniformVariableChanges + NumViewportChanges;
+    }
+  };
+
 protected:
   using Base = Renderer;
 
@@ -42,7 +66,7 @@ protected:
   virtual bool TextureChanged(int textureUnit, Texture* texture, bool enable) override;
 
   /// @copydoc Renderer::UniformVariableChanged
-  virtual bool UniformVariableChanged(Program* program, const std::string& name,
+  virtual bool UniformVariableChanged(Program* program, UniformID id,
                                       const UniformVariable& value) override;
 
   /// @copydoc Renderer::ViewportChanged
@@ -51,16 +75,42 @@ protected:
   virtual bool
   clearRenderBuffers(const std::set<RenderBuffer::RenderBufferKind>& buffersToClear) override;
 
+  /// @copydoc Renderer::bindUniformBlock
+  virtual bool bindUniformBlock(const std::string& name, const std::vector<Byte>& data) override;
+
   /// @copydoc Renderer::draw
   virtual bool draw(const DrawCommand& drawCommand) override;
 
+  /// @copydoc Renderer::supportsInstancing
+  virtual bool supportsInstancing(Program* program) const override;
+
+  /// @copydoc Renderer::drawInstanced
+  virtual bool drawInstanced(const DrawCommand& drawCommand,
+                             ArrayRef<math::mat4> matModels) override;
+
+  /// @copydoc Renderer::supportsMultiDrawIndirect
+  virtual bool supportsMultiDrawIndirect() const override;
+
+  /// @copydoc Renderer::drawIndirect
+  virtual bool drawIndirect(const DrawCommand& drawCommand, ArrayRef<DrawIndirectCommand> commands,
+                            ArrayRef<math::mat4> matModels) override;
+
   /// @copydoc Renderer::toStringImpl
   std::pair<std::string, std::string> toStringImpl() const override;
 
 public:
   NullRenderer();
 
+  /// @brief Get the statistics gathered since the last call to `resetStatistics()`
+  const Statistics& getStatistics() const noexcept { return statistics_; }
+
+  /// @brief Reset the statistics
+  void resetStatistics() noexcept { statistics_ = Statistics(); }
+
   SEQUOIA_NULL_OBJECT(Renderer)
+
+private:
+  Statistics statistics_;
 };
 
 } // namespace render
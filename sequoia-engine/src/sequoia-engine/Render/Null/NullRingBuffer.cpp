@@ -0,0 +1,45 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                         _____                        _
+//                        / ____|                      (_)
+//                       | (___   ___  __ _ _   _  ___  _  __ _
+//                        \___ \ / _ \/ _` | | | |/ _ \| |/ _` |
+//                        ____) |  __/ (_| | |_| | (_) | | (_| |
+//                       |_____/ \___|\__, |\__,_|\___/|_|\__,_| - Game Engine (2016-2017)
+//                                       | |
+//                                       |_|
+//
+// This file is distributed under the MIT License (MIT).
+// See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#include "sequoia-engine/Render/Null/NullRingBuffer.h"
+#include <algorithm>
+
+namespace sequoia {
+
+namespace render {
+
+NullRingBuffer::NullRingBuffer(std::size_t numBytes, std::size_t maxFramesInFlight)
+    : RingBuffer(numBytes, maxFramesInFlight), data_(numBytes), numFences_(0),
+      numSignaledFrames_(0) {
+  setData(data_.data());
+}
+
+NullRingBuffer::~NullRingBuffer() {}
+
+void NullRingBuffer::signalFences(std::uint64_t frame) {
+  numSignaledFrames_ = std::max(numSignaledFrames_, frame + 1);
+}
+
+void NullRingBuffer::insertFence(std::uint64_t frame) { ++numFences_; }
+
+bool NullRingBuffer::waitFence(std::uint64_t frame, bool block) {
+  if(block)
+    signalFences(frame);
+  return frame < numSignaledFrames_;
+}
+
+} // namespace render
+
+} // namespace sequoia
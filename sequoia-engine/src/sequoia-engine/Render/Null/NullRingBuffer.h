@@ -0,0 +1,68 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                         _____                        _
+//                        / ____|                      (_)
+//                       | (___   ___  __ _ _   _  ___  _  __ _
+//                        \___ \ / _ \/ _` | | | |/ _ \| |/ _` |
+//                        ____) |  __/ (_| | |_| | (_) | | (_| |
+//                       |_____/ \___|\__, |\__,_|\___/|_|\__,_| - Game Engine (2016-2017)
+//                                       | |
+//                                       |_|
+//
+// This file is distributed under the MIT License (MIT).
+// See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#ifndef SEQUOIA_ENGINE_RENDER_NULL_NULLRINGBUFFER_H
+#define SEQUOIA_ENGINE_RENDER_NULL_NULLRINGBUFFER_H
+
+#include "sequoia-engine/Render/RingBuffer.h"
+#include <vector>
+
+namespace sequoia {
+
+namespace render {
+
+/// @brief Null ring buffer
+///
+/// The memory is a plain host allocation. The GPU is emulated by explicitly signaling the fences
+/// via `signalFences`, a blocking wait signals the fence immediately.
+///
+/// @ingroup null
+class SEQUOIA_API NullRingBuffer final : public RingBuffer {
+public:
+  /// @copydoc RingBuffer::RingBuffer
+  NullRingBuffer(std::size_t numBytes, std::size_t maxFramesInFlight = 3);
+
+  /// @brief Free all memory
+  ~NullRingBuffer();
+
+  /// @brief Signal the fences of all frames up to (and including) `frame`
+  void signalFences(std::uint64_t frame);
+
+  /// @brief Get the number of fences which have been inserted
+  std::size_t getNumFences() const noexcept { return numFences_; }
+
+protected:
+  /// @copydoc RingBuffer::insertFence
+  virtual void insertFence(std::uint64_t frame) override;
+
+  /// @copydoc RingBuffer::waitFence
+  virtual bool waitFence(std::uint64_t frame, bool block) override;
+
+private:
+  /// Mock data
+  std::vector<Byte> data_;
+
+  /// Number of inserted fences
+  std::size_t numFences_;
+
+  /// All frames before this one have been signaled
+  std::uint64_t numSignaledFrames_;
+};
+
+} // namespace render
+
+} // namespace sequoia
+
+#endif
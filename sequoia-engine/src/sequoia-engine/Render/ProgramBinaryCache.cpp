@@ -0,0 +1,182 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                         _____                        _
+//                        / ____|                      (_)
+//                       | (___   ___  __ _ _   _  ___  _  __ _
+//                        \___ \ / _ \/ _` | | | |/ _ \| |/ _` |
+//                        ____) |  __/ (_| | |_| | (_) | | (_| |
+//                       |_____/ \___|\__, |\__,_|\___/|_|\__,_| - Game Engine (2016-2017)
+//                                       | |
+//                                       |_|
+//
+// This file is distributed under the MIT License (MIT).
+// See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#include "sequoia-engine/Core/Format.h"
+#include "sequoia-engine/Core/Hash.h"
+#include "sequoia-engine/Core/Logging.h"
+#include "sequoia-engine/Core/StringRef.h"
+#include "sequoia-engine/Core/StringUtil.h"
+#include "sequoia-engine/Render/ProgramBinaryCache.h"
+#include "sequoia-engine/Render/Shader.h"
+#include <algorithm>
+#include <cstring>
+
+namespace sequoia {
+
+namespace render {
+
+namespace {
+
+/// @brief Header of a cache entry (followed by the driver string and the binary)
+struct EntryHeader {
+  char Magic[4];
+  std::uint32_t Version;
+  std::uint64_t Key;
+  std::uint32_t Format;
+  std::uint32_t DriverLength;
+  std::uint64_t NumBytes;
+  std::uint64_t Checksum;
+};
+
+static_assert(sizeof(EntryHeader) == 40, "EntryHeader is expected to be unpadded");
+
+static const char EntryMagic[4] = {'S', 'Q', 'P', 'B'};
+
+} // anonymous namespace
+
+ProgramBinaryCache::ProgramBinaryCache(const std::shared_ptr<core::FileSystem>& fileSystem,
+                                       const std::string& driver)
+    : fileSystem_(fileSystem), driver_(driver),
+      driverHash_(core::fnv1a(driver.data(), driver.size())), numHits_(0), numMisses_(0),
+      numInvalid_(0) {}
+
+std::uint64_t
+ProgramBinaryCache::makeKey(const std::set<std::shared_ptr<Shader>>& shaders) const noexcept {
+  std::uint64_t hashes[2] = {ProgramBinaryCache::hash(shaders), driverHash_};
+  return core::fnv1a(hashes, sizeof(hashes));
+}
+
+bool ProgramBinaryCache::load(std::uint64_t key, ProgramBinary& binary) {
+  SEQUOIA_LOCK_GUARD(mutex_);
+  const std::string path = getPath(key);
+
+  std::shared_ptr<core::FileBuffer> buffer;
+  try {
+    if(fileSystem_->exists(path))
+      buffer = fileSystem_->read(path, core::FileBuffer::FF_Binary);
+  } catch(std::exception& e) {
+    Log::warn("Failed to read program binary \"{}\": {}", path, e.what());
+  }
+
+  if(!buffer) {
+    numMisses_++;
+    return false;
+  }
+
+  auto invalid = [this, &path](const char* reason) {
+    Log::warn("Ignoring program binary \"{}\": {}", path, reason);
+    numInvalid_++;
+    return false;
+  };
+
+  // Trailing bytes are ignored as an overwritten entry may be shorter than the previous one
+  const Byte* data = buffer->getDataAs<Byte>();
+  const std::size_t numBytes = buffer->getNumBytes();
+
+  EntryHeader header;
+  if(numBytes < sizeof(EntryHeader))
+    return invalid("truncated header");
+  std::memcpy(&header, data, sizeof(EntryHeader));
+
+  if(std::memcmp(header.Magic, EntryMagic, sizeof(EntryMagic)) != 0)
+    return invalid("invalid magic");
+  if(header.Version != Version)
+    return invalid("version mismatch");
+  if(header.Key != key)
+    return invalid("key mismatch");
+  if(numBytes - sizeof(EntryHeader) < header.DriverLength ||
+     numBytes - sizeof(EntryHeader) - header.DriverLength < header.NumBytes)
+    return invalid("truncated data");
+
+  const char* driver = reinterpret_cast<const char*>(data + sizeof(EntryHeader));
+  if(StringRef(driver, header.DriverLength) != driver_)
+    return invalid("driver mismatch");
+
+  const Byte* blob = data + sizeof(EntryHeader) + header.DriverLength;
+  if(core::fnv1a(blob, header.NumBytes) != header.Checksum)
+    return invalid("checksum mismatch");
+
+  binary.Format = header.Format;
+  binary.Data.assign(blob, blob + header.NumBytes);
+  numHits_++;
+  return true;
+}
+
+bool ProgramBinaryCache::store(std::uint64_t key, const ProgramBinary& binary) {
+  SEQUOIA_LOCK_GUARD(mutex_);
+  const std::string path = getPath(key);
+
+  EntryHeader header;
+  std::memcpy(header.Magic, EntryMagic, sizeof(EntryMagic));
+  header.Version = Version;
+  header.Key = key;
+  header.Format = binary.Format;
+  header.DriverLength = driver_.size();
+  header.NumBytes = binary.Data.size();
+  header.Checksum = core::fnv1a(binary.Data.data(), binary.Data.size());
+
+  try {
+    auto buffer = std::make_shared<core::FileBuffer>(
+        core::FileBuffer::FF_Binary, path, sizeof(EntryHeader) + driver_.size() + header.NumBytes);
+
+    Byte* data = buffer->getDataAs<Byte>();
+    std::memcpy(data, &header, sizeof(EntryHeader));
+    std::memcpy(data + sizeof(EntryHeader), driver_.data(), driver_.size());
+    std::copy(binary.Data.begin(), binary.Data.end(),
+              data + sizeof(EntryHeader) + driver_.size());
+
+    fileSystem_->write(path, buffer);
+  } catch(std::exception& e) {
+    Log::warn("Failed to write program binary \"{}\": {}", path, e.what());
+    return false;
+  }
+  return true;
+}
+
+std::string ProgramBinaryCache::getPath(std::uint64_t key) {
+  return core::format("{:016x}.bin", key);
+}
+
+std::uint64_t
+ProgramBinaryCache::hash(const std::set<std::shared_ptr<Shader>>& shaders) noexcept {
+  // The set is ordered by pointer, hence we sort the individual hashes to get a stable result
+  std::vector<std::uint64_t> hashes;
+  hashes.reserve(shaders.size());
+
+  for(const auto& shader : shaders) {
+    std::uint32_t type = shader->getType();
+    const std::string& source = shader->getSourceCode();
+    hashes.push_back(core::fnv1a(source.data(), source.size(), core::fnv1a(&type, sizeof(type))));
+  }
+
+  std::sort(hashes.begin(), hashes.end());
+  return core::fnv1a(hashes.data(), hashes.size() * sizeof(std::uint64_t));
+}
+
+std::string ProgramBinaryCache::toString() const {
+  return core::format("ProgramBinaryCache[\n"
+                      "  fileSystem = {},\n"
+                      "  driver = \"{}\",\n"
+                      "  numHits = {},\n"
+                      "  numMisses = {},\n"
+                      "  numInvalid = {}\n"
+                      "]",
+                      core::indent(fileSystem_->toString()), driver_, numHits_, numMisses_,
+                      numInvalid_);
+}
+
+} // namespace render
+
+} // namespace sequoia
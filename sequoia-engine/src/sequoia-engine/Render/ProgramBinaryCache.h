@@ -0,0 +1,120 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                         _____                        _
+//                        / ____|                      (_)
+//                       | (___   ___  __ _ _   _  ___  _  __ _
+//                        \___ \ / _ \/ _` | | | |/ _ \| |/ _` |
+//                        ____) |  __/ (_| | |_| | (_) | | (_| |
+//                       |_____/ \___|\__, |\__,_|\___/|_|\__,_| - Game Engine (2016-2017)
+//                                       | |
+//                                       |_|
+//
+// This file is distributed under the MIT License (MIT).
+// See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#ifndef SEQUOIA_ENGINE_RENDER_PROGRAMBINARYCACHE_H
+#define SEQUOIA_ENGINE_RENDER_PROGRAMBINARYCACHE_H
+
+#include "sequoia-engine/Core/Byte.h"
+#include "sequoia-engine/Core/Export.h"
+#include "sequoia-engine/Core/FileSystem.h"
+#include "sequoia-engine/Core/Mutex.h"
+#include "sequoia-engine/Core/NonCopyable.h"
+#include <cstdint>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace sequoia {
+
+namespace render {
+
+class Shader;
+
+/// @brief On-disk cache of linked GPU program binaries
+///
+/// Each entry is stored in its own file, named after the key of the program, which is derived
+/// from the *content* of the shaders (type and source code) and the driver string. The file
+/// starts with a header recording the format version, the key, the driver and a checksum of the
+/// binary; entries which are truncated, corrupted or were produced by a different driver are
+/// reported as cache misses and will be overwritten by the next `store`.
+///
+/// The cache is backend agnostic and only operates on the given `core::FileSystem`, the backend
+/// is responsible for retrieving and uploading the binaries.
+///
+/// @remark Thread-safe
+/// @ingroup render
+class SEQUOIA_API ProgramBinaryCache : public NonCopyable {
+public:
+  /// @brief Current version of the file format (bump to invalidate all existing entries)
+  static constexpr std::uint32_t Version = 1;
+
+  /// @brief Binary representation of a linked program
+  struct ProgramBinary {
+    std::uint32_t Format = 0; ///< Backend specific format of the binary
+    std::vector<Byte> Data;   ///< Binary blob
+  };
+
+  /// @brief Create the cache operating on `fileSystem`
+  ///
+  /// @param fileSystem   File system storing the entries
+  /// @param driver       Identification of the driver (e.g vendor, renderer and version string)
+  ProgramBinaryCache(const std::shared_ptr<core::FileSystem>& fileSystem,
+                     const std::string& driver);
+
+  /// @brief Compute the key of the program linked from `shaders`
+  std::uint64_t makeKey(const std::set<std::shared_ptr<Shader>>& shaders) const noexcept;
+
+  /// @brief Load the binary stored under `key`
+  /// @returns `true` if a valid entry was found and copied to `binary`, `false` otherwise
+  bool load(std::uint64_t key, ProgramBinary& binary);
+
+  /// @brief Store `binary` under `key` (overwrites any existing entry)
+  /// @returns `true` on success, failures are logged but otherwise ignored
+  bool store(std::uint64_t key, const ProgramBinary& binary);
+
+  /// @brief Get the path (relative to the base directory of the file system) of the entry `key`
+  static std::string getPath(std::uint64_t key);
+
+  /// @brief Compute the hash of the content of `shaders` (independent of their order)
+  static std::uint64_t hash(const std::set<std::shared_ptr<Shader>>& shaders) noexcept;
+
+  /// @brief Get the driver string
+  const std::string& getDriver() const noexcept { return driver_; }
+
+  /// @brief Get the number of successful loads
+  std::size_t getNumHits() const noexcept { return numHits_; }
+
+  /// @brief Get the number of loads which did not find an entry
+  std::size_t getNumMisses() const noexcept { return numMisses_; }
+
+  /// @brief Get the number of loads which found an invalid entry
+  std::size_t getNumInvalid() const noexcept { return numInvalid_; }
+
+  /// @brief Convert to string
+  std::string toString() const;
+
+private:
+  /// Access mutex
+  SpinMutex mutex_;
+
+  /// File system storing the entries
+  std::shared_ptr<core::FileSystem> fileSystem_;
+
+  /// Driver string and its hash
+  std::string driver_;
+  std::uint64_t driverHash_;
+
+  /// Statistics
+  std::size_t numHits_;
+  std::size_t numMisses_;
+  std::size_t numInvalid_;
+};
+
+} // namespace render
+
+} // namespace sequoia
+
+#endif
@@ -24,6 +24,8 @@ void RenderCommand::reset(RenderTarget* target) {
   Techniques.clear();
   DrawCommands.clear();
   Scene = nullptr;
+  ViewMatrix = core::optional<math::mat4>();
+  ProjectionMatrix = core::optional<math::mat4>();
 }
 
 } // namespace render
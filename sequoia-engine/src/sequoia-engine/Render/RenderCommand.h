@@ -17,6 +17,7 @@
 #define SEQUOIA_ENGINE_RENDER_RENDERCOMMAND_H
 
 #include "sequoia-engine/Core/Export.h"
+#include "sequoia-engine/Core/Optional.h"
 #include "sequoia-engine/Render/DrawCommand.h"
 #include "sequoia-engine/Render/RenderFwd.h"
 #include <vector>
@@ -37,12 +38,18 @@ struct SEQUOIA_API RenderCommand {
   /// List of techniques to apply
   std::vector<RenderTechnique*> Techniques;
 
-  /// List of draw commands to execute consecutively
+  /// List of draw commands to execute (the Renderer may reorder them to minimize state changes)
   std::vector<DrawCommand> DrawCommands;
 
   /// Scene information (e.g lighting information)
   DrawScene* Scene = nullptr;
 
+  /// Snapshot of the view and projection matrix taken when the command was prepared. If not set,
+  /// the matrices are queried from the Camera of the Viewport while rendering (which is only safe
+  /// if the Camera is not modified concurrently).
+  core::optional<math::mat4> ViewMatrix;
+  core::optional<math::mat4> ProjectionMatrix;
+
   /// @brief Reset the command to it's default state and set the new RenderTarget to `target`
   void reset(RenderTarget* target);
 };
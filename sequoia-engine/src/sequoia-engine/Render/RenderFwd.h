@@ -22,21 +22,26 @@ namespace sequoia {
 
 namespace render {
 
+class BindingSet;
 class Camera;
 class DrawCommand;
 class DrawScene;
 class FrameBuffer;
 class Program;
+class ProgramBinaryCache;
 class Renderer;
 class RenderBuffer;
 class RenderPass;
+class RenderServer;
 class RenderStateCache;
 class RenderSystem;
 class RenderTarget;
 class RenderTechnique;
 class RenderWindow;
+class RingBuffer;
 class Shader;
 class Texture;
+class UniformNameTable;
 class UniformVariable;
 class VertexArrayObject;
 class VertexData;
@@ -44,6 +49,7 @@ class VertexVistor;
 class ViewFrustum;
 class Viewport;
 struct DrawCallContext;
+struct DrawIndirectCommand;
 struct RenderCommand;
 struct RenderPipeline;
 struct TextureParameter;
@@ -15,46 +15,145 @@
 
 #include "sequoia-engine/Render/RenderServer.h"
 #include "sequoia-engine/Core/Logging.h"
+#include <algorithm>
 
 namespace sequoia {
 
 namespace render {
 
-RenderServer::RenderServer() { ressourceCtx_.Join = false; }
+namespace {
+
+/// @brief Worker executing the current thread (if any)
+struct CurrentWorker {
+  const RenderServer* Server = nullptr;
+  std::size_t Index = 0;
+};
+
+static thread_local CurrentWorker currentWorker;
+
+} // anonymous namespace
+
+RenderServer::RenderServer(std::size_t numWorkers)
+    : numPending_(0), numSteals_(0), join_(false) {
+  if(numWorkers == 0)
+    numWorkers = getDefaultNumWorkers();
+
+  Log::debug("Spawning {} render-server workers ...", numWorkers);
+
+  // Allocate all workers before starting them as they steal from each other
+  for(std::size_t i = 0; i < numWorkers; ++i)
+    workers_.emplace_back(std::make_unique<Worker>());
+
+  for(std::size_t i = 0; i < numWorkers; ++i)
+    workers_[i]->Thread = std::thread([this, i]() { run(i); });
+}
+
+std::size_t RenderServer::getDefaultNumWorkers() noexcept {
+  return std::max(1u, std::thread::hardware_concurrency() / 2);
+}
 
 RenderServer::~RenderServer() {
-  ressourceCtx_.Mutex.lock();
-  ressourceCtx_.Join = true;
-  ressourceCtx_.TasksAvailable.notify_all();
-  ressourceCtx_.Mutex.unlock();
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    join_ = true;
+  }
+  jobsAvailable_.notify_all();
+
+  for(auto& worker : workers_)
+    worker->Thread.join();
+}
+
+std::size_t RenderServer::runMainThreadJobs() {
+  std::size_t numJobs = 0;
+  std::shared_ptr<Task> job;
+  while(mainThreadQueue_.try_pop(job)) {
+    job->run();
+    job.reset();
+    numJobs++;
+  }
+  return numJobs;
+}
+
+void RenderServer::push(std::shared_ptr<Task> job, JobPriority priority) {
+  // Jobs spawned by a worker stay local, the others are injected into the shared queue
+  JobQueue& queue = currentWorker.Server == this
+                        ? workers_[currentWorker.Index]->Queues[priority]
+                        : injectionQueues_[priority];
 
-  ressourceCtx_.Thread.join();
+  // Count the job before it becomes visible to the workers, otherwise a worker could pop it (and
+  // decrement the counter) before it was counted
+  {
+    SEQUOIA_LOCK_GUARD(queue.Mutex);
+    numPending_++;
+    queue.Jobs.emplace_back(std::move(job));
+  }
+
+  // Acquire the mutex to not miss a worker which is about to go to sleep
+  { std::lock_guard<std::mutex> lock(mutex_); }
+  jobsAvailable_.notify_one();
 }
 
-void RenderServer::initRessourceThread(std::function<void()> initFunction) {
-  // Log::info("Initializing ressource thread {} ... ", core::LoggerListener::getThreadID());
+std::shared_ptr<Task> RenderServer::pop(std::size_t index) {
+  std::shared_ptr<Task> job;
 
-  ressourceCtx_.Thread = std::thread([this, &initFunction]() {
-    // Initialize the thread
-    initFunction();
+  for(int priority = 0; priority < JP_NumPriorities; ++priority) {
+    // Newest job of our own queue
+    JobQueue& queue = workers_[index]->Queues[priority];
+    {
+      SEQUOIA_LOCK_GUARD(queue.Mutex);
+      if(!queue.Jobs.empty()) {
+        job = std::move(queue.Jobs.back());
+        queue.Jobs.pop_back();
+      }
+    }
 
-    std::shared_ptr<Task> curTask = nullptr;
-    while(!ressourceCtx_.Join) {
+    // Oldest injected job
+    if(!job) {
+      JobQueue& injected = injectionQueues_[priority];
+      SEQUOIA_LOCK_GUARD(injected.Mutex);
+      if(!injected.Jobs.empty()) {
+        job = std::move(injected.Jobs.front());
+        injected.Jobs.pop_front();
+      }
+    }
 
-      // Run as many tasks as possible
-      while(ressourceCtx_.Queue.try_pop(curTask)) {
-        curTask->run();
-        curTask.reset();
+    // Oldest job of the other workers
+    for(std::size_t i = 1; !job && i < workers_.size(); ++i) {
+      JobQueue& victim = workers_[(index + i) % workers_.size()]->Queues[priority];
+      SEQUOIA_LOCK_GUARD(victim.Mutex);
+      if(!victim.Jobs.empty()) {
+        job = std::move(victim.Jobs.front());
+        victim.Jobs.pop_front();
+        numSteals_++;
       }
+    }
+
+    if(job) {
+      numPending_--;
+      return job;
+    }
+  }
+  return nullptr;
+}
+
+void RenderServer::run(std::size_t index) {
+  currentWorker.Server = this;
+  currentWorker.Index = index;
 
-      // Go to sleep if no more tasks are available
-      std::unique_lock<std::mutex> lock(ressourceCtx_.Mutex);
-      ressourceCtx_.TasksAvailable.wait(
-          lock, [this]() -> bool { return !ressourceCtx_.Queue.empty() || ressourceCtx_.Join; });
+  while(true) {
+    if(std::shared_ptr<Task> job = pop(index)) {
+      job->run();
+      continue;
     }
-  });
 
-  // Log::info("Successfully initialized ressource thread {}", core::LoggerListener::getThreadID());
+    // Go to sleep until new jobs are available, exit if we are asked to join and all jobs are done
+    std::unique_lock<std::mutex> lock(mutex_);
+    jobsAvailable_.wait(lock, [this]() { return numPending_ > 0 || join_; });
+    if(join_ && numPending_ == 0)
+      break;
+  }
+
+  currentWorker.Server = nullptr;
 }
 
 } // namespace render
@@ -22,63 +22,134 @@
 #include "sequoia-engine/Core/Mutex.h"
 #include "sequoia-engine/Core/NonCopyable.h"
 #include "sequoia-engine/Core/STLExtras.h"
+#include <array>
 #include <atomic>
 #include <condition_variable>
+#include <deque>
+#include <memory>
 #include <thread>
+#include <vector>
 
 namespace sequoia {
 
 namespace render {
 
-/// @brief Server of the render-system which handles all interaction with the backend render system
+/// @brief Server of the render-system which runs the background jobs (e.g ressource creation or
+/// image decoding)
+///
+/// Jobs are executed by a pool of worker threads. Each worker owns a double-ended queue per
+/// priority: jobs spawned from within a worker are pushed to its own queue and popped in LIFO
+/// order (good locality for nested jobs) while idle workers steal the oldest jobs of the other
+/// workers. Jobs spawned from outside of the workers are put into a shared injection queue (per
+/// priority) which is served in FIFO order, hence early submissions are not starved by later ones.
+/// Higher priorities are always served first, i.e a worker steals a high priority job before it
+/// runs one of its own normal priority jobs.
+///
+/// Jobs which need to run on the main thread (e.g because they require the OpenGL context) are
+/// queued separately and executed by `runMainThreadJobs`.
+///
+/// @note Waiting on the future of a job from within another job can deadlock if all workers are
+/// waiting.
 ///
 /// @ingroup render
 class SEQUOIA_API RenderServer : public NonCopyable {
 public:
-  RenderServer();
+  /// @brief Priority of a job
+  enum JobPriority { JP_High = 0, JP_Normal, JP_Low, JP_NumPriorities };
+
+  /// @brief Spawn the worker threads
+  /// @param numWorkers   Number of workers, `0` uses `getDefaultNumWorkers()`
+  RenderServer(std::size_t numWorkers = 0);
+
+  /// @brief Get the default number of workers i.e half of the hardware threads (at least one)
+  ///
+  /// The other half is left to the main thread and the TBB scheduler (which runs the update of the
+  /// scene), see `game::Game::init`.
+  static std::size_t getDefaultNumWorkers() noexcept;
+
+  /// @brief Finish all queued jobs (except the main-thread jobs) and join the workers
   ~RenderServer();
 
-  /// @brief Spawn a ressource task
+  /// @brief Spawn a job with the given `priority`
   template <class Functor>
-  auto spawnRessourceTask(Functor&& function) {
+  auto spawnJob(Functor&& function, JobPriority priority = JP_Normal) {
     using ReturnType = typename core::function_return_t<decltype(function)>;
 
     auto task = std::make_shared<FutureTask<ReturnType>>(std::move(function));
-    ressourceCtx_.Queue.push(std::static_pointer_cast<Task>(task));
-    ressourceCtx_.TasksAvailable.notify_all();
+    push(std::static_pointer_cast<Task>(task), priority);
     return task->getFuture();
   }
 
-  /// @brief Initialize the ressource thread
-  /// @param initFunction   Function executed by the ressource thread at startup (use this to bind
-  ///                       the context of the render-system for example)
-  void initRessourceThread(std::function<void(void)> initFunction);
+  /// @brief Spawn a job which is executed on the main thread by the next `runMainThreadJobs`
+  template <class Functor>
+  auto spawnMainThreadJob(Functor&& function) {
+    using ReturnType = typename core::function_return_t<decltype(function)>;
 
-private:
-  struct QueueContext {
-    /// Internal queue for tasks
-    concurrent_queue<std::shared_ptr<Task>> Queue;
+    auto task = std::make_shared<FutureTask<ReturnType>>(std::move(function));
+    mainThreadQueue_.push(std::static_pointer_cast<Task>(task));
+    return task->getFuture();
+  }
 
-    /// Handle of the thread
-    std::thread Thread;
+  /// @brief Spawn a ressource task (i.e a job of normal priority)
+  template <class Functor>
+  auto spawnRessourceTask(Functor&& function) {
+    return spawnJob(std::forward<Functor>(function), JP_Normal);
+  }
+
+  /// @brief Run all queued main-thread jobs (call this from the main thread)
+  /// @returns number of executed jobs
+  std::size_t runMainThreadJobs();
+
+  /// @brief Get the number of worker threads
+  std::size_t getNumWorkers() const noexcept { return workers_.size(); }
 
-    /// Condition variable used to wait if the queue is empty i.e clients wake the worker thread up
-    /// via this variable
-    std::condition_variable TasksAvailable;
+  /// @brief Get the number of jobs which were stolen from another worker
+  std::size_t getNumSteals() const noexcept { return numSteals_.load(); }
 
-    /// Mutex to modify `TasksAvailable`
-    std::mutex Mutex;
+private:
+  /// @brief Queue of jobs of one priority (owned by a worker or shared for the injected jobs)
+  struct JobQueue {
+    SpinMutex Mutex;
+    std::deque<std::shared_ptr<Task>> Jobs;
+  };
 
-    /// Signal the thread it should exit the function and join the main thread
-    std::atomic<bool> Join;
+  /// @brief Worker thread and its queues
+  struct Worker {
+    std::thread Thread;
+    std::array<JobQueue, JP_NumPriorities> Queues;
   };
 
-  /// @brief Implementation of the working threads
-  static void runImpl(QueueContext* ctx);
+  /// @brief Queue the `job`
+  void push(std::shared_ptr<Task> job, JobPriority priority);
+
+  /// @brief Pop a job from the queues of worker `index` or steal one from the other workers
+  std::shared_ptr<Task> pop(std::size_t index);
+
+  /// @brief Implementation of the worker threads
+  void run(std::size_t index);
 
 private:
-  /// Context of the ressource tasks
-  QueueContext ressourceCtx_;
+  /// Workers
+  std::vector<std::unique_ptr<Worker>> workers_;
+
+  /// Jobs spawned from outside of the workers (served in FIFO order)
+  std::array<JobQueue, JP_NumPriorities> injectionQueues_;
+
+  /// Jobs which need to run on the main thread
+  concurrent_queue<std::shared_ptr<Task>> mainThreadQueue_;
+
+  /// Number of queued jobs (excluding the main-thread jobs)
+  std::atomic<std::size_t> numPending_;
+
+  /// Number of stolen jobs
+  std::atomic<std::size_t> numSteals_;
+
+  /// Condition variable used to wake up idle workers (and its mutex)
+  std::condition_variable jobsAvailable_;
+  std::mutex mutex_;
+
+  /// Signal the workers they should exit once all jobs are done
+  bool join_;
 };
 
 } // namespace render
@@ -13,8 +13,10 @@
 //
 //===------------------------------------------------------------------------------------------===//
 
+#include "sequoia-engine/Core/Platform.h"
 #include "sequoia-engine/Core/Unreachable.h"
 #include "sequoia-engine/Render/Exception.h"
+#include "sequoia-engine/Render/RenderServer.h"
 #include "sequoia-engine/Render/RenderSystem.h"
 #include "sequoia-engine/Render/Renderer.h"
 
@@ -61,6 +63,7 @@ RenderSystem::RenderSystem(RenderSystemKind kind, const std::shared_ptr<Options>
     : RenderSystemObject(kind), options_(options) {
   SEQUOIA_ASSERT_MSG(options_, "invalid options");
   shaderSourceManager_ = std::make_unique<ShaderSourceManager>(language);
+  renderServer_ = std::make_unique<RenderServer>(options_->getInt("Render.NumWorkers"));
 }
 
 void RenderSystem::setDefaultOptions(const std::shared_ptr<Options>& options) {
@@ -80,6 +83,14 @@ void RenderSystem::setDefaultOptions(const std::shared_ptr<Options>& options) {
 
   options->setDefaultInt("Render.MSAA", 0); 
   options->setDefaultBool("Render.VSync", true);
+  options->setDefaultInt("Render.StreamBufferSize", 8 << 20);
+  options->setDefaultBool("Render.VertexDataArenas", true);
+  options->setDefaultInt("Render.VertexDataArenaInitialNumVertices", 1 << 16);
+  options->setDefaultInt("Render.VertexDataArenaInitialNumIndices", 3 << 16);
+  options->setDefaultInt("Render.VertexDataArenaNumVertices", 1 << 20);
+  options->setDefaultInt("Render.VertexDataArenaNumIndices", 3 << 20);
+  options->setDefaultInt("Render.TextureStreamingBudget", 4 << 20);
+  options->setDefaultInt("Render.NumWorkers", 0);
   options->setDefaultBool(
       "Render.TraceAPI", false,
       OptionMetaData{"trace", "t", false, "",
@@ -88,11 +99,18 @@ void RenderSystem::setDefaultOptions(const std::shared_ptr<Options>& options) {
   // OpenGL
   options->setDefaultInt("Render.GL.MajorVersion", 4);
   options->setDefaultInt("Render.GL.MinorVersion", 5);
+  options->setDefaultBool("Render.GL.ProgramCache", true);
+  options->setDefaultString("Render.GL.ProgramCacheDir",
+                            platform::toAnsiString(platform::filesystem::temp_directory_path() /
+                                                   PLATFORM_STR("sequoia-engine") /
+                                                   PLATFORM_STR("ProgramCache")));
 }
 
 RenderSystem::~RenderSystem() {}
 
 void RenderSystem::renderOneFrame(const RenderCommand& command) {
+  renderServer_->runMainThreadJobs();
+
   for(FrameListener* listener : getListeners<FrameListener>())
     listener->frameListenerRenderingBegin(command);
 
@@ -129,6 +129,10 @@ public:
   /// @throws RenderSystemException   Shader `filename` does not exists.
   const std::string& loadShaderSource(const std::string& filename) const;
 
+  /// @brief Get the server running the asynchronous tasks of the render-system (e.g decoding of
+  /// streamed textures)
+  RenderServer* getRenderServer() const { return renderServer_.get(); }
+
   /// @brief Set if we run in debug-mode
   Options& getOptions() const { return *options_; }
   Options* getOptionsPtr() const { return options_.get(); }
@@ -144,6 +148,9 @@ private:
   /// Builtin shader sources
   std::unique_ptr<ShaderSourceManager> shaderSourceManager_;
 
+  /// Server of the asynchronous tasks
+  std::unique_ptr<RenderServer> renderServer_;
+
 private:
   static void setDefaultOptions(const std::shared_ptr<Options>& options);
 };
@@ -16,8 +16,11 @@
 #include "sequoia-engine/Core/Compiler.h"
 #include "sequoia-engine/Core/Format.h"
 #include "sequoia-engine/Core/Logging.h"
+#include "sequoia-engine/Core/RadixSort.h"
 #include "sequoia-engine/Core/StringUtil.h"
+#include "sequoia-engine/Render/BindingSet.h"
 #include "sequoia-engine/Render/Camera.h"
+#include "sequoia-engine/Render/CameraBlock.h"
 #include "sequoia-engine/Render/DrawCallContext.h"
 #include "sequoia-engine/Render/DrawCommand.h"
 #include "sequoia-engine/Render/Program.h"
@@ -34,6 +37,8 @@
 #include <boost/preprocessor/seq/enum.hpp>
 #include <boost/preprocessor/seq/for_each.hpp>
 #include <boost/preprocessor/stringize.hpp>
+#include <algorithm>
+#include <limits>
 
 namespace sequoia {
 
@@ -61,6 +66,26 @@ std::string stringify(const std::string& value) {
   return value;
 }
 
+template <>
+std::string stringify(const UniformID& id) {
+  return UniformNameTable::getGlobal().getName(id);
+}
+
+template <>
+std::string stringify(const std::vector<Byte>& data) {
+  return core::format("{} bytes", data.size());
+}
+
+template <>
+std::string stringify(const std::vector<math::mat4>& matrices) {
+  return core::format("{} instance matrices", matrices.size());
+}
+
+template <>
+std::string stringify(const std::vector<DrawIndirectCommand>& commands) {
+  return core::format("{} indirect commands", commands.size());
+}
+
 template <>
 std::string stringify(const std::set<RenderBuffer::RenderBufferKind>& buffersToClear) {
   return core::toStringRange(buffersToClear, [](const auto& buffer) {
@@ -80,8 +105,8 @@ std::string stringify(const std::set<RenderBuffer::RenderBufferKind>& buffersToC
   });
 }
 
-template <>
-std::string stringify(const std::unordered_map<int, Texture*>& textures) {
+template <class Range>
+std::string stringifyTextures(const Range& textures) {
   return textures.empty() ? "null" : core::toStringRange(textures, [](const auto& var) {
     return core::indent(core::format("texture = {{\n"
                                      "  unit = {},\n"
@@ -91,6 +116,48 @@ std::string stringify(const std::unordered_map<int, Texture*>& textures) {
   });
 }
 
+template <>
+std::string stringify(const std::unordered_map<int, Texture*>& textures) {
+  return stringifyTextures(textures);
+}
+
+template <>
+std::string stringify(const ArrayRef<std::pair<int, Texture*>>& textures) {
+  return stringifyTextures(textures);
+}
+
+/// @brief Check if `other` can be drawn as an instance of `first`
+bool isInstanceOf(const DrawCommand& first, const DrawCommand& other) noexcept {
+  return first.getVertexData() == other.getVertexData() &&
+         first.getBindingSet() == other.getBindingSet() && first.getUniforms().empty() &&
+         other.getUniforms().empty();
+}
+
+/// @brief Check if `other` can be drawn in the same multi-draw as `first`
+bool isMultiDrawableWith(const DrawCommand& first, const DrawCommand& other) noexcept {
+  return first.getVertexData()->getStorage() == other.getVertexData()->getStorage() &&
+         first.getVertexData()->hasIndices() == other.getVertexData()->hasIndices() &&
+         first.getBindingSet() == other.getBindingSet() && first.getUniforms().empty() &&
+         other.getUniforms().empty();
+}
+
+/// @brief Get the ID of `key` or assign the next free ID if `key` is seen for the first time
+///
+/// If we run out of IDs (i.e exceed the `numBits` of the field in the sort key), all remaining keys
+/// share the last ID (which only makes the sorting less effective).
+template <class KeyType>
+std::uint16_t getOrInsertID(std::unordered_map<KeyType, std::uint16_t>& ids, const KeyType& key,
+                            int numBits) {
+  auto it = ids.find(key);
+  if(it != ids.end())
+    return it->second;
+
+  const std::size_t maxID = (std::size_t(1) << numBits) - 1;
+  std::uint16_t id = static_cast<std::uint16_t>(std::min<std::size_t>(ids.size(), maxID));
+  ids.emplace(key, id);
+  return id;
+}
+
 } // anonymous namespace
 
 #define SEQUOIA_PP_STRINGIFY_ARGUMENT(r, Data, Elem)                                               \
@@ -115,7 +182,10 @@ std::string stringify(const std::unordered_map<int, Texture*>& textures) {
 
 Renderer::Renderer(RenderSystemKind kind)
     : RenderSystemObject(kind), forceRenderPipelineUpdate_(true), x_(-1), y_(-1), width_(-1),
-      height_(-1), vertexData_(nullptr) {}
+      height_(-1), vertexData_(nullptr), uniformCacheProgram_(nullptr), uniformCache_(nullptr),
+      matMVPID_(UniformNameTable::getGlobal().intern("u_matMVP")),
+      instancedID_(UniformNameTable::getGlobal().intern("u_instanced")), sortDrawCommands_(true),
+      instancing_(true), multiDrawIndirect_(true) {}
 
 void Renderer::reset() {
   forceRenderPipelineUpdate_ = true;
@@ -123,13 +193,15 @@ void Renderer::reset() {
   vertexData_ = nullptr;
   textures_.clear();
   uniforms_.clear();
+  uniformCacheProgram_ = nullptr;
+  uniformCache_ = nullptr;
   x_ = y_ = width_ = height_ = -1;
 }
 
 void Renderer::resetUniforms(Program* program) {
   auto it = uniforms_.find(program);
   if(it != uniforms_.end())
-    it->second.clear();
+    std::fill(it->second.begin(), it->second.end(), UniformVariable());
 }
 
 bool Renderer::setRenderPipeline(const RenderPipeline& pipeline) {
@@ -152,68 +224,82 @@ bool Renderer::setRenderPipeline(const RenderPipeline& pipeline) {
   return true;
 }
 
-bool Renderer::setUniformVariable(Program* program, const std::string& name,
-                                  const UniformVariable& value) {
-  std::unordered_map<std::string, UniformVariable>& oldUniformVariables = uniforms_[program];
-
-  auto it = oldUniformVariables.find(name);
-  bool updateNeeded = false;
-
-  if(it == oldUniformVariables.end()) {
-    // Variable does not exist -> update
-    updateNeeded = true;
-  } else {
-    if(it->second != value)
-      // Variable exists but with different value -> update
-      updateNeeded = true;
+bool Renderer::setUniformVariable(Program* program, UniformID id, const UniformVariable& value) {
+  if(program != uniformCacheProgram_) {
+    uniformCache_ = &uniforms_[program];
+    uniformCacheProgram_ = program;
   }
 
-  if(updateNeeded) {
-    if(!UniformVariableChanged(program, name, value))
+  std::vector<UniformVariable>& oldUniformVariables = *uniformCache_;
+  if(id >= oldUniformVariables.size())
+    oldUniformVariables.resize(id + 1);
+
+  // Unset variables are invalid and thus never compare equal to `value`
+  UniformVariable& oldValue = oldUniformVariables[id];
+  if(oldValue != value) {
+    if(!UniformVariableChanged(program, id, value))
       return false;
-    oldUniformVariables[name] = value;
+    oldValue = value;
   }
 
   return true;
 }
 
+bool Renderer::setUniformVariable(Program* program, const std::string& name,
+                                  const UniformVariable& value) {
+  return setUniformVariable(program, UniformNameTable::getGlobal().intern(name), value);
+}
+
 bool Renderer::setTextures(const std::unordered_map<int, Texture*>& textures) {
-  if(textures_ != textures) {
-    // There are 4 possible scenarios for each texture-unit/texture pair
-    //
-    //  1. Texture unit is bound in `textures_` and requested in `textures` and they share the same
-    //     texture -> do nothing
-    //  2. Texture unit is bound in `textures_` and requested in `textures` but their textures
-    //     differ -> set new texture
-    //  3. Texture unit is not bound in `textures_` but requested in `textures`
-    //     -> enable the unit and set the texture
-    //  4. Texture unit is not bound in `textures_` but not requsted in `textures`-> disable unit
-    //
-    for(const std::pair<int, Texture*>& texPair : textures) {
-      int textureUnit = texPair.first;
-      Texture* texture = texPair.second;
-
-      auto it = textures_.find(textureUnit);
-      if(it == textures_.end()) {
-        // Handle case 3
-        if(!TextureChanged(textureUnit, texture, true))
-          return false;
-      } else {
-        if(texture != it->second)
-          // Handle case 2
-          if(!TextureChanged(textureUnit, texture, true))
-            return false;
-      }
+  std::vector<std::pair<int, Texture*>> texturesVec(textures.begin(), textures.end());
+  return setTextures(texturesVec);
+}
+
+bool Renderer::setTextures(ArrayRef<std::pair<int, Texture*>> textures) {
+  // There are 4 possible scenarios for each texture-unit/texture pair
+  //
+  //  1. Texture unit is bound in `textures_` and requested in `textures` and they share the same
+  //     texture -> do nothing
+  //  2. Texture unit is bound in `textures_` and requested in `textures` but their textures
+  //     differ -> set new texture
+  //  3. Texture unit is not bound in `textures_` but requested in `textures`
+  //     -> enable the unit and set the texture
+  //  4. Texture unit is bound in `textures_` but not requsted in `textures`-> disable unit
+  //
+  for(const std::pair<int, Texture*>& texPair : textures) {
+    int textureUnit = texPair.first;
+    Texture* texture = texPair.second;
+
+    auto it = textures_.find(textureUnit);
+    if(it == textures_.end()) {
+      // Handle case 3
+      if(!TextureChanged(textureUnit, texture, true))
+        return false;
+      textures_.emplace(textureUnit, texture);
+    } else if(texture != it->second) {
+      // Handle case 2
+      if(!TextureChanged(textureUnit, texture, true))
+        return false;
+      it->second = texture;
     }
+  }
 
-    for(const std::pair<int, Texture*>& texPair : textures_) {
-      if(!textures.count(texPair.first))
+  if(textures_.size() != textures.size()) {
+    for(auto it = textures_.begin(); it != textures_.end();) {
+      int textureUnit = it->first;
+      bool isRequested =
+          std::find_if(textures.begin(), textures.end(), [&](const std::pair<int, Texture*>& p) {
+            return p.first == textureUnit;
+          }) != textures.end();
+
+      if(!isRequested) {
         // Handle case 4
-        if(!TextureChanged(texPair.first, texPair.second, false))
+        if(!TextureChanged(textureUnit, it->second, false))
           return false;
+        it = textures_.erase(it);
+      } else
+        ++it;
     }
-
-    textures_ = textures;
   }
 
   return true;
@@ -221,8 +307,10 @@ bool Renderer::setTextures(const std::unordered_map<int, Texture*>& textures) {
 
 bool Renderer::setVertexData(VertexData* vertexData) {
   if(vertexData_ != vertexData) {
-    if(!VertexDataChanged(vertexData))
-      return false;
+    // VertexData sharing the same storage share the bound buffers
+    if(!vertexData_ || vertexData_->getStorage() != vertexData->getStorage())
+      if(!VertexDataChanged(vertexData))
+        return false;
     vertexData_ = vertexData;
   }
   return true;
@@ -242,7 +330,68 @@ bool Renderer::setViewport(const Viewport* viewport) {
   return true;
 }
 
+std::uint64_t Renderer::makeSortKey(std::uint16_t programID, std::uint16_t bindingSetID,
+                                     std::uint16_t storageID, std::uint16_t vertexDataID,
+                                     float depth) noexcept {
+  auto field = [](std::uint64_t value, int numBits, int shift) {
+    return (value & ((std::uint64_t(1) << numBits) - 1)) << shift;
+  };
+
+  const std::uint64_t maxDepth = (std::uint64_t(1) << SK_DepthBits) - 1;
+  std::uint64_t depthBits = static_cast<std::uint64_t>(math::clamp(depth, 0.0f, 1.0f) * maxDepth);
+
+  return field(programID, SK_ProgramBits, 52) | field(bindingSetID, SK_BindingSetBits, 36) |
+         field(storageID, SK_StorageBits, 24) | field(vertexDataID, SK_VertexDataBits, 12) |
+         depthBits;
+}
+
+void Renderer::computeDrawOrder(const std::vector<DrawCommand>& drawCommands,
+                                const math::mat4& matVP) {
+  drawOrder_.resize(drawCommands.size());
+
+  if(!sortDrawCommands_) {
+    for(std::uint32_t i = 0; i < drawCommands.size(); ++i)
+      drawOrder_[i] = std::make_pair(0, i);
+    return;
+  }
+
+  // The program is fixed by the RenderPass, yet we keep it in the key to be independent of it
+  const std::uint16_t programID = getOrInsertID(programIDs_, pipeline_.Program, SK_ProgramBits);
+
+  for(std::uint32_t i = 0; i < drawCommands.size(); ++i) {
+    const DrawCommand& drawCommand = drawCommands[i];
+
+    // Only draws sharing the BindingSet can be merged into instanced draws (sharing the textures
+    // is not enough)
+    std::uint16_t bindingSetID =
+        getOrInsertID(bindingSetIDs_, drawCommand.getBindingSet(), SK_BindingSetBits);
+
+    // Views into the same arena share the storage and thus the VAO, hence they are drawn
+    // back-to-back (grouped by view to allow instancing)
+    const VertexData* vertexData = drawCommand.getVertexData();
+    std::uint16_t storageID = getOrInsertID(storageIDs_, vertexData->getStorage(), SK_StorageBits);
+    std::uint16_t vertexDataID = getOrInsertID(vertexDataIDs_, vertexData, SK_VertexDataBits);
+
+    // Depth of the origin of the model in normalized device coordinates mapped to [0, 1] (objects
+    // behind the camera get a depth of 0)
+    math::vec4 clipPos = matVP * drawCommand.getModelMatrix()[3];
+    float depth = clipPos.w > 0.0f ? 0.5f * (clipPos.z / clipPos.w) + 0.5f : 0.0f;
+
+    drawOrder_[i] =
+        std::make_pair(makeSortKey(programID, bindingSetID, storageID, vertexDataID, depth), i);
+  }
+
+  core::radixSort(drawOrder_, drawOrderScratch_,
+                  [](const std::pair<std::uint64_t, std::uint32_t>& p) { return p.first; });
+}
+
 void Renderer::render(const RenderCommand& command) {
+  // IDs are only valid for a single frame
+  programIDs_.clear();
+  bindingSetIDs_.clear();
+  storageIDs_.clear();
+  vertexDataIDs_.clear();
+
   for(RenderTechnique* technique : command.Techniques) {
     SEQUOIA_ASSERT(technique);
     auto rendererFun = [&command, &technique, this](RenderPass* pass) -> void {
@@ -251,7 +400,12 @@ void Renderer::render(const RenderCommand& command) {
       Viewport* viewport = command.Target->getViewport();
       SEQUOIA_ASSERT_MSG(viewport, "no Viewport set");
 
-      DrawCallContext ctx(viewport, command.Target, command.Scene, &command.DrawCommands);
+      // Keep the storage of the uniform blocks of the previous passes around
+      for(auto& nameBlockPair : uniformBlocks_)
+        nameBlockPair.second.clear();
+
+      DrawCallContext ctx(viewport, command.Target, command.Scene, &command.DrawCommands,
+                          uniformBlocks_);
       pass->setUp(ctx);
 
       // Update the pipeline (including the program)
@@ -268,25 +422,94 @@ void Renderer::render(const RenderCommand& command) {
         SEQUOIA_CALL_OR_CONTINUE(setUniformVariable, pipeline_.Program, name, value);
       }
 
-      Camera* camera = ctx.Viewport->getCamera();
-      SEQUOIA_ASSERT_MSG(camera, "no Camera set");
+      // Compute the camera matrices (unless the command carries a snapshot)
+      CameraBlock cameraBlock;
+      if(command.ViewMatrix && command.ProjectionMatrix) {
+        cameraBlock.matView = *command.ViewMatrix;
+        cameraBlock.matProj = *command.ProjectionMatrix;
+      } else {
+        Camera* camera = ctx.Viewport->getCamera();
+        SEQUOIA_ASSERT_MSG(camera, "no Camera set");
+        cameraBlock.matView = camera->getViewMatrix();
+        cameraBlock.matProj = camera->getProjectionMatrix();
+      }
+      cameraBlock.matViewProj = cameraBlock.matProj * cameraBlock.matView;
+      const math::mat4& matVP = cameraBlock.matViewProj;
+
+      // Write the camera block once for the whole pass (unless the pass provides its own)
+      if(!ctx.hasUniformBlock<CameraBlock>())
+        ctx.setUniformBlock(cameraBlock);
+
+      for(const auto& nameBlockPair : ctx.UniformBlocks)
+        if(!nameBlockPair.second.empty())
+          SEQUOIA_CALL_OR_CONTINUE(bindUniformBlock, nameBlockPair.first, nameBlockPair.second);
 
-      // Compute projection-view matrix
-      math::mat4 matVP = camera->getViewProjectionMatrix();
+      // Determine the submission order of the DrawCommands
+      computeDrawOrder(command.DrawCommands, matVP);
+
+      // Merge the DrawCommands into instanced draws and multi-draws?
+      const bool instancing = instancing_ && supportsInstancing(pipeline_.Program);
+      const bool multiDrawIndirect =
+          instancing && multiDrawIndirect_ && supportsMultiDrawIndirect();
 
       // Render the DrawCommands
-      for(const DrawCommand& drawCommand : command.DrawCommands) {
+      for(std::size_t i = 0, numInstances = 0; i < drawOrder_.size(); i += numInstances) {
+        const DrawCommand& drawCommand = command.DrawCommands[drawOrder_[i].second];
+
+        // Gather the consecutive DrawCommands which can be drawn as instances of `drawCommand` (or
+        // in the same multi-draw). Each run of instances sharing the same VertexData is recorded
+        // as one indirect command.
+        numInstances = 1;
+        if(instancing) {
+          instanceMatrices_.clear();
+          instanceMatrices_.push_back(drawCommand.getModelMatrix());
+          indirectCommands_.clear();
+          indirectCommands_.push_back(DrawIndirectCommand::create(drawCommand.getVertexData(), 0));
+
+          for(; i + numInstances < drawOrder_.size(); ++numInstances) {
+            const DrawCommand& instance =
+                command.DrawCommands[drawOrder_[i + numInstances].second];
+            const DrawCommand& previous =
+                command.DrawCommands[drawOrder_[i + numInstances - 1].second];
+
+            if(isInstanceOf(previous, instance))
+              indirectCommands_.back().InstanceCount++;
+            else if(multiDrawIndirect && isMultiDrawableWith(drawCommand, instance))
+              indirectCommands_.push_back(DrawIndirectCommand::create(
+                  instance.getVertexData(), static_cast<std::uint32_t>(instanceMatrices_.size())));
+            else
+              break;
+
+            instanceMatrices_.push_back(instance.getModelMatrix());
+          }
+        }
+
+        // Set the uniforms of the BindingSet
+        if(const BindingSet* bindingSet = drawCommand.getBindingSet()) {
+          for(const auto& idVariablePair : bindingSet->getUniforms()) {
+            const UniformID id = idVariablePair.first;
+            const UniformVariable& value = idVariablePair.second;
+            SEQUOIA_CALL_OR_CONTINUE(setUniformVariable, pipeline_.Program, id, value);
+          }
+        }
 
         // Set per DrawCommand uniforms
-        for(const auto& nameVariablePair : drawCommand.getUniforms()) {
-          const std::string& name = nameVariablePair.first;
-          const UniformVariable& value = nameVariablePair.second;
-          SEQUOIA_CALL_OR_CONTINUE(setUniformVariable, pipeline_.Program, name, value);
+        for(const auto& idVariablePair : drawCommand.getUniforms()) {
+          const UniformID id = idVariablePair.first;
+          const UniformVariable& value = idVariablePair.second;
+          SEQUOIA_CALL_OR_CONTINUE(setUniformVariable, pipeline_.Program, id, value);
         }
 
-        UniformVariable u_matMVP = matVP * drawCommand.getModelMatrix();
-        std::string name = "u_matMVP";
-        SEQUOIA_CALL_OR_CONTINUE(setUniformVariable, pipeline_.Program, name, u_matMVP);
+        // A single instance is drawn without streaming its model matrix
+        const bool drawInstances = instancing && instanceMatrices_.size() > 1;
+        if(instancing)
+          SEQUOIA_CALL_OR_CONTINUE(setUniformVariable, pipeline_.Program, instancedID_,
+                                   UniformVariable(drawInstances));
+
+        if(!drawInstances) {
+          UniformVariable u_matMVP = matVP * drawCommand.getModelMatrix();
+          SEQUOIA_CALL_OR_CONTINUE(setUniformVariable, pipeline_.Program, matMVPID_, u_matMVP);
+        }
 
         // Set textures
         SEQUOIA_CALL_OR_CONTINUE(setTextures, drawCommand.getTextures());
@@ -295,7 +518,13 @@ void Renderer::render(const RenderCommand& command) {
         SEQUOIA_CALL_OR_CONTINUE(setVertexData, drawCommand.getVertexData());
 
         // Issue the draw command
-        SEQUOIA_CALL_OR_CONTINUE(draw, drawCommand);
+        if(drawInstances && indirectCommands_.size() > 1) {
+          SEQUOIA_CALL_OR_CONTINUE(drawIndirect, drawCommand, indirectCommands_, instanceMatrices_);
+        } else if(drawInstances) {
+          SEQUOIA_CALL_OR_CONTINUE(drawInstanced, drawCommand, instanceMatrices_);
+        } else {
+          SEQUOIA_CALL_OR_CONTINUE(draw, drawCommand);
+        }
       }
 
       pass->tearDown(ctx);
@@ -333,7 +562,13 @@ std::pair<std::string, std::string> Renderer::toStringImpl() const {
                        ? "null"
                        : core::toStringRange(uniforms_, [this](const auto& programUniformMapPair) {
                            Program* program = programUniformMapPair.first;
-                           const auto& uniformMap = programUniformMapPair.second;
+                           const auto& uniformValues = programUniformMapPair.second;
+
+                           std::vector<std::pair<UniformID, const UniformVariable*>> uniformMap;
+                           for(UniformID id = 0; id < uniformValues.size(); ++id)
+                             if(uniformValues[id].getType() != UniformType::Invalid)
+                               uniformMap.emplace_back(id, &uniformValues[id]);
+
                            return core::indent(core::format(
                                "perProgramUniforms = {{\n"
                                "  program = {},\n"
@@ -343,14 +578,15 @@ std::pair<std::string, std::string> Renderer::toStringImpl() const {
                                uniformMap.empty()
                                    ? "null"
                                    : core::indent(core::toStringRange(
-                                         uniformMap, [](const auto& nameVariablePair) {
+                                         uniformMap, [](const auto& idVariablePair) {
                                            return core::indent(core::format(
                                                "uniform = {{\n"
                                                "  name = {},\n"
                                                "  variable = {}\n"
                                                "}}",
-                                               nameVariablePair.first,
-                                               core::indent(nameVariablePair.second.toString())));
+                                               UniformNameTable::getGlobal().getName(
+                                                   idVariablePair.first),
+                                               core::indent(idVariablePair.second->toString())));
                                          }))));
                          })));
 }
@@ -16,17 +16,24 @@
 #ifndef SEQUOIA_ENGINE_RENDER_RENDERER_H
 #define SEQUOIA_ENGINE_RENDER_RENDERER_H
 
+#include "sequoia-engine/Core/ArrayRef.h"
+#include "sequoia-engine/Core/Byte.h"
 #include "sequoia-engine/Core/Export.h"
+#include "sequoia-engine/Math/Math.h"
+#include "sequoia-engine/Render/DrawIndirectCommand.h"
 #include "sequoia-engine/Render/RenderBuffer.h"
 #include "sequoia-engine/Render/RenderFwd.h"
 #include "sequoia-engine/Render/RenderPipeline.h"
 #include "sequoia-engine/Render/RenderSystemObject.h"
+#include "sequoia-engine/Render/UniformNameTable.h"
 #include "sequoia-engine/Render/UniformVariable.h"
 #include "sequoia-engine/Render/VertexData.h"
 #include <cstdint>
 #include <set>
 #include <string>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace sequoia {
 
@@ -46,24 +53,103 @@ public:
   /// @returns `true` if the RenderPipeline was successfully updated, `false` otherwise
   bool setRenderPipeline(const RenderPipeline& pipeline);
 
-  /// @brief Set the uniform variable `name` of `program` to `value`
+  /// @brief Set the uniform variable `id` (or `name`) of `program` to `value`
+  ///
+  /// The values are cached per program and indexed by the `UniformID`, the overload taking the
+  /// `name` needs to intern it first and should not be used in the per-draw hot path.
+  /// @{
+  bool setUniformVariable(Program* program, UniformID id, const UniformVariable& value);
   bool setUniformVariable(Program* program, const std::string& name, const UniformVariable& value);
+  /// @}
 
   /// @brief Set texture-unit/texture pairs
   ///
   /// Note that each call potentially disables all texture units which are not present in
   /// `textures`. Thus, you should only call this function once per draw-call.
+  /// @{
   bool setTextures(const std::unordered_map<int, Texture*>& textures);
+  bool setTextures(ArrayRef<std::pair<int, Texture*>> textures);
+  /// @}
 
   /// @brief Bind the vertex-data
+  ///
+  /// `VertexDataChanged` is only called if the storage of the vertex-data changes (see
+  /// `VertexData::getStorage`).
   bool setVertexData(VertexData* vertexData);
 
   /// @brief Set the viewport
   bool setViewport(const Viewport* viewport);
-  
+
   /// @brief Render `command`
+  ///
+  /// If sorting is enabled (the default), the `DrawCommand`s of each pass are submitted in the
+  /// order of their sort key (see `makeSortKey`) instead of the order in which they were recorded.
+  /// The `CameraBlock` is bound once per pass.
   void render(const RenderCommand& command);
 
+  /// @brief Enable/disable automatic instancing
+  ///
+  /// If enabled (the default) and the program of the pass supports instancing (see
+  /// `supportsInstancing`), consecutive `DrawCommand`s (in submission order) which share the same
+  /// VertexData and BindingSet and have no per-draw uniform variables are merged into a single
+  /// instanced draw. The per-instance model matrices are passed to `drawInstanced` (the program
+  /// transforms them with the `CameraBlock`) and the uniform variable `u_instanced` is set to
+  /// `true`. Draws of a single instance set `u_instanced` to `false` and are drawn with `draw`
+  /// using the uniform variable `u_matMVP`.
+  void setInstancing(bool instancing) noexcept { instancing_ = instancing; }
+  bool isInstancing() const noexcept { return instancing_; }
+
+  /// @brief Enable/disable merging of draws into multi-draws
+  ///
+  /// If enabled (the default), instancing is active and the backend supports it (see
+  /// `supportsMultiDrawIndirect`), consecutive `DrawCommand`s which share the same BindingSet, have
+  /// no per-draw uniform variables and whose VertexData live in the same storage (see
+  /// `VertexData::getStorage`) are merged into a single call to `drawIndirect`. Each run of
+  /// `DrawCommand`s with the same VertexData becomes one `DrawIndirectCommand` drawing several
+  /// instances.
+  void setMultiDrawIndirect(bool multiDrawIndirect) noexcept {
+    multiDrawIndirect_ = multiDrawIndirect;
+  }
+  bool isMultiDrawIndirect() const noexcept { return multiDrawIndirect_; }
+
+  /// @brief Enable/disable sorting of the `DrawCommand`s by their sort key
+  void setSortDrawCommands(bool sortDrawCommands) noexcept { sortDrawCommands_ = sortDrawCommands; }
+  bool isSortingDrawCommands() const noexcept { return sortDrawCommands_; }
+
+  /// @brief Number of bits of the fields of the sort key (see `makeSortKey`)
+  enum SortKeyBits : int {
+    SK_ProgramBits = 12,
+    SK_BindingSetBits = 16,
+    SK_StorageBits = 12,
+    SK_VertexDataBits = 12,
+    SK_DepthBits = 12
+  };
+
+  /// @brief Compute the 64-bit sort key of a draw command
+  ///
+  /// The key is laid out from the most to the least significant bits as:
+  ///
+  /// @verbatim
+  ///   63     52 51         36 35     24 23     12 11      0
+  ///  +---------+-------------+---------+---------+---------+
+  ///  | Program | BindingSet  | Storage | VtxData |  Depth  |
+  ///  +---------+-------------+---------+---------+---------+
+  /// @endverbatim
+  ///
+  /// Sorting by this key groups all draws sharing the same program, then the same BindingSet, the
+  /// same storage of the vertex data (see `VertexData::getStorage`) and the same vertex data, which
+  /// minimizes the number of state changes and places the draws which can be instanced or merged
+  /// into multi-draws next to each other. Draws with identical state are ordered front-to-back.
+  ///
+  /// @param programID      ID of the program
+  /// @param bindingSetID   ID of the BindingSet
+  /// @param storageID      ID of the storage of the vertex data
+  /// @param vertexDataID   ID of the vertex data
+  /// @param depth          Normalized depth in `[0, 1]` (values outside are clamped)
+  static std::uint64_t makeSortKey(std::uint16_t programID, std::uint16_t bindingSetID,
+                                   std::uint16_t storageID, std::uint16_t vertexDataID,
+                                   float depth) noexcept;
+
   /// @brief Reset the internal state
   ///
   /// This will essentially force a call to all `<name>Changed` methods on the next `set<name>`
@@ -85,7 +171,7 @@ protected:
   /// @returns `true` if the new program was successfully updated, `false` otherwise
   virtual bool ProgramChanged(Program* program) = 0;
 
-  /// @brief VertexData changed
+  /// @brief VertexData changed (to VertexData with a different storage)
   /// @returns `true` if the new VertexData was successfully updated, `false` otherwise
   virtual bool VertexDataChanged(VertexData* data) = 0;
 
@@ -93,9 +179,9 @@ protected:
   /// @returns `true` if the new texture was successfully updated, `false` otherwise
   virtual bool TextureChanged(int textureUnit, Texture* texture, bool enable) = 0;
 
-  /// @brief The uniform variable `name` of `program` changed
+  /// @brief The uniform variable `id` of `program` changed
   /// @returns `true` if the new UniformVariable was successfully updated, `false` otherwise
-  virtual bool UniformVariableChanged(Program* program, const std::string& name,
+  virtual bool UniformVariableChanged(Program* program, UniformID id,
                                       const UniformVariable& value) = 0;
 
   /// @brief The Viewport changed
@@ -106,13 +192,44 @@ protected:
   virtual bool
   clearRenderBuffers(const std::set<RenderBuffer::RenderBufferKind>& buffersToClear) = 0;
 
+  /// @brief Upload the uniform block `name` (in std140 layout) and bind it to the programs
+  /// @returns `true` if the uniform block was successfully bound, `false` otherwise
+  virtual bool bindUniformBlock(const std::string& name, const std::vector<Byte>& data) = 0;
+
   /// @brief Draw the command
   /// @returns `true` if the new DrawCommand was successfully drawn, `false` otherwise
   virtual bool draw(const DrawCommand& drawCommand) = 0;
 
+  /// @brief Check if `program` can render instances (i.e reads the model matrix per instance)
+  ///
+  /// If a program supports instancing, *all* draws are issued via `drawInstanced` (or
+  /// `drawIndirect`).
+  virtual bool supportsInstancing(Program* program) const = 0;
+
+  /// @brief Draw `matModels.size()` instances of the command where the i-th instance uses the
+  /// model matrix `matModels[i]`
+  /// @returns `true` if the instances were successfully drawn, `false` otherwise
+  virtual bool drawInstanced(const DrawCommand& drawCommand, ArrayRef<math::mat4> matModels) = 0;
+
+  /// @brief Check if the backend can issue multi-draws via `drawIndirect`
+  virtual bool supportsMultiDrawIndirect() const = 0;
+
+  /// @brief Issue all `commands` with a single multi-draw from the storage of the VertexData of
+  /// `drawCommand`
+  ///
+  /// The instances of the i-th command use the model matrices starting at
+  /// `matModels[commands[i].BaseInstance]`.
+  /// @returns `true` if the commands were successfully drawn, `false` otherwise
+  virtual bool drawIndirect(const DrawCommand& drawCommand,
+                            ArrayRef<DrawIndirectCommand> commands,
+                            ArrayRef<math::mat4> matModels) = 0;
+
   /// @brief Implementation of `toString` returns stringified members and title
   virtual std::pair<std::string, std::string> toStringImpl() const;
 
+  /// @brief Compute the order in which `drawCommands` are submitted and store it in `drawOrder_`
+  void computeDrawOrder(const std::vector<DrawCommand>& drawCommands, const math::mat4& matVP);
+
 protected:
   /// If `reset()` was called, all `<name>Changed` methods of the RenderPipeline need to be executed
   /// (regardless of the state)
@@ -130,8 +247,47 @@ protected:
   /// Current bound textures
   std::unordered_map<int, Texture*> textures_;
 
-  /// Keep track of the values of the uniform variables of the Programs
-  std::unordered_map<Program*, std::unordered_map<std::string, UniformVariable>> uniforms_;
+  /// Keep track of the values of the uniform variables of the Programs (indexed by `UniformID`,
+  /// unset variables are invalid)
+  std::unordered_map<Program*, std::vector<UniformVariable>> uniforms_;
+
+  /// Program of the last access to `uniforms_` and its values (avoids the lookup per variable)
+  Program* uniformCacheProgram_;
+  std::vector<UniformVariable>* uniformCache_;
+
+  /// ID of the model-view-projection matrix `u_matMVP` which is set for every non-instanced draw
+  UniformID matMVPID_;
+
+  /// ID of `u_instanced` which is set for every draw of a program supporting instancing
+  UniformID instancedID_;
+
+  /// Sort the DrawCommands before submission?
+  bool sortDrawCommands_;
+
+  /// Merge DrawCommands into instanced draws?
+  bool instancing_;
+
+  /// Merge DrawCommands sharing the storage of their VertexData into multi-draws?
+  bool multiDrawIndirect_;
+
+  /// Model matrices of the instances of the current draw
+  std::vector<math::mat4> instanceMatrices_;
+
+  /// Storage of the uniform blocks of the passes (see `DrawCallContext::UniformBlocks`)
+  std::unordered_map<std::string, std::vector<Byte>> uniformBlocks_;
+
+  /// Commands of the current multi-draw
+  std::vector<DrawIndirectCommand> indirectCommands_;
+
+  /// Sort key and index of the DrawCommands in submission order (and scratch space for sorting)
+  std::vector<std::pair<std::uint64_t, std::uint32_t>> drawOrder_, drawOrderScratch_;
+
+  /// IDs of the programs, BindingSets, storages and vertex data of the current frame (handed out in
+  /// order of first appearance)
+  std::unordered_map<Program*, std::uint16_t> programIDs_;
+  std::unordered_map<const BindingSet*, std::uint16_t> bindingSetIDs_;
+  std::unordered_map<const VertexData*, std::uint16_t> storageIDs_;
+  std::unordered_map<const VertexData*, std::uint16_t> vertexDataIDs_;
 };
 
 } // namespace render
@@ -0,0 +1,144 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                         _____                        _
+//                        / ____|                      (_)
+//                       | (___   ___  __ _ _   _  ___  _  __ _
+//                        \___ \ / _ \/ _` | | | |/ _ \| |/ _` |
+//                        ____) |  __/ (_| | |_| | (_) | | (_| |
+//                       |_____/ \___|\__, |\__,_|\___/|_|\__,_| - Game Engine (2016-2017)
+//                                       | |
+//                                       |_|
+//
+// This file is distributed under the MIT License (MIT).
+// See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#include "sequoia-engine/Core/Assert.h"
+#include "sequoia-engine/Core/Format.h"
+#include "sequoia-engine/Render/Exception.h"
+#include "sequoia-engine/Render/RingBuffer.h"
+#include <cstring>
+
+namespace sequoia {
+
+namespace render {
+
+RingBuffer::RingBuffer(std::size_t numBytes, std::size_t maxFramesInFlight)
+    : data_(nullptr), numBytes_(numBytes), maxFramesInFlight_(maxFramesInFlight), head_(0),
+      numBytesInUse_(0), frame_(0), frameNumBytes_(0), numWrapArounds_(0), numStalls_(0) {
+  SEQUOIA_ASSERT_MSG(numBytes_ > 0, "empty ring buffer");
+  SEQUOIA_ASSERT_MSG(maxFramesInFlight_ > 0, "at least one frame needs to be in flight");
+}
+
+RingBuffer::~RingBuffer() {}
+
+RingBuffer::Allocation RingBuffer::allocate(std::size_t numBytes, std::size_t alignment) {
+  SEQUOIA_ASSERT_MSG(data_, "ring buffer not mapped");
+  SEQUOIA_ASSERT_MSG(numBytes > 0, "empty allocation");
+  SEQUOIA_ASSERT_MSG(alignment > 0 && (alignment & (alignment - 1)) == 0,
+                     "alignment needs to be a power of 2");
+
+  if(numBytes > numBytes_)
+    SEQUOIA_THROW(RenderSystemException, "allocation of {} bytes exceeds ring buffer of {} bytes",
+                  numBytes, numBytes_);
+
+  while(true) {
+    // Align the head or wrap around if the allocation does not fit before the end of the buffer.
+    // The skipped bytes are accounted to the current frame.
+    std::size_t offset = (head_ + alignment - 1) & ~(alignment - 1);
+    const bool wrapAround = offset + numBytes > numBytes_;
+    if(wrapAround)
+      offset = 0;
+    const std::size_t padding = wrapAround ? numBytes_ - head_ : offset - head_;
+
+    if(numBytesInUse_ + padding + numBytes <= numBytes_) {
+      numWrapArounds_ += wrapAround;
+      head_ = offset + numBytes;
+      numBytesInUse_ += padding + numBytes;
+      frameNumBytes_ += padding + numBytes;
+
+      Allocation allocation;
+      allocation.Data = data_ + offset;
+      allocation.Offset = offset;
+      allocation.NumBytes = numBytes;
+      return allocation;
+    }
+
+    if(framesInFlight_.empty())
+      SEQUOIA_THROW(RenderSystemException,
+                    "ring buffer of {} bytes exhausted by a single frame (allocating {} bytes)",
+                    numBytes_, numBytes);
+
+    retireOldestFrame();
+  }
+}
+
+bool RingBuffer::canAllocate(std::size_t numBytes, std::size_t alignment) const noexcept {
+  // Once all frames in flight are retired, an empty frame restarts at the beginning of the buffer
+  if(frameNumBytes_ == 0)
+    return numBytes <= numBytes_;
+
+  std::size_t offset = (head_ + alignment - 1) & ~(alignment - 1);
+  const bool wrapAround = offset + numBytes > numBytes_;
+  if(wrapAround)
+    offset = 0;
+  const std::size_t padding = wrapAround ? numBytes_ - head_ : offset - head_;
+  return frameNumBytes_ + padding + numBytes <= numBytes_;
+}
+
+RingBuffer::Allocation RingBuffer::write(const void* src, std::size_t numBytes,
+                                         std::size_t alignment) {
+  Allocation allocation = allocate(numBytes, alignment);
+  std::memcpy(allocation.Data, src, numBytes);
+  return allocation;
+}
+
+void RingBuffer::endFrame() {
+  // Nothing to guard
+  if(frameNumBytes_ == 0) {
+    ++frame_;
+    return;
+  }
+
+  while(framesInFlight_.size() >= maxFramesInFlight_)
+    retireOldestFrame();
+
+  insertFence(frame_);
+  framesInFlight_.push_back(Frame{frame_, frameNumBytes_});
+
+  ++frame_;
+  frameNumBytes_ = 0;
+}
+
+void RingBuffer::retireOldestFrame() {
+  SEQUOIA_ASSERT(!framesInFlight_.empty());
+  const Frame& frame = framesInFlight_.front();
+
+  if(!waitFence(frame.Sequence, false)) {
+    ++numStalls_;
+    waitFence(frame.Sequence, true);
+  }
+
+  numBytesInUse_ -= frame.NumBytes;
+  framesInFlight_.pop_front();
+
+  // Restart at the beginning of the buffer if it's empty to avoid needless wrap arounds
+  if(numBytesInUse_ == 0)
+    head_ = 0;
+}
+
+std::string RingBuffer::toString() const {
+  return core::format("RingBuffer[\n"
+                      "  numBytes = {},\n"
+                      "  numBytesInUse = {},\n"
+                      "  frame = {},\n"
+                      "  numFramesInFlight = {},\n"
+                      "  maxFramesInFlight = {}\n"
+                      "]",
+                      numBytes_, numBytesInUse_, frame_, framesInFlight_.size(),
+                      maxFramesInFlight_);
+}
+
+} // namespace render
+
+} // namespace sequoia
@@ -0,0 +1,173 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                         _____                        _
+//                        / ____|                      (_)
+//                       | (___   ___  __ _ _   _  ___  _  __ _
+//                        \___ \ / _ \/ _` | | | |/ _ \| |/ _` |
+//                        ____) |  __/ (_| | |_| | (_) | | (_| |
+//                       |_____/ \___|\__, |\__,_|\___/|_|\__,_| - Game Engine (2016-2017)
+//                                       | |
+//                                       |_|
+//
+// This file is distributed under the MIT License (MIT).
+// See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#ifndef SEQUOIA_ENGINE_RENDER_RINGBUFFER_H
+#define SEQUOIA_ENGINE_RENDER_RINGBUFFER_H
+
+#include "sequoia-engine/Core/Byte.h"
+#include "sequoia-engine/Core/Export.h"
+#include "sequoia-engine/Core/NonCopyable.h"
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <string>
+
+namespace sequoia {
+
+namespace render {
+
+/// @brief Ring allocator for streaming per-frame data (e.g dynamic geometry or uniform data) into
+/// a persistently mapped hardware buffer
+///
+/// Each frame sub-allocates its data linearly from the buffer, wrapping around at the end. At the
+/// end of a frame (see `endFrame`), a fence is inserted by the backend which guards all the
+/// allocations of the frame. Memory of a frame is only reused once its fence has been signaled
+/// i.e the GPU is done reading it. By default at most three frames are in flight at the same time
+/// (triple-buffering).
+///
+/// The bookkeeping is backend agnostic; backends map the memory (see `setData`) and implement the
+/// fences (see `insertFence` and `waitFence`). The fences are identified by the sequence number of
+/// the frame and are always inserted and waited for in increasing order.
+///
+/// @ingroup render
+class SEQUOIA_API RingBuffer : public NonCopyable {
+public:
+  /// @brief Sub-allocation of the ring buffer
+  struct Allocation {
+    /// Pointer to the mapped memory to write to
+    void* Data = nullptr;
+
+    /// Byte offset of the allocation from the start of the hardware buffer
+    std::size_t Offset = 0;
+
+    /// Number of bytes allocated
+    std::size_t NumBytes = 0;
+  };
+
+  /// @brief Setup the bookkeeping of a buffer of `numBytes`
+  ///
+  /// @param numBytes             Capacity of the buffer in bytes
+  /// @param maxFramesInFlight    Maximum number of frames which can be in flight at the same time
+  RingBuffer(std::size_t numBytes, std::size_t maxFramesInFlight = 3);
+
+  virtual ~RingBuffer();
+
+  /// @brief Allocate `numBytes` with the given `alignment` for the current frame
+  ///
+  /// If there is not enough free space, the oldest frames in flight are retired which may block
+  /// until the GPU has signaled their fences.
+  ///
+  /// @param numBytes     Number of bytes to allocate (needs to be non-zero)
+  /// @param alignment    Alignment of the offset (needs to be a power of 2)
+  /// @throws RenderSystemException   The current frame alone exhausted the buffer
+  Allocation allocate(std::size_t numBytes, std::size_t alignment = 16);
+
+  /// @brief Check if `numBytes` with the given `alignment` can be allocated in the current frame
+  ///
+  /// This accounts for the memory which is already allocated by the current frame, the frames in
+  /// flight are assumed to be retired (i.e `allocate` may still block on a fence but never throws).
+  bool canAllocate(std::size_t numBytes, std::size_t alignment = 16) const noexcept;
+
+  /// @brief Allocate `numBytes` and copy them from `src`
+  Allocation write(const void* src, std::size_t numBytes, std::size_t alignment = 16);
+
+  /// @brief Finish the current frame and insert a fence guarding its allocations
+  ///
+  /// If the maximum number of frames is already in flight, this waits for the oldest frame.
+  void endFrame();
+
+  /// @brief Get the capacity of the buffer in bytes
+  std::size_t getNumBytes() const noexcept { return numBytes_; }
+
+  /// @brief Get the number of bytes in use by the frames in flight and the current frame
+  std::size_t getNumBytesInUse() const noexcept { return numBytesInUse_; }
+
+  /// @brief Get the number of frames in flight (excluding the current frame)
+  std::size_t getNumFramesInFlight() const noexcept { return framesInFlight_.size(); }
+
+  /// @brief Get the maximum number of frames in flight
+  std::size_t getMaxFramesInFlight() const noexcept { return maxFramesInFlight_; }
+
+  /// @brief Get the sequence number of the current frame
+  std::uint64_t getFrame() const noexcept { return frame_; }
+
+  /// @brief Get the number of times the allocation wrapped around the end of the buffer
+  std::size_t getNumWrapArounds() const noexcept { return numWrapArounds_; }
+
+  /// @brief Get the number of times we had to block on a fence which was not yet signaled
+  std::size_t getNumStalls() const noexcept { return numStalls_; }
+
+  /// @brief Convert to string
+  std::string toString() const;
+
+protected:
+  /// @brief Set the mapped memory of the buffer
+  void setData(void* data) noexcept { data_ = static_cast<Byte*>(data); }
+
+  /// @brief Insert a fence guarding all commands issued in `frame`
+  virtual void insertFence(std::uint64_t frame) = 0;
+
+  /// @brief Check if the fence of `frame` has been signaled and release the fence if so
+  ///
+  /// @param frame    Sequence number of the frame
+  /// @param block    Wait until the fence is signaled?
+  /// @returns `true` if the fence has been signaled (always the case if `block` is `true`)
+  virtual bool waitFence(std::uint64_t frame, bool block) = 0;
+
+private:
+  /// @brief Retire the oldest frame in flight, blocking if necessary
+  void retireOldestFrame();
+
+private:
+  struct Frame {
+    /// Sequence number of the frame
+    std::uint64_t Sequence;
+
+    /// Number of bytes allocated by the frame (including padding)
+    std::size_t NumBytes;
+  };
+
+  /// Mapped memory
+  Byte* data_;
+
+  /// Capacity of the buffer in bytes
+  std::size_t numBytes_;
+
+  /// Maximum number of frames in flight
+  std::size_t maxFramesInFlight_;
+
+  /// Offset of the next allocation
+  std::size_t head_;
+
+  /// Number of bytes in use (starting at `head_ - numBytesInUse_` modulo capacity)
+  std::size_t numBytesInUse_;
+
+  /// Sequence number and number of bytes of the current frame
+  std::uint64_t frame_;
+  std::size_t frameNumBytes_;
+
+  /// Frames in flight, from the oldest to the newest
+  std::deque<Frame> framesInFlight_;
+
+  /// Statistics
+  std::size_t numWrapArounds_;
+  std::size_t numStalls_;
+};
+
+} // namespace render
+
+} // namespace sequoia
+
+#endif
@@ -4,16 +4,28 @@
 in vec3 in_Position;
 in vec4 in_Color;
 in vec2 in_TexCoord;
+in mat4 in_InstanceMatModel;  // Model matrix (per instance, if u_instanced)
 
 // Output
 out vec4 frag_Color;
 out vec2 frag_TexCoord;
 
+// Uniform blocks
+layout(std140) uniform CameraBlock {
+  mat4 matView;      // View matrix
+  mat4 matProj;      // Projection matrix
+  mat4 matViewProj;  // View-Projection matrix
+};
+
 // Uniforms
-uniform mat4 u_matMVP;  // Model-View-Projection matrix
+uniform mat4 u_matMVP;     // Model-View-Projection matrix (single draws)
+uniform bool u_instanced;  // Draw instances of in_InstanceMatModel?
 
 void main() {
-  gl_Position = u_matMVP * vec4(in_Position, 1.0f);
+  if(u_instanced)
+    gl_Position = matViewProj * in_InstanceMatModel * vec4(in_Position, 1.0f);
+  else
+    gl_Position = u_matMVP * vec4(in_Position, 1.0f);
 
   frag_Color = in_Color;
   frag_TexCoord = in_TexCoord;
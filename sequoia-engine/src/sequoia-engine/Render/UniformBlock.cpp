@@ -0,0 +1,136 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                         _____                        _
+//                        / ____|                      (_)
+//                       | (___   ___  __ _ _   _  ___  _  __ _
+//                        \___ \ / _ \/ _` | | | |/ _ \| |/ _` |
+//                        ____) |  __/ (_| | |_| | (_) | | (_| |
+//                       |_____/ \___|\__, |\__,_|\___/|_|\__,_| - Game Engine (2016-2017)
+//                                       | |
+//                                       |_|
+//
+// This file is distributed under the MIT License (MIT).
+// See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#include "sequoia-engine/Core/Byte.h"
+#include "sequoia-engine/Core/Format.h"
+#include "sequoia-engine/Render/Exception.h"
+#include "sequoia-engine/Render/UniformBlock.h"
+#include <cstring>
+
+namespace sequoia {
+
+namespace render {
+
+namespace {
+
+/// @brief std140 properties of a type
+struct Std140TypeInfo {
+  std::uint32_t BaseAlignment; ///< Base alignment of the type
+  std::uint32_t Size;          ///< Size of the type
+  std::uint32_t NumColumns;    ///< Number of columns (1 if not a matrix)
+  std::uint32_t ColumnSize;    ///< Host size of a column
+};
+
+Std140TypeInfo getStd140TypeInfo(const UniformBlockMemberInfo& info) {
+  switch(info.Type) {
+  case UniformType::Bool:
+  case UniformType::Int:
+  case UniformType::Float:
+    return Std140TypeInfo{4, 4, 1, 4};
+  case UniformType::Float2:
+    return Std140TypeInfo{8, 8, 1, 8};
+  case UniformType::Float3:
+    return Std140TypeInfo{16, 12, 1, 12};
+  case UniformType::Float4:
+    return Std140TypeInfo{16, 16, 1, 16};
+  case UniformType::Float2x2:
+    return Std140TypeInfo{16, 32, 2, 8};
+  case UniformType::Float3x3:
+    return Std140TypeInfo{16, 48, 3, 12};
+  case UniformType::Float4x4:
+    return Std140TypeInfo{16, 64, 4, 16};
+  default:
+    SEQUOIA_THROW(RenderSystemException,
+                  "cannot compute std140 layout of uniform block member '{}' of type '{}'",
+                  info.Name, info.Type);
+  }
+}
+
+inline std::uint32_t alignTo(std::uint32_t offset, std::uint32_t alignment) {
+  return (offset + alignment - 1) / alignment * alignment;
+}
+
+} // anonymous namespace
+
+UniformBlockLayout::UniformBlockLayout(const std::vector<UniformBlockMemberInfo>& memberInfo)
+    : numBytes_(0) {
+  std::uint32_t offset = 0;
+
+  for(const UniformBlockMemberInfo& info : memberInfo) {
+    Std140TypeInfo typeInfo = getStd140TypeInfo(info);
+    UniformBlockMemberLayout member{info, 0, 0, 0};
+
+    if(typeInfo.NumColumns > 1)
+      member.MatrixStride = 16;
+
+    // The elements of arrays are aligned (and padded) to the alignment of a vec4
+    std::uint32_t size = typeInfo.Size;
+    std::uint32_t alignment = typeInfo.BaseAlignment;
+    if(info.Rank > 1) {
+      alignment = alignTo(alignment, 16);
+      member.ArrayStride = alignTo(typeInfo.Size, 16);
+      size = member.ArrayStride * info.Rank;
+    }
+
+    member.Offset = alignTo(offset, alignment);
+    offset = member.Offset + size;
+    members_.emplace_back(member);
+  }
+
+  numBytes_ = alignTo(offset, 16);
+}
+
+void UniformBlockLayout::pack(const void* src, void* dest) const noexcept {
+  const Byte* srcData = static_cast<const Byte*>(src);
+  Byte* destData = static_cast<Byte*>(dest);
+  std::memset(destData, 0, numBytes_);
+
+  for(const UniformBlockMemberLayout& member : members_) {
+    const Std140TypeInfo typeInfo = getStd140TypeInfo(member.Info);
+    const std::uint32_t hostElementSize = member.Info.Size / member.Info.Rank;
+
+    for(std::uint32_t element = 0; element < member.Info.Rank; ++element) {
+      const Byte* srcElement = srcData + member.Info.Offset + element * hostElementSize;
+      Byte* destElement = destData + member.Offset + element * member.ArrayStride;
+
+      if(member.Info.Type == UniformType::Bool) {
+        // Booleans are 4 bytes in std140
+        std::uint32_t value = *reinterpret_cast<const bool*>(srcElement) ? 1 : 0;
+        std::memcpy(destElement, &value, sizeof(value));
+      } else {
+        for(std::uint32_t col = 0; col < typeInfo.NumColumns; ++col)
+          std::memcpy(destElement + col * member.MatrixStride,
+                      srcElement + col * typeInfo.ColumnSize, typeInfo.ColumnSize);
+      }
+    }
+  }
+}
+
+std::string UniformBlockLayout::toString() const {
+  return core::format("UniformBlockLayout[\n"
+                      "  numBytes = {},\n"
+                      "  members = {}\n"
+                      "]",
+                      numBytes_, core::indent(core::toStringRange(members_, [](const auto& member) {
+                        return core::format("{}: type = {}, offset = {}, arrayStride = {}, "
+                                            "matrixStride = {}",
+                                            member.Info.Name, member.Info.Type, member.Offset,
+                                            member.ArrayStride, member.MatrixStride);
+                      })));
+}
+
+} // namespace render
+
+} // namespace sequoia
@@ -16,6 +16,7 @@
 #ifndef SEQUOIA_ENGINE_RENDER_UNIFORMBLOCK_H
 #define SEQUOIA_ENGINE_RENDER_UNIFORMBLOCK_H
 
+#include "sequoia-engine/Core/Export.h"
 #include "sequoia-engine/Core/PreprocessorUtil.h"
 #include "sequoia-engine/Core/StringUtil.h"
 #include "sequoia-engine/Render/UniformVariable.h"
@@ -23,6 +24,7 @@
 #include <boost/preprocessor/empty.hpp>
 #include <boost/preprocessor/if.hpp>
 #include <boost/preprocessor/tuple/elem.hpp>
+#include <cstddef>
 #include <sstream>
 #include <vector>
 
@@ -172,15 +174,86 @@ struct UniformBlockMemberInfo {
   std::uint32_t Rank;   ///< Rank of the member (size of array)
 };
 
+/// @brief Location of a member of a UniformBlock in the std140 layout
+/// @ingroup render
+struct UniformBlockMemberLayout {
+  UniformBlockMemberInfo Info; ///< Host information of the member
+  std::uint32_t Offset;        ///< Byte offset of the member in the std140 layout
+  std::uint32_t ArrayStride;   ///< Byte stride between the array elements (0 if not an array)
+  std::uint32_t MatrixStride;  ///< Byte stride between the matrix columns (0 if not a matrix)
+};
+
+/// @brief std140 layout of a UniformBlock
+///
+/// The layout follows the rules of the OpenGL specification ("Standard Uniform Block Layout")
+/// i.e `vec3` and `vec4` are aligned to 16 bytes, each column of a matrix as well as each element
+/// of an array is padded to 16 bytes and `bool` occupies 4 bytes. The layout is computed once per
+/// block and converts the host representation of the block via `pack`.
+///
+/// @ingroup render
+class SEQUOIA_API UniformBlockLayout {
+public:
+  /// @brief Compute the std140 layout of the members
+  ///
+  /// @throws RenderSystemException   A member cannot be laid out (e.g struct members)
+  UniformBlockLayout(const std::vector<UniformBlockMemberInfo>& memberInfo);
+
+  /// @brief Get the size of the block in the std140 layout (a multiple of 16 bytes)
+  std::size_t getNumBytes() const noexcept { return numBytes_; }
+
+  /// @brief Get the layout of the members (in order of declaration)
+  const std::vector<UniformBlockMemberLayout>& getMembers() const noexcept { return members_; }
+
+  /// @brief Convert the host representation `src` of the block to the std140 layout in `dest`
+  ///
+  /// @param src    Host representation of the block
+  /// @param dest   Destination of at least `getNumBytes()` bytes
+  void pack(const void* src, void* dest) const noexcept;
+
+  /// @brief Convert to string
+  std::string toString() const;
+
+private:
+  std::vector<UniformBlockMemberLayout> members_;
+  std::size_t numBytes_;
+};
+
 } // namespace game
 
 } // namespace sequoia
 
+/// @brief Define a block of uniform variables which matches an equivalent `layout(std140)` uniform
+/// block declaration in a GPU Program
+///
+/// @param Name        Name of the generated class (and of the uniform block in the GPU program)
+/// @param Members     A sequence of `(type0, name0, rank0)...(typeN, nameN, rankN)` tuples which
+///                    declares the type, name and rank of each member of the block
+///
+/// @b Example: The following
+///
+/// @code{.cpp}
+///   SEQUOIA_UNIFORM_BLOCK(Camera, (math::mat4, matViewProj, 1)(math::vec3, position, 1));
+/// @endcode
+///
+/// matches the GLSL declaration
+///
+/// @code
+///   layout(std140) uniform Camera {
+///     mat4 matViewProj;
+///     vec3 position;
+///   };
+/// @endcode
+///
+/// The block is bound to the programs of a `RenderPass` via `DrawCallContext::setUniformBlock`.
+///
+/// @ingroup render
 #define SEQUOIA_UNIFORM_BLOCK(Name, Members)                                                       \
   class Name {                                                                                     \
   public:                                                                                          \
     SEQUOIA_PP_UB_GENERATE_MEMBERS(Members)                                                        \
                                                                                                    \
+    static inline const char* GetName() { return BOOST_PP_STRINGIZE(Name); }                       \
+                                                                                                   \
     inline std::string toString() const {                                                          \
       std::stringstream ss;                                                                        \
       ss << BOOST_PP_STRINGIZE(Name) "[\n";                                                        \
@@ -193,6 +266,13 @@ struct UniformBlockMemberInfo {
       SEQUOIA_PP_UB_GENERATE_MEMBERINFOS(Members, Name)                                            \
       return memberInfo;                                                                           \
     }                                                                                              \
+                                                                                                   \
+    static inline const ::sequoia::render::UniformBlockLayout& GetLayout() {                       \
+      static const ::sequoia::render::UniformBlockLayout layout(GetMemberInfo());                  \
+      return layout;                                                                               \
+    }                                                                                              \
+                                                                                                   \
+    inline void pack(void* dest) const { GetLayout().pack(this, dest); }                           \
   }
 
 #endif
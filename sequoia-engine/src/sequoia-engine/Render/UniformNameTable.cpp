@@ -0,0 +1,65 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                         _____                        _
+//                        / ____|                      (_)
+//                       | (___   ___  __ _ _   _  ___  _  __ _
+//                        \___ \ / _ \/ _` | | | |/ _ \| |/ _` |
+//                        ____) |  __/ (_| | |_| | (_) | | (_| |
+//                       |_____/ \___|\__, |\__,_|\___/|_|\__,_| - Game Engine (2016-2017)
+//                                       | |
+//                                       |_|
+//
+// This file is distributed under the MIT License (MIT).
+// See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#include "sequoia-engine/Core/Assert.h"
+#include "sequoia-engine/Render/UniformNameTable.h"
+
+namespace sequoia {
+
+namespace render {
+
+constexpr UniformID UniformNameTable::InvalidID;
+
+UniformNameTable::UniformNameTable() {}
+
+UniformNameTable::~UniformNameTable() {}
+
+UniformNameTable& UniformNameTable::getGlobal() {
+  static UniformNameTable table;
+  return table;
+}
+
+UniformID UniformNameTable::intern(const std::string& name) {
+  SEQUOIA_LOCK_GUARD(mutex_);
+  auto it = ids_.find(name);
+  if(it != ids_.end())
+    return it->second;
+
+  UniformID id = static_cast<UniformID>(ids_.size());
+  SEQUOIA_ASSERT_MSG(id != InvalidID, "too many uniform variable names");
+  names_.push_back(name);
+  ids_.emplace(name, id);
+  return id;
+}
+
+UniformID UniformNameTable::lookup(const std::string& name) const {
+  SEQUOIA_LOCK_GUARD(mutex_);
+  auto it = ids_.find(name);
+  return it != ids_.end() ? it->second : InvalidID;
+}
+
+const std::string& UniformNameTable::getName(UniformID id) const {
+  SEQUOIA_ASSERT_MSG(id < names_.size(), "invalid uniform ID");
+  return names_[id];
+}
+
+std::size_t UniformNameTable::size() const {
+  SEQUOIA_LOCK_GUARD(mutex_);
+  return ids_.size();
+}
+
+} // namespace render
+
+} // namespace sequoia
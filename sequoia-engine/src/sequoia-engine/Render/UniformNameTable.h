@@ -0,0 +1,86 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                         _____                        _
+//                        / ____|                      (_)
+//                       | (___   ___  __ _ _   _  ___  _  __ _
+//                        \___ \ / _ \/ _` | | | |/ _ \| |/ _` |
+//                        ____) |  __/ (_| | |_| | (_) | | (_| |
+//                       |_____/ \___|\__, |\__,_|\___/|_|\__,_| - Game Engine (2016-2017)
+//                                       | |
+//                                       |_|
+//
+// This file is distributed under the MIT License (MIT).
+// See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#ifndef SEQUOIA_ENGINE_RENDER_UNIFORMNAMETABLE_H
+#define SEQUOIA_ENGINE_RENDER_UNIFORMNAMETABLE_H
+
+#include "sequoia-engine/Core/ConcurrentADT.h"
+#include "sequoia-engine/Core/Export.h"
+#include "sequoia-engine/Core/Mutex.h"
+#include "sequoia-engine/Core/NonCopyable.h"
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <unordered_map>
+
+namespace sequoia {
+
+namespace render {
+
+/// @brief Dense integer identifier of a uniform variable name
+/// @ingroup render
+using UniformID = std::uint32_t;
+
+/// @brief Global table which interns the names of uniform variables
+///
+/// Each distinct name is mapped *once* to a dense integer ID (handed out in order of first
+/// appearance). Programs resolve their uniform variables to IDs at link time and store their
+/// locations in tables indexed by the ID. Hence, setting a uniform variable in the per-draw hot
+/// path does neither construct nor hash any strings.
+///
+/// Interning is thread-safe, querying the name of an already interned ID is lock-free.
+///
+/// @ingroup render
+class SEQUOIA_API UniformNameTable : public NonCopyable {
+public:
+  /// @brief ID which is never handed out
+  static constexpr UniformID InvalidID = std::numeric_limits<UniformID>::max();
+
+  UniformNameTable();
+  ~UniformNameTable();
+
+  /// @brief Get the global table
+  static UniformNameTable& getGlobal();
+
+  /// @brief Get the ID of `name` (the name is interned if it is seen for the first time)
+  UniformID intern(const std::string& name);
+
+  /// @brief Get the ID of `name` or `InvalidID` if the name has not been interned
+  UniformID lookup(const std::string& name) const;
+
+  /// @brief Get the name of the interned `id`
+  const std::string& getName(UniformID id) const;
+
+  /// @brief Number of interned names
+  ///
+  /// All IDs are strictly smaller than this number which makes it suitable to size lookup tables.
+  std::size_t size() const;
+
+private:
+  /// Map of the interned names to their IDs
+  std::unordered_map<std::string, UniformID> ids_;
+
+  /// Names of the IDs (elements never move)
+  core::concurrent_vector<std::string> names_;
+
+  /// Access control of `ids_`
+  mutable SpinMutex mutex_;
+};
+
+} // namespace render
+
+} // namespace sequoia
+
+#endif
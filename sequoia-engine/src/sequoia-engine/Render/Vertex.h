@@ -30,7 +30,9 @@ namespace render {
 
 #define SEQUOIA_VERTICES SEQUOIA_REGSTER_VERTICES(                                                 \
   Vertex_posf3_norf3_texf2_colu4,                                                                  \
-  Vertex_posf2_texf2_colu4                                                                         \
+  Vertex_posf2_texf2_colu4,                                                                        \
+  Vertex_posf3_noro2_texh2_colu4,                                                                  \
+  Vertex_poss4_noro2_texh2_colu4                                                                   \
 )
 
 SEQUOIA_DEFINE_VERTEX_ID_ENUM(SEQUOIA_VERTICES)
@@ -52,6 +54,23 @@ SEQUOIA_DEFINE_VERTEX(Vertex_posf2_texf2_colu4,
                      (float, TexCoord, 2, false)
                      (std::uint8_t, Color, 4, true));
 
+// Compact 3D vertex (24 bytes) with octahedral encoded normals and half precision texture
+// coordinates (see `quantizeVertices`)
+SEQUOIA_DEFINE_VERTEX(Vertex_posf3_noro2_texh2_colu4,
+                     (float, Position, 3, false)
+                     (std::int16_t, Normal, 2, true)
+                     (core::Half, TexCoord, 2, false)
+                     (std::uint8_t, Color, 4, true));
+
+// Compact 3D vertex (20 bytes) with 16-bit positions normalized to the bounding box of the mesh
+// (the 4th component is padding set to 1), octahedral encoded normals and half precision texture
+// coordinates (see `quantizeVertices`)
+SEQUOIA_DEFINE_VERTEX(Vertex_poss4_noro2_texh2_colu4,
+                     (std::int16_t, Position, 4, true)
+                     (std::int16_t, Normal, 2, true)
+                     (core::Half, TexCoord, 2, false)
+                     (std::uint8_t, Color, 4, true));
+
 // clang-format on
 
 } // namespace render
@@ -22,10 +22,14 @@
 #include "sequoia-engine/Core/Unreachable.h"
 #include "sequoia-engine/Math/Math.h"
 #include "sequoia-engine/Render/Vertex.h"
+#include "sequoia-engine/Render/VertexQuantization.h"
 #include <algorithm>
 #include <array>
+#include <cmath>
 #include <cstring>
 #include <iosfwd>
+#include <limits>
+#include <type_traits>
 
 namespace sequoia {
 
@@ -43,11 +47,42 @@ inline constexpr std::size_t computeMaxVertexSize() {
   return maxSize;
 }
 
+/// @brief Convert `value` to `To` where normalized integers are mapped to (and from) `[0, 1]`
+/// (unsigned) or `[-1, 1]` (signed) floating point values
+template <class To, class From,
+          int Kind = (std::is_integral<To>::value && std::is_floating_point<From>::value)
+                         ? 1
+                         : (std::is_floating_point<To>::value && std::is_integral<From>::value)
+                               ? 2
+                               : 0>
+struct NormalizedCast {
+  static To cast(const From& value) noexcept { return static_cast<To>(value); }
+};
+
+template <class To, class From>
+struct NormalizedCast<To, From, 1> {
+  static To cast(const From& value) noexcept {
+    const From minimum = std::is_signed<To>::value ? From(-1) : From(0);
+    return static_cast<To>(std::round(std::min(std::max(value, minimum), From(1)) *
+                                      std::numeric_limits<To>::max()));
+  }
+};
+
+template <class To, class From>
+struct NormalizedCast<To, From, 2> {
+  static To cast(const From& value) noexcept {
+    return std::max(static_cast<To>(value) / std::numeric_limits<From>::max(), To(-1));
+  }
+};
+
 } // namespace internal
 
 /// @brief Allow unified access to all vertices
 ///
-/// This data structure is fairly efficient and only operates on the stack.
+/// This data structure is fairly efficient and only operates on the stack. Quantized attributes
+/// are converted transparently i.e normalized integers are read and written as floating point
+/// values in `[0, 1]` or `[-1, 1]` and octahedral encoded normals as 3D vectors. Normalized integer
+/// positions are accessed without their dequantization (see `PositionDequantization`).
 ///
 /// @ingroup render
 class SEQUOIA_API VertexAdapter {
@@ -87,7 +122,13 @@ public:
   }
 
   inline void setNormal(const float* data, int numElements) noexcept {
-    setAttribute(layout_.Normal, data, numElements);
+    if(layout_.Normal.NumElements == 2 && numElements >= 3) {
+      float oct[2];
+      encodeOctahedral(data, oct);
+      setAttribute(layout_.Normal, oct, 2);
+    } else {
+      setAttribute(layout_.Normal, data, numElements);
+    }
   }
   inline void setNormal(const math::vec2& data) noexcept {
     setNormal(math::value_ptr(data), data.length());
@@ -132,7 +173,13 @@ public:
   }
   inline math::vec4 getNormal() const noexcept {
     math::vec4 data(0);
-    getAttribute(layout_.Normal, math::value_ptr(data), data.length());
+    if(layout_.Normal.NumElements == 2) {
+      float oct[2] = {0.0f, 0.0f};
+      getAttribute(layout_.Normal, oct, 2);
+      decodeOctahedral(oct, math::value_ptr(data));
+    } else {
+      getAttribute(layout_.Normal, math::value_ptr(data), data.length());
+    }
     return data;
   }
   inline math::vec4 getTexCoord() const noexcept {
@@ -192,7 +239,8 @@ private:
 
 #define VERTEX_LAYOUT_TYPE(Type, Name)                                                             \
   case VertexLayout::Name:                                                                         \
-    setArray<VertexLayout::Name>(vertexData, vertexNumElements, data, numElements);                \
+    setArray<VertexLayout::Name>(vertexData, vertexNumElements, data, numElements,                 \
+                                 attribute.Normalize);                                             \
     break;
 #include "sequoia-engine/Render/VertexLayout.inc"
 #undef VERTEX_LAYOUT_TYPE
@@ -206,12 +254,12 @@ private:
   /// to be equal to the array `data` of size `numElements`
   template <VertexLayout::TypeID TypeID, class DataType>
   inline void setArray(Byte* vertexData, const int vertexNumElements, const DataType* data,
-                       const int numElements) noexcept {
+                       const int numElements, const bool normalize) noexcept {
     using VertexDataType = typename internal::TypeIDToType<TypeID>::type;
     const int numElementsToCopy = std::min(vertexNumElements, numElements);
 
     for(int i = 0; i < numElementsToCopy; ++i, vertexData += sizeof(VertexDataType))
-      set<VertexDataType>(vertexData, data[i]);
+      set<VertexDataType>(vertexData, data[i], normalize);
 
     for(int i = numElementsToCopy; i < vertexNumElements; ++i, vertexData += sizeof(VertexDataType))
       setToZero<VertexDataType>(vertexData);
@@ -219,9 +267,9 @@ private:
 
   /// @brief Interpret `vertexData` as type `T` and set it to be equal to `value`
   template <class T, class U>
-  inline static void set(Byte* vertexData, const U& value) noexcept {
+  inline static void set(Byte* vertexData, const U& value, const bool normalize) noexcept {
     T& left = *reinterpret_cast<T*>(vertexData);
-    left = static_cast<T>(value);
+    left = normalize ? internal::NormalizedCast<T, U>::cast(value) : static_cast<T>(value);
   }
 
   /// @brief Interpret `vertexData` as type `T` and set it to 0
@@ -244,7 +292,8 @@ private:
     switch(attribute.Type) {
 #define VERTEX_LAYOUT_TYPE(Type, Name)                                                             \
   case VertexLayout::Name:                                                                         \
-    getArray<VertexLayout::Name>(vertexData, vertexNumElements, data, numElements);                \
+    getArray<VertexLayout::Name>(vertexData, vertexNumElements, data, numElements,                 \
+                                 attribute.Normalize);                                             \
     break;
 #include "sequoia-engine/Render/VertexLayout.inc"
 #undef VERTEX_LAYOUT_TYPE
@@ -258,19 +307,19 @@ private:
   /// to the array `data` of size `numElements`
   template <VertexLayout::TypeID TypeID, class DataType>
   inline static void getArray(const Byte* vertexData, const int vertexNumElements, DataType* data,
-                              const int numElements) noexcept {
+                              const int numElements, const bool normalize) noexcept {
     using VertexDataType = typename internal::TypeIDToType<TypeID>::type;
     const int numElementsToCopy = std::min(vertexNumElements, numElements);
 
     for(int i = 0; i < numElementsToCopy; ++i, vertexData += sizeof(VertexDataType))
-      get<VertexDataType>(vertexData, data + i);
+      get<VertexDataType>(vertexData, data + i, normalize);
   }
 
   /// @brief Interpret `vertexData` as type `T` and assign it to `value`
   template <class T, class U>
-  inline static void get(const Byte* vertexData, U* value) noexcept {
+  inline static void get(const Byte* vertexData, U* value, const bool normalize) noexcept {
     const T& right = *reinterpret_cast<const T*>(vertexData);
-    *value = static_cast<U>(right);
+    *value = normalize ? internal::NormalizedCast<U, T>::cast(right) : static_cast<U>(right);
   }
 
 private:
@@ -50,7 +50,8 @@ static const char* drawModeToString(VertexData::DrawModeKind mode) {
 }
 
 VertexData::VertexData(RenderSystemKind renderSystemKind, VertexData::DrawModeKind drawMode)
-    : RenderSystemObject(renderSystemKind), bbox_(nullptr), drawMode_(drawMode) {}
+    : RenderSystemObject(renderSystemKind), bbox_(nullptr), dequantization_(nullptr),
+      drawMode_(drawMode) {}
 
 VertexData::~VertexData() {}
 
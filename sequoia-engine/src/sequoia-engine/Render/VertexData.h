@@ -23,6 +23,8 @@
 #include "sequoia-engine/Render/RenderSystemObject.h"
 #include "sequoia-engine/Render/Vertex.h"
 #include "sequoia-engine/Render/VertexBuffer.h"
+#include "sequoia-engine/Render/VertexQuantization.h"
+#include <cstdint>
 
 namespace sequoia {
 
@@ -37,6 +39,15 @@ public:
     DM_Triangles = 0 ///< Treats each triplet of vertices as an independent triangle
   };
 
+  /// @brief Range of the vertices and indices drawn by the VertexData within the buffers of its
+  /// storage (see `getStorage`)
+  struct DrawRange {
+    std::uint32_t FirstVertex;
+    std::uint32_t NumVertices;
+    std::uint32_t FirstIndex;
+    std::uint32_t NumIndices;
+  };
+
   VertexData(RenderSystemKind renderSystemKind, DrawModeKind drawMode);
 
   /// @brief Deallocate all memory
@@ -54,6 +65,9 @@ public:
     return *bbox_;
   }
 
+  /// @brief Check if the axis aligned bounding box has been set
+  bool hasAxisAlignedBox() const noexcept { return bbox_ != nullptr; }
+
   /// @brief Set the axis aligned bounding box
   void setAxisAlignedBox(const math::AxisAlignedBox& bbox) {
     if(bbox_)
@@ -62,6 +76,26 @@ public:
       bbox_ = std::make_unique<math::AxisAlignedBox>(bbox);
   }
 
+  /// @brief Get the mapping of the normalized integer positions to the positions of the mesh
+  const PositionDequantization& getPositionDequantization() const noexcept {
+    SEQUOIA_ASSERT_MSG(dequantization_, "position dequantization not set");
+    return *dequantization_;
+  }
+
+  /// @brief Check if the positions are quantized (i.e the dequantization has been set)
+  bool hasPositionDequantization() const noexcept { return dequantization_ != nullptr; }
+
+  /// @brief Set the mapping of the normalized integer positions to the positions of the mesh
+  ///
+  /// The dequantization is applied to the model matrix when drawing the VertexData, the bounding
+  /// box is given in the dequantized positions.
+  void setPositionDequantization(const PositionDequantization& dequantization) {
+    if(dequantization_)
+      *dequantization_ = dequantization;
+    else
+      dequantization_ = std::make_unique<PositionDequantization>(dequantization);
+  }
+
   /// @brief Get number of allocated vertices
   std::size_t getNumVertices() const noexcept { return getVertexBuffer()->getNumVertices(); }
 
@@ -79,6 +113,20 @@ public:
   /// @brief Get the IndexBuffer
   virtual IndexBuffer* getIndexBuffer() const = 0;
 
+  /// @brief Get the VertexData owning the vertex and index buffers this VertexData draws from
+  ///
+  /// VertexData sharing the same storage (and thus the same buffers and vertex layout) can be
+  /// drawn with a single multi-draw. By default, the VertexData is its own storage.
+  virtual const VertexData* getStorage() const noexcept { return this; }
+
+  /// @brief Get the range of vertices and indices drawn within the buffers of the storage
+  ///
+  /// By default, all allocated vertices and indices are drawn.
+  virtual DrawRange getDrawRange() const noexcept {
+    return DrawRange{0, static_cast<std::uint32_t>(getNumVertices()), 0,
+                     static_cast<std::uint32_t>(getNumIndices())};
+  }
+
   /// @brief Dump the vertex data and indices to `stdout`
   void dump() const;
 
@@ -93,6 +141,9 @@ private:
   /// Axis aligned bounding box of the mesh
   std::unique_ptr<math::AxisAlignedBox> bbox_;
 
+  /// Dequantization of normalized integer positions
+  std::unique_ptr<PositionDequantization> dequantization_;
+
   /// Mode of drawing the vertices
   DrawModeKind drawMode_;
 };
@@ -18,6 +18,7 @@
 
 #include "sequoia-engine/Core/Assert.h"
 #include "sequoia-engine/Core/Export.h"
+#include "sequoia-engine/Core/Half.h"
 #include <cstdint>
 #include <string>
 
@@ -26,6 +27,12 @@ namespace sequoia {
 namespace render {
 
 /// @brief Layout description of vertices
+///
+/// Integer attributes with `Normalize` are mapped to `[0, 1]` (unsigned) or `[-1, 1]` (signed). A
+/// `Normal` with 2 elements is octahedral encoded (see `encodeOctahedral`) and a normalized integer
+/// `Position` is mapped to the mesh by the dequantization of its VertexData (see
+/// `VertexData::setPositionDequantization`).
+///
 /// @ingroup render
 struct SEQUOIA_API VertexLayout {
   constexpr VertexLayout() = default;
@@ -0,0 +1,135 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                         _____                        _
+//                        / ____|                      (_)
+//                       | (___   ___  __ _ _   _  ___  _  __ _
+//                        \___ \ / _ \/ _` | | | |/ _ \| |/ _` |
+//                        ____) |  __/ (_| | |_| | (_) | | (_| |
+//                       |_____/ \___|\__, |\__,_|\___/|_|\__,_| - Game Engine (2016-2017)
+//                                       | |
+//                                       |_|
+//
+// This file is distributed under the MIT License (MIT).
+// See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#include "sequoia-engine/Core/Format.h"
+#include "sequoia-engine/Render/VertexQuantization.h"
+#include <cstring>
+
+namespace sequoia {
+
+namespace render {
+
+bool PositionDequantization::operator==(const PositionDequantization& other) const noexcept {
+  return std::equal(Scale, Scale + 3, other.Scale) && std::equal(Offset, Offset + 3, other.Offset);
+}
+
+std::string PositionDequantization::toString() const {
+  return core::format("PositionDequantization[\n"
+                      "  Scale = [{}, {}, {}],\n"
+                      "  Offset = [{}, {}, {}]\n"
+                      "]",
+                      Scale[0], Scale[1], Scale[2], Offset[0], Offset[1], Offset[2]);
+}
+
+static float signNotZero(float value) noexcept { return value >= 0.0f ? 1.0f : -1.0f; }
+
+void encodeOctahedral(const float* normal, float* oct) noexcept {
+  const float l1Norm = std::abs(normal[0]) + std::abs(normal[1]) + std::abs(normal[2]);
+  if(l1Norm == 0.0f) {
+    oct[0] = oct[1] = 0.0f;
+    return;
+  }
+
+  const float x = normal[0] / l1Norm;
+  const float y = normal[1] / l1Norm;
+
+  // Fold the lower hemisphere
+  if(normal[2] < 0.0f) {
+    oct[0] = (1.0f - std::abs(y)) * signNotZero(x);
+    oct[1] = (1.0f - std::abs(x)) * signNotZero(y);
+  } else {
+    oct[0] = x;
+    oct[1] = y;
+  }
+}
+
+void decodeOctahedral(const float* oct, float* normal) noexcept {
+  float x = oct[0];
+  float y = oct[1];
+  const float z = 1.0f - std::abs(x) - std::abs(y);
+
+  // Unfold the lower hemisphere
+  const float t = std::max(-z, 0.0f);
+  x += x >= 0.0f ? -t : t;
+  y += y >= 0.0f ? -t : t;
+
+  const float length = std::sqrt(x * x + y * y + z * z);
+  normal[0] = x / length;
+  normal[1] = y / length;
+  normal[2] = z / length;
+}
+
+namespace {
+
+template <class DestVertexType>
+void quantizeAttributes(const Vertex_posf3_norf3_texf2_colu4& src, DestVertexType& dest) noexcept {
+  float oct[2];
+  encodeOctahedral(src.Normal, oct);
+  for(int i = 0; i < 2; ++i)
+    dest.Normal[i] = toSnorm<std::int16_t>(oct[i]);
+
+  for(int i = 0; i < 2; ++i)
+    dest.TexCoord[i] = core::Half(src.TexCoord[i]);
+
+  std::memcpy(dest.Color, src.Color, sizeof(src.Color));
+}
+
+} // anonymous namespace
+
+void quantizeVertices(const Vertex_posf3_norf3_texf2_colu4* src, std::size_t numVertices,
+                      Vertex_posf3_noro2_texh2_colu4* dest) noexcept {
+  for(std::size_t i = 0; i < numVertices; ++i) {
+    std::memcpy(dest[i].Position, src[i].Position, sizeof(src[i].Position));
+    quantizeAttributes(src[i], dest[i]);
+  }
+}
+
+PositionDequantization quantizeVertices(const Vertex_posf3_norf3_texf2_colu4* src,
+                                        std::size_t numVertices,
+                                        Vertex_poss4_noro2_texh2_colu4* dest) noexcept {
+  PositionDequantization dequantization;
+  if(numVertices == 0)
+    return dequantization;
+
+  // Map the bounding box of the positions to [-1, 1]^3
+  float minimum[3], maximum[3];
+  for(int j = 0; j < 3; ++j)
+    minimum[j] = maximum[j] = src[0].Position[j];
+
+  for(std::size_t i = 1; i < numVertices; ++i)
+    for(int j = 0; j < 3; ++j) {
+      minimum[j] = std::min(minimum[j], src[i].Position[j]);
+      maximum[j] = std::max(maximum[j], src[i].Position[j]);
+    }
+
+  for(int j = 0; j < 3; ++j) {
+    dequantization.Offset[j] = 0.5f * (minimum[j] + maximum[j]);
+    const float scale = 0.5f * (maximum[j] - minimum[j]);
+    dequantization.Scale[j] = scale > 0.0f ? scale : 1.0f;
+  }
+
+  for(std::size_t i = 0; i < numVertices; ++i) {
+    for(int j = 0; j < 3; ++j)
+      dest[i].Position[j] = toSnorm<std::int16_t>((src[i].Position[j] - dequantization.Offset[j]) /
+                                                  dequantization.Scale[j]);
+    dest[i].Position[3] = std::numeric_limits<std::int16_t>::max();
+    quantizeAttributes(src[i], dest[i]);
+  }
+  return dequantization;
+}
+
+} // namespace render
+
+} // namespace sequoia
@@ -0,0 +1,111 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                         _____                        _
+//                        / ____|                      (_)
+//                       | (___   ___  __ _ _   _  ___  _  __ _
+//                        \___ \ / _ \/ _` | | | |/ _ \| |/ _` |
+//                        ____) |  __/ (_| | |_| | (_) | | (_| |
+//                       |_____/ \___|\__, |\__,_|\___/|_|\__,_| - Game Engine (2016-2017)
+//                                       | |
+//                                       |_|
+//
+// This file is distributed under the MIT License (MIT).
+// See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#ifndef SEQUOIA_ENGINE_RENDER_VERTEXQUANTIZATION_H
+#define SEQUOIA_ENGINE_RENDER_VERTEXQUANTIZATION_H
+
+#include "sequoia-engine/Core/Export.h"
+#include "sequoia-engine/Render/Vertex.h"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+
+namespace sequoia {
+
+namespace render {
+
+/// @brief Mapping of normalized integer positions (in `[-1, 1]`) to the positions of the mesh
+///
+/// The position of the mesh is `Offset + Scale * p` where `p` is the normalized position. This
+/// is folded into the model matrix when drawing the VertexData.
+///
+/// @ingroup render
+struct SEQUOIA_API PositionDequantization {
+  float Scale[3] = {1.0f, 1.0f, 1.0f};  ///< Half extent of the mesh
+  float Offset[3] = {0.0f, 0.0f, 0.0f}; ///< Center of the mesh
+
+  /// @brief Map the `normalized` position to `position`
+  void apply(const float* normalized, float* position) const noexcept {
+    for(int i = 0; i < 3; ++i)
+      position[i] = Offset[i] + Scale[i] * normalized[i];
+  }
+
+  /// @name Comparison
+  /// @{
+  bool operator==(const PositionDequantization& other) const noexcept;
+  bool operator!=(const PositionDequantization& other) const noexcept { return !(*this == other); }
+  /// @}
+
+  /// @brief Convert to string
+  std::string toString() const;
+};
+
+/// @brief Convert `value` to a signed normalized integer of type `T` (`value` is clamped to
+/// `[-1, 1]`)
+/// @ingroup render
+template <class T>
+inline T toSnorm(float value) noexcept {
+  value = std::min(std::max(value, -1.0f), 1.0f);
+  return static_cast<T>(std::round(value * std::numeric_limits<T>::max()));
+}
+
+/// @brief Convert the signed normalized integer `value` to `[-1, 1]`
+/// @ingroup render
+template <class T>
+inline float fromSnorm(T value) noexcept {
+  return std::max(static_cast<float>(value) / std::numeric_limits<T>::max(), -1.0f);
+}
+
+/// @brief Encode the direction `normal` (3 elements) as octahedral coordinates `oct` (2 elements
+/// in `[-1, 1]`)
+///
+/// The unit sphere is projected onto an octahedron whose lower half is folded over the upper half.
+/// `normal` does not need to be normalized, a zero vector is encoded as `(0, 0, 1)`.
+///
+/// @see Cigolle et al. "A Survey of Efficient Representations for Independent Unit Vectors" (2014)
+/// @ingroup render
+SEQUOIA_API extern void encodeOctahedral(const float* normal, float* oct) noexcept;
+
+/// @brief Decode the octahedral coordinates `oct` (2 elements) to the unit vector `normal`
+/// (3 elements)
+/// @ingroup render
+SEQUOIA_API extern void decodeOctahedral(const float* oct, float* normal) noexcept;
+
+/// @brief Convert `numVertices` vertices from `src` to the compact format `dest`
+///
+/// The normals are octahedral encoded and the texture coordinates converted to half precision.
+/// @ingroup render
+SEQUOIA_API extern void quantizeVertices(const Vertex_posf3_norf3_texf2_colu4* src,
+                                         std::size_t numVertices,
+                                         Vertex_posf3_noro2_texh2_colu4* dest) noexcept;
+
+/// @brief Convert `numVertices` vertices from `src` to the compact format `dest` with 16-bit
+/// positions
+///
+/// The positions are normalized to the bounding box of the vertices. The returned dequantization
+/// needs to be set on the VertexData of the vertices (see `VertexData::setPositionDequantization`).
+/// @ingroup render
+SEQUOIA_API extern PositionDequantization
+quantizeVertices(const Vertex_posf3_norf3_texf2_colu4* src, std::size_t numVertices,
+                 Vertex_poss4_noro2_texh2_colu4* dest) noexcept;
+
+} // namespace render
+
+} // namespace sequoia
+
+#endif
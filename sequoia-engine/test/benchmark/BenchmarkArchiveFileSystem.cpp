@@ -0,0 +1,124 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                         _____                        _
+//                        / ____|                      (_)
+//                       | (___   ___  __ _ _   _  ___  _  __ _
+//                        \___ \ / _ \/ _` | | | |/ _ \| |/ _` |
+//                        ____) |  __/ (_| | |_| | (_) | | (_| |
+//                       |_____/ \___|\__, |\__,_|\___/|_|\__,_| - Game Engine (2016-2017)
+//                                       | |
+//                                       |_|
+//
+// This file is distributed under the MIT License (MIT).
+// See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#include "sequoia-engine/Core/ArchiveFileSystem.h"
+#include "sequoia-engine/Core/Format.h"
+#include "sequoia-engine/Core/Platform.h"
+#include "sequoia-engine/Core/RealFileSystem.h"
+#include "sequoia-engine/Unittest/BenchmarkEnvironment.h"
+#include "sequoia-engine/Unittest/BenchmarkMain.h"
+#include <fstream>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace sequoia;
+using namespace sequoia::core;
+
+namespace {
+
+/// @brief `N` small files stored as loose files as well as packed into archives
+struct Dataset {
+  platform::Path Directory;
+  platform::Path Archive;
+  platform::Path CompressedArchive;
+  std::vector<std::string> Files;
+};
+
+static const Dataset& getDataset(int numFiles) {
+  static std::map<int, std::unique_ptr<Dataset>> datasets;
+
+  auto& dataset = datasets[numFiles];
+  if(!dataset) {
+    dataset = std::make_unique<Dataset>();
+    platform::Path root = platform::filesystem::temp_directory_path() /
+                          PLATFORM_STR("sequoia-engine") /
+                          PLATFORM_STR("BenchmarkArchiveFileSystem") /
+                          platform::asPath(std::to_string(numFiles));
+    dataset->Directory = root / PLATFORM_STR("Loose");
+    dataset->Archive = root / PLATFORM_STR("Archive.sqpa");
+    dataset->CompressedArchive = root / PLATFORM_STR("CompressedArchive.sqpa");
+
+    ArchiveWriter writer, compressedWriter;
+    for(int i = 0; i < numFiles; ++i) {
+      std::string path = core::format("dir{}/file{}.txt", i % 16, i);
+
+      // Something resembling a small (text) asset of a few KB
+      std::string content;
+      for(int line = 0; line < 128; ++line)
+        content += core::format("v {} {} {}\n", i, line, i * line);
+
+      platform::Path fullPath = dataset->Directory / platform::asPath(path);
+      platform::filesystem::create_directories(fullPath.parent_path());
+      std::ofstream ofs(platform::toAnsiString(fullPath).c_str(), std::ios_base::binary);
+      ofs << content;
+
+      const Byte* data = reinterpret_cast<const Byte*>(content.data());
+      writer.add(path, data, content.size(), false);
+      compressedWriter.add(path, data, content.size(), true);
+      dataset->Files.emplace_back(std::move(path));
+    }
+    writer.write(dataset->Archive);
+    compressedWriter.write(dataset->CompressedArchive);
+  }
+  return *dataset;
+}
+
+/// @brief Read all files of the dataset and touch their content
+template <class FileSystemType>
+static void readAll(FileSystemType& fs, const Dataset& dataset) {
+  for(const std::string& file : dataset.Files) {
+    auto buffer = fs.read(file, FileBuffer::FF_Binary);
+    benchmark::DoNotOptimize(buffer->template getDataAs<Byte>()[buffer->getNumBytes() - 1]);
+  }
+}
+
+// Each iteration opens a fresh file system and reads all N files i.e this measures the cold-start
+// cost of loading N assets (the OS page cache is warm in all cases)
+
+static void BM_LooseFiles(benchmark::State& state) {
+  const Dataset& dataset = getDataset(state.range(0));
+  while(state.KeepRunning()) {
+    RealFileSystem fs(platform::toAnsiString(dataset.Directory));
+    readAll(fs, dataset);
+  }
+  state.SetItemsProcessed(state.iterations() * dataset.Files.size());
+}
+BENCHMARK(BM_LooseFiles)->Arg(256)->Arg(4096)->Unit(benchmark::kMillisecond);
+
+static void BM_Archive(benchmark::State& state) {
+  const Dataset& dataset = getDataset(state.range(0));
+  while(state.KeepRunning()) {
+    ArchiveFileSystem fs(platform::toAnsiString(dataset.Archive));
+    readAll(fs, dataset);
+  }
+  state.SetItemsProcessed(state.iterations() * dataset.Files.size());
+}
+BENCHMARK(BM_Archive)->Arg(256)->Arg(4096)->Unit(benchmark::kMillisecond);
+
+static void BM_CompressedArchive(benchmark::State& state) {
+  const Dataset& dataset = getDataset(state.range(0));
+  while(state.KeepRunning()) {
+    ArchiveFileSystem fs(platform::toAnsiString(dataset.CompressedArchive));
+    readAll(fs, dataset);
+  }
+  state.SetItemsProcessed(state.iterations() * dataset.Files.size());
+}
+BENCHMARK(BM_CompressedArchive)->Arg(256)->Arg(4096)->Unit(benchmark::kMillisecond);
+
+} // anonymous namespace
+
+SEQUOIA_BENCHMARK_MAIN(sequoia::unittest::BenchmarkEnvironment);
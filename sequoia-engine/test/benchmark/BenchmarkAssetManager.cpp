@@ -0,0 +1,106 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                         _____                        _
+//                        / ____|                      (_)
+//                       | (___   ___  __ _ _   _  ___  _  __ _
+//                        \___ \ / _ \/ _` | | | |/ _ \| |/ _` |
+//                        ____) |  __/ (_| | |_| | (_) | | (_| |
+//                       |_____/ \___|\__, |\__,_|\___/|_|\__,_| - Game Engine (2016-2017)
+//                                       | |
+//                                       |_|
+//
+// This file is distributed under the MIT License (MIT).
+// See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#include "sequoia-engine/Core/Format.h"
+#include "sequoia-engine/Core/Platform.h"
+#include "sequoia-engine/Game/AssetManager.h"
+#include "sequoia-engine/Render/RenderServer.h"
+#include "sequoia-engine/Unittest/BenchmarkEnvironment.h"
+#include "sequoia-engine/Unittest/BenchmarkMain.h"
+#include <fstream>
+#include <opencv2/opencv.hpp>
+#include <string>
+#include <vector>
+
+using namespace sequoia;
+using namespace sequoia::game;
+
+namespace {
+
+/// @brief Directory with `NumImages` 128x128 PNG images
+struct Dataset {
+  static constexpr int NumImages = 256;
+
+  platform::Path Directory;
+  std::vector<std::string> Files;
+};
+
+static const Dataset& getDataset() {
+  static Dataset dataset;
+
+  if(dataset.Files.empty()) {
+    dataset.Directory = platform::filesystem::temp_directory_path() /
+                        PLATFORM_STR("sequoia-engine") / PLATFORM_STR("BenchmarkAssetManager");
+    platform::filesystem::create_directories(dataset.Directory);
+
+    for(int i = 0; i < Dataset::NumImages; ++i) {
+      cv::Mat image(128, 128, CV_8UC3);
+      cv::randu(image, cv::Scalar::all(0), cv::Scalar::all(255));
+      cv::GaussianBlur(image, image, cv::Size(5, 5), 0);
+
+      std::vector<uchar> encoded;
+      cv::imencode(".png", image, encoded);
+
+      std::string path = core::format("image{}.png", i);
+      std::ofstream ofs(platform::toAnsiString(dataset.Directory / platform::asPath(path)).c_str(),
+                        std::ios_base::binary);
+      ofs.write(reinterpret_cast<const char*>(encoded.data()), encoded.size());
+      dataset.Files.emplace_back(std::move(path));
+    }
+  }
+  return dataset;
+}
+
+// Each iteration creates a fresh manager and loads (read + decode) all images
+
+static void BM_LoadSerial(benchmark::State& state) {
+  const Dataset& dataset = getDataset();
+  while(state.KeepRunning()) {
+    AssetManager manager(platform::toAnsiString(dataset.Directory));
+    for(const std::string& file : dataset.Files)
+      benchmark::DoNotOptimize(manager.loadImage(file).get());
+  }
+  state.SetItemsProcessed(state.iterations() * dataset.Files.size());
+}
+BENCHMARK(BM_LoadSerial)->Unit(benchmark::kMillisecond);
+
+// Load all images asynchronously on a RenderServer with N workers. Every image is requested twice
+// (as happens when several materials reference the same texture), the second request shares the
+// in-flight load of the first one.
+
+static void BM_LoadAsync(benchmark::State& state) {
+  const Dataset& dataset = getDataset();
+  render::RenderServer server(state.range(0));
+
+  std::vector<Future<std::shared_ptr<Image>>> futures;
+  futures.reserve(2 * dataset.Files.size());
+
+  while(state.KeepRunning()) {
+    AssetManager manager(platform::toAnsiString(dataset.Directory), &server);
+    for(int request = 0; request < 2; ++request)
+      for(const std::string& file : dataset.Files)
+        futures.emplace_back(manager.loadImageAsync(file));
+
+    for(auto& future : futures)
+      benchmark::DoNotOptimize(future.get().get());
+    futures.clear();
+  }
+  state.SetItemsProcessed(state.iterations() * dataset.Files.size());
+}
+BENCHMARK(BM_LoadAsync)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->Unit(benchmark::kMillisecond);
+
+} // anonymous namespace
+
+SEQUOIA_BENCHMARK_MAIN(sequoia::unittest::BenchmarkEnvironment);
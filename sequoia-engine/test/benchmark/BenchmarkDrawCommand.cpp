@@ -0,0 +1,120 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                         _____                        _
+//                        / ____|                      (_)
+//                       | (___   ___  __ _ _   _  ___  _  __ _
+//                        \___ \ / _ \/ _` | | | |/ _ \| |/ _` |
+//                        ____) |  __/ (_| | |_| | (_) | | (_| |
+//                       |_____/ \___|\__, |\__,_|\___/|_|\__,_| - Game Engine (2016-2017)
+//                                       | |
+//                                       |_|
+//
+// This file is distributed under the MIT License (MIT).
+// See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#include "sequoia-engine/Game/Material.h"
+#include "sequoia-engine/Render/DrawCommand.h"
+#include "sequoia-engine/Unittest/BenchmarkEnvironment.h"
+#include "sequoia-engine/Unittest/BenchmarkMain.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+/// Number of heap allocations
+static std::atomic<std::size_t> NumAllocations{0};
+
+void* operator new(std::size_t size) {
+  NumAllocations++;
+  if(void* ptr = std::malloc(size))
+    return ptr;
+  throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+
+using namespace sequoia;
+
+namespace {
+
+/// Material with a few textures and uniforms (the textures are never dereferenced)
+static std::vector<std::shared_ptr<game::Material>> makeMaterials(int numMaterials) {
+  std::vector<std::shared_ptr<game::Material>> materials;
+  for(int i = 0; i < numMaterials; ++i) {
+    auto material = std::make_shared<game::Material>();
+    material->setTexture(0, nullptr);
+    material->setTexture(1, nullptr);
+    material->setUniformVariable("u_Shininess", float(i));
+    material->setUniformVariable("u_DiffuseColor", math::vec3(i));
+    material->setUniformVariable("u_SpecularColorIntensity", math::vec4(i));
+    materials.emplace_back(material);
+  }
+  return materials;
+}
+
+/// DrawCommand which holds a copy of the textures and uniforms of the material (i.e the layout of
+/// the DrawCommand prior to the BindingSet)
+struct CopyingDrawCommand {
+  render::VertexData* Data;
+  math::mat4 ModelMatrix;
+  std::unordered_map<int, render::Texture*> Textures;
+  std::unordered_map<std::string, render::UniformVariable> Uniforms;
+};
+
+// Generate the DrawCommands of `state.range(0)` objects by copying the material into each command
+
+static void BM_DrawCommandCopyMaterial(benchmark::State& state) {
+  auto materials = makeMaterials(16);
+  std::vector<CopyingDrawCommand> drawCommands;
+  drawCommands.reserve(state.range(0));
+
+  std::size_t numAllocations = NumAllocations;
+  while(state.KeepRunning()) {
+    drawCommands.clear();
+    for(int i = 0; i < state.range(0); ++i) {
+      const game::Material* material = materials[i % materials.size()].get();
+      CopyingDrawCommand cmd{nullptr, math::mat4(1.0f), {}, {}};
+      for(const auto& unitTexturePair : material->getTextures())
+        cmd.Textures[unitTexturePair.first] = unitTexturePair.second.get();
+      for(const auto& nameVariablePair : material->getUniforms())
+        cmd.Uniforms[nameVariablePair.first] = nameVariablePair.second;
+      drawCommands.emplace_back(std::move(cmd));
+    }
+    benchmark::DoNotOptimize(drawCommands.data());
+  }
+  state.counters["AllocsPerIteration"] =
+      double(NumAllocations - numAllocations) / state.iterations();
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_DrawCommandCopyMaterial)->RangeMultiplier(8)->Range(1 << 6, 1 << 15);
+
+// Generate the DrawCommands of `state.range(0)` objects by referencing the BindingSet of the
+// material
+
+static void BM_DrawCommandBindingSet(benchmark::State& state) {
+  auto materials = makeMaterials(16);
+  std::vector<render::DrawCommand> drawCommands;
+  drawCommands.reserve(state.range(0));
+
+  // Create the BindingSets upfront (this happens only once per material)
+  for(const auto& material : materials)
+    material->getBindingSet();
+
+  std::size_t numAllocations = NumAllocations;
+  while(state.KeepRunning()) {
+    drawCommands.clear();
+    for(int i = 0; i < state.range(0); ++i) {
+      const game::Material* material = materials[i % materials.size()].get();
+      drawCommands.emplace_back(nullptr, math::mat4(1.0f), material->getBindingSet());
+    }
+    benchmark::DoNotOptimize(drawCommands.data());
+  }
+  state.counters["AllocsPerIteration"] =
+      double(NumAllocations - numAllocations) / state.iterations();
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_DrawCommandBindingSet)->RangeMultiplier(8)->Range(1 << 6, 1 << 15);
+
+} // anonymous namespace
+
+SEQUOIA_BENCHMARK_MAIN(sequoia::unittest::BenchmarkEnvironment);
@@ -0,0 +1,92 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                         _____                        _
+//                        / ____|                      (_)
+//                       | (___   ___  __ _ _   _  ___  _  __ _
+//                        \___ \ / _ \/ _` | | | |/ _ \| |/ _` |
+//                        ____) |  __/ (_| | |_| | (_) | | (_| |
+//                       |_____/ \___|\__, |\__,_|\___/|_|\__,_| - Game Engine (2016-2017)
+//                                       | |
+//                                       |_|
+//
+// This file is distributed under the MIT License (MIT).
+// See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#include "sequoia-engine/Render/RenderServer.h"
+#include "sequoia-engine/Unittest/BenchmarkEnvironment.h"
+#include "sequoia-engine/Unittest/BenchmarkMain.h"
+#include <opencv2/opencv.hpp>
+#include <vector>
+
+using namespace sequoia;
+using namespace sequoia::render;
+
+namespace {
+
+/// @brief Encoded 512x512 RGB image with some structure (so the PNG does not degenerate)
+static const std::vector<uchar>& getEncodedImage() {
+  static std::vector<uchar> encoded;
+  if(encoded.empty()) {
+    cv::Mat image(512, 512, CV_8UC3);
+    cv::randu(image, cv::Scalar::all(0), cv::Scalar::all(255));
+    cv::GaussianBlur(image, image, cv::Size(9, 9), 0);
+    cv::imencode(".png", image, encoded);
+  }
+  return encoded;
+}
+
+// Decode N independent images on a RenderServer with M workers (M = 1 corresponds to the former
+// single ressource thread)
+
+static void BM_DecodeJobs(benchmark::State& state) {
+  const std::vector<uchar>& encoded = getEncodedImage();
+  const int numJobs = state.range(0);
+  RenderServer server(state.range(1));
+
+  std::vector<Future<int>> futures;
+  futures.reserve(numJobs);
+
+  while(state.KeepRunning()) {
+    for(int i = 0; i < numJobs; ++i)
+      futures.emplace_back(server.spawnRessourceTask(
+          [&encoded]() { return cv::imdecode(encoded, cv::IMREAD_COLOR).rows; }));
+
+    for(auto& future : futures)
+      benchmark::DoNotOptimize(future.get());
+    futures.clear();
+  }
+  state.SetItemsProcessed(state.iterations() * numJobs);
+}
+BENCHMARK(BM_DecodeJobs)
+    ->Args({64, 1})
+    ->Args({64, 2})
+    ->Args({64, 4})
+    ->Args({64, 8})
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+// Overhead of spawning and waiting for empty jobs
+
+static void BM_EmptyJobs(benchmark::State& state) {
+  const int numJobs = state.range(0);
+  RenderServer server(state.range(1));
+
+  std::vector<Future<void>> futures;
+  futures.reserve(numJobs);
+
+  while(state.KeepRunning()) {
+    for(int i = 0; i < numJobs; ++i)
+      futures.emplace_back(server.spawnJob([]() {}));
+
+    for(auto& future : futures)
+      future.get();
+    futures.clear();
+  }
+  state.SetItemsProcessed(state.iterations() * numJobs);
+}
+BENCHMARK(BM_EmptyJobs)->Args({1024, 1})->Args({1024, 4})->UseRealTime();
+
+} // anonymous namespace
+
+SEQUOIA_BENCHMARK_MAIN(sequoia::unittest::BenchmarkEnvironment);
@@ -13,12 +13,70 @@
 //
 //===------------------------------------------------------------------------------------------===//
 
+#include "sequoia-engine/Game/SceneGraph.h"
 #include "sequoia-engine/Game/SceneNode.h"
 #include "sequoia-engine/Unittest/BenchmarkEnvironment.h"
 #include "sequoia-engine/Unittest/BenchmarkMain.h"
+#include <tbb/task_scheduler_init.h>
 
 using namespace sequoia;
+using namespace sequoia::game;
 
-namespace {} // anonymous namespace
+namespace {
+
+/// Node which does a bit of work on each update (similar to a moving object)
+class RotatingNode : public SceneNode {
+public:
+  RotatingNode(const std::string& name) : SceneNode(name) {}
+
+  void update(const UpdateEvent& event) override {
+    SceneNode::update(event);
+    yaw(math::Radian(event.TimeStep));
+    benchmark::DoNotOptimize(getModelMatrix());
+  }
+};
+
+/// Build a graph of `numNodes` nodes where each node has up to `fanout` children
+static std::shared_ptr<SceneGraph> makeSceneGraph(int numNodes, int fanout) {
+  auto graph = std::make_shared<SceneGraph>();
+
+  std::vector<std::shared_ptr<SceneNode>> nodes;
+  nodes.reserve(numNodes);
+  for(int i = 0; i < numNodes; ++i) {
+    auto node = SceneNode::allocate<RotatingNode>("Node_" + std::to_string(i));
+    if(i < fanout)
+      graph->insert(node);
+    else
+      nodes[i / fanout - 1]->addChild(node);
+    nodes.emplace_back(node);
+  }
+  return graph;
+}
+
+// Benchmark sequential update of the SceneGraph
+
+static void BM_SceneGraphUpdateSequential(benchmark::State& state) {
+  auto graph = makeSceneGraph(state.range(0), 8);
+  while(state.KeepRunning())
+    graph->update(SceneNode::UpdateEvent{0.01f}, SceneNode::EP_Sequential);
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_SceneGraphUpdateSequential)->Arg(1 << 10)->Arg(1 << 14)->Arg(1 << 16);
+
+// Benchmark parallel update of the SceneGraph with an increasing number of threads
+
+static void BM_SceneGraphUpdateParallel(benchmark::State& state) {
+  tbb::task_scheduler_init init(state.range(1));
+  auto graph = makeSceneGraph(state.range(0), 8);
+  while(state.KeepRunning())
+    graph->update(SceneNode::UpdateEvent{0.01f}, SceneNode::EP_Parallel);
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_SceneGraphUpdateParallel)
+    ->RangeMultiplier(2)
+    ->Ranges({{1 << 10, 1 << 16}, {1, 16}})
+    ->UseRealTime();
+
+} // anonymous namespace
 
 SEQUOIA_BENCHMARK_MAIN(sequoia::unittest::BenchmarkEnvironment);
@@ -0,0 +1,112 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                         _____                        _
+//                        / ____|                      (_)
+//                       | (___   ___  __ _ _   _  ___  _  __ _
+//                        \___ \ / _ \/ _` | | | |/ _ \| |/ _` |
+//                        ____) |  __/ (_| | |_| | (_) | | (_| |
+//                       |_____/ \___|\__, |\__,_|\___/|_|\__,_| - Game Engine (2016-2017)
+//                                       | |
+//                                       |_|
+//
+// This file is distributed under the MIT License (MIT).
+// See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#include "sequoia-engine/Core/Format.h"
+#include "sequoia-engine/Core/Platform.h"
+#include "sequoia-engine/Core/RealFileSystem.h"
+#include "sequoia-engine/Game/AssetManager.h"
+#include "sequoia-engine/Game/MeshCache.h"
+#include "sequoia-engine/Game/ShapeManager.h"
+#include "sequoia-engine/Unittest/BenchmarkEnvironment.h"
+#include "sequoia-engine/Unittest/BenchmarkMain.h"
+#include <cmath>
+#include <fstream>
+#include <map>
+#include <memory>
+
+using namespace sequoia;
+using namespace sequoia::game;
+
+namespace {
+
+static platform::Path getBenchmarkDir() {
+  return platform::filesystem::temp_directory_path() / PLATFORM_STR("sequoia-engine") /
+         PLATFORM_STR("BenchmarkShapeManager");
+}
+
+/// @brief Get the `.obj` file of a sphere with `N x N` vertices
+static std::shared_ptr<File> getSphere(int N) {
+  static std::map<int, std::shared_ptr<File>> files;
+  static AssetManager assetManager(platform::toAnsiString(getBenchmarkDir()));
+
+  auto& file = files[N];
+  if(!file) {
+    std::string path = core::format("Sphere{}.obj", N);
+    platform::filesystem::create_directories(getBenchmarkDir());
+    std::ofstream ofs(platform::toAnsiString(getBenchmarkDir() / platform::asPath(path)).c_str());
+
+    const float pi = 3.14159265358979f;
+    for(int i = 0; i < N; ++i) {
+      for(int j = 0; j < N; ++j) {
+        float theta = pi * i / (N - 1), phi = 2 * pi * j / (N - 1);
+        float x = std::sin(theta) * std::cos(phi), y = std::cos(theta),
+              z = std::sin(theta) * std::sin(phi);
+        ofs << core::format("v {} {} {}\nvn {} {} {}\nvt {} {}\n", x, y, z, x, y, z,
+                            float(j) / (N - 1), float(i) / (N - 1));
+      }
+    }
+
+    for(int i = 0; i < N - 1; ++i) {
+      for(int j = 0; j < N - 1; ++j) {
+        int v[4] = {i * N + j + 1, (i + 1) * N + j + 1, (i + 1) * N + j + 2, i * N + j + 2};
+        ofs << core::format("f {0}/{0}/{0} {1}/{1}/{1} {2}/{2}/{2} {3}/{3}/{3}\n", v[0], v[1],
+                            v[2], v[3]);
+      }
+    }
+    ofs.close();
+    file = assetManager.load(path);
+  }
+  return file;
+}
+
+/// @brief Count the triangles to make sure the meshes are not optimized away
+static std::size_t getNumIndices(const MeshCache::Entry& entry) {
+  std::size_t numIndices = 0;
+  for(const auto& mesh : entry.Meshes)
+    numIndices += mesh.NumIndices;
+  return numIndices;
+}
+
+// Read the meshes of a sphere with N x N vertices (without uploading them to the GPU)
+
+static void BM_Import(benchmark::State& state) {
+  auto file = getSphere(state.range(0));
+  ShapeManager manager;
+  while(state.KeepRunning())
+    benchmark::DoNotOptimize(getNumIndices(manager.readMeshes(file)));
+  state.SetBytesProcessed(state.iterations() * file->getNumBytes());
+}
+BENCHMARK(BM_Import)->Arg(64)->Arg(256)->Arg(512)->Unit(benchmark::kMillisecond);
+
+static void BM_Cached(benchmark::State& state) {
+  auto file = getSphere(state.range(0));
+  platform::Path cacheDir = getBenchmarkDir() / PLATFORM_STR("MeshCache");
+  platform::filesystem::create_directories(cacheDir);
+
+  ShapeManager manager(std::make_unique<MeshCache>(
+      std::make_shared<core::RealFileSystem>(platform::toAnsiString(cacheDir))));
+
+  // Populate the cache
+  manager.readMeshes(file);
+
+  while(state.KeepRunning())
+    benchmark::DoNotOptimize(getNumIndices(manager.readMeshes(file)));
+  state.SetBytesProcessed(state.iterations() * file->getNumBytes());
+}
+BENCHMARK(BM_Cached)->Arg(64)->Arg(256)->Arg(512)->Unit(benchmark::kMillisecond);
+
+} // anonymous namespace
+
+SEQUOIA_BENCHMARK_MAIN(sequoia::unittest::BenchmarkEnvironment);
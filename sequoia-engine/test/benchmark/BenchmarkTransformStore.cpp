@@ -0,0 +1,87 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                         _____                        _
+//                        / ____|                      (_)
+//                       | (___   ___  __ _ _   _  ___  _  __ _
+//                        \___ \ / _ \/ _` | | | |/ _ \| |/ _` |
+//                        ____) |  __/ (_| | |_| | (_) | | (_| |
+//                       |_____/ \___|\__, |\__,_|\___/|_|\__,_| - Game Engine (2016-2017)
+//                                       | |
+//                                       |_|
+//
+// This file is distributed under the MIT License (MIT).
+// See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#include "sequoia-engine/Game/SceneNodeAlloc.h"
+#include "sequoia-engine/Game/TransformStore.h"
+#include "sequoia-engine/Unittest/BenchmarkEnvironment.h"
+#include "sequoia-engine/Unittest/BenchmarkMain.h"
+#include <algorithm>
+#include <random>
+#include <string>
+
+using namespace sequoia;
+using namespace sequoia::game;
+
+namespace {
+
+/// Transformation interleaved with the other members of a node, each node being allocated
+/// separately (i.e the layout of the SceneNode prior to the TransformStore)
+struct InterleavedNode {
+  InterleavedNode(const std::string& name) : Name(name) {}
+
+  math::vec3 Position = math::vec3(0.0f);
+  math::quat Orientation = math::quat();
+  float Scale = 1.0f;
+  math::mat4 ModelMatrix = math::mat4(1.0f);
+  bool ModelMatrixIsDirty = true;
+  std::weak_ptr<InterleavedNode> Parent;
+  std::string Name;
+};
+
+// Use the same math as the TransformStore, only the memory layout differs between the benchmarks
+static void computeModelMatrix(InterleavedNode& node) {
+  TransformStore::computeModelMatrices(1, &node.Position, &node.Orientation, &node.Scale,
+                                       &node.ModelMatrix);
+  node.ModelMatrixIsDirty = false;
+}
+
+// Recompute the model matrices of separately allocated nodes (visited in a shuffled order to mimic
+// a long running scene where nodes are allocated all over the heap)
+
+static void BM_TransformInterleaved(benchmark::State& state) {
+  std::vector<std::shared_ptr<InterleavedNode>> nodes;
+  for(int i = 0; i < state.range(0); ++i) {
+    nodes.emplace_back(scene::allocate_shared<InterleavedNode>("Node_" + std::to_string(i)));
+    nodes.back()->Position = math::vec3(i);
+  }
+  std::shuffle(nodes.begin(), nodes.end(), std::mt19937(42));
+
+  while(state.KeepRunning()) {
+    for(const auto& node : nodes)
+      computeModelMatrix(*node);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_TransformInterleaved)->RangeMultiplier(4)->Range(1 << 10, 1 << 18);
+
+// Recompute the model matrices stored in the TransformStore in a single linear pass
+
+static void BM_TransformStore(benchmark::State& state) {
+  TransformStore store;
+  for(int i = 0; i < state.range(0); ++i)
+    store.getPosition(store.allocate()) = math::vec3(i);
+
+  while(state.KeepRunning()) {
+    store.computeModelMatrices();
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_TransformStore)->RangeMultiplier(4)->Range(1 << 10, 1 << 18);
+
+} // anonymous namespace
+
+SEQUOIA_BENCHMARK_MAIN(sequoia::unittest::BenchmarkEnvironment);
@@ -0,0 +1,175 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                         _____                        _
+//                        / ____|                      (_)
+//                       | (___   ___  __ _ _   _  ___  _  __ _
+//                        \___ \ / _ \/ _` | | | |/ _ \| |/ _` |
+//                        ____) |  __/ (_| | |_| | (_) | | (_| |
+//                       |_____/ \___|\__, |\__,_|\___/|_|\__,_| - Game Engine (2016-2017)
+//                                       | |
+//                                       |_|
+//
+// This file is distributed under the MIT License (MIT).
+// See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#include "sequoia-engine/Core/ArchiveFileSystem.h"
+#include "sequoia-engine/Core/Exception.h"
+#include "sequoia-engine/Unittest/TestEnvironment.h"
+#include <fstream>
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+
+using namespace sequoia::core;
+using namespace sequoia::unittest;
+using namespace sequoia::platform;
+
+namespace {
+
+class ArchiveFileSystemTest : public testing::Test {
+protected:
+  Path archivePath;
+
+  virtual void SetUp() override {
+    auto& env = TestEnvironment::getSingleton();
+    archivePath = env.createTemporaryDir(getCurrentBaseDir()) / PLATFORM_STR("Archive.sqpa");
+  }
+
+  Path getCurrentBaseDir() {
+    auto& env = TestEnvironment::getSingleton();
+    return Path(PLATFORM_STR("sequoia-engine")) / PLATFORM_STR("Core") /
+           asPath(env.testCaseName()) / asPath(env.testName());
+  }
+
+  void add(ArchiveWriter& writer, const std::string& path, const std::string& content,
+           bool compress) {
+    writer.add(path, reinterpret_cast<const Byte*>(content.data()), content.size(), compress);
+  }
+};
+
+static std::string makeCompressible(std::size_t numBytes) {
+  std::string str;
+  while(str.size() < numBytes)
+    str += "Hello sequoia! ";
+  return str.substr(0, numBytes);
+}
+
+TEST_F(ArchiveFileSystemTest, Read) {
+  ArchiveWriter writer;
+  add(writer, "foo/bar.txt", "Hello bar!", false);
+  add(writer, "foo.txt", "Hello foo!", false);
+  add(writer, "empty.txt", "", false);
+  EXPECT_EQ(writer.getNumEntries(), 3);
+  EXPECT_THROW(add(writer, "foo.txt", "Hello foo!", false), Exception);
+  writer.write(archivePath);
+
+  ArchiveFileSystem fs(toAnsiString(archivePath));
+  EXPECT_EQ(fs.getArchive().getEntries().size(), 3);
+
+  EXPECT_TRUE(fs.exists("foo/bar.txt"));
+  EXPECT_TRUE(fs.exists("foo\\bar.txt"));
+  EXPECT_FALSE(fs.exists("bar.txt"));
+
+  auto bar = fs.read("foo/bar.txt", FileBuffer::FF_Text);
+  ASSERT_TRUE(bar != nullptr);
+  EXPECT_TRUE(bar->isMapped());
+  EXPECT_STREQ(bar->getDataAsString().c_str(), "Hello bar!");
+
+  // Blobs are aligned
+  EXPECT_TRUE(memory::is_aligned(bar->getData()));
+
+  // Read same file (should return the same buffer)
+  EXPECT_EQ(bar.get(), fs.read("foo/bar.txt", FileBuffer::FF_Text).get());
+
+  auto foo = fs.read("foo.txt", FileBuffer::FF_Text);
+  ASSERT_TRUE(foo != nullptr);
+  EXPECT_STREQ(foo->getDataAsString().c_str(), "Hello foo!");
+
+  auto empty = fs.read("empty.txt", FileBuffer::FF_Text);
+  ASSERT_TRUE(empty != nullptr);
+  EXPECT_EQ(empty->getNumBytes(), 0);
+
+  EXPECT_THROW(fs.read("bar.txt", FileBuffer::FF_Text), Exception);
+}
+
+TEST_F(ArchiveFileSystemTest, Compressed) {
+  const std::string content = makeCompressible(1 << 16);
+
+  ArchiveWriter writer;
+  add(writer, "foo.txt", content, true);
+  add(writer, "bar.txt", "Hello bar!", true);
+  EXPECT_LT(writer.getNumBytes(), writer.getNumBytesUncompressed());
+  writer.write(archivePath);
+
+  ArchiveFileSystem fs(toAnsiString(archivePath));
+  EXPECT_TRUE(fs.getArchive().find("foo.txt")->isCompressed());
+
+  // Compressing small files doesn't pay off
+  EXPECT_FALSE(fs.getArchive().find("bar.txt")->isCompressed());
+
+  auto foo = fs.read("foo.txt", FileBuffer::FF_Text);
+  ASSERT_TRUE(foo != nullptr);
+  EXPECT_FALSE(foo->isMapped());
+  EXPECT_EQ(foo->getDataAsString(), content);
+
+  auto bar = fs.read("bar.txt", FileBuffer::FF_Text);
+  ASSERT_TRUE(bar != nullptr);
+  EXPECT_STREQ(bar->getDataAsString().c_str(), "Hello bar!");
+}
+
+TEST_F(ArchiveFileSystemTest, VirtualFile) {
+  ArchiveWriter writer;
+  add(writer, "foo.txt", "Hello foo!", false);
+  writer.write(archivePath);
+
+  ArchiveFileSystem fs(toAnsiString(archivePath));
+
+  auto barBuffer = std::make_shared<FileBuffer>(FileBuffer::FF_Text, "XXX", 10);
+  barBuffer->write("Hello bar!", 0, 10);
+
+  // Files of the archive are read-only
+  EXPECT_THROW(fs.addFile("foo.txt", barBuffer), Exception);
+  EXPECT_THROW(fs.write("foo.txt", barBuffer), Exception);
+
+  EXPECT_NO_THROW(fs.addFile("bar.txt", barBuffer));
+  EXPECT_TRUE(fs.exists("bar.txt"));
+  EXPECT_STREQ(barBuffer->getPath().c_str(), "bar.txt");
+  EXPECT_EQ(fs.read("bar.txt", FileBuffer::FF_Text).get(), barBuffer.get());
+}
+
+TEST_F(ArchiveFileSystemTest, Invalid) {
+  {
+    std::ofstream ofs(toAnsiString(archivePath).c_str());
+    ofs << "SQPA but not really an archive ... not at all!";
+  }
+  EXPECT_THROW(ArchiveFileSystem fs(toAnsiString(archivePath)), Exception);
+
+  // Truncated archive
+  ArchiveWriter writer;
+  add(writer, "foo.txt", makeCompressible(1 << 12), false);
+  writer.write(archivePath);
+  filesystem::resize_file(archivePath, filesystem::file_size(archivePath) - 16);
+  EXPECT_THROW(ArchiveFileSystem fs(toAnsiString(archivePath)), Exception);
+
+  // Uncompressed size exceeding the maximum compression ratio
+  writer.write(archivePath);
+  {
+    std::fstream fs(toAnsiString(archivePath).c_str(),
+                    std::ios_base::in | std::ios_base::out | std::ios_base::binary);
+    Archive::Header header;
+    fs.read(reinterpret_cast<char*>(&header), sizeof(header));
+
+    Archive::Entry entry;
+    fs.seekg(header.EntriesOffset);
+    fs.read(reinterpret_cast<char*>(&entry), sizeof(entry));
+    ASSERT_TRUE(entry.isCompressed());
+
+    entry.NumBytesUncompressed = std::uint64_t(1) << 60;
+    fs.seekp(header.EntriesOffset);
+    fs.write(reinterpret_cast<const char*>(&entry), sizeof(entry));
+  }
+  EXPECT_THROW(ArchiveFileSystem fs(toAnsiString(archivePath)), Exception);
+}
+
+} // anonymous namespace
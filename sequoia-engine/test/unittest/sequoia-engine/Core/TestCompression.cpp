@@ -0,0 +1,111 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                         _____                        _
+//                        / ____|                      (_)
+//                       | (___   ___  __ _ _   _  ___  _  __ _
+//                        \___ \ / _ \/ _` | | | |/ _ \| |/ _` |
+//                        ____) |  __/ (_| | |_| | (_) | | (_| |
+//                       |_____/ \___|\__, |\__,_|\___/|_|\__,_| - Game Engine (2016-2017)
+//                                       | |
+//                                       |_|
+//
+// This file is distributed under the MIT License (MIT).
+// See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#include "sequoia-engine/Core/Compression.h"
+#include <gtest/gtest.h>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace sequoia::core;
+
+namespace {
+
+static std::vector<Byte> compress(const std::vector<Byte>& data) {
+  std::vector<Byte> compressed(compression::getCompressBound(data.size()));
+  std::size_t numBytes =
+      compression::compress(data.data(), data.size(), compressed.data(), compressed.size());
+  compressed.resize(numBytes);
+  return compressed;
+}
+
+static std::vector<Byte> decompress(const std::vector<Byte>& compressed, std::size_t numBytes) {
+  std::vector<Byte> data(numBytes);
+  if(!compression::decompress(compressed.data(), compressed.size(), data.data(), data.size()))
+    data.clear();
+  return data;
+}
+
+TEST(CompressionTest, Empty) {
+  std::vector<Byte> data;
+  auto compressed = compress(data);
+  ASSERT_FALSE(compressed.empty());
+  EXPECT_TRUE(compression::decompress(compressed.data(), compressed.size(), nullptr, 0));
+}
+
+TEST(CompressionTest, Compressible) {
+  std::string text;
+  for(int i = 0; i < 1000; ++i)
+    text += "Hello sequoia! ";
+
+  std::vector<Byte> data(text.begin(), text.end());
+  auto compressed = compress(data);
+  ASSERT_FALSE(compressed.empty());
+  EXPECT_LT(compressed.size(), data.size() / 10);
+  EXPECT_EQ(decompress(compressed, data.size()), data);
+}
+
+TEST(CompressionTest, DecompressBound) {
+  // A single repeated byte yields the highest compression ratio
+  std::vector<Byte> data(1 << 20, Byte(42));
+  auto compressed = compress(data);
+  ASSERT_FALSE(compressed.empty());
+  EXPECT_LE(data.size(), compression::getDecompressBound(compressed.size()));
+  EXPECT_EQ(decompress(compressed, data.size()), data);
+}
+
+TEST(CompressionTest, Incompressible) {
+  std::mt19937 rng(42);
+  std::vector<Byte> data(1 << 16);
+  for(auto& byte : data)
+    byte = static_cast<Byte>(rng());
+
+  auto compressed = compress(data);
+  ASSERT_FALSE(compressed.empty());
+  EXPECT_LE(compressed.size(), compression::getCompressBound(data.size()));
+  EXPECT_EQ(decompress(compressed, data.size()), data);
+
+  // Insufficient capacity
+  std::vector<Byte> small(data.size() / 2);
+  EXPECT_EQ(compression::compress(data.data(), data.size(), small.data(), small.size()), 0);
+}
+
+TEST(CompressionTest, Corrupted) {
+  std::string text;
+  for(int i = 0; i < 100; ++i)
+    text += "Hello sequoia! " + std::to_string(i);
+
+  std::vector<Byte> data(text.begin(), text.end());
+  auto compressed = compress(data);
+
+  // Wrong size
+  std::vector<Byte> dest(data.size() + 1);
+  EXPECT_FALSE(
+      compression::decompress(compressed.data(), compressed.size(), dest.data(), dest.size()));
+
+  // Truncated input
+  EXPECT_FALSE(compression::decompress(compressed.data(), compressed.size() / 2, dest.data(),
+                                       data.size()));
+
+  // Random corruptions must never access memory out of bounds
+  std::mt19937 rng(42);
+  for(int i = 0; i < 100; ++i) {
+    auto corrupted = compressed;
+    corrupted[rng() % corrupted.size()] ^= static_cast<Byte>(1 + rng() % 255);
+    compression::decompress(corrupted.data(), corrupted.size(), dest.data(), data.size());
+  }
+}
+
+} // anonymous namespace
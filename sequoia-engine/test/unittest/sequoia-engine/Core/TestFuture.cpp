@@ -15,8 +15,12 @@
 
 #include "sequoia-engine/Core/Future.h"
 #include "sequoia-engine/Core/STLExtras.h"
+#include <atomic>
 #include <gtest/gtest.h>
+#include <memory>
+#include <string>
 #include <thread>
+#include <vector>
 
 using namespace sequoia;
 
@@ -103,4 +107,143 @@ TEST(FutureTest, FutureTaskError) {
   t.join();
 }
 
+TEST(FutureTest, IsReady) {
+  auto task = makeTask([]() { return int(2); });
+  auto future = task->getFuture();
+  EXPECT_FALSE(future.isReady());
+
+  task->run();
+  EXPECT_TRUE(future.isReady());
+  EXPECT_FALSE(future.hasError());
+  EXPECT_EQ(future.get(), 2);
+
+  Future<int> invalid;
+  EXPECT_FALSE(invalid.isReady());
+}
+
+TEST(FutureTest, Then) {
+  auto task = makeTask([]() { return int(2); });
+  Future<int> future = task->getFuture();
+
+  std::vector<int> order;
+  Future<int> f1 = future.then([&order](Future<int> f) {
+    order.push_back(1);
+    return f.get() * 2;
+  });
+  Future<std::string> f = f1.then([&order](Future<int> f) {
+    order.push_back(2);
+    return std::to_string(f.get());
+  });
+  EXPECT_FALSE(future.valid());
+  EXPECT_FALSE(f.isReady());
+  EXPECT_TRUE(order.empty());
+
+  // Continuations run in order on the thread completing the future
+  std::thread t([&task]() { task->run(); });
+  EXPECT_EQ(f.get(), "4");
+  t.join();
+
+  ASSERT_EQ(order.size(), 2);
+  EXPECT_EQ(order[0], 1);
+  EXPECT_EQ(order[1], 2);
+
+  // Continuation of a ready future runs immediately
+  bool run = false;
+  Future<void> g = Future<int>::create(5).then([&run](Future<int> f) { run = f.get() == 5; });
+  EXPECT_TRUE(run);
+  EXPECT_TRUE(g.isReady());
+  EXPECT_NO_THROW(g.get());
+}
+
+TEST(FutureTest, ThenError) {
+  auto task = makeTask([]() -> int { throw std::runtime_error("Error"); });
+
+  // The error is propagated through the chain by calling `get()`
+  std::atomic<bool> run(false);
+  Future<int> f1 = task->getFuture().then([](Future<int> f) { return f.get() + 1; });
+  Future<int> f = f1.then([&run](Future<int> f) {
+    run = true;
+    return f.get() + 1;
+  });
+
+  task->run();
+  EXPECT_TRUE(run.load());
+  EXPECT_TRUE(f.isDone());
+  EXPECT_FALSE(f.isReady());
+  EXPECT_TRUE(f.hasError());
+  EXPECT_THROW(f.get(), std::runtime_error);
+
+  // Errors thrown by the continuation itself
+  Future<void> g = Future<void>::create().then([](Future<void> f) {
+    f.get();
+    throw std::logic_error("Error");
+  });
+  EXPECT_THROW(g.get(), std::logic_error);
+}
+
+TEST(FutureTest, ThenMoveOnly) {
+  auto task = makeTask([]() { return int(2); });
+
+  // Continuations may capture move-only state
+  auto factor = std::make_unique<int>(3);
+  Future<int> f = task->getFuture().then(
+      [factor = std::move(factor)](Future<int> f) { return f.get() * (*factor); });
+
+  task->run();
+  EXPECT_EQ(f.get(), 6);
+}
+
+TEST(FutureTest, WhenAll) {
+  std::vector<std::shared_ptr<FutureTask<int>>> tasks;
+  std::vector<Future<int>> futures;
+  for(int i = 0; i < 4; ++i) {
+    tasks.emplace_back(makeTask([i]() -> int {
+      if(i == 3)
+        throw std::runtime_error("Error");
+      return i;
+    }));
+    futures.emplace_back(tasks.back()->getFuture());
+  }
+
+  auto all = when_all(futures);
+  EXPECT_FALSE(all.isReady());
+
+  std::vector<std::thread> threads;
+  for(auto& task : tasks)
+    threads.emplace_back([task]() { task->run(); });
+
+  std::vector<Future<int>> results = all.get();
+  for(auto& thread : threads)
+    thread.join();
+
+  ASSERT_EQ(results.size(), 4);
+  for(int i = 0; i < 3; ++i) {
+    EXPECT_TRUE(results[i].isReady());
+    EXPECT_EQ(results[i].get(), i);
+  }
+  EXPECT_TRUE(results[3].hasError());
+  EXPECT_THROW(results[3].get(), std::runtime_error);
+
+  // Empty range is ready immediately
+  EXPECT_TRUE(when_all(std::vector<Future<int>>()).isReady());
+}
+
+TEST(FutureTest, WhenAny) {
+  auto task1 = makeTask([]() { return int(1); });
+  auto task2 = makeTask([]() { return int(2); });
+
+  auto any = when_any(std::vector<Future<int>>{task1->getFuture(), task2->getFuture()});
+  EXPECT_FALSE(any.isReady());
+
+  task2->run();
+  ASSERT_TRUE(any.isReady());
+  task1->run();
+
+  auto result = any.get();
+  EXPECT_EQ(result.Index, 1);
+  ASSERT_EQ(result.Futures.size(), 2);
+  EXPECT_EQ(result.Futures[1].get(), 2);
+  EXPECT_EQ(result.Futures[0].get(), 1);
+}
+
 } // anonymous namespace
@@ -0,0 +1,83 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                         _____                        _
+//                        / ____|                      (_)
+//                       | (___   ___  __ _ _   _  ___  _  __ _
+//                        \___ \ / _ \/ _` | | | |/ _ \| |/ _` |
+//                        ____) |  __/ (_| | |_| | (_) | | (_| |
+//                       |_____/ \___|\__, |\__,_|\___/|_|\__,_| - Game Engine (2016-2017)
+//                                       | |
+//                                       |_|
+//
+// This file is distributed under the MIT License (MIT).
+// See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#include "sequoia-engine/Core/Half.h"
+#include <cmath>
+#include <gtest/gtest.h>
+#include <limits>
+
+using namespace sequoia;
+
+namespace {
+
+TEST(HalfTest, Exact) {
+  // Integers up to 2048 and powers of two are exactly representable
+  for(int i = -2048; i <= 2048; ++i)
+    EXPECT_EQ(float(Half(float(i))), float(i));
+
+  EXPECT_EQ(Half(1.0f).Bits, 0x3c00);
+  EXPECT_EQ(Half(-2.0f).Bits, 0xc000);
+  EXPECT_EQ(Half(0.5f).Bits, 0x3800);
+  EXPECT_EQ(Half(65504.0f).Bits, 0x7bff);
+  EXPECT_EQ(Half(std::ldexp(1.0f, -14)).Bits, 0x0400);
+}
+
+TEST(HalfTest, Rounding) {
+  // Relative error is bounded by 2^-11 for normal halfs
+  for(float value = 1e-4f; value < 60000.0f; value *= 1.01f) {
+    EXPECT_NEAR(float(Half(value)), value, value * 0.00049f);
+    EXPECT_NEAR(float(Half(-value)), -value, value * 0.00049f);
+  }
+
+  // Round to nearest even: 2049 lies halfway between 2048 and 2050
+  EXPECT_EQ(float(Half(2049.0f)), 2048.0f);
+  EXPECT_EQ(float(Half(2051.0f)), 2052.0f);
+  EXPECT_EQ(float(Half(2049.5f)), 2050.0f);
+}
+
+TEST(HalfTest, Special) {
+  // Zero
+  EXPECT_EQ(Half(0.0f).Bits, 0x0000);
+  EXPECT_EQ(Half(-0.0f).Bits, 0x8000);
+  EXPECT_TRUE(std::signbit(float(Half(-0.0f))));
+
+  // Subnormals
+  EXPECT_EQ(Half(std::ldexp(1.0f, -24)).Bits, 0x0001);
+  EXPECT_EQ(float(Half(std::ldexp(1.0f, -24))), std::ldexp(1.0f, -24));
+  EXPECT_EQ(float(Half(std::ldexp(3.0f, -20))), std::ldexp(3.0f, -20));
+  EXPECT_EQ(Half(std::ldexp(1.0f, -26)).Bits, 0x0000);
+
+  // Infinity and overflow
+  const float inf = std::numeric_limits<float>::infinity();
+  EXPECT_EQ(Half(inf).Bits, 0x7c00);
+  EXPECT_EQ(Half(-inf).Bits, 0xfc00);
+  EXPECT_EQ(Half(65520.0f).Bits, 0x7c00);
+  EXPECT_EQ(Half(1e10f).Bits, 0x7c00);
+  EXPECT_EQ(float(Half(inf)), inf);
+
+  // NaN
+  EXPECT_TRUE(std::isnan(float(Half(std::numeric_limits<float>::quiet_NaN()))));
+}
+
+TEST(HalfTest, AllBits) {
+  // Every finite half survives the round trip
+  for(std::uint32_t bits = 0; bits < 0x10000; ++bits) {
+    if(((bits >> 10) & 0x1f) == 0x1f)
+      continue;
+    EXPECT_EQ(Half::fromFloat(Half::toFloat(bits)), bits);
+  }
+}
+
+} // anonymous namespace
@@ -0,0 +1,94 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                         _____                        _
+//                        / ____|                      (_)
+//                       | (___   ___  __ _ _   _  ___  _  __ _
+//                        \___ \ / _ \/ _` | | | |/ _ \| |/ _` |
+//                        ____) |  __/ (_| | |_| | (_) | | (_| |
+//                       |_____/ \___|\__, |\__,_|\___/|_|\__,_| - Game Engine (2016-2017)
+//                                       | |
+//                                       |_|
+//
+// This file is distributed under the MIT License (MIT).
+// See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#include "sequoia-engine/Core/Exception.h"
+#include "sequoia-engine/Core/FileBuffer.h"
+#include "sequoia-engine/Core/MappedFile.h"
+#include "sequoia-engine/Unittest/TestEnvironment.h"
+#include <cstdint>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <string>
+
+using namespace sequoia::core;
+using namespace sequoia::unittest;
+using namespace sequoia::platform;
+
+namespace {
+
+Path getCurrentBaseDir() {
+  auto& env = TestEnvironment::getSingleton();
+  return Path(PLATFORM_STR("sequoia-engine")) / PLATFORM_STR("Core") /
+         asPath(env.testCaseName()) / asPath(env.testName());
+}
+
+static std::string readFile(const Path& path) {
+  std::ifstream ifs(toAnsiString(path).c_str(), std::ios_base::in | std::ios_base::binary);
+  return std::string(std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>());
+}
+
+TEST(MappedFileTest, Map) {
+  auto& env = TestEnvironment::getSingleton();
+  std::string content(3 * MappedFile::getPageSize() + 7, 'x');
+  content.back() = 'y';
+
+  Path path = env.createTemporaryFile(getCurrentBaseDir() / PLATFORM_STR("foo.bin"), content);
+
+  MappedFile file(path);
+  ASSERT_EQ(file.getNumBytes(), content.size());
+  ASSERT_NE(file.getData(), nullptr);
+  EXPECT_EQ(std::string((const char*)file.getData(), file.getNumBytes()), content);
+
+  // Mapping starts at a page boundary
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(file.getData()) % MappedFile::getPageSize(), 0);
+}
+
+TEST(MappedFileTest, Empty) {
+  auto& env = TestEnvironment::getSingleton();
+  Path path = env.createTemporaryFile(getCurrentBaseDir() / PLATFORM_STR("foo.bin"));
+
+  MappedFile file(path);
+  EXPECT_EQ(file.getNumBytes(), 0);
+  EXPECT_EQ(file.getData(), nullptr);
+}
+
+TEST(MappedFileTest, NoSuchFile) {
+  auto& env = TestEnvironment::getSingleton();
+  Path path = env.createTemporaryDir(getCurrentBaseDir()) / PLATFORM_STR("foo.bin");
+
+  EXPECT_THROW(MappedFile file(path), Exception);
+  EXPECT_EQ(MappedFile::tryMap(path), nullptr);
+}
+
+TEST(MappedFileTest, CopyOnWrite) {
+  auto& env = TestEnvironment::getSingleton();
+  Path path = env.createTemporaryFile(getCurrentBaseDir() / PLATFORM_STR("foo.bin"), "Hello foo!");
+
+  FileBuffer buffer(FileBuffer::FF_Binary, "foo.bin", std::make_unique<MappedFile>(path));
+  EXPECT_TRUE(buffer.isMapped());
+  EXPECT_STREQ(buffer.getDataAsString().c_str(), "Hello foo!");
+
+  // Modifications of the buffer are private
+  buffer.write("Hello bar!", 0, 10);
+  EXPECT_STREQ(buffer.getDataAsString().c_str(), "Hello bar!");
+  EXPECT_STREQ(readFile(path).c_str(), "Hello foo!");
+
+  // Reallocating the buffer drops the mapping
+  buffer.allocate(4, Buffer::UH_Dynamic);
+  EXPECT_FALSE(buffer.isMapped());
+  EXPECT_EQ(buffer.getNumBytes(), 4);
+}
+
+} // anonymous namespace
@@ -0,0 +1,65 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                         _____                        _
+//                        / ____|                      (_)
+//                       | (___   ___  __ _ _   _  ___  _  __ _
+//                        \___ \ / _ \/ _` | | | |/ _ \| |/ _` |
+//                        ____) |  __/ (_| | |_| | (_) | | (_| |
+//                       |_____/ \___|\__, |\__,_|\___/|_|\__,_| - Game Engine (2016-2017)
+//                                       | |
+//                                       |_|
+//
+// This file is distributed under the MIT License (MIT).
+// See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#include "sequoia-engine/Core/RadixSort.h"
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <random>
+
+using namespace sequoia;
+
+namespace {
+
+using KeyValue = std::pair<std::uint64_t, int>;
+
+TEST(RadixSortTest, Sort) {
+  std::mt19937_64 rng(42);
+  std::vector<KeyValue> values, scratch;
+  for(int i = 0; i < 1000; ++i)
+    values.emplace_back(rng(), i);
+
+  std::vector<KeyValue> ref = values;
+  std::sort(ref.begin(), ref.end());
+
+  core::radixSort(values, scratch, [](const KeyValue& v) { return v.first; });
+  EXPECT_EQ(values, ref);
+}
+
+TEST(RadixSortTest, Stable) {
+  // Keys only differ in the upper bits and contain many duplicates
+  std::vector<KeyValue> values, scratch;
+  for(int i = 0; i < 100; ++i)
+    values.emplace_back(static_cast<std::uint64_t>(i % 3) << 48, i);
+
+  core::radixSort(values, scratch, [](const KeyValue& v) { return v.first; });
+
+  EXPECT_TRUE(std::is_sorted(values.begin(), values.end()));
+}
+
+TEST(RadixSortTest, Trivial) {
+  std::vector<KeyValue> values, scratch;
+  core::radixSort(values, scratch, [](const KeyValue& v) { return v.first; });
+  EXPECT_TRUE(values.empty());
+
+  values = {{5, 0}};
+  core::radixSort(values, scratch, [](const KeyValue& v) { return v.first; });
+  EXPECT_EQ(values[0], KeyValue(5, 0));
+
+  values = {{5, 0}, {5, 1}, {5, 2}};
+  core::radixSort(values, scratch, [](const KeyValue& v) { return v.first; });
+  EXPECT_EQ(values, (std::vector<KeyValue>{{5, 0}, {5, 1}, {5, 2}}));
+}
+
+} // anonymous namespace
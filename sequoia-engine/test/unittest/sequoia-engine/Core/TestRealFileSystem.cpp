@@ -76,6 +76,26 @@ TEST_F(RealFileSystemTest, Read) {
   EXPECT_STREQ(foo->getDataAsString().c_str(), "Hello foo!");
 }
 
+TEST_F(RealFileSystemTest, ReadMapped) {
+  auto& env = TestEnvironment::getSingleton();
+
+  std::string content(2 * MappedFile::getPageSize(), 'x');
+  env.createTemporaryFile(getCurrentBaseDir() / PLATFORM_STR("foo.bin"), content);
+  env.createTemporaryFile(getCurrentBaseDir() / PLATFORM_STR("bar.bin"), "Hello bar!");
+
+  // Large files are mapped
+  auto foo = fs->read("foo.bin", FileBuffer::FF_Binary);
+  ASSERT_TRUE(foo != nullptr);
+  EXPECT_TRUE(foo->isMapped());
+  EXPECT_EQ(foo->getDataAsString(), content);
+
+  // Small files are copied
+  auto bar = fs->read("bar.bin", FileBuffer::FF_Binary);
+  ASSERT_TRUE(bar != nullptr);
+  EXPECT_FALSE(bar->isMapped());
+  EXPECT_STREQ(bar->getDataAsString().c_str(), "Hello bar!");
+}
+
 TEST_F(RealFileSystemTest, Write) {
   auto& env = TestEnvironment::getSingleton();
 
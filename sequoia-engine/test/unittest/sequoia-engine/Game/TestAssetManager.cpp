@@ -14,10 +14,13 @@
 //===------------------------------------------------------------------------------------------===//
 
 #include "sequoia-engine/Game/AssetManager.h"
+#include "sequoia-engine/Render/RenderServer.h"
 #include "sequoia-engine/Unittest/TestEnvironment.h"
 #include <fstream>
 #include <gtest/gtest.h>
 #include <sstream>
+#include <thread>
+#include <vector>
 
 using namespace sequoia;
 using namespace sequoia::unittest;
@@ -52,4 +55,71 @@ TEST(AssetManagerTest, LoadImage) {
   EXPECT_EQ(*image, *imageCopy);
 }
 
+TEST(AssetManagerTest, LoadAsync) {
+  auto& env = TestEnvironment::getSingleton();
+  render::RenderServer server(4);
+  AssetManager manager(platform::toAnsiString(env.getRessourcePath()), &server);
+
+  // Concurrent requests of the same asset share one load
+  std::vector<Future<std::shared_ptr<File>>> futures;
+  for(int i = 0; i < 16; ++i)
+    futures.emplace_back(manager.loadAsync("sequoia-engine/Game/TestAssetManager/Test.txt"));
+
+  auto file = manager.load("sequoia-engine/Game/TestAssetManager/Test.txt");
+  for(auto& future : futures)
+    EXPECT_EQ(future.get(), file);
+
+  // Already loaded assets are returned immediately
+  auto future = manager.loadAsync("sequoia-engine/Game/TestAssetManager/Test.txt");
+  EXPECT_TRUE(future.isReady());
+  EXPECT_EQ(future.get(), file);
+
+  // Images are decoded once
+  std::vector<Future<std::shared_ptr<Image>>> imageFutures;
+  for(int i = 0; i < 16; ++i)
+    imageFutures.emplace_back(
+        manager.loadImageAsync("sequoia-engine/Game/TestAssetManager/Test.png"));
+
+  auto image = manager.loadImage("sequoia-engine/Game/TestAssetManager/Test.png");
+  for(auto& imageFuture : imageFutures)
+    EXPECT_EQ(imageFuture.get(), image);
+}
+
+TEST(AssetManagerTest, DestroyWithPendingLoads) {
+  auto& env = TestEnvironment::getSingleton();
+  render::RenderServer server(2);
+
+  // The futures are dropped, the manager waits for the pending loads when it is destroyed
+  {
+    AssetManager manager(platform::toAnsiString(env.getRessourcePath()), &server);
+    for(int i = 0; i < 8; ++i) {
+      manager.loadAsync("sequoia-engine/Game/TestAssetManager/Test.txt");
+      manager.loadImageAsync("sequoia-engine/Game/TestAssetManager/Test.png");
+    }
+  }
+}
+
+TEST(AssetManagerTest, ConcurrentLoad) {
+  auto& env = TestEnvironment::getSingleton();
+  AssetManager manager(platform::toAnsiString(env.getRessourcePath()));
+
+  std::vector<std::shared_ptr<File>> files(8);
+  std::vector<std::shared_ptr<Image>> images(8);
+  std::vector<std::thread> threads;
+  for(std::size_t i = 0; i < files.size(); ++i)
+    threads.emplace_back([&, i]() {
+      files[i] = manager.load("sequoia-engine/Game/TestAssetManager/Test.txt");
+      images[i] = manager.loadImage("sequoia-engine/Game/TestAssetManager/Test.png");
+    });
+
+  for(auto& thread : threads)
+    thread.join();
+
+  for(std::size_t i = 1; i < files.size(); ++i) {
+    EXPECT_EQ(files[i], files[0]);
+    EXPECT_EQ(images[i], images[0]);
+  }
+  EXPECT_STREQ(files[0]->getFilename().c_str(), "Test.txt");
+}
+
 } // anonymous namespace
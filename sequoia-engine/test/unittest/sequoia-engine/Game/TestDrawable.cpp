@@ -18,9 +18,18 @@
 #include "sequoia-engine/Game/Scene.h"
 #include "sequoia-engine/Game/SceneGraph.h"
 #include "sequoia-engine/Game/ShapeManager.h"
+#include "sequoia-engine/Render/Camera.h"
+#include "sequoia-engine/Render/DrawCommand.h"
+#include "sequoia-engine/Render/Null/NullRenderer.h"
+#include "sequoia-engine/Render/RTDefault.h"
+#include "sequoia-engine/Render/RenderCommand.h"
+#include "sequoia-engine/Render/VertexData.h"
+#include "sequoia-engine/Render/Viewport.h"
 #include "sequoia-engine/Unittest/GameSetup.h"
+#include "sequoia-engine/Unittest/TestEnvironment.h"
 #include <gtest/gtest.h>
 
+using namespace sequoia;
 using namespace sequoia::unittest;
 using namespace sequoia::game;
 
@@ -55,4 +64,81 @@ TEST_F(DrawableTest, Construction) {
       "invalid kind");
 }
 
+TEST_F(DrawableTest, LodSelection) {
+  Game& game = Game::getSingleton();
+  TestEnvironment& env = TestEnvironment::getSingleton();
+
+  auto file = env.getFile("sequoia-engine/Game/TestMeshManager/Sphere.obj");
+  std::vector<std::shared_ptr<Shape>> shapes =
+      game.getShapeManager()->loadLods("TestLods", file, 3);
+
+  // The unit sphere covers a screen size of `sqrt(3) / (d * tan(45 / 2))` at a distance `d` i.e
+  // level 0 is used up to `d = 8.4` and level 1 up to `d = 16.7` (+/- 10% hysteresis)
+  std::shared_ptr<SceneNode> node = SceneNode::allocate("TestNode");
+  node->addCapability<Drawable>(Drawable::makeLods(shapes, 0.5f, 0.5f), 0.1f);
+  Drawable* drawable = node->get<Drawable>();
+  ASSERT_EQ(drawable->getLods().size(), 3);
+  EXPECT_EQ(drawable->getLod(), 0);
+
+  render::Camera camera;
+  render::RenderTarget* target = game.getMainRenderTarget();
+  auto viewport = std::make_shared<render::Viewport>(target, 0, 0, 80, 80);
+  viewport->setCamera(&camera);
+  target->setViewport(viewport);
+
+  // The DrawCommands are rendered by the NullRenderer which counts the drawn triangles
+  auto renderer = std::make_unique<render::NullRenderer>();
+  render::RTDefault technique;
+  std::size_t numTriangles = 0;
+
+  auto selectLodAt = [&](float distance) {
+    camera.lookAt(math::vec3(0, 0, distance), math::vec3(0, 0, 0));
+
+    render::RenderCommand renderCmd(target);
+    renderCmd.Techniques = {&technique};
+    drawable->prepareDrawCommands(renderCmd.DrawCommands, 1.0f, &camera);
+
+    // The DrawCommands use the meshes of the selected level
+    const auto& meshes = shapes[drawable->getLod()]->getMeshes();
+    EXPECT_EQ(renderCmd.DrawCommands.size(), meshes.size());
+    for(std::size_t i = 0; i < renderCmd.DrawCommands.size(); ++i)
+      EXPECT_EQ(renderCmd.DrawCommands[i].getVertexData(), meshes[i]->getVertexData());
+
+    renderer->reset();
+    renderer->resetStatistics();
+    renderer->render(renderCmd);
+    numTriangles = renderer->getStatistics().NumTriangles;
+    return drawable->getLod();
+  };
+
+  EXPECT_EQ(selectLodAt(5.0f), 0);
+  const std::size_t numTrianglesLod0 = numTriangles;
+  EXPECT_EQ(numTrianglesLod0, 960);
+
+  // Within the hysteresis the level is kept
+  EXPECT_EQ(selectLodAt(9.0f), 0);
+  EXPECT_EQ(selectLodAt(12.0f), 1);
+  EXPECT_EQ(selectLodAt(8.0f), 1);
+  const std::size_t numTrianglesLod1 = numTriangles;
+
+  EXPECT_EQ(selectLodAt(40.0f), 2);
+  EXPECT_EQ(selectLodAt(16.0f), 2);
+  const std::size_t numTrianglesLod2 = numTriangles;
+
+  EXPECT_EQ(selectLodAt(14.0f), 1);
+  EXPECT_EQ(selectLodAt(5.0f), 0);
+
+  EXPECT_LT(numTrianglesLod1, numTrianglesLod0);
+  EXPECT_LT(numTrianglesLod2, numTrianglesLod1);
+
+  // Without a camera the selected level is kept
+  std::vector<render::DrawCommand> drawCommands;
+  drawable->prepareDrawCommands(drawCommands);
+  EXPECT_EQ(drawable->getLod(), 0);
+
+  // Cloning preserves the levels of detail
+  auto nodeClone = node->clone();
+  EXPECT_EQ(nodeClone->get<Drawable>()->getLods().size(), 3);
+}
+
 } // anonymous namespace
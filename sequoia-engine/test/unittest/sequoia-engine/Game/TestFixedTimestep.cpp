@@ -0,0 +1,89 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                         _____                        _
+//                        / ____|                      (_)
+//                       | (___   ___  __ _ _   _  ___  _  __ _
+//                        \___ \ / _ \/ _` | | | |/ _ \| |/ _` |
+//                        ____) |  __/ (_| | |_| | (_) | | (_| |
+//                       |_____/ \___|\__, |\__,_|\___/|_|\__,_| - Game Engine (2016-2017)
+//                                       | |
+//                                       |_|
+//
+// This file is distributed under the MIT License (MIT).
+// See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#include "sequoia-engine/Game/FixedTimestep.h"
+#include <gtest/gtest.h>
+
+using namespace sequoia;
+using namespace sequoia::game;
+
+namespace {
+
+TEST(FixedTimestepTest, ExactSteps) {
+  double now = 0.0;
+  FixedTimestep timestep(0.25, 5, [&now]() { return now; });
+
+  EXPECT_EQ(timestep.advance(), 0);
+
+  now = 0.5;
+  EXPECT_EQ(timestep.advance(), 2);
+  EXPECT_FLOAT_EQ(timestep.getAlpha(), 0.0f);
+
+  now = 0.75;
+  EXPECT_EQ(timestep.advance(), 1);
+  EXPECT_EQ(timestep.getNumSteps(), 3);
+}
+
+TEST(FixedTimestepTest, Accumulate) {
+  double now = 0.0;
+  FixedTimestep timestep(0.25, 5, [&now]() { return now; });
+
+  // Partial frames are accumulated until a full step is reached
+  now = 0.125;
+  EXPECT_EQ(timestep.advance(), 0);
+  EXPECT_FLOAT_EQ(timestep.getAlpha(), 0.5f);
+
+  now = 0.3125;
+  EXPECT_EQ(timestep.advance(), 1);
+  EXPECT_FLOAT_EQ(timestep.getAlpha(), 0.25f);
+
+  now = 0.5;
+  EXPECT_EQ(timestep.advance(), 1);
+  EXPECT_FLOAT_EQ(timestep.getAlpha(), 0.0f);
+}
+
+TEST(FixedTimestepTest, CatchUpIsCapped) {
+  double now = 0.0;
+  FixedTimestep timestep(0.25, 4, [&now]() { return now; });
+
+  // A frame of 10 steps is capped to 4 steps, the rest is dropped
+  now = 2.5;
+  EXPECT_EQ(timestep.advance(), 4);
+  EXPECT_DOUBLE_EQ(timestep.getDroppedTime(), 1.5);
+  EXPECT_FLOAT_EQ(timestep.getAlpha(), 0.0f);
+
+  // The simulation continues normally afterwards
+  now = 2.75;
+  EXPECT_EQ(timestep.advance(), 1);
+  EXPECT_DOUBLE_EQ(timestep.getDroppedTime(), 1.5);
+}
+
+TEST(FixedTimestepTest, Reset) {
+  double now = 0.0;
+  FixedTimestep timestep(0.25, 5, [&now]() { return now; });
+
+  now = 0.125;
+  timestep.advance();
+  EXPECT_FLOAT_EQ(timestep.getAlpha(), 0.5f);
+
+  now = 10.0;
+  timestep.reset();
+  EXPECT_FLOAT_EQ(timestep.getAlpha(), 0.0f);
+
+  now = 10.25;
+  EXPECT_EQ(timestep.advance(), 1);
+}
+
+} // anonymous namespace
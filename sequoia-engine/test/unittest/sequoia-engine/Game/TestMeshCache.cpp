@@ -0,0 +1,193 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                         _____                        _
+//                        / ____|                      (_)
+//                       | (___   ___  __ _ _   _  ___  _  __ _
+//                        \___ \ / _ \/ _` | | | |/ _ \| |/ _` |
+//                        ____) |  __/ (_| | |_| | (_) | | (_| |
+//                       |_____/ \___|\__, |\__,_|\___/|_|\__,_| - Game Engine (2016-2017)
+//                                       | |
+//                                       |_|
+//
+// This file is distributed under the MIT License (MIT).
+// See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#include "sequoia-engine/Core/Platform.h"
+#include "sequoia-engine/Core/RealFileSystem.h"
+#include "sequoia-engine/Game/MeshCache.h"
+#include "sequoia-engine/Unittest/TestEnvironment.h"
+#include <cstring>
+#include <gtest/gtest.h>
+#include <memory>
+#include <vector>
+
+using namespace sequoia;
+using namespace sequoia::game;
+using namespace sequoia::unittest;
+using namespace sequoia::platform;
+
+namespace {
+
+class MeshCacheTest : public testing::Test {
+protected:
+  std::shared_ptr<core::RealFileSystem> fs;
+
+  /// Two meshes with 3 and 5 vertices (the second has an odd size and the first 16-bit indices
+  /// to test the padding)
+  std::vector<Byte> vertices0, vertices1;
+  std::vector<std::uint16_t> indices0;
+  std::vector<std::uint32_t> indices1;
+
+  virtual void SetUp() override {
+    auto& env = TestEnvironment::getSingleton();
+    fs = std::make_shared<core::RealFileSystem>(toAnsiString(
+        env.createTemporaryDir(Path(PLATFORM_STR("sequoia-engine")) / PLATFORM_STR("Game") /
+                               asPath(env.testCaseName()) / asPath(env.testName()))));
+
+    for(int i = 0; i < 3 * 12; ++i)
+      vertices0.push_back(static_cast<Byte>(i));
+    indices0 = {0, 1, 2};
+
+    for(int i = 0; i < 5 * 7; ++i)
+      vertices1.push_back(static_cast<Byte>(2 * i));
+    indices1 = {0, 1, 2, 2, 3, 4};
+  }
+
+  virtual void TearDown() override { fs.reset(); }
+
+  std::vector<MeshCache::MeshView> makeMeshes() const {
+    std::vector<MeshCache::MeshView> meshes(2);
+    meshes[0].LayoutID = 1;
+    meshes[0].SizeOf = 12;
+    meshes[0].SizeOfIndex = sizeof(std::uint16_t);
+    meshes[0].NumVertices = 3;
+    meshes[0].NumIndices = indices0.size();
+    meshes[0].Vertices = vertices0.data();
+    meshes[0].Indices = indices0.data();
+    meshes[0].AxisAlignedBox = math::AxisAlignedBox(math::vec3(-1, -2, -3), math::vec3(1, 2, 3));
+
+    meshes[1].LayoutID = 2;
+    meshes[1].SizeOf = 7;
+    meshes[1].SizeOfIndex = sizeof(std::uint32_t);
+    meshes[1].NumVertices = 5;
+    meshes[1].NumIndices = indices1.size();
+    meshes[1].Vertices = vertices1.data();
+    meshes[1].Indices = indices1.data();
+    meshes[1].AxisAlignedBox = math::AxisAlignedBox(math::vec3(0, 0, 0), math::vec3(1, 1, 1));
+    return meshes;
+  }
+
+  /// @brief Overwrite the entry `key` after applying `modify` to its content
+  template <class FunctorType>
+  void corrupt(std::uint64_t key, FunctorType&& modify) {
+    std::string path = MeshCache::getPath(key);
+    std::string data = fs->read(path, core::FileBuffer::FF_Binary)->getDataAsString();
+    modify(data);
+
+    auto buffer = std::make_shared<core::FileBuffer>(core::FileBuffer::FF_Binary, path,
+                                                     data.size());
+    buffer->write(data.data(), 0, data.size());
+    fs->write(path, buffer);
+  }
+};
+
+TEST_F(MeshCacheTest, Key) {
+  std::string content = "v 0 0 0\nv 1 0 0\nv 0 1 0\nf 1 2 3\n";
+  std::uint64_t key = MeshCache::makeKey(content.data(), content.size(), 0);
+
+  EXPECT_EQ(MeshCache::makeKey(content.data(), content.size(), 0), key);
+  EXPECT_NE(MeshCache::makeKey(content.data(), content.size(), 1), key);
+  EXPECT_NE(MeshCache::makeKey(content.data(), content.size() - 1, 0), key);
+}
+
+TEST_F(MeshCacheTest, LoadAndStore) {
+  MeshCache cache(fs);
+  std::uint64_t key = 42;
+
+  MeshCache::Entry entry;
+  EXPECT_FALSE(cache.load(key, entry));
+  EXPECT_EQ(cache.getNumMisses(), 1);
+
+  auto stored = makeMeshes();
+  EXPECT_TRUE(cache.store(key, stored));
+  EXPECT_TRUE(fs->exists(MeshCache::getPath(key)));
+
+  // Reload from disk with a new file system
+  MeshCache newCache(std::make_shared<core::RealFileSystem>(fs->getBaseDir()));
+  ASSERT_TRUE(newCache.load(key, entry));
+  EXPECT_EQ(newCache.getNumHits(), 1);
+  EXPECT_TRUE(entry.Storage != nullptr);
+  ASSERT_EQ(entry.Meshes.size(), stored.size());
+
+  for(std::size_t i = 0; i < stored.size(); ++i) {
+    const MeshCache::MeshView& mesh = entry.Meshes[i];
+    EXPECT_EQ(mesh.LayoutID, stored[i].LayoutID);
+    EXPECT_EQ(mesh.SizeOf, stored[i].SizeOf);
+    EXPECT_EQ(mesh.SizeOfIndex, stored[i].SizeOfIndex);
+    ASSERT_EQ(mesh.NumVertices, stored[i].NumVertices);
+    ASSERT_EQ(mesh.NumIndices, stored[i].NumIndices);
+    EXPECT_TRUE(mesh.AxisAlignedBox == stored[i].AxisAlignedBox);
+
+    EXPECT_EQ(std::vector<Byte>(mesh.Vertices, mesh.Vertices + mesh.NumVertices * mesh.SizeOf),
+              std::vector<Byte>(stored[i].Vertices,
+                                stored[i].Vertices + mesh.NumVertices * mesh.SizeOf));
+    EXPECT_EQ(std::memcmp(mesh.Indices, stored[i].Indices, mesh.NumIndices * mesh.SizeOfIndex), 0);
+  }
+}
+
+TEST_F(MeshCacheTest, Corruption) {
+  MeshCache cache(fs);
+  std::uint64_t key = 42;
+  MeshCache::Entry entry;
+
+  // Truncated header
+  cache.store(key, makeMeshes());
+  corrupt(key, [](std::string& data) { data.resize(10); });
+  EXPECT_NO_THROW(EXPECT_FALSE(cache.load(key, entry)));
+
+  // Truncated data
+  cache.store(key, makeMeshes());
+  corrupt(key, [](std::string& data) { data.resize(data.size() - 1); });
+  EXPECT_NO_THROW(EXPECT_FALSE(cache.load(key, entry)));
+
+  // Invalid magic
+  cache.store(key, makeMeshes());
+  corrupt(key, [](std::string& data) { data[0] = 'X'; });
+  EXPECT_NO_THROW(EXPECT_FALSE(cache.load(key, entry)));
+
+  // Invalid version
+  cache.store(key, makeMeshes());
+  corrupt(key, [](std::string& data) { data[4] ^= 0xff; });
+  EXPECT_NO_THROW(EXPECT_FALSE(cache.load(key, entry)));
+
+  // Invalid index size (of the first mesh)
+  cache.store(key, makeMeshes());
+  corrupt(key, [](std::string& data) { data[32 + 2] = 3; });
+  EXPECT_NO_THROW(EXPECT_FALSE(cache.load(key, entry)));
+
+  // Index out of bounds (last index of the last mesh)
+  cache.store(key, makeMeshes());
+  corrupt(key, [](std::string& data) { data[data.size() - 4] = 5; });
+  EXPECT_NO_THROW(EXPECT_FALSE(cache.load(key, entry)));
+
+  // Entry stored under another key
+  cache.store(key, makeMeshes());
+  EXPECT_FALSE(cache.load(key + 1, entry));
+  std::string data =
+      fs->read(MeshCache::getPath(key), core::FileBuffer::FF_Binary)->getDataAsString();
+  auto buffer = std::make_shared<core::FileBuffer>(core::FileBuffer::FF_Binary,
+                                                   MeshCache::getPath(key + 1), data.size());
+  buffer->write(data.data(), 0, data.size());
+  fs->write(MeshCache::getPath(key + 1), buffer);
+  EXPECT_FALSE(cache.load(key + 1, entry));
+
+  EXPECT_EQ(cache.getNumInvalid(), 7);
+  EXPECT_EQ(cache.getNumHits(), 0);
+
+  // Valid entry
+  cache.store(key, makeMeshes());
+  EXPECT_TRUE(cache.load(key, entry));
+}
+
+} // anonymous namespace
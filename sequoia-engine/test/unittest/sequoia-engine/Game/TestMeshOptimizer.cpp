@@ -0,0 +1,144 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                         _____                        _
+//                        / ____|                      (_)
+//                       | (___   ___  __ _ _   _  ___  _  __ _
+//                        \___ \ / _ \/ _` | | | |/ _ \| |/ _` |
+//                        ____) |  __/ (_| | |_| | (_) | | (_| |
+//                       |_____/ \___|\__, |\__,_|\___/|_|\__,_| - Game Engine (2016-2017)
+//                                       | |
+//                                       |_|
+//
+// This file is distributed under the MIT License (MIT).
+// See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#include "sequoia-engine/Game/MeshOptimizer.h"
+#include <algorithm>
+#include <array>
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+
+using namespace sequoia;
+using namespace sequoia::game;
+
+namespace {
+
+class MeshOptimizerTest : public testing::Test {
+protected:
+  /// Grid of `N x N` quads in the xy-plane with shuffled triangles
+  static constexpr int N = 64;
+
+  std::vector<std::array<float, 3>> positions;
+  std::vector<std::uint32_t> indices;
+
+  virtual void SetUp() override {
+    for(int y = 0; y <= N; ++y)
+      for(int x = 0; x <= N; ++x)
+        positions.push_back({{float(x), float(y), 0.0f}});
+
+    std::vector<std::array<std::uint32_t, 3>> triangles;
+    for(int y = 0; y < N; ++y)
+      for(int x = 0; x < N; ++x) {
+        std::uint32_t v = y * (N + 1) + x;
+        triangles.push_back({{v, v + 1, v + N + 2}});
+        triangles.push_back({{v, v + N + 2, v + N + 1}});
+      }
+
+    std::mt19937 gen(42);
+    std::shuffle(triangles.begin(), triangles.end(), gen);
+    for(const auto& triangle : triangles)
+      indices.insert(indices.end(), triangle.begin(), triangle.end());
+  }
+
+  float computeACMR(const std::vector<std::uint32_t>& idx) const {
+    return MeshOptimizer::computeACMR(idx.data(), idx.size(), positions.size());
+  }
+
+  /// Sorted triangles (rotated to start with the smallest vertex to preserve the winding)
+  template <class GetVertexFunc>
+  static std::vector<std::array<float, 3>>
+  getTriangles(const std::vector<std::uint32_t>& idx, GetVertexFunc&& getVertex) {
+    std::vector<std::array<float, 3>> triangles;
+    for(std::size_t i = 0; i < idx.size(); i += 3) {
+      std::array<float, 3> t = {{getVertex(idx[i]), getVertex(idx[i + 1]), getVertex(idx[i + 2])}};
+      std::rotate(t.begin(), std::min_element(t.begin(), t.end()), t.end());
+      triangles.push_back(t);
+    }
+    std::sort(triangles.begin(), triangles.end());
+    return triangles;
+  }
+};
+
+TEST_F(MeshOptimizerTest, VertexCache) {
+  std::vector<std::uint32_t> optimized = indices;
+  MeshOptimizer::optimizeVertexCache(optimized.data(), optimized.size(), positions.size());
+
+  float before = computeACMR(indices);
+  float after = computeACMR(optimized);
+  RecordProperty("ACMRBefore", std::to_string(before));
+  RecordProperty("ACMRAfter", std::to_string(after));
+
+  EXPECT_LT(after, before);
+  EXPECT_LT(after, 0.8f);
+
+  // Same triangles with the same winding
+  auto id = [](std::uint32_t v) { return float(v); };
+  EXPECT_EQ(getTriangles(indices, id), getTriangles(optimized, id));
+}
+
+TEST_F(MeshOptimizerTest, Overdraw) {
+  std::vector<std::uint32_t> optimized = indices;
+  MeshOptimizer::optimizeVertexCache(optimized.data(), optimized.size(), positions.size());
+  float acmr = computeACMR(optimized);
+
+  MeshOptimizer::optimizeOverdraw(optimized.data(), optimized.size(), positions[0].data(),
+                                  sizeof(positions[0]), positions.size());
+
+  // Reordering the clusters barely affects the cache efficiency
+  EXPECT_LT(computeACMR(optimized), acmr + 0.05f);
+
+  auto id = [](std::uint32_t v) { return float(v); };
+  EXPECT_EQ(getTriangles(indices, id), getTriangles(optimized, id));
+}
+
+TEST_F(MeshOptimizerTest, VertexFetch) {
+  // Add an unreferenced vertex
+  std::vector<std::array<float, 3>> vertices = positions;
+  vertices.push_back({{-1.0f, -1.0f, -1.0f}});
+
+  std::vector<std::uint32_t> optimized = indices;
+  std::size_t numVertices = MeshOptimizer::optimizeVertexFetch(
+      vertices.data(), vertices.size(), sizeof(vertices[0]), optimized.data(), optimized.size());
+  EXPECT_EQ(numVertices, positions.size());
+  EXPECT_EQ(computeACMR(optimized), computeACMR(indices));
+
+  // Vertices are in the order of their first use
+  std::uint32_t next = 0;
+  for(std::uint32_t v : optimized) {
+    ASSERT_LE(v, next);
+    if(v == next)
+      next++;
+  }
+
+  // Same triangles (compared by the x/y coordinates of the vertices)
+  auto getBefore = [&](std::uint32_t v) { return positions[v][0] + 1000.0f * positions[v][1]; };
+  auto getAfter = [&](std::uint32_t v) { return vertices[v][0] + 1000.0f * vertices[v][1]; };
+  EXPECT_EQ(getTriangles(indices, getBefore), getTriangles(optimized, getAfter));
+}
+
+TEST_F(MeshOptimizerTest, ACMR) {
+  // A single triangle misses the cache with all vertices, a strip of quads with ~1 per triangle
+  std::vector<std::uint32_t> triangle = {0, 1, 2};
+  EXPECT_FLOAT_EQ(MeshOptimizer::computeACMR(triangle.data(), triangle.size(), 3), 3.0f);
+
+  std::vector<std::uint32_t> strip;
+  for(std::uint32_t v = 0; v < 2 * 100; v += 2) {
+    strip.insert(strip.end(), {v, v + 1, v + 3});
+    strip.insert(strip.end(), {v, v + 3, v + 2});
+  }
+  EXPECT_NEAR(MeshOptimizer::computeACMR(strip.data(), strip.size(), 202), 1.0f, 0.02f);
+}
+
+} // anonymous namespace
@@ -0,0 +1,196 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                         _____                        _
+//                        / ____|                      (_)
+//                       | (___   ___  __ _ _   _  ___  _  __ _
+//                        \___ \ / _ \/ _` | | | |/ _ \| |/ _` |
+//                        ____) |  __/ (_| | |_| | (_) | | (_| |
+//                       |_____/ \___|\__, |\__,_|\___/|_|\__,_| - Game Engine (2016-2017)
+//                                       | |
+//                                       |_|
+//
+// This file is distributed under the MIT License (MIT).
+// See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#include "sequoia-engine/Game/MeshSimplifier.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <gtest/gtest.h>
+#include <map>
+#include <vector>
+
+using namespace sequoia;
+using namespace sequoia::game;
+
+namespace {
+
+using Position = std::array<float, 3>;
+
+class MeshSimplifierTest : public testing::Test {
+protected:
+  std::vector<Position> positions;
+  std::vector<std::uint32_t> indices;
+
+  /// Grid of `N x N` quads spanning `[0, N] x [0, N]` in the xy-plane
+  void makePlane(int N) {
+    for(int y = 0; y <= N; ++y)
+      for(int x = 0; x <= N; ++x)
+        positions.push_back({{float(x), float(y), 0.0f}});
+
+    for(int y = 0; y < N; ++y)
+      for(int x = 0; x < N; ++x) {
+        std::uint32_t v = y * (N + 1) + x;
+        indices.insert(indices.end(), {v, v + 1, v + N + 2, v, v + N + 2, v + N + 1});
+      }
+  }
+
+  /// Closed unit sphere with `N` rings and `2 * N` segments (without seams)
+  void makeSphere(int N) {
+    const float pi = std::acos(-1.0f);
+    const std::uint32_t M = 2 * N;
+
+    positions.push_back({{0.0f, 0.0f, 1.0f}});
+    for(int i = 1; i < N; ++i) {
+      float theta = pi * i / N;
+      for(std::uint32_t j = 0; j < M; ++j) {
+        float phi = 2 * pi * j / M;
+        positions.push_back(
+            {{std::sin(theta) * std::cos(phi), std::sin(theta) * std::sin(phi), std::cos(theta)}});
+      }
+    }
+    positions.push_back({{0.0f, 0.0f, -1.0f}});
+
+    const std::uint32_t south = positions.size() - 1;
+    auto ring = [&](int i, std::uint32_t j) { return 1 + (i - 1) * M + j % M; };
+
+    for(std::uint32_t j = 0; j < M; ++j) {
+      indices.insert(indices.end(), {0, ring(1, j), ring(1, j + 1)});
+      indices.insert(indices.end(), {south, ring(N - 1, j + 1), ring(N - 1, j)});
+    }
+    for(int i = 1; i < N - 1; ++i)
+      for(std::uint32_t j = 0; j < M; ++j)
+        indices.insert(indices.end(), {ring(i, j), ring(i + 1, j), ring(i + 1, j + 1), ring(i, j),
+                                       ring(i + 1, j + 1), ring(i, j + 1)});
+  }
+
+  std::size_t simplify(std::size_t targetNumIndices, float targetError, float* resultError) {
+    return MeshSimplifier::simplify(indices.data(), indices.size(), positions.front().data(),
+                                    sizeof(Position), positions.size(), targetNumIndices,
+                                    targetError, resultError);
+  }
+
+  std::array<double, 3> getNormal(std::size_t i) const {
+    const Position& p0 = positions[indices[i]];
+    const Position& p1 = positions[indices[i + 1]];
+    const Position& p2 = positions[indices[i + 2]];
+    std::array<double, 3> e1 = {{p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2]}};
+    std::array<double, 3> e2 = {{p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2]}};
+    return {{e1[1] * e2[2] - e1[2] * e2[1], e1[2] * e2[0] - e1[0] * e2[2],
+             e1[0] * e2[1] - e1[1] * e2[0]}};
+  }
+
+  /// Number of triangles adjacent to each edge
+  std::map<std::pair<std::uint32_t, std::uint32_t>, int> getEdgeCount() const {
+    std::map<std::pair<std::uint32_t, std::uint32_t>, int> count;
+    for(std::size_t i = 0; i < indices.size(); i += 3)
+      for(int j = 0; j < 3; ++j) {
+        std::uint32_t a = indices[i + j], b = indices[i + (j + 1) % 3];
+        count[std::make_pair(std::min(a, b), std::max(a, b))]++;
+      }
+    return count;
+  }
+};
+
+TEST_F(MeshSimplifierTest, Plane) {
+  makePlane(32);
+  const std::size_t numIndices = indices.size();
+
+  float error = -1.0f;
+  indices.resize(simplify(numIndices / 10, 1e-3f, &error));
+
+  // A plane can be simplified without any error
+  EXPECT_LE(indices.size(), numIndices / 10);
+  EXPECT_EQ(indices.size() % 3, 0);
+  EXPECT_FLOAT_EQ(error, 0.0f);
+
+  // The triangles still cover the plane and none of them is flipped
+  double area = 0.0;
+  for(std::size_t i = 0; i < indices.size(); i += 3) {
+    auto n = getNormal(i);
+    EXPECT_GT(n[2], 0.0);
+    area += 0.5 * n[2];
+  }
+  EXPECT_NEAR(area, 32.0 * 32.0, 1e-3);
+
+  // The corners are preserved
+  for(std::uint32_t corner : {0u, 32u, 33u * 32u, 33u * 33u - 1u})
+    EXPECT_NE(std::find(indices.begin(), indices.end(), corner), indices.end());
+}
+
+TEST_F(MeshSimplifierTest, Sphere) {
+  makeSphere(16);
+  const std::size_t numIndices = indices.size();
+
+  indices.resize(simplify(numIndices / 4, 1.0f, nullptr));
+  EXPECT_LE(indices.size(), numIndices / 4);
+  EXPECT_GT(indices.size(), 0);
+
+  // The mesh is still closed and manifold
+  for(const auto& edgeCount : getEdgeCount())
+    EXPECT_EQ(edgeCount.second, 2);
+
+  // ... and oriented outwards
+  double volume = 0.0;
+  for(std::size_t i = 0; i < indices.size(); i += 3) {
+    auto n = getNormal(i);
+    const Position& p = positions[indices[i]];
+    volume += (n[0] * p[0] + n[1] * p[1] + n[2] * p[2]) / 6.0;
+  }
+  const double pi = std::acos(-1.0);
+  EXPECT_GT(volume, 0.7 * 4.0 / 3.0 * pi);
+  EXPECT_LT(volume, 4.0 / 3.0 * pi);
+}
+
+TEST_F(MeshSimplifierTest, TargetError) {
+  makeSphere(16);
+  const std::size_t numIndices = indices.size();
+
+  // The curvature of the sphere prevents reaching the target with a small error
+  float error = -1.0f;
+  std::size_t newNumIndices = simplify(3, 1e-2f, &error);
+  EXPECT_LT(newNumIndices, numIndices);
+  EXPECT_GT(newNumIndices, 3);
+  EXPECT_GT(error, 0.0f);
+  EXPECT_LE(error, 1e-2f);
+}
+
+TEST_F(MeshSimplifierTest, Seams) {
+  makePlane(8);
+
+  // Split the plane along `x = 4` by duplicating the vertices of the right half
+  const std::uint32_t numVertices = positions.size();
+  for(std::uint32_t v = 0; v < numVertices; ++v)
+    positions.push_back(positions[v]);
+  for(std::size_t i = 0; i < indices.size(); i += 3) {
+    bool isRight = true;
+    for(int j = 0; j < 3; ++j)
+      isRight &= positions[indices[i + j]][0] >= 4.0f;
+    if(isRight)
+      for(int j = 0; j < 3; ++j)
+        indices[i + j] += numVertices;
+  }
+
+  const std::size_t numIndices = indices.size();
+  indices.resize(simplify(0, 1.0f, nullptr));
+  EXPECT_LT(indices.size(), numIndices);
+
+  // The vertices on the seam are never collapsed
+  for(std::uint32_t y = 0; y <= 8; ++y) {
+    EXPECT_NE(std::find(indices.begin(), indices.end(), y * 9 + 4), indices.end());
+    EXPECT_NE(std::find(indices.begin(), indices.end(), numVertices + y * 9 + 4), indices.end());
+  }
+}
+
+} // anonymous namespace
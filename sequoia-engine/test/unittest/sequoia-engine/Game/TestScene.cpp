@@ -0,0 +1,72 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                         _____                        _
+//                        / ____|                      (_)
+//                       | (___   ___  __ _ _   _  ___  _  __ _
+//                        \___ \ / _ \/ _` | | | |/ _ \| |/ _` |
+//                        ____) |  __/ (_| | |_| | (_) | | (_| |
+//                       |_____/ \___|\__, |\__,_|\___/|_|\__,_| - Game Engine (2016-2017)
+//                                       | |
+//                                       |_|
+//
+// This file is distributed under the MIT License (MIT).
+// See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#include "sequoia-engine/Game/Drawable.h"
+#include "sequoia-engine/Game/Scene.h"
+#include "sequoia-engine/Game/SceneGraph.h"
+#include "sequoia-engine/Game/ShapeManager.h"
+#include "sequoia-engine/Render/Camera.h"
+#include "sequoia-engine/Render/DrawCommand.h"
+#include "sequoia-engine/Unittest/GameSetup.h"
+#include <gtest/gtest.h>
+
+using namespace sequoia;
+using namespace sequoia::unittest;
+using namespace sequoia::game;
+
+namespace {
+
+SEQUOIA_TESTCASEFIXTURE(SceneTest, GameSetup);
+
+TEST_F(SceneTest, FrustumCulling) {
+  Game& game = Game::getSingleton();
+  auto shape = game.getShapeManager()->createCube("TestCube");
+
+  // Camera is located at (0, 0, 10) and looks at the origin
+  Scene scene("TestScene");
+  scene.setActiveCamera(std::make_shared<render::Camera>());
+  EXPECT_TRUE(scene.hasFrustumCulling());
+
+  auto addCube = [&](const std::string& name, const math::vec3& position) {
+    auto node = SceneNode::allocate(name);
+    node->addCapability<Drawable>(shape);
+    node->setPosition(position);
+    scene.getSceneGraph()->insert(node);
+  };
+
+  addCube("Visible_1", math::vec3(0, 0, 0));
+  addCube("Visible_2", math::vec3(2, 1, -5));
+  addCube("Behind", math::vec3(0, 0, 20));
+  addCube("Right", math::vec3(100, 0, 0));
+  addCube("Below", math::vec3(0, -100, 0));
+
+  // Cube straddling the left plane is kept
+  addCube("Partial", math::vec3(-5.6f, 0, 0));
+
+  {
+    std::vector<render::DrawCommand> drawCommands;
+    scene.prepareDrawCommands(drawCommands);
+    EXPECT_EQ(drawCommands.size(), 3);
+  }
+
+  {
+    scene.setFrustumCulling(false);
+    std::vector<render::DrawCommand> drawCommands;
+    scene.prepareDrawCommands(drawCommands);
+    EXPECT_EQ(drawCommands.size(), 6);
+  }
+}
+
+} // anonymous namespace
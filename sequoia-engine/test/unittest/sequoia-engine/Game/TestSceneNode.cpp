@@ -17,6 +17,7 @@
 #include "sequoia-engine/Game/Scene.h"
 #include "sequoia-engine/Game/SceneGraph.h"
 #include "sequoia-engine/Game/SceneNode.h"
+#include "sequoia-engine/Game/TransformStore.h"
 #include "sequoia-engine/Unittest/GameSetup.h"
 #include <atomic>
 #include <gtest/gtest.h>
@@ -107,4 +108,101 @@ TEST_F(SceneNodeTest, ApplySequential) {
                std::runtime_error);
 }
 
+TEST_F(SceneNodeTest, ApplyParallel) {
+  auto node = SceneNode::allocate("Parent");
+  for(int i = 0; i < 8; ++i) {
+    auto child = SceneNode::allocate("Child_" + std::to_string(i));
+    for(int j = 0; j < 8; ++j)
+      child->addChild(SceneNode::allocate("GrandChild_" + std::to_string(j)));
+    node->addChild(child);
+  }
+
+  // Every node is visited exactly once
+  std::atomic<int> numNodes{0};
+  node->apply([&numNodes](SceneNode*) { numNodes++; }, SceneNode::EP_Parallel);
+  EXPECT_EQ(numNodes.load(), 1 + 8 + 8 * 8);
+
+  // Parents are visited before their children
+  node->setScale(2.0f);
+  node->apply(
+      [](SceneNode* n) {
+        if(n->hasParent())
+          n->setScale(n->getParent()->getScale() + 1.0f);
+      },
+      SceneNode::EP_Parallel);
+  for(const auto& child : node->getChildren()) {
+    EXPECT_FLOAT_EQ(child->getScale(), 3.0f);
+    for(const auto& grandChild : child->getChildren())
+      EXPECT_FLOAT_EQ(grandChild->getScale(), 4.0f);
+  }
+
+  // Check exceptions
+  EXPECT_THROW(node->apply([](SceneNode*) { throw std::runtime_error("test"); },
+                           SceneNode::EP_Parallel),
+               std::runtime_error);
+}
+
+TEST_F(SceneNodeTest, WorldMatrix) {
+  auto parent = SceneNode::allocate("Parent");
+  auto child = SceneNode::allocate("Child");
+  auto grandChild = SceneNode::allocate("GrandChild");
+
+  parent->addChild(child);
+  child->addChild(grandChild);
+
+  parent->setPosition(math::vec3(1, 0, 0));
+  parent->setScale(2.0f);
+  child->setPosition(math::vec3(0, 1, 0));
+  grandChild->setPosition(math::vec3(0, 0, 1));
+
+  auto getWorldPosition = [](const std::shared_ptr<SceneNode>& node) {
+    return math::vec3(node->getWorldMatrix()[3]);
+  };
+
+  // Lazy evaluation
+  EXPECT_EQ(getWorldPosition(grandChild), math::vec3(1, 2, 2));
+  EXPECT_EQ(grandChild->getWorldMatrix(), parent->getModelMatrix() * child->getModelMatrix() *
+                                              grandChild->getModelMatrix());
+
+  // Modifying the parent invalidates the whole subtree
+  parent->setPosition(math::vec3(5, 0, 0));
+  EXPECT_EQ(getWorldPosition(child), math::vec3(5, 2, 0));
+  EXPECT_EQ(getWorldPosition(grandChild), math::vec3(5, 2, 2));
+
+  // Modifying the child does not affect the parent
+  child->setPosition(math::vec3(0, 0, 0));
+  parent->updateWorldMatrices();
+  EXPECT_EQ(getWorldPosition(parent), math::vec3(5, 0, 0));
+  EXPECT_EQ(getWorldPosition(child), math::vec3(5, 0, 0));
+  EXPECT_EQ(getWorldPosition(grandChild), math::vec3(5, 0, 2));
+
+  // Top-down update through the SceneGraph
+  SceneGraph graph;
+  graph.insert(parent);
+  grandChild->setScale(3.0f);
+  parent->setPosition(math::vec3(0, 0, 0));
+  graph.updateWorldMatrices();
+  EXPECT_EQ(getWorldPosition(grandChild), math::vec3(0, 0, 2));
+  EXPECT_FLOAT_EQ(grandChild->getWorldMatrix()[0][0], 6.0f);
+
+  // Detaching a node makes its world matrix equal to its model matrix
+  child->removeChild(grandChild);
+  EXPECT_FALSE(grandChild->hasParent());
+  EXPECT_EQ(grandChild->getWorldMatrix(), grandChild->getModelMatrix());
+}
+
+TEST_F(SceneNodeTest, InterpolatedWorldMatrix) {
+  auto node = SceneNode::allocate("Node");
+
+  // The previous world matrix is seeded with the first world matrix
+  EXPECT_EQ(node->getInterpolatedWorldMatrix(0.5f), math::mat4(1.0f));
+
+  TransformStore::getGlobal().storePreviousWorldMatrices();
+  node->setPosition(math::vec3(4, 0, 0));
+
+  EXPECT_EQ(math::vec3(node->getInterpolatedWorldMatrix(0.0f)[3]), math::vec3(0, 0, 0));
+  EXPECT_EQ(math::vec3(node->getInterpolatedWorldMatrix(0.5f)[3]), math::vec3(2, 0, 0));
+  EXPECT_EQ(math::vec3(node->getInterpolatedWorldMatrix(1.0f)[3]), math::vec3(4, 0, 0));
+}
+
 } // anonymous namespace
@@ -13,12 +13,21 @@
 //
 //===------------------------------------------------------------------------------------------===//
 
+#include "sequoia-engine/Core/Platform.h"
+#include "sequoia-engine/Core/RealFileSystem.h"
 #include "sequoia-engine/Game/Shape.h"
 #include "sequoia-engine/Game/ShapeManager.h"
+#include "sequoia-engine/Render/Camera.h"
+#include "sequoia-engine/Render/Null/NullRenderer.h"
+#include "sequoia-engine/Render/RTDefault.h"
+#include "sequoia-engine/Render/RenderCommand.h"
 #include "sequoia-engine/Render/VertexData.h"
+#include "sequoia-engine/Render/Viewport.h"
 #include "sequoia-engine/Unittest/GameSetup.h"
 #include "sequoia-engine/Unittest/TestEnvironment.h"
+#include <cstring>
 #include <gtest/gtest.h>
+#include <memory>
 
 using namespace sequoia;
 using namespace sequoia::unittest;
@@ -43,18 +52,129 @@ TEST_F(ShapeManagerTest, Cube) {
               math::AxisAlignedBox(math::vec3(-0.5, -0.5, -0.5), math::vec3(0.5, 0.5, 0.5)));
 }
 
-//TEST_F(ShapeManagerTest, Obj) {
-//  Game& game = Game::getSingleton();
-//  TestEnvironment& env = TestEnvironment::getSingleton();
+TEST_F(ShapeManagerTest, Obj) {
+  Game& game = Game::getSingleton();
+  TestEnvironment& env = TestEnvironment::getSingleton();
 
-//  std::shared_ptr<Mesh> mesh = game.getShapeManager()->load("TestCube", env.getFile("sequoia-engine/Game/TestMeshManager/Cube.obj"));
+  auto file = env.getFile("sequoia-engine/Game/TestMeshManager/Cube.obj");
+  std::shared_ptr<Shape> shape = game.getShapeManager()->load("TestObj", file);
 
-////  EXPECT_EQ(mesh->getVertexData()->getNumIndices(), 36);
-////  EXPECT_EQ(mesh->getVertexData()->getNumVertices(), 24);
-////  EXPECT_FALSE(mesh->isModifiable());
-////  EXPECT_TRUE(mesh->getAxisAlignedBox() ==
-////              math::AxisAlignedBox(math::vec3(0, 0, 0), math::vec3(2, 2, 2)));
-//}
+  // The meshes are split by material, all of them together form the cube
+  ASSERT_GE(shape->getMeshes().size(), 1);
+  EXPECT_EQ(shape->getMaterials().size(), shape->getMeshes().size());
+
+  std::size_t numIndices = 0;
+  math::AxisAlignedBox bbox;
+  for(const auto& mesh : shape->getMeshes()) {
+    numIndices += mesh->getVertexData()->getNumIndices();
+    bbox.merge(mesh->getAxisAlignedBox());
+    EXPECT_FALSE(mesh->isModifiable());
+
+    // Small meshes use 16-bit indices
+    EXPECT_EQ(mesh->getVertexData()->getIndexBuffer()->getIndexType(),
+              render::IndexBuffer::IT_UInt16);
+  }
+  EXPECT_EQ(numIndices, 36);
+  EXPECT_TRUE(bbox == math::AxisAlignedBox(math::vec3(0, 0, 0), math::vec3(2, 2, 2)));
+
+  // Loading the same file again shares the vertex data
+  std::shared_ptr<Shape> shapeCopy = game.getShapeManager()->load("TestObjCopy", file);
+  ASSERT_EQ(shapeCopy->getMeshes().size(), shape->getMeshes().size());
+  for(std::size_t i = 0; i < shape->getMeshes().size(); ++i)
+    EXPECT_EQ(shapeCopy->getMeshes()[i]->getVertexData(), shape->getMeshes()[i]->getVertexData());
+}
+
+TEST_F(ShapeManagerTest, ObjCached) {
+  TestEnvironment& env = TestEnvironment::getSingleton();
+
+  // Start from an empty cache (independent of the cache of the game and of previous runs)
+  platform::Path dir = platform::Path(PLATFORM_STR("sequoia-engine")) / PLATFORM_STR("Game") /
+                       platform::asPath(env.testCaseName()) / platform::asPath(env.testName());
+  platform::filesystem::remove_all(env.getTemporaryPath() / dir);
+  auto fs = std::make_shared<core::RealFileSystem>(
+      platform::toAnsiString(env.createTemporaryDir(dir)));
+
+  ShapeManager manager(std::make_unique<MeshCache>(fs));
+  MeshCache* cache = manager.getMeshCache();
+  ASSERT_NE(cache, nullptr);
+
+  // The first read imports the file and stores it in the cache
+  auto file = env.getFile("sequoia-engine/Game/TestMeshManager/cornell_box.obj");
+  MeshCache::Entry imported = manager.readMeshes(file);
+  ASSERT_FALSE(imported.Meshes.empty());
+  EXPECT_EQ(cache->getNumHits(), 0);
+  EXPECT_EQ(cache->getNumMisses(), 1);
+
+  // The second read is served by the cache
+  MeshCache::Entry cached = manager.readMeshes(file);
+  EXPECT_EQ(cache->getNumHits(), 1);
+
+  ASSERT_EQ(cached.Meshes.size(), imported.Meshes.size());
+  for(std::size_t i = 0; i < cached.Meshes.size(); ++i) {
+    const MeshCache::MeshView& a = imported.Meshes[i];
+    const MeshCache::MeshView& b = cached.Meshes[i];
+    ASSERT_EQ(a.NumVertices, b.NumVertices);
+    ASSERT_EQ(a.NumIndices, b.NumIndices);
+    ASSERT_EQ(a.SizeOfIndex, b.SizeOfIndex);
+    EXPECT_EQ(std::memcmp(a.Vertices, b.Vertices, a.NumVertices * a.SizeOf), 0);
+    EXPECT_EQ(std::memcmp(a.Indices, b.Indices, a.NumIndices * a.SizeOfIndex), 0);
+    EXPECT_TRUE(a.AxisAlignedBox == b.AxisAlignedBox);
+  }
+}
+
+TEST_F(ShapeManagerTest, Lods) {
+  Game& game = Game::getSingleton();
+  TestEnvironment& env = TestEnvironment::getSingleton();
+
+  render::Camera camera;
+  render::RenderTarget* target = game.getMainRenderTarget();
+  auto viewport = std::make_shared<render::Viewport>(target, 0, 0, 80, 80);
+  viewport->setCamera(&camera);
+  target->setViewport(viewport);
+
+  // The triangles of a shape are counted by rendering its meshes with the NullRenderer
+  auto renderer = std::make_unique<render::NullRenderer>();
+  render::RTDefault technique;
+
+  auto getNumTriangles = [&](const std::shared_ptr<Shape>& shape) {
+    render::RenderCommand renderCmd(target);
+    renderCmd.Techniques = {&technique};
+    for(const auto& mesh : shape->getMeshes())
+      renderCmd.DrawCommands.emplace_back(mesh->getVertexData(), math::mat4(1.0f));
+
+    renderer->reset();
+    renderer->resetStatistics();
+    renderer->render(renderCmd);
+    return renderer->getStatistics().NumTriangles;
+  };
+
+  auto file = env.getFile("sequoia-engine/Game/TestMeshManager/Sphere.obj");
+  std::vector<std::shared_ptr<Shape>> lods = game.getShapeManager()->loadLods("TestLods", file, 3);
+  ASSERT_EQ(lods.size(), 3);
+  EXPECT_EQ(lods[0]->getName(), "TestLods");
+  EXPECT_EQ(lods[2]->getName(), "TestLods#LOD2");
+
+  // Every level keeps at most half of the triangles of the previous level
+  const std::size_t numTriangles = getNumTriangles(lods[0]);
+  EXPECT_EQ(numTriangles, 960);
+  EXPECT_LE(getNumTriangles(lods[1]), numTriangles / 2);
+  EXPECT_LE(getNumTriangles(lods[2]), numTriangles / 4);
+  EXPECT_GT(getNumTriangles(lods[2]), 0);
+
+  // The levels share the materials and the bounding box of the original shape
+  for(const auto& lod : lods) {
+    EXPECT_EQ(lod->getMeshes().size(), lods[0]->getMeshes().size());
+    EXPECT_TRUE(lod->getAxisAlignedBox() == lods[0]->getAxisAlignedBox());
+  }
+
+  // Loading the levels again shares the vertex data
+  std::vector<std::shared_ptr<Shape>> lodsCopy =
+      game.getShapeManager()->loadLods("TestLodsCopy", file, 3);
+  ASSERT_EQ(lodsCopy.size(), lods.size());
+  for(std::size_t i = 0; i < lods.size(); ++i)
+    EXPECT_EQ(lodsCopy[i]->getMeshes().front()->getVertexData(),
+              lods[i]->getMeshes().front()->getVertexData());
+}
 
 //TEST_F(ShapeManagerTest, FreeUnusedMeshes) {
 //  // TODO: We currently load a default scene with a cube so we can't yet test this
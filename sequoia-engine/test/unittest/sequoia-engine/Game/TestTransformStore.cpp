@@ -0,0 +1,128 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                         _____                        _
+//                        / ____|                      (_)
+//                       | (___   ___  __ _ _   _  ___  _  __ _
+//                        \___ \ / _ \/ _` | | | |/ _ \| |/ _` |
+//                        ____) |  __/ (_| | |_| | (_) | | (_| |
+//                       |_____/ \___|\__, |\__,_|\___/|_|\__,_| - Game Engine (2016-2017)
+//                                       | |
+//                                       |_|
+//
+// This file is distributed under the MIT License (MIT).
+// See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#include "sequoia-engine/Game/SceneNode.h"
+#include "sequoia-engine/Game/TransformStore.h"
+#include <gtest/gtest.h>
+
+using namespace sequoia;
+using namespace sequoia::game;
+
+namespace {
+
+TEST(TransformStoreTest, AllocateAndFree) {
+  TransformStore store;
+  EXPECT_EQ(store.size(), 0);
+
+  TransformStore::Handle h0 = store.allocate();
+  TransformStore::Handle h1 = store.allocate();
+  EXPECT_NE(h0, h1);
+  EXPECT_EQ(store.size(), 2);
+
+  // Initialized to the identity
+  EXPECT_EQ(store.getPosition(h0), math::vec3(0.0f));
+  EXPECT_EQ(store.getOrientation(h0), math::quat());
+  EXPECT_EQ(store.getScale(h0), 1.0f);
+  EXPECT_EQ(store.getModelMatrix(h0), math::mat4(1.0f));
+  EXPECT_EQ(store.getWorldMatrix(h0), math::mat4(1.0f));
+
+  // Freed handles are reused
+  store.free(h0);
+  EXPECT_EQ(store.size(), 1);
+  EXPECT_EQ(store.allocate(), h0);
+}
+
+TEST(TransformStoreTest, StableReferences) {
+  TransformStore store;
+
+  TransformStore::Handle handle = store.allocate();
+  math::vec3* position = &store.getPosition(handle);
+  *position = math::vec3(1, 2, 3);
+
+  // Force the allocation of several new chunks
+  for(std::uint32_t i = 0; i < 3 * TransformStore::ChunkSize; ++i)
+    store.allocate();
+  EXPECT_GE(store.getNumChunks(), 4);
+
+  EXPECT_EQ(&store.getPosition(handle), position);
+  EXPECT_EQ(store.getPosition(handle), math::vec3(1, 2, 3));
+}
+
+TEST(TransformStoreTest, ComputeModelMatrices) {
+  TransformStore store;
+
+  std::vector<TransformStore::Handle> handles;
+  for(int i = 0; i < 10; ++i) {
+    TransformStore::Handle handle = store.allocate();
+    store.getPosition(handle) = math::vec3(i, -i, 2 * i);
+    store.getOrientation(handle) = math::angleAxis(0.1f * i, math::vec3(0, 1, 0));
+    store.getScale(handle) = 1.0f + i;
+    handles.push_back(handle);
+  }
+
+  store.computeModelMatrices();
+
+  for(TransformStore::Handle handle : handles) {
+    math::mat4 ref = math::translate(math::mat4(1.0f), store.getPosition(handle)) *
+                     math::mat4_cast(store.getOrientation(handle)) *
+                     math::scale(math::mat4(1.0f), math::vec3(store.getScale(handle)));
+    const math::mat4& m = store.getModelMatrix(handle);
+    for(int c = 0; c < 4; ++c)
+      for(int r = 0; r < 4; ++r)
+        EXPECT_NEAR(m[c][r], ref[c][r], 1e-5f);
+  }
+}
+
+TEST(TransformStoreTest, ComputeModelMatricesSkipsFreeSlots) {
+  TransformStore store;
+
+  TransformStore::Handle h0 = store.allocate();
+  TransformStore::Handle h1 = store.allocate();
+  TransformStore::Handle h2 = store.allocate();
+  store.free(h1);
+
+  store.getPosition(h0) = math::vec3(1, 2, 3);
+  store.getPosition(h1) = math::vec3(4, 5, 6);
+  store.getPosition(h2) = math::vec3(7, 8, 9);
+
+  store.computeModelMatrices();
+
+  EXPECT_EQ(store.getModelMatrix(h0)[3], math::vec4(1, 2, 3, 1));
+  EXPECT_EQ(store.getModelMatrix(h1), math::mat4(1.0f));
+  EXPECT_EQ(store.getModelMatrix(h2)[3], math::vec4(7, 8, 9, 1));
+}
+
+TEST(TransformStoreTest, SceneNode) {
+  TransformStore& store = TransformStore::getGlobal();
+  std::size_t size = store.size();
+
+  {
+    auto node = SceneNode::allocate("Node");
+    EXPECT_EQ(store.size(), size + 1);
+
+    node->setPosition(math::vec3(1, 2, 3));
+    EXPECT_EQ(store.getPosition(node->getTransformHandle()), math::vec3(1, 2, 3));
+
+    // Clones own their transformation
+    auto clone = node->clone();
+    EXPECT_NE(clone->getTransformHandle(), node->getTransformHandle());
+    EXPECT_EQ(clone->getPosition(), math::vec3(1, 2, 3));
+    EXPECT_EQ(store.size(), size + 2);
+  }
+
+  EXPECT_EQ(store.size(), size);
+}
+
+} // anonymous namespace
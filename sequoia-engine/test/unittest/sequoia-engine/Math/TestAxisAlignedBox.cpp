@@ -58,6 +58,30 @@ TEST(AxisAlignedBoxTest, MergeBox) {
   // TODO...
 }
 
+TEST(AxisAlignedBoxTest, Transform) {
+  {
+    math::AxisAlignedBox aab(math::vec3(-1, -1, -1), math::vec3(1, 1, 1));
+    aab.transform(math::translate(math::mat4(1.0f), math::vec3(2, 0, -3)));
+    EXPECT_EQ(aab.getMinimum(), math::vec3(1, -1, -4));
+    EXPECT_EQ(aab.getMaximum(), math::vec3(3, 1, -2));
+  }
+
+  {
+    // Rotating by 45 degrees around the Z-axis enlarges the box in X and Y
+    math::AxisAlignedBox aab(math::vec3(-1, -1, -1), math::vec3(1, 1, 1));
+    aab.transform(math::rotate(math::mat4(1.0f), math::radians(45.0f), math::vec3(0, 0, 1)));
+    EXPECT_NEAR(aab.getMaximum().x, std::sqrt(2.0f), 1e-5f);
+    EXPECT_NEAR(aab.getMaximum().y, std::sqrt(2.0f), 1e-5f);
+    EXPECT_NEAR(aab.getMaximum().z, 1.0f, 1e-5f);
+  }
+
+  {
+    math::AxisAlignedBox aab;
+    aab.transform(math::scale(math::mat4(1.0f), math::vec3(2)));
+    EXPECT_TRUE(aab.isNull());
+  }
+}
+
 TEST(AxisAlignedBoxTest, Intersection) {
   // TODO...
 }
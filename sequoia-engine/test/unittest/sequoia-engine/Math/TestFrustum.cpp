@@ -0,0 +1,75 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                         _____                        _
+//                        / ____|                      (_)
+//                       | (___   ___  __ _ _   _  ___  _  __ _
+//                        \___ \ / _ \/ _` | | | |/ _ \| |/ _` |
+//                        ____) |  __/ (_| | |_| | (_) | | (_| |
+//                       |_____/ \___|\__, |\__,_|\___/|_|\__,_| - Game Engine (2016-2017)
+//                                       | |
+//                                       |_|
+//
+// This file is distributed under the MIT License (MIT).
+// See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#include "sequoia-engine/Math/Frustum.h"
+#include <gtest/gtest.h>
+
+using namespace sequoia;
+
+namespace {
+
+TEST(FrustumTest, Infinite) {
+  math::Frustum frustum;
+  EXPECT_TRUE(frustum.contains(math::vec3(1e6f, -1e6f, 1e6f)));
+  EXPECT_TRUE(frustum.intersects(math::AxisAlignedBox(math::vec3(-1), math::vec3(1))));
+  EXPECT_FALSE(frustum.intersects(math::AxisAlignedBox()));
+}
+
+TEST(FrustumTest, ExtractPlanes) {
+  // Camera at (0, 0, 10) looking down the negative Z-axis
+  math::mat4 matViewProj =
+      math::perspective(math::radians(45.0f), 1.0f, 1.0f, 100.0f) *
+      math::lookAt(math::vec3(0, 0, 10), math::vec3(0, 0, 0), math::vec3(0, 1, 0));
+  math::Frustum frustum(matViewProj);
+
+  // Near and far plane are perpendicular to the viewing direction
+  EXPECT_NEAR(frustum.getPlane(math::Frustum::PK_Near).z, -1.0f, 1e-5f);
+  EXPECT_NEAR(frustum.getPlane(math::Frustum::PK_Far).z, 1.0f, 1e-5f);
+
+  // Signed distance of the origin to the near plane is 9
+  EXPECT_NEAR(frustum.getPlane(math::Frustum::PK_Near).w, 9.0f, 1e-3f);
+
+  EXPECT_TRUE(frustum.contains(math::vec3(0, 0, 0)));
+  EXPECT_FALSE(frustum.contains(math::vec3(0, 0, 20)));  // Behind the camera
+  EXPECT_FALSE(frustum.contains(math::vec3(0, 0, -95))); // Beyond the far plane
+  EXPECT_FALSE(frustum.contains(math::vec3(50, 0, 0)));  // Right of the frustum
+  EXPECT_FALSE(frustum.contains(math::vec3(0, -50, 0))); // Below the frustum
+}
+
+TEST(FrustumTest, IntersectsBox) {
+  math::mat4 matViewProj =
+      math::perspective(math::radians(45.0f), 1.0f, 1.0f, 100.0f) *
+      math::lookAt(math::vec3(0, 0, 10), math::vec3(0, 0, 0), math::vec3(0, 1, 0));
+  math::Frustum frustum(matViewProj);
+
+  // Fully inside
+  EXPECT_TRUE(frustum.intersects(math::AxisAlignedBox(math::vec3(-1), math::vec3(1))));
+
+  // Partially inside (box straddles the right plane)
+  EXPECT_TRUE(
+      frustum.intersects(math::AxisAlignedBox(math::vec3(0, -1, -1), math::vec3(50, 1, 1))));
+
+  // Fully outside
+  EXPECT_FALSE(frustum.intersects(math::AxisAlignedBox(math::vec3(49), math::vec3(51))));
+  EXPECT_FALSE(
+      frustum.intersects(math::AxisAlignedBox(math::vec3(-1, -1, 15), math::vec3(1, 1, 20))));
+
+  // Infinite boxes are always visible
+  math::AxisAlignedBox infiniteBox;
+  infiniteBox.setInfinite();
+  EXPECT_TRUE(frustum.intersects(infiniteBox));
+}
+
+} // anonymous namespace
@@ -17,11 +17,15 @@
 #include "sequoia-engine/Render/Exception.h"
 #include "sequoia-engine/Render/GL/GL.h"
 #include "sequoia-engine/Render/GL/GLRenderSystem.h"
+#include "sequoia-engine/Render/GL/GLRenderer.h"
 #include "sequoia-engine/Render/GL/GLTextureManager.h"
+#include "sequoia-engine/Render/GL/GLTextureStreamer.h"
 #include "sequoia-engine/Unittest/RenderSetup.h"
 #include "sequoia-engine/Unittest/TestEnvironment.h"
+#include <algorithm>
 #include <gli/gli.hpp>
 #include <gtest/gtest.h>
+#include <opencv2/opencv.hpp>
 
 using namespace sequoia;
 using namespace sequoia::unittest;
@@ -110,6 +114,61 @@ TEST_F(GLTextureTest, LoadTexture2DCompressed) {
   }
 }
 
+TEST_F(GLTextureTest, Streaming) {
+  TestEnvironment& env = TestEnvironment::getSingleton();
+  RenderSystem& rsys = RenderSystem::getSingleton();
+
+  GLTextureStreamer* streamer = getGLRenderer().getTextureManager()->getStreamer();
+  ASSERT_NE(streamer, nullptr);
+
+  auto image = Image::load(env.getFile("sequoia-engine/Render/GL/TestGLTexture/Test.png"));
+  TextureParameter param;
+  param.UseMipmap = false;
+  std::shared_ptr<Texture> texture = rsys.createTexture(image, param);
+
+  // The texture is usable right away but contains the placeholder
+  GLTexture* gltexture = core::dyn_cast<GLTexture>(texture.get());
+  EXPECT_TRUE(gltexture->isValid());
+  ASSERT_TRUE(gltexture->isStreaming());
+  EXPECT_GE(streamer->getNumPending(), 1);
+
+  streamer->flush();
+  EXPECT_FALSE(gltexture->isStreaming());
+  EXPECT_EQ(streamer->getNumPending(), 0);
+
+  // The bottom left pixel of the image is the first pixel of the texture
+  RegularImage* regularImage = core::dyn_cast<RegularImage>(image.get());
+  const cv::Mat& mat = regularImage->getMat();
+
+  std::vector<Byte> pixels(4 * mat.cols * mat.rows);
+  glGetTextureImage(gltexture->getID(), 0, GL_BGRA, GL_UNSIGNED_BYTE, pixels.size(),
+                    pixels.data());
+
+  const Byte* expected = mat.ptr(mat.rows - 1);
+  for(int c = 0; c < regularImage->getNumChannels(); ++c)
+    EXPECT_EQ(pixels[c], expected[c]);
+
+  // Stream the texture again with a budget smaller than a row, the rows are split into spans
+  GLTextureStreamer smallStreamer(16);
+  ASSERT_LT(smallStreamer.getBudget(), 4 * mat.cols);
+
+  std::fill(pixels.begin(), pixels.end(), 0);
+  glClearTexImage(gltexture->getID(), 0, GL_BGRA, GL_UNSIGNED_BYTE, nullptr);
+
+  smallStreamer.stream(std::dynamic_pointer_cast<GLTexture>(texture));
+  smallStreamer.flush();
+  EXPECT_EQ(smallStreamer.getNumPending(), 0);
+  EXPECT_EQ(smallStreamer.getNumBytesUploaded(), pixels.size());
+
+  glGetTextureImage(gltexture->getID(), 0, GL_BGRA, GL_UNSIGNED_BYTE, pixels.size(),
+                    pixels.data());
+
+  // The last pixel of the bottom row is uploaded in the last span of the row
+  const Byte* expectedLast = mat.ptr(mat.rows - 1, mat.cols - 1);
+  for(int c = 0; c < regularImage->getNumChannels(); ++c)
+    EXPECT_EQ(pixels[4 * (mat.cols - 1) + c], expectedLast[c]);
+}
+
 TEST_F(GLTextureTest, RTTI) {
   TestEnvironment& env = TestEnvironment::getSingleton();
   RenderSystem& rsys = RenderSystem::getSingleton();
@@ -18,6 +18,7 @@
 #include "sequoia-engine/Render/GL/GLRenderSystem.h"
 #include "sequoia-engine/Render/GL/GLVertexAttribute.h"
 #include "sequoia-engine/Render/GL/GLVertexData.h"
+#include "sequoia-engine/Render/GL/GLVertexDataArena.h"
 #include "sequoia-engine/Render/VertexAdapter.h"
 #include "sequoia-engine/Unittest/RenderSetup.h"
 #include "sequoia-engine/Unittest/TestEnvironment.h"
@@ -213,6 +214,15 @@ TYPED_TEST(GLVertexDataTest, VertexAttributes) {
   gldata->unbind();
 }
 
+/// @brief Set all vertex attributes to the index `i` of the vertex
+static void setVertex(VertexAdapter& adapter, std::size_t i) {
+  adapter.clear();
+  adapter.setPosition(math::vec4(i));
+  adapter.setNormal(math::vec4(i));
+  adapter.setTexCoord(math::vec4(i));
+  adapter.setColor(Color(i, i, i, i));
+}
+
 /// @brief Write to all vertex attributes the index of the vertex
 static void writeVertex(VertexBuffer* buffer) {
   BufferGuard guard(buffer, Buffer::LO_Discard);
@@ -224,46 +234,47 @@ static void writeVertex(VertexBuffer* buffer) {
   Byte* vertexPtr = guard.getAsByte();
 
   for(std::size_t i = 0; i < numVertices; ++i, vertexPtr += layout.SizeOf) {
-    adapter.clear();
-
-    adapter.setPosition(math::vec4(i));
-    adapter.setNormal(math::vec4(i));
-    adapter.setTexCoord(math::vec4(i));
-    adapter.setColor(Color(i, i, i, i));
-
+    setVertex(adapter, i);
     adapter.copyTo(vertexPtr);
   }
 }
 
 /// @brief Real all vertex attributes and check if each attribute contains the vertex index
+///
+/// Quantized attributes are compared to the quantized vertex index.
 static void readVertex(VertexBuffer* buffer) {
   BufferGuard guard(buffer, Buffer::LO_ReadOnly);
 
   const VertexLayout& layout = buffer->getLayout();
   const std::size_t numVertices = buffer->getNumVertices();
 
-  VertexAdapter adapter(layout);
+  VertexAdapter adapter(layout), expected(layout);
   Byte* vertexPtr = guard.getAsByte();
 
   for(std::size_t i = 0; i < numVertices; ++i, vertexPtr += layout.SizeOf) {
     adapter.copyFrom(vertexPtr);
+    setVertex(expected, i);
 
     // Position
     auto position = adapter.getPosition();
+    auto expectedPosition = expected.getPosition();
     for(int j = 0; j < layout.Position.NumElements; ++j)
-      EXPECT_FLOAT_EQ(position[j], i) << "Vertex index: " << i << ", Attribute: Position[" << j
-                                      << "]";
+      EXPECT_FLOAT_EQ(position[j], expectedPosition[j])
+          << "Vertex index: " << i << ", Attribute: Position[" << j << "]";
 
     // Normal
     auto normal = adapter.getNormal();
+    auto expectedNormal = expected.getNormal();
     for(int j = 0; j < layout.Normal.NumElements; ++j)
-      EXPECT_FLOAT_EQ(normal[j], i) << "Vertex index: " << i << ", Attribute: Normal[" << j << "]";
+      EXPECT_FLOAT_EQ(normal[j], expectedNormal[j])
+          << "Vertex index: " << i << ", Attribute: Normal[" << j << "]";
 
     // TexCoord
     auto texCoord = adapter.getTexCoord();
+    auto expectedTexCoord = expected.getTexCoord();
     for(int j = 0; j < layout.TexCoord.NumElements; ++j)
-      EXPECT_FLOAT_EQ(texCoord[j], i) << "Vertex index: " << i << ", Attribute: TexCoord[" << j
-                                      << "]";
+      EXPECT_FLOAT_EQ(texCoord[j], expectedTexCoord[j])
+          << "Vertex index: " << i << ", Attribute: TexCoord[" << j << "]";
 
     // Color
     auto color = adapter.getColor();
@@ -305,4 +316,76 @@ TYPED_TEST(GLVertexDataTest, ReadAndWrite) {
   }
 }
 
+TYPED_TEST(GLVertexDataTest, Arena) {
+  std::shared_ptr<GLVertexData> gldata1 = makeVertexData<TypeParam>(4, 6, false, false);
+  std::shared_ptr<GLVertexData> gldata2 = makeVertexData<TypeParam>(8, 12, false, false);
+
+  // Both are views of the same arena
+  GLVertexDataArena* arena = gldata1->getArena();
+  ASSERT_NE(arena, nullptr);
+  EXPECT_EQ(gldata2->getArena(), arena);
+  EXPECT_EQ(gldata1->getStorage(), gldata2->getStorage());
+  EXPECT_EQ(gldata1->getVAOID(), gldata2->getVAOID());
+
+  // The ranges are disjoint
+  VertexData::DrawRange range1 = gldata1->getDrawRange();
+  VertexData::DrawRange range2 = gldata2->getDrawRange();
+  EXPECT_EQ(range1.NumVertices, 4);
+  EXPECT_EQ(range1.NumIndices, 6);
+  EXPECT_EQ(range2.NumVertices, 8);
+  EXPECT_EQ(range2.NumIndices, 12);
+  EXPECT_TRUE(range1.FirstVertex + range1.NumVertices <= range2.FirstVertex ||
+              range2.FirstVertex + range2.NumVertices <= range1.FirstVertex);
+  EXPECT_TRUE(range1.FirstIndex + range1.NumIndices <= range2.FirstIndex ||
+              range2.FirstIndex + range2.NumIndices <= range1.FirstIndex);
+
+  // Writing one view doesn't affect the other
+  writeVertex(gldata1->getVertexBuffer());
+  writeVertex(gldata2->getVertexBuffer());
+  readVertex(gldata1->getVertexBuffer());
+  readVertex(gldata2->getVertexBuffer());
+
+  // The range is returned to the arena on destruction
+  std::size_t numAllocated = arena->getVertexAllocator().getNumAllocated();
+  gldata2.reset();
+  EXPECT_EQ(arena->getVertexAllocator().getNumAllocated(), numAllocated - 8);
+
+  // Dynamic vertex data owns its buffers
+  RenderSystem& rsys = RenderSystem::getSingleton();
+  VertexDataParameter param(render::VertexData::DM_Triangles, TypeParam::getLayout(), 4, 6,
+                            Buffer::UH_DynamicWriteOnlyDiscardable);
+  auto dynamicData = core::dyn_pointer_cast<GLVertexData>(rsys.createVertexData(param));
+  EXPECT_EQ(dynamicData->getArena(), nullptr);
+  EXPECT_EQ(dynamicData->getStorage(), dynamicData.get());
+
+  // 16-bit indices are allocated from a separate arena
+  VertexDataParameter param16(render::VertexData::DM_Triangles, TypeParam::getLayout(), 4, 6,
+                              Buffer::UH_StaticWriteOnly);
+  param16.IndexType = IndexBuffer::IT_UInt16;
+  auto data16 = core::dyn_pointer_cast<GLVertexData>(rsys.createVertexData(param16));
+  ASSERT_NE(data16->getArena(), nullptr);
+  EXPECT_NE(data16->getArena(), arena);
+  EXPECT_EQ(data16->getArena()->getIndexType(), IndexBuffer::IT_UInt16);
+  EXPECT_EQ(data16->getIndexBuffer()->getIndexType(), IndexBuffer::IT_UInt16);
+
+  std::vector<std::uint16_t> indices16 = {0, 1, 2, 2, 3, 0};
+  data16->getIndexBuffer()->write(indices16.data(), 0, indices16.size() * sizeof(std::uint16_t));
+  std::vector<std::uint16_t> indices16Ref(6, 0);
+  data16->getIndexBuffer()->read(0, indices16.size() * sizeof(std::uint16_t), indices16Ref.data());
+  EXPECT_EQ(indices16, indices16Ref);
+
+  // Arenas start small and grow to fit larger meshes (up to the maximum size)
+  const std::size_t initialNumVertices =
+      rsys.getOptions().getInt("Render.VertexDataArenaInitialNumVertices");
+  const std::size_t maxNumVertices = rsys.getOptions().getInt("Render.VertexDataArenaNumVertices");
+  EXPECT_LT(initialNumVertices, maxNumVertices);
+
+  VertexDataParameter paramLarge(render::VertexData::DM_Triangles, TypeParam::getLayout(),
+                                 initialNumVertices + 1, 0, Buffer::UH_StaticWriteOnly);
+  auto dataLarge = core::dyn_pointer_cast<GLVertexData>(rsys.createVertexData(paramLarge));
+  ASSERT_NE(dataLarge->getArena(), nullptr);
+  EXPECT_GT(dataLarge->getArena()->getVertexAllocator().getCapacity(), initialNumVertices);
+  EXPECT_LE(dataLarge->getArena()->getVertexAllocator().getCapacity(), maxNumVertices);
+}
+
 } // anonymous namespace
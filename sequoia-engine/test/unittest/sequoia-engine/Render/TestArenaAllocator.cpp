@@ -0,0 +1,94 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                         _____                        _
+//                        / ____|                      (_)
+//                       | (___   ___  __ _ _   _  ___  _  __ _
+//                        \___ \ / _ \/ _` | | | |/ _ \| |/ _` |
+//                        ____) |  __/ (_| | |_| | (_) | | (_| |
+//                       |_____/ \___|\__, |\__,_|\___/|_|\__,_| - Game Engine (2016-2017)
+//                                       | |
+//                                       |_|
+//
+// This file is distributed under the MIT License (MIT).
+// See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#include "sequoia-engine/Render/ArenaAllocator.h"
+#include <gtest/gtest.h>
+
+using namespace sequoia::render;
+
+namespace {
+
+TEST(ArenaAllocatorTest, Allocate) {
+  ArenaAllocator allocator(100);
+  EXPECT_EQ(allocator.getCapacity(), 100);
+  EXPECT_TRUE(allocator.isEmpty());
+
+  EXPECT_EQ(allocator.allocate(10), 0);
+  EXPECT_EQ(allocator.allocate(20), 10);
+  EXPECT_EQ(allocator.allocate(30), 30);
+  EXPECT_EQ(allocator.getNumAllocated(), 60);
+  EXPECT_EQ(allocator.getLargestFreeRange(), 40);
+
+  // Zero sized allocations don't consume anything
+  EXPECT_EQ(allocator.allocate(0), 0);
+  EXPECT_EQ(allocator.getNumAllocated(), 60);
+
+  // Exhausted
+  EXPECT_EQ(allocator.allocate(41), ArenaAllocator::InvalidOffset);
+  EXPECT_EQ(allocator.allocate(40), 60);
+  EXPECT_EQ(allocator.getNumFreeRanges(), 0);
+  EXPECT_EQ(allocator.allocate(1), ArenaAllocator::InvalidOffset);
+}
+
+TEST(ArenaAllocatorTest, FirstFit) {
+  ArenaAllocator allocator(100);
+  std::size_t a = allocator.allocate(10);
+  std::size_t b = allocator.allocate(20);
+  std::size_t c = allocator.allocate(10);
+  allocator.allocate(10);
+
+  // Holes [0, 10) and [30, 40)
+  allocator.deallocate(a, 10);
+  allocator.deallocate(c, 10);
+  EXPECT_EQ(allocator.getNumFreeRanges(), 3);
+
+  // The first hole which is large enough is used
+  EXPECT_EQ(allocator.allocate(5), 0);
+  EXPECT_EQ(allocator.allocate(10), 30);
+  EXPECT_EQ(allocator.allocate(15), 50);
+  EXPECT_EQ(allocator.allocate(5), 5);
+
+  allocator.deallocate(b, 20);
+  EXPECT_EQ(allocator.allocate(20), b);
+}
+
+TEST(ArenaAllocatorTest, Coalesce) {
+  ArenaAllocator allocator(40);
+  std::size_t a = allocator.allocate(10);
+  std::size_t b = allocator.allocate(10);
+  std::size_t c = allocator.allocate(10);
+  std::size_t d = allocator.allocate(10);
+  EXPECT_EQ(allocator.getNumFreeRanges(), 0);
+
+  // Coalesce with the preceding range
+  allocator.deallocate(a, 10);
+  allocator.deallocate(b, 10);
+  EXPECT_EQ(allocator.getNumFreeRanges(), 1);
+  EXPECT_EQ(allocator.getLargestFreeRange(), 20);
+
+  // Coalesce with the succeeding range
+  allocator.deallocate(d, 10);
+  EXPECT_EQ(allocator.getNumFreeRanges(), 2);
+
+  // Coalesce with both ranges
+  allocator.deallocate(c, 10);
+  EXPECT_EQ(allocator.getNumFreeRanges(), 1);
+  EXPECT_EQ(allocator.getLargestFreeRange(), 40);
+  EXPECT_TRUE(allocator.isEmpty());
+
+  EXPECT_EQ(allocator.allocate(40), 0);
+}
+
+} // anonymous namespace
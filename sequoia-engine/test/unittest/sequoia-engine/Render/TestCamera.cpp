@@ -43,4 +43,16 @@ TEST(CameraTest, Initialization) {
   }
 }
 
+TEST(CameraTest, ViewMatrix) {
+  Camera camera(math::vec3(0, 0, 10), math::vec3(0, 0, 0));
+
+  // The eye is moved to the origin, looking down the negative Z-axis
+  math::vec4 center = camera.getViewMatrix() * math::vec4(0, 0, 0, 1);
+  EXPECT_VEC_NEAR(math::vec3(center), math::vec3(0, 0, -10), 1e-05f);
+
+  math::vec4 p = camera.getViewProjectionMatrix() * math::vec4(1, 2, 3, 1);
+  math::vec4 q = camera.getProjectionMatrix() * (camera.getViewMatrix() * math::vec4(1, 2, 3, 1));
+  EXPECT_VEC_NEAR(p, q, 1e-05f);
+}
+
 } // anonymous namespace
@@ -0,0 +1,196 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                         _____                        _
+//                        / ____|                      (_)
+//                       | (___   ___  __ _ _   _  ___  _  __ _
+//                        \___ \ / _ \/ _` | | | |/ _ \| |/ _` |
+//                        ____) |  __/ (_| | |_| | (_) | | (_| |
+//                       |_____/ \___|\__, |\__,_|\___/|_|\__,_| - Game Engine (2016-2017)
+//                                       | |
+//                                       |_|
+//
+// This file is distributed under the MIT License (MIT).
+// See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#include "sequoia-engine/Core/Platform.h"
+#include "sequoia-engine/Core/RealFileSystem.h"
+#include "sequoia-engine/Render/Null/NullShader.h"
+#include "sequoia-engine/Render/ProgramBinaryCache.h"
+#include "sequoia-engine/Unittest/TestEnvironment.h"
+#include <gtest/gtest.h>
+#include <memory>
+
+using namespace sequoia;
+using namespace sequoia::render;
+using namespace sequoia::unittest;
+using namespace sequoia::platform;
+
+namespace {
+
+class ProgramBinaryCacheTest : public testing::Test {
+protected:
+  std::shared_ptr<core::RealFileSystem> fs;
+  std::set<std::shared_ptr<Shader>> shaders;
+
+  virtual void SetUp() override {
+    auto& env = TestEnvironment::getSingleton();
+    fs = std::make_shared<core::RealFileSystem>(toAnsiString(
+        env.createTemporaryDir(Path(PLATFORM_STR("sequoia-engine")) / PLATFORM_STR("Render") /
+                               asPath(env.testCaseName()) / asPath(env.testName()))));
+
+    shaders.insert(makeShader(Shader::ST_Vertex, "void main() { gl_Position = vec4(0); }"));
+    shaders.insert(makeShader(Shader::ST_Fragment, "void main() {}"));
+  }
+
+  virtual void TearDown() override {
+    shaders.clear();
+    fs.reset();
+  }
+
+  static std::shared_ptr<Shader> makeShader(Shader::ShaderType type, const std::string& source) {
+    return std::make_shared<NullShader>(type, "shader", source);
+  }
+
+  static ProgramBinaryCache::ProgramBinary makeBinary() {
+    ProgramBinaryCache::ProgramBinary binary;
+    binary.Format = 42;
+    for(int i = 0; i < 128; ++i)
+      binary.Data.push_back(static_cast<Byte>(i));
+    return binary;
+  }
+
+  /// @brief Overwrite the entry `key` after applying `modify` to its content
+  template <class FunctorType>
+  void corrupt(std::uint64_t key, FunctorType&& modify) {
+    std::string path = ProgramBinaryCache::getPath(key);
+    std::string data = fs->read(path, core::FileBuffer::FF_Binary)->getDataAsString();
+    modify(data);
+
+    auto buffer = std::make_shared<core::FileBuffer>(core::FileBuffer::FF_Binary, path,
+                                                     data.size());
+    buffer->write(data.data(), 0, data.size());
+    fs->write(path, buffer);
+  }
+};
+
+TEST_F(ProgramBinaryCacheTest, Key) {
+  ProgramBinaryCache cache(fs, "driver 1.0");
+  std::uint64_t key = cache.makeKey(shaders);
+
+  // Same content yields the same key, independent of the shader objects
+  std::set<std::shared_ptr<Shader>> sameShaders;
+  for(const auto& shader : shaders)
+    sameShaders.insert(makeShader(shader->getType(), shader->getSourceCode()));
+  EXPECT_EQ(cache.makeKey(sameShaders), key);
+
+  // Different source or type
+  std::set<std::shared_ptr<Shader>> otherSource = shaders;
+  otherSource.insert(makeShader(Shader::ST_Geometry, "void main() {}"));
+  EXPECT_NE(cache.makeKey(otherSource), key);
+
+  std::set<std::shared_ptr<Shader>> otherType;
+  for(const auto& shader : shaders)
+    otherType.insert(makeShader(shader->getType() == Shader::ST_Vertex ? Shader::ST_Geometry
+                                                                       : shader->getType(),
+                                shader->getSourceCode()));
+  EXPECT_NE(cache.makeKey(otherType), key);
+
+  // Different driver
+  ProgramBinaryCache otherCache(fs, "driver 1.1");
+  EXPECT_NE(otherCache.makeKey(shaders), key);
+}
+
+TEST_F(ProgramBinaryCacheTest, LoadAndStore) {
+  ProgramBinaryCache cache(fs, "driver 1.0");
+  std::uint64_t key = cache.makeKey(shaders);
+
+  ProgramBinaryCache::ProgramBinary binary;
+  EXPECT_FALSE(cache.load(key, binary));
+  EXPECT_EQ(cache.getNumMisses(), 1);
+
+  auto stored = makeBinary();
+  EXPECT_TRUE(cache.store(key, stored));
+  EXPECT_TRUE(fs->exists(ProgramBinaryCache::getPath(key)));
+
+  ASSERT_TRUE(cache.load(key, binary));
+  EXPECT_EQ(binary.Format, stored.Format);
+  EXPECT_EQ(binary.Data, stored.Data);
+  EXPECT_EQ(cache.getNumHits(), 1);
+
+  // Reload from disk with a new file system
+  auto newFs = std::make_shared<core::RealFileSystem>(fs->getBaseDir());
+  ProgramBinaryCache newCache(newFs, "driver 1.0");
+
+  ProgramBinaryCache::ProgramBinary newBinary;
+  ASSERT_TRUE(newCache.load(key, newBinary));
+  EXPECT_EQ(newBinary.Data, stored.Data);
+}
+
+TEST_F(ProgramBinaryCacheTest, DriverMismatch) {
+  ProgramBinaryCache cache(fs, "driver 1.0");
+  std::uint64_t key = cache.makeKey(shaders);
+  cache.store(key, makeBinary());
+
+  // Entry written by another driver (e.g the cache directory is shared)
+  ProgramBinaryCache otherCache(fs, "driver 1.1");
+  ProgramBinaryCache::ProgramBinary binary;
+  EXPECT_FALSE(otherCache.load(key, binary));
+  EXPECT_EQ(otherCache.getNumInvalid(), 1);
+
+  // Storing again invalidates the old entry
+  otherCache.store(key, makeBinary());
+  EXPECT_TRUE(otherCache.load(key, binary));
+  EXPECT_FALSE(cache.load(key, binary));
+}
+
+TEST_F(ProgramBinaryCacheTest, Corruption) {
+  ProgramBinaryCache cache(fs, "driver 1.0");
+  std::uint64_t key = cache.makeKey(shaders);
+  ProgramBinaryCache::ProgramBinary binary;
+
+  // Truncated header
+  cache.store(key, makeBinary());
+  corrupt(key, [](std::string& data) { data.resize(10); });
+  EXPECT_NO_THROW(EXPECT_FALSE(cache.load(key, binary)));
+
+  // Truncated data
+  cache.store(key, makeBinary());
+  corrupt(key, [](std::string& data) { data.resize(data.size() - 1); });
+  EXPECT_NO_THROW(EXPECT_FALSE(cache.load(key, binary)));
+
+  // Invalid magic
+  cache.store(key, makeBinary());
+  corrupt(key, [](std::string& data) { data[0] = 'X'; });
+  EXPECT_NO_THROW(EXPECT_FALSE(cache.load(key, binary)));
+
+  // Invalid version
+  cache.store(key, makeBinary());
+  corrupt(key, [](std::string& data) { data[4] ^= 0xff; });
+  EXPECT_NO_THROW(EXPECT_FALSE(cache.load(key, binary)));
+
+  // Flipped bit in the binary
+  cache.store(key, makeBinary());
+  corrupt(key, [](std::string& data) { data.back() ^= 0x01; });
+  EXPECT_NO_THROW(EXPECT_FALSE(cache.load(key, binary)));
+
+  // Entry stored under another key
+  cache.store(key, makeBinary());
+  std::string data = fs->read(ProgramBinaryCache::getPath(key), core::FileBuffer::FF_Binary)
+                         ->getDataAsString();
+  auto buffer = std::make_shared<core::FileBuffer>(core::FileBuffer::FF_Binary,
+                                                   ProgramBinaryCache::getPath(key + 1),
+                                                   data.size());
+  buffer->write(data.data(), 0, data.size());
+  fs->write(ProgramBinaryCache::getPath(key + 1), buffer);
+  EXPECT_FALSE(cache.load(key + 1, binary));
+
+  EXPECT_EQ(cache.getNumInvalid(), 6);
+  EXPECT_EQ(cache.getNumHits(), 0);
+
+  // Valid entry
+  cache.store(key, makeBinary());
+  EXPECT_TRUE(cache.load(key, binary));
+}
+
+} // anonymous namespace
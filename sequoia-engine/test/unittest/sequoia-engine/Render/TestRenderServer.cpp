@@ -14,9 +14,12 @@
 //===------------------------------------------------------------------------------------------===//
 
 #include "sequoia-engine/Render/RenderServer.h"
-#include <gtest/gtest.h>
-
+#include <atomic>
 #include <chrono>
+#include <future>
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
 
 using namespace sequoia;
 using namespace sequoia::render;
@@ -25,15 +28,122 @@ namespace {
 
 TEST(RenderServerTest, SpawnRessourceTask) {
   RenderServer s;
-  s.initRessourceThread([]() {});
   Future<int> f = s.spawnRessourceTask([]() {
     using namespace std::literals::chrono_literals;
-    //std::cout << "1" << std::endl;
     std::this_thread::sleep_for(1ms);
-    //std::cout << "2" << std::endl;
     return 1;
   });
-  std::cout << f.get() << std::endl;
+  EXPECT_EQ(f.get(), 1);
+}
+
+TEST(RenderServerTest, DefaultNumWorkers) {
+  RenderServer s;
+  EXPECT_EQ(s.getNumWorkers(), RenderServer::getDefaultNumWorkers());
+  EXPECT_GE(s.getNumWorkers(), 1);
+}
+
+TEST(RenderServerTest, ManyJobs) {
+  RenderServer s(4);
+  EXPECT_EQ(s.getNumWorkers(), 4);
+
+  std::vector<Future<int>> futures;
+  for(int i = 0; i < 1000; ++i)
+    futures.emplace_back(s.spawnJob([i]() { return i; }));
+
+  int sum = 0;
+  for(auto& future : futures)
+    sum += future.get();
+  EXPECT_EQ(sum, 999 * 1000 / 2);
+}
+
+TEST(RenderServerTest, NestedJobs) {
+  RenderServer s(4);
+  std::atomic<int> counter(0);
+
+  // Jobs spawned from a worker are queued locally and stolen by the idle workers
+  Future<void> f = s.spawnJob([&s, &counter]() {
+    for(int i = 0; i < 100; ++i)
+      s.spawnJob([&counter]() { counter++; });
+  });
+  f.get();
+
+  while(counter.load() != 100)
+    std::this_thread::yield();
+  EXPECT_EQ(counter.load(), 100);
+}
+
+TEST(RenderServerTest, Priorities) {
+  RenderServer s(1);
+  std::atomic<bool> release(false);
+  std::promise<void> started;
+  std::vector<int> order;
+
+  // Block the only worker while the other jobs are queued
+  Future<void> blocker = s.spawnJob([&release, &started]() {
+    started.set_value();
+    while(!release.load())
+      std::this_thread::yield();
+  });
+  started.get_future().wait();
+
+  auto low = s.spawnJob([&order]() { order.push_back(RenderServer::JP_Low); },
+                        RenderServer::JP_Low);
+  auto normal = s.spawnJob([&order]() { order.push_back(RenderServer::JP_Normal); });
+  auto high = s.spawnJob([&order]() { order.push_back(RenderServer::JP_High); },
+                         RenderServer::JP_High);
+
+  release.store(true);
+  blocker.get();
+  low.get();
+  normal.get();
+  high.get();
+
+  ASSERT_EQ(order.size(), 3);
+  EXPECT_EQ(order[0], RenderServer::JP_High);
+  EXPECT_EQ(order[1], RenderServer::JP_Normal);
+  EXPECT_EQ(order[2], RenderServer::JP_Low);
+}
+
+TEST(RenderServerTest, InjectedJobsAreFIFO) {
+  RenderServer s(1);
+  std::atomic<bool> release(false);
+  std::promise<void> started;
+  std::vector<int> order;
+
+  // Block the only worker while the other jobs are queued
+  Future<void> blocker = s.spawnJob([&release, &started]() {
+    started.set_value();
+    while(!release.load())
+      std::this_thread::yield();
+  });
+  started.get_future().wait();
+
+  std::vector<Future<void>> futures;
+  for(int i = 0; i < 10; ++i)
+    futures.emplace_back(s.spawnJob([&order, i]() { order.push_back(i); }));
+
+  release.store(true);
+  blocker.get();
+  for(auto& future : futures)
+    future.get();
+
+  // Jobs spawned from outside of the workers run in the order they were submitted
+  ASSERT_EQ(order.size(), 10);
+  for(int i = 0; i < 10; ++i)
+    EXPECT_EQ(order[i], i);
+}
+
+TEST(RenderServerTest, MainThreadJobs) {
+  RenderServer s(2);
+  std::thread::id mainThread = std::this_thread::get_id();
+
+  Future<std::thread::id> f = s.spawnMainThreadJob([]() { return std::this_thread::get_id(); });
+  Future<std::thread::id> g = s.spawnJob([]() { return std::this_thread::get_id(); });
+
+  EXPECT_NE(g.get(), mainThread);
+  EXPECT_EQ(s.runMainThreadJobs(), 1);
+  EXPECT_EQ(f.get(), mainThread);
+  EXPECT_EQ(s.runMainThreadJobs(), 0);
 }
 
 } // anonymous namespace
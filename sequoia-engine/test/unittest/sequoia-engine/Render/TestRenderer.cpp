@@ -16,8 +16,11 @@
 #include "sequoia-engine/Core/Format.h"
 #include "sequoia-engine/Core/StringUtil.h"
 #include "sequoia-engine/Math/Math.h"
+#include "sequoia-engine/Render/BindingSet.h"
 #include "sequoia-engine/Render/Camera.h"
 #include "sequoia-engine/Render/DrawCallContext.h"
+#include "sequoia-engine/Render/DrawIndirectCommand.h"
+#include "sequoia-engine/Render/Null/NullRenderer.h"
 #include "sequoia-engine/Render/RenderSystem.h"
 #include "sequoia-engine/Render/RenderTechnique.h"
 #include "sequoia-engine/Render/Renderer.h"
@@ -26,6 +29,7 @@
 #include <algorithm>
 #include <gtest/gtest.h>
 #include <memory>
+#include <tuple>
 #include <vector>
 
 using namespace sequoia::render;
@@ -65,9 +69,9 @@ protected:
     return true;
   }
 
-  bool UniformVariableChanged(Program* program, const std::string& name,
+  bool UniformVariableChanged(Program* program, UniformID id,
                               const UniformVariable& value) override {
-    changes_.emplace_back("UniformVariable_" + name);
+    changes_.emplace_back("UniformVariable_" + UniformNameTable::getGlobal().getName(id));
     return true;
   }
 
@@ -95,8 +99,27 @@ protected:
     return true;
   }
 
+  virtual bool bindUniformBlock(const std::string& name, const std::vector<Byte>& data) override {
+    changes_.emplace_back("UniformBlock_" + name);
+    return true;
+  }
+
   virtual bool draw(const DrawCommand& drawCommand) override { return true; }
 
+  virtual bool supportsInstancing(Program* program) const override { return false; }
+
+  virtual bool drawInstanced(const DrawCommand& drawCommand,
+                             ArrayRef<mat4> matModels) override {
+    return true;
+  }
+
+  virtual bool supportsMultiDrawIndirect() const override { return false; }
+
+  virtual bool drawIndirect(const DrawCommand& drawCommand, ArrayRef<DrawIndirectCommand> commands,
+                            ArrayRef<mat4> matModels) override {
+    return true;
+  }
+
   virtual std::pair<std::string, std::string> toStringImpl() const override {
     return std::make_pair("TestRenderer",
                           format("{}"
@@ -156,6 +179,23 @@ static std::shared_ptr<VertexData> makeNullVertexData() {
   return rsys.createVertexData(param);
 }
 
+/// @brief VertexData drawing a sub-range of the buffers of another VertexData
+class SubVertexData final : public VertexData {
+public:
+  SubVertexData(VertexData* storage, DrawRange range)
+      : VertexData(storage->getRenderSystemKind(), storage->getDrawMode()), storage_(storage),
+        range_(range) {}
+
+  VertexBuffer* getVertexBuffer() const override { return storage_->getVertexBuffer(); }
+  IndexBuffer* getIndexBuffer() const override { return storage_->getIndexBuffer(); }
+  const VertexData* getStorage() const noexcept override { return storage_; }
+  DrawRange getDrawRange() const noexcept override { return range_; }
+
+private:
+  VertexData* storage_;
+  DrawRange range_;
+};
+
 SEQUOIA_TESTCASEFIXTURE(RendererTest, RenderSetup);
 
 TEST_F(RendererTest, PipelineChange) {
@@ -225,6 +265,12 @@ TEST_F(RendererTest, VertexDataChange) {
     ASSERT_EQ(c.size(), 1);
     EXPECT_STREQ(c[0].c_str(), "VertexData");
   }
+
+  // Bind vertex-data sharing the storage -> nothing should happen
+  SubVertexData subdata(vertexdata1.get(), VertexData::DrawRange{0, 0, 0, 0});
+  renderer->resetChanges();
+  renderer->setVertexData(&subdata);
+  ASSERT_EQ(renderer->getChanges().size(), 0);
 }
 
 TEST_F(RendererTest, RenderBufferChange) {
@@ -298,6 +344,36 @@ TEST_F(RendererTest, TextureChange) {
   }
 }
 
+TEST_F(RendererTest, DrawCommandBindings) {
+  RenderSystem& rsys = RenderSystem::getSingleton();
+  auto tex0 = rsys.createTexture(nullptr);
+  auto tex1 = rsys.createTexture(nullptr);
+
+  // Textures are sorted by their unit
+  auto bindingSet = BindingSet::create({{3, tex1.get()}, {0, tex0.get()}}, {{"two", 2.0f}});
+  ASSERT_EQ(bindingSet->getTextures().size(), 2);
+  EXPECT_EQ(bindingSet->getTextures()[0].first, 0);
+  EXPECT_EQ(bindingSet->getTextures()[1].first, 3);
+  ASSERT_EQ(bindingSet->getUniforms().size(), 1);
+  EXPECT_EQ(bindingSet->getUniforms()[0].first, UniformNameTable::getGlobal().lookup("two"));
+
+  // Same textures produce the same hash
+  auto otherBindingSet = BindingSet::create({{0, tex0.get()}, {3, tex1.get()}}, {});
+  EXPECT_EQ(bindingSet->getTextureHash(), otherBindingSet->getTextureHash());
+
+  DrawCommand drawCmd(nullptr, mat4(1.0f), bindingSet.get());
+  EXPECT_EQ(drawCmd.getTextures().size(), 2);
+  EXPECT_EQ(drawCmd.getUniforms().size(), 0);
+
+  // Per-draw uniforms are stored inline and overriden if set twice
+  drawCmd.setUniformVariable("five", UniformVariable(5));
+  drawCmd.setUniformVariable("six", UniformVariable(6));
+  drawCmd.setUniformVariable("five", UniformVariable(55));
+  ASSERT_EQ(drawCmd.getUniforms().size(), 2);
+  EXPECT_EQ(drawCmd.getUniforms()[0].first, UniformNameTable::getGlobal().lookup("five"));
+  EXPECT_EQ(drawCmd.getUniforms()[0].second, UniformVariable(55));
+}
+
 TEST_F(RendererTest, UniformChange) {
   RenderSystem& rsys = RenderSystem::getSingleton();
   auto renderer = std::make_unique<TestRenderer>();
@@ -372,7 +448,7 @@ TEST_F(RendererTest, Draw) {
   // Check all changes are applied
   {
     const std::vector<std::string>& c = renderer->getChanges();
-    ASSERT_EQ(c.size(), 10);
+    ASSERT_EQ(c.size(), 11);
 
     // Pipeline
     EXPECT_TRUE(std::find(c.begin(), c.end(), "DepthTest") != c.end());
@@ -393,7 +469,285 @@ TEST_F(RendererTest, Draw) {
     EXPECT_TRUE(std::find(c.begin(), c.end(), "UniformVariable_u_matMVP") != c.end());
     EXPECT_TRUE(std::find(c.begin(), c.end(), "UniformVariable_two") != c.end());
     EXPECT_TRUE(std::find(c.begin(), c.end(), "UniformVariable_five") != c.end());
+
+    // Uniform blocks
+    EXPECT_TRUE(std::find(c.begin(), c.end(), "UniformBlock_CameraBlock") != c.end());
   }
 }
 
+TEST_F(RendererTest, SortKey) {
+  // Program dominates BindingSet, which dominates storage, which dominates vertex data, which
+  // dominates depth
+  EXPECT_LT(Renderer::makeSortKey(0, 1, 1, 1, 1.0f), Renderer::makeSortKey(1, 0, 0, 0, 0.0f));
+  EXPECT_LT(Renderer::makeSortKey(0, 0, 1, 1, 1.0f), Renderer::makeSortKey(0, 1, 0, 0, 0.0f));
+  EXPECT_LT(Renderer::makeSortKey(0, 0, 0, 1, 1.0f), Renderer::makeSortKey(0, 0, 1, 0, 0.0f));
+  EXPECT_LT(Renderer::makeSortKey(0, 0, 0, 0, 1.0f), Renderer::makeSortKey(0, 0, 0, 1, 0.0f));
+  EXPECT_LT(Renderer::makeSortKey(0, 0, 0, 0, 0.2f), Renderer::makeSortKey(0, 0, 0, 0, 0.8f));
+
+  // Depth is clamped
+  EXPECT_EQ(Renderer::makeSortKey(0, 0, 0, 0, -1.0f), Renderer::makeSortKey(0, 0, 0, 0, 0.0f));
+  EXPECT_EQ(Renderer::makeSortKey(0, 0, 0, 0, 2.0f), Renderer::makeSortKey(0, 0, 0, 0, 1.0f));
+
+  // IDs exceeding their field do not spill into the other fields
+  EXPECT_LT(Renderer::makeSortKey(0, 0, 0, 0xffff, 1.0f), Renderer::makeSortKey(0, 0, 1, 0, 0.0f));
+}
+
+TEST_F(RendererTest, SortDrawCommands) {
+  RenderSystem& rsys = RenderSystem::getSingleton();
+
+  auto renderer = std::make_unique<NullRenderer>();
+  auto target = rsys.getMainWindow();
+  auto program = rsys.createProgram({});
+  auto technique = std::make_unique<TestRenderTechnique>(program.get());
+
+  auto camera = std::make_shared<Camera>();
+  auto viewport = std::make_shared<Viewport>(target, 0, 0, 80, 80);
+  viewport->setCamera(camera.get());
+  target->setViewport(viewport);
+
+  auto vertexdata0 = makeNullVertexData();
+  auto vertexdata1 = makeNullVertexData();
+  auto tex0 = rsys.createTexture(nullptr);
+  auto tex1 = rsys.createTexture(nullptr);
+  auto bindingSet0 = BindingSet::create({{0, tex0.get()}}, {});
+  auto bindingSet1 = BindingSet::create({{0, tex1.get()}}, {});
+
+  // Interleave the vertex data and textures such that every draw changes state when submitted in
+  // recording order
+  RenderCommand renderCmd(target);
+  renderCmd.Techniques = {technique.get()};
+
+  const int numDrawCommands = 16;
+  for(int i = 0; i < numDrawCommands; ++i) {
+    renderCmd.DrawCommands.emplace_back(i % 2 ? vertexdata1.get() : vertexdata0.get(),
+                                        translate(mat4(1.0f), vec3(0, 0, -float(i))),
+                                        (i / 2) % 2 ? bindingSet1.get() : bindingSet0.get());
+  }
+
+  // Instancing would merge the draws sharing vertex data and textures
+  renderer->setInstancing(false);
+
+  // Unsorted
+  renderer->setSortDrawCommands(false);
+  renderer->reset();
+  renderer->resetStatistics();
+  renderer->render(renderCmd);
+
+  NullRenderer::Statistics unsorted = renderer->getStatistics();
+  EXPECT_EQ(unsorted.NumDrawCalls, numDrawCommands);
+  EXPECT_EQ(unsorted.NumVertexDataChanges, numDrawCommands);
+
+  // Sorted
+  renderer->setSortDrawCommands(true);
+  renderer->reset();
+  renderer->resetStatistics();
+  renderer->render(renderCmd);
+
+  NullRenderer::Statistics sorted = renderer->getStatistics();
+  EXPECT_EQ(sorted.NumDrawCalls, numDrawCommands);
+  EXPECT_EQ(sorted.NumProgramChanges, 1);
+  EXPECT_EQ(sorted.NumTextureChanges, 2);
+  EXPECT_EQ(sorted.NumVertexDataChanges, 4);
+  EXPECT_EQ(sorted.NumUniformBlockBindings, 1);
+  EXPECT_LT(sorted.getNumStateChanges(), unsorted.getNumStateChanges());
+
+  // Sorting is deterministic
+  renderer->reset();
+  renderer->resetStatistics();
+  renderer->render(renderCmd);
+  EXPECT_EQ(renderer->getStatistics().getNumStateChanges(), sorted.getNumStateChanges());
+}
+
+TEST_F(RendererTest, Instancing) {
+  RenderSystem& rsys = RenderSystem::getSingleton();
+
+  auto renderer = std::make_unique<NullRenderer>();
+  auto target = rsys.getMainWindow();
+  auto program = rsys.createProgram({});
+  auto technique = std::make_unique<TestRenderTechnique>(program.get());
+
+  auto camera = std::make_shared<Camera>();
+  auto viewport = std::make_shared<Viewport>(target, 0, 0, 80, 80);
+  viewport->setCamera(camera.get());
+  target->setViewport(viewport);
+
+  auto vertexdata0 = makeNullVertexData();
+  auto vertexdata1 = makeNullVertexData();
+  auto tex0 = rsys.createTexture(nullptr);
+  auto bindingSet0 = BindingSet::create({{0, tex0.get()}}, {});
+  auto bindingSet1 = BindingSet::create({{0, tex0.get()}}, {{"two", 2.0f}});
+
+  auto renderStatistics = [&](const RenderCommand& renderCmd) {
+    renderer->reset();
+    renderer->resetStatistics();
+    renderer->render(renderCmd);
+    return renderer->getStatistics();
+  };
+
+  // 10x10 grid of the same mesh and material is drawn with a single instanced draw
+  RenderCommand gridCmd(target);
+  gridCmd.Techniques = {technique.get()};
+  for(int i = 0; i < 100; ++i)
+    gridCmd.DrawCommands.emplace_back(vertexdata0.get(),
+                                      translate(mat4(1.0f), vec3(i % 10, i / 10, -5.0f)),
+                                      bindingSet0.get());
+
+  NullRenderer::Statistics grid = renderStatistics(gridCmd);
+  EXPECT_EQ(grid.NumDrawCalls, 1);
+  EXPECT_EQ(grid.NumInstancedDrawCalls, 1);
+  EXPECT_EQ(grid.NumInstances, 100);
+
+  // Without instancing every DrawCommand is drawn separately
+  renderer->setInstancing(false);
+  NullRenderer::Statistics gridNoInstancing = renderStatistics(gridCmd);
+  EXPECT_EQ(gridNoInstancing.NumDrawCalls, 100);
+  EXPECT_EQ(gridNoInstancing.NumInstancedDrawCalls, 0);
+  EXPECT_EQ(gridNoInstancing.NumInstances, 100);
+  renderer->setInstancing(true);
+
+  // Only draws sharing the vertex data and the BindingSet (and without per-draw uniforms) are
+  // merged
+  RenderCommand mixedCmd(target);
+  mixedCmd.Techniques = {technique.get()};
+  for(int i = 0; i < 4; ++i) {
+    mixedCmd.DrawCommands.emplace_back(vertexdata0.get(), mat4(1.0f), bindingSet0.get());
+    mixedCmd.DrawCommands.emplace_back(vertexdata1.get(), mat4(1.0f), bindingSet0.get());
+    mixedCmd.DrawCommands.emplace_back(vertexdata0.get(), mat4(1.0f), bindingSet1.get());
+  }
+  mixedCmd.DrawCommands.emplace_back(vertexdata0.get(), mat4(1.0f), bindingSet0.get());
+  mixedCmd.DrawCommands.back().setUniformVariable("five", UniformVariable(5));
+
+  // Without sorting, no two consecutive draws can be merged
+  renderer->setSortDrawCommands(false);
+  NullRenderer::Statistics mixed = renderStatistics(mixedCmd);
+  EXPECT_EQ(mixed.NumInstances, mixedCmd.DrawCommands.size());
+  EXPECT_EQ(mixed.NumDrawCalls, mixedCmd.DrawCommands.size());
+  EXPECT_EQ(mixed.NumInstancedDrawCalls, 0);
+  renderer->setSortDrawCommands(true);
+
+  // Sorting groups the draws by BindingSet and vertex data which allows merging them (the draw
+  // with per-draw uniforms is drawn on its own)
+  NullRenderer::Statistics sorted = renderStatistics(mixedCmd);
+  EXPECT_EQ(sorted.NumInstances, mixedCmd.DrawCommands.size());
+  EXPECT_EQ(sorted.NumDrawCalls, 4);
+  EXPECT_EQ(sorted.NumInstancedDrawCalls, 3);
+
+  // A single instance is drawn without instancing
+  RenderCommand singleCmd(target);
+  singleCmd.Techniques = {technique.get()};
+  singleCmd.DrawCommands.emplace_back(vertexdata0.get(), mat4(1.0f), bindingSet0.get());
+
+  NullRenderer::Statistics single = renderStatistics(singleCmd);
+  EXPECT_EQ(single.NumDrawCalls, 1);
+  EXPECT_EQ(single.NumInstancedDrawCalls, 0);
+  EXPECT_EQ(single.NumInstances, 1);
+}
+
+TEST_F(RendererTest, DrawCommandOwnership) {
+  RenderSystem& rsys = RenderSystem::getSingleton();
+
+  std::shared_ptr<VertexData> vertexData = makeNullVertexData();
+  auto tex0 = rsys.createTexture(nullptr);
+  std::shared_ptr<const BindingSet> bindingSet = BindingSet::create({{0, tex0.get()}}, {});
+
+  std::weak_ptr<VertexData> weakVertexData = vertexData;
+  std::weak_ptr<const BindingSet> weakBindingSet = bindingSet;
+
+  // The DrawCommand keeps the vertex data and the BindingSet alive while it is in flight
+  DrawCommand drawCommand(vertexData, mat4(1.0f), bindingSet);
+  vertexData.reset();
+  bindingSet.reset();
+  EXPECT_FALSE(weakVertexData.expired());
+  EXPECT_FALSE(weakBindingSet.expired());
+  EXPECT_EQ(drawCommand.getVertexData(), weakVertexData.lock().get());
+  EXPECT_EQ(drawCommand.getBindingSet(), weakBindingSet.lock().get());
+
+  drawCommand = DrawCommand();
+  EXPECT_TRUE(weakVertexData.expired());
+  EXPECT_TRUE(weakBindingSet.expired());
+}
+
+TEST_F(RendererTest, DrawIndirectCommand) {
+  auto storage = makeNullVertexData();
+  SubVertexData subdata(storage.get(), VertexData::DrawRange{24, 8, 0, 0});
+
+  EXPECT_EQ(subdata.getStorage(), storage.get());
+  EXPECT_EQ(storage->getStorage(), storage.get());
+
+  DrawIndirectCommand command = DrawIndirectCommand::create(&subdata, 3);
+  EXPECT_EQ(command.Count, 8);
+  EXPECT_EQ(command.InstanceCount, 1);
+  EXPECT_EQ(command.First, 24);
+  EXPECT_EQ(command.BaseVertex, 0);
+  EXPECT_EQ(command.BaseInstance, 3);
+}
+
+TEST_F(RendererTest, MultiDrawIndirect) {
+  RenderSystem& rsys = RenderSystem::getSingleton();
+
+  auto renderer = std::make_unique<NullRenderer>();
+  auto target = rsys.getMainWindow();
+  auto program = rsys.createProgram({});
+  auto technique = std::make_unique<TestRenderTechnique>(program.get());
+
+  auto camera = std::make_shared<Camera>();
+  auto viewport = std::make_shared<Viewport>(target, 0, 0, 80, 80);
+  viewport->setCamera(camera.get());
+  target->setViewport(viewport);
+
+  // Three meshes sharing the buffers of `storage0` and one mesh in `storage1` (5 triangles in
+  // total)
+  auto storage0 = makeNullVertexData();
+  auto storage1 = makeNullVertexData();
+  SubVertexData mesh0(storage0.get(), VertexData::DrawRange{0, 3, 0, 0});
+  SubVertexData mesh1(storage0.get(), VertexData::DrawRange{3, 6, 0, 0});
+  SubVertexData mesh2(storage0.get(), VertexData::DrawRange{9, 3, 0, 0});
+  SubVertexData mesh3(storage1.get(), VertexData::DrawRange{0, 3, 0, 0});
+
+  auto tex0 = rsys.createTexture(nullptr);
+  auto bindingSet0 = BindingSet::create({{0, tex0.get()}}, {});
+
+  RenderCommand renderCmd(target);
+  renderCmd.Techniques = {technique.get()};
+  for(int i = 0; i < 10; ++i)
+    for(VertexData* mesh : {&mesh0, &mesh1, &mesh2, &mesh3})
+      renderCmd.DrawCommands.emplace_back(mesh, translate(mat4(1.0f), vec3(i, 0.0f, -5.0f)),
+                                          bindingSet0.get());
+
+  auto renderStatistics = [&]() {
+    renderer->reset();
+    renderer->resetStatistics();
+    renderer->render(renderCmd);
+    return renderer->getStatistics();
+  };
+
+  // The 30 draws of the meshes in `storage0` collapse into a single multi-draw (one command per
+  // mesh) while the draws of `mesh3` are instanced
+  NullRenderer::Statistics multiDraw = renderStatistics();
+  EXPECT_EQ(multiDraw.NumDrawCalls, 2);
+  EXPECT_EQ(multiDraw.NumIndirectDrawCalls, 1);
+  EXPECT_EQ(multiDraw.NumIndirectCommands, 3);
+  EXPECT_EQ(multiDraw.NumInstancedDrawCalls, 1);
+  EXPECT_EQ(multiDraw.NumInstances, 40);
+  EXPECT_EQ(multiDraw.NumTriangles, 50);
+
+  // Without multi-draws every mesh is drawn with a separate instanced draw
+  renderer->setMultiDrawIndirect(false);
+  NullRenderer::Statistics instanced = renderStatistics();
+  EXPECT_EQ(instanced.NumDrawCalls, 4);
+  EXPECT_EQ(instanced.NumIndirectDrawCalls, 0);
+  EXPECT_EQ(instanced.NumInstancedDrawCalls, 4);
+  EXPECT_EQ(instanced.NumInstances, 40);
+  EXPECT_EQ(instanced.NumTriangles, 50);
+  renderer->setMultiDrawIndirect(true);
+
+  // Multi-draws require instancing
+  renderer->setInstancing(false);
+  NullRenderer::Statistics single = renderStatistics();
+  EXPECT_EQ(single.NumDrawCalls, 40);
+  EXPECT_EQ(single.NumIndirectDrawCalls, 0);
+  EXPECT_EQ(single.NumTriangles, 50);
+  renderer->setInstancing(true);
+}
+
 } // anonymous namespace
@@ -0,0 +1,124 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                         _____                        _
+//                        / ____|                      (_)
+//                       | (___   ___  __ _ _   _  ___  _  __ _
+//                        \___ \ / _ \/ _` | | | |/ _ \| |/ _` |
+//                        ____) |  __/ (_| | |_| | (_) | | (_| |
+//                       |_____/ \___|\__, |\__,_|\___/|_|\__,_| - Game Engine (2016-2017)
+//                                       | |
+//                                       |_|
+//
+// This file is distributed under the MIT License (MIT).
+// See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#include "sequoia-engine/Render/Exception.h"
+#include "sequoia-engine/Render/Null/NullRingBuffer.h"
+#include <gtest/gtest.h>
+
+using namespace sequoia;
+using namespace sequoia::render;
+
+namespace {
+
+TEST(RingBufferTest, Allocate) {
+  NullRingBuffer buffer(256);
+
+  RingBuffer::Allocation a = buffer.allocate(10, 16);
+  RingBuffer::Allocation b = buffer.allocate(8, 16);
+  EXPECT_EQ(a.Offset, 0);
+  EXPECT_EQ(a.NumBytes, 10);
+  EXPECT_EQ(b.Offset, 16);
+  EXPECT_EQ(static_cast<Byte*>(b.Data), static_cast<Byte*>(a.Data) + 16);
+
+  // Padding is accounted to the frame
+  EXPECT_EQ(buffer.getNumBytesInUse(), 24);
+
+  int value = 42;
+  RingBuffer::Allocation c = buffer.write(&value, sizeof(int), sizeof(int));
+  EXPECT_EQ(c.Offset, 24);
+  EXPECT_EQ(*static_cast<int*>(c.Data), 42);
+}
+
+TEST(RingBufferTest, WrapAround) {
+  NullRingBuffer buffer(224);
+
+  buffer.allocate(96);
+  buffer.endFrame();
+  buffer.allocate(96);
+  buffer.endFrame();
+  EXPECT_EQ(buffer.getNumFences(), 2);
+  EXPECT_EQ(buffer.getNumFramesInFlight(), 2);
+
+  // The GPU is done with the first frame, its memory can be reused without stalling
+  buffer.signalFences(0);
+  RingBuffer::Allocation allocation = buffer.allocate(96);
+  EXPECT_EQ(allocation.Offset, 0);
+  EXPECT_EQ(buffer.getNumWrapArounds(), 1);
+  EXPECT_EQ(buffer.getNumStalls(), 0);
+  EXPECT_EQ(buffer.getNumFramesInFlight(), 1);
+  buffer.endFrame();
+
+  // The second frame is still in flight, we need to wait for it
+  allocation = buffer.allocate(96);
+  EXPECT_EQ(allocation.Offset, 96);
+  EXPECT_EQ(buffer.getNumStalls(), 1);
+  EXPECT_EQ(buffer.getNumFramesInFlight(), 1);
+}
+
+TEST(RingBufferTest, MaxFramesInFlight) {
+  NullRingBuffer buffer(1024, 2);
+
+  for(int frame = 0; frame < 2; ++frame) {
+    buffer.allocate(16);
+    buffer.endFrame();
+  }
+  EXPECT_EQ(buffer.getNumFramesInFlight(), 2);
+  EXPECT_EQ(buffer.getNumStalls(), 0);
+
+  // Ending a third frame has to wait for the first one
+  buffer.allocate(16);
+  buffer.endFrame();
+  EXPECT_EQ(buffer.getNumFramesInFlight(), 2);
+  EXPECT_EQ(buffer.getNumStalls(), 1);
+  EXPECT_EQ(buffer.getFrame(), 3);
+}
+
+TEST(RingBufferTest, EmptyFrame) {
+  NullRingBuffer buffer(256);
+
+  buffer.endFrame();
+  EXPECT_EQ(buffer.getFrame(), 1);
+  EXPECT_EQ(buffer.getNumFences(), 0);
+  EXPECT_EQ(buffer.getNumFramesInFlight(), 0);
+}
+
+TEST(RingBufferTest, Exhausted) {
+  NullRingBuffer buffer(256);
+
+  EXPECT_THROW(buffer.allocate(512), RenderSystemException);
+
+  // A single frame can't use more than the capacity of the buffer
+  buffer.allocate(200);
+  EXPECT_THROW(buffer.allocate(100), RenderSystemException);
+}
+
+TEST(RingBufferTest, CanAllocate) {
+  NullRingBuffer buffer(256);
+  EXPECT_TRUE(buffer.canAllocate(256));
+  EXPECT_FALSE(buffer.canAllocate(512));
+
+  buffer.allocate(100);
+  EXPECT_TRUE(buffer.canAllocate(144));
+  EXPECT_FALSE(buffer.canAllocate(145));
+
+  // Frames in flight are retired on demand, only the current frame counts
+  buffer.endFrame();
+  buffer.allocate(10);
+  EXPECT_TRUE(buffer.canAllocate(128));
+  EXPECT_FALSE(buffer.canAllocate(250));
+  EXPECT_NO_THROW(buffer.allocate(128));
+}
+
+} // anonymous namespace
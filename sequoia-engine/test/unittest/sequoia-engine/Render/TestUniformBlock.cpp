@@ -0,0 +1,151 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                         _____                        _
+//                        / ____|                      (_)
+//                       | (___   ___  __ _ _   _  ___  _  __ _
+//                        \___ \ / _ \/ _` | | | |/ _ \| |/ _` |
+//                        ____) |  __/ (_| | |_| | (_) | | (_| |
+//                       |_____/ \___|\__, |\__,_|\___/|_|\__,_| - Game Engine (2016-2017)
+//                                       | |
+//                                       |_|
+//
+// This file is distributed under the MIT License (MIT).
+// See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#include "sequoia-engine/Math/Math.h"
+#include "sequoia-engine/Render/UniformBlock.h"
+#include <cstring>
+#include <gtest/gtest.h>
+#include <vector>
+
+using namespace sequoia;
+using namespace sequoia::render;
+
+namespace {
+
+SEQUOIA_UNIFORM_BLOCK(ScalarBlock, (float, a, 1)(int, b, 1)(bool, c, 1));
+
+SEQUOIA_UNIFORM_BLOCK(VectorBlock, (float, a, 1)(math::vec3, b, 1)(float, c, 1)(math::vec2, d, 1));
+
+SEQUOIA_UNIFORM_BLOCK(MatrixBlock, (float, a, 1)(math::mat3, b, 1)(math::mat4, c, 1));
+
+SEQUOIA_UNIFORM_BLOCK(ArrayBlock, (float, a, 3)(math::vec2, b, 2)(float, c, 1));
+
+TEST(UniformBlockTest, Name) {
+  EXPECT_STREQ(ScalarBlock::GetName(), "ScalarBlock");
+  EXPECT_STREQ(ArrayBlock::GetName(), "ArrayBlock");
+}
+
+TEST(UniformBlockTest, ScalarLayout) {
+  const UniformBlockLayout& layout = ScalarBlock::GetLayout();
+  const auto& members = layout.getMembers();
+
+  ASSERT_EQ(members.size(), 3);
+  EXPECT_EQ(members[0].Offset, 0);
+  EXPECT_EQ(members[1].Offset, 4);
+  EXPECT_EQ(members[2].Offset, 8);
+  EXPECT_EQ(layout.getNumBytes(), 16);
+}
+
+TEST(UniformBlockTest, VectorLayout) {
+  const UniformBlockLayout& layout = VectorBlock::GetLayout();
+  const auto& members = layout.getMembers();
+
+  // vec3 is aligned to 16 bytes, a following scalar is packed into its last component
+  ASSERT_EQ(members.size(), 4);
+  EXPECT_EQ(members[0].Offset, 0);
+  EXPECT_EQ(members[1].Offset, 16);
+  EXPECT_EQ(members[2].Offset, 28);
+  EXPECT_EQ(members[3].Offset, 32);
+  EXPECT_EQ(layout.getNumBytes(), 48);
+}
+
+TEST(UniformBlockTest, MatrixLayout) {
+  const UniformBlockLayout& layout = MatrixBlock::GetLayout();
+  const auto& members = layout.getMembers();
+
+  // Each column of a matrix is padded to a vec4
+  ASSERT_EQ(members.size(), 3);
+  EXPECT_EQ(members[1].Offset, 16);
+  EXPECT_EQ(members[1].MatrixStride, 16);
+  EXPECT_EQ(members[2].Offset, 64);
+  EXPECT_EQ(members[2].MatrixStride, 16);
+  EXPECT_EQ(layout.getNumBytes(), 128);
+}
+
+TEST(UniformBlockTest, ArrayLayout) {
+  const UniformBlockLayout& layout = ArrayBlock::GetLayout();
+  const auto& members = layout.getMembers();
+
+  // Each array element is padded to a vec4
+  ASSERT_EQ(members.size(), 3);
+  EXPECT_EQ(members[0].Offset, 0);
+  EXPECT_EQ(members[0].ArrayStride, 16);
+  EXPECT_EQ(members[1].Offset, 48);
+  EXPECT_EQ(members[1].ArrayStride, 16);
+  EXPECT_EQ(members[2].Offset, 80);
+  EXPECT_EQ(members[2].ArrayStride, 0);
+  EXPECT_EQ(layout.getNumBytes(), 96);
+}
+
+TEST(UniformBlockTest, Pack) {
+  MatrixBlock block;
+  block.a = 1.0f;
+  block.b = math::mat3(2.0f);
+  block.c = math::mat4(3.0f);
+
+  std::vector<float> data(MatrixBlock::GetLayout().getNumBytes() / sizeof(float), -1.0f);
+  block.pack(data.data());
+
+  EXPECT_EQ(data[0], 1.0f);
+
+  // Padding is zeroed
+  EXPECT_EQ(data[1], 0.0f);
+
+  // Columns of the mat3 (the 4th component of each column is padding)
+  for(int col = 0; col < 3; ++col)
+    for(int row = 0; row < 4; ++row)
+      EXPECT_EQ(data[4 + 4 * col + row], (row == col ? 2.0f : 0.0f));
+
+  for(int col = 0; col < 4; ++col)
+    for(int row = 0; row < 4; ++row)
+      EXPECT_EQ(data[16 + 4 * col + row], (row == col ? 3.0f : 0.0f));
+}
+
+TEST(UniformBlockTest, PackArray) {
+  ArrayBlock block;
+  block.a[0] = 1.0f;
+  block.a[1] = 2.0f;
+  block.a[2] = 3.0f;
+  block.b[0] = math::vec2(4.0f, 5.0f);
+  block.b[1] = math::vec2(6.0f, 7.0f);
+  block.c = 8.0f;
+
+  std::vector<float> data(ArrayBlock::GetLayout().getNumBytes() / sizeof(float));
+  block.pack(data.data());
+
+  EXPECT_EQ(data[0], 1.0f);
+  EXPECT_EQ(data[4], 2.0f);
+  EXPECT_EQ(data[8], 3.0f);
+  EXPECT_EQ(data[12], 4.0f);
+  EXPECT_EQ(data[13], 5.0f);
+  EXPECT_EQ(data[16], 6.0f);
+  EXPECT_EQ(data[17], 7.0f);
+  EXPECT_EQ(data[20], 8.0f);
+}
+
+TEST(UniformBlockTest, PackBool) {
+  ScalarBlock block;
+  block.a = 1.5f;
+  block.b = 2;
+  block.c = true;
+
+  std::vector<std::uint32_t> data(ScalarBlock::GetLayout().getNumBytes() / sizeof(std::uint32_t));
+  block.pack(data.data());
+
+  EXPECT_EQ(data[1], 2);
+  EXPECT_EQ(data[2], 1);
+}
+
+} // anonymous namespace
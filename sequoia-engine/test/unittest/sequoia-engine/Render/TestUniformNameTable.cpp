@@ -0,0 +1,85 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                         _____                        _
+//                        / ____|                      (_)
+//                       | (___   ___  __ _ _   _  ___  _  __ _
+//                        \___ \ / _ \/ _` | | | |/ _ \| |/ _` |
+//                        ____) |  __/ (_| | |_| | (_) | | (_| |
+//                       |_____/ \___|\__, |\__,_|\___/|_|\__,_| - Game Engine (2016-2017)
+//                                       | |
+//                                       |_|
+//
+// This file is distributed under the MIT License (MIT).
+// See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#include "sequoia-engine/Render/UniformNameTable.h"
+#include <gtest/gtest.h>
+#include <set>
+#include <thread>
+#include <vector>
+
+using namespace sequoia::render;
+
+namespace {
+
+TEST(UniformNameTableTest, Intern) {
+  UniformNameTable table;
+  EXPECT_EQ(table.size(), 0);
+
+  // IDs are dense and handed out in order of first appearance
+  UniformID foo = table.intern("u_foo");
+  UniformID bar = table.intern("u_bar");
+  EXPECT_EQ(foo, 0);
+  EXPECT_EQ(bar, 1);
+  EXPECT_EQ(table.size(), 2);
+
+  // Interning a name twice yields the same ID
+  EXPECT_EQ(table.intern("u_foo"), foo);
+  EXPECT_EQ(table.size(), 2);
+
+  EXPECT_EQ(table.getName(foo), "u_foo");
+  EXPECT_EQ(table.getName(bar), "u_bar");
+}
+
+TEST(UniformNameTableTest, Lookup) {
+  UniformNameTable table;
+  UniformID foo = table.intern("u_foo");
+
+  EXPECT_EQ(table.lookup("u_foo"), foo);
+  EXPECT_EQ(table.lookup("u_bar"), UniformNameTable::InvalidID);
+
+  // Lookup does not intern
+  EXPECT_EQ(table.size(), 1);
+}
+
+TEST(UniformNameTableTest, Concurrent) {
+  UniformNameTable table;
+  const int numThreads = 4;
+  const int numNames = 100;
+
+  std::vector<std::vector<UniformID>> ids(numThreads);
+  std::vector<std::thread> threads;
+  for(int t = 0; t < numThreads; ++t)
+    threads.emplace_back([&, t]() {
+      for(int i = 0; i < numNames; ++i)
+        ids[t].push_back(table.intern("u_var" + std::to_string(i)));
+    });
+
+  for(auto& thread : threads)
+    thread.join();
+
+  // All threads agree on the IDs which are dense
+  EXPECT_EQ(table.size(), numNames);
+  for(int t = 1; t < numThreads; ++t)
+    EXPECT_EQ(ids[t], ids[0]);
+
+  std::set<UniformID> uniqueIDs(ids[0].begin(), ids[0].end());
+  EXPECT_EQ(uniqueIDs.size(), numNames);
+  EXPECT_EQ(*uniqueIDs.rbegin(), numNames - 1);
+
+  for(int i = 0; i < numNames; ++i)
+    EXPECT_EQ(table.getName(ids[0][i]), "u_var" + std::to_string(i));
+}
+
+} // anonymous namespace
@@ -76,4 +76,68 @@ TEST(VertexLayoutTest, Vertex_posf2_texf2_colu4) {
   EXPECT_STREQ(layout.getName(), "Vertex_posf2_texf2_colu4");
 }
 
+TEST(VertexLayoutTest, Vertex_posf3_noro2_texh2_colu4) {
+  VertexLayout layout = Vertex_posf3_noro2_texh2_colu4::getLayout();
+  EXPECT_EQ(layout.SizeOf, sizeof(Vertex_posf3_noro2_texh2_colu4));
+  EXPECT_EQ(layout.SizeOf, 24);
+
+  // float Position[3];
+  EXPECT_EQ(layout.Position.Type, VertexLayout::Float32);
+  EXPECT_EQ(layout.Position.NumElements, 3);
+  EXPECT_EQ(layout.Position.Offset, 0);
+  EXPECT_EQ(layout.Position.Normalize, false);
+
+  // std::int16_t Normal[2];
+  EXPECT_EQ(layout.Normal.Type, VertexLayout::Int16);
+  EXPECT_EQ(layout.Normal.NumElements, 2);
+  EXPECT_EQ(layout.Normal.Offset, 12);
+  EXPECT_EQ(layout.Normal.Normalize, true);
+
+  // Half TexCoord[2];
+  EXPECT_EQ(layout.TexCoord.Type, VertexLayout::Float16);
+  EXPECT_EQ(layout.TexCoord.NumElements, 2);
+  EXPECT_EQ(layout.TexCoord.Offset, 16);
+  EXPECT_EQ(layout.TexCoord.Normalize, false);
+
+  // unsigned char Color[4];
+  EXPECT_EQ(layout.Color.Type, VertexLayout::UInt8);
+  EXPECT_EQ(layout.Color.NumElements, 4);
+  EXPECT_EQ(layout.Color.Offset, 20);
+  EXPECT_EQ(layout.Color.Normalize, true);
+
+  EXPECT_STREQ(layout.getName(), "Vertex_posf3_noro2_texh2_colu4");
+}
+
+TEST(VertexLayoutTest, Vertex_poss4_noro2_texh2_colu4) {
+  VertexLayout layout = Vertex_poss4_noro2_texh2_colu4::getLayout();
+  EXPECT_EQ(layout.SizeOf, sizeof(Vertex_poss4_noro2_texh2_colu4));
+  EXPECT_EQ(layout.SizeOf, 20);
+
+  // std::int16_t Position[4];
+  EXPECT_EQ(layout.Position.Type, VertexLayout::Int16);
+  EXPECT_EQ(layout.Position.NumElements, 4);
+  EXPECT_EQ(layout.Position.Offset, 0);
+  EXPECT_EQ(layout.Position.Normalize, true);
+
+  // std::int16_t Normal[2];
+  EXPECT_EQ(layout.Normal.Type, VertexLayout::Int16);
+  EXPECT_EQ(layout.Normal.NumElements, 2);
+  EXPECT_EQ(layout.Normal.Offset, 8);
+  EXPECT_EQ(layout.Normal.Normalize, true);
+
+  // Half TexCoord[2];
+  EXPECT_EQ(layout.TexCoord.Type, VertexLayout::Float16);
+  EXPECT_EQ(layout.TexCoord.NumElements, 2);
+  EXPECT_EQ(layout.TexCoord.Offset, 12);
+  EXPECT_EQ(layout.TexCoord.Normalize, false);
+
+  // unsigned char Color[4];
+  EXPECT_EQ(layout.Color.Type, VertexLayout::UInt8);
+  EXPECT_EQ(layout.Color.NumElements, 4);
+  EXPECT_EQ(layout.Color.Offset, 16);
+  EXPECT_EQ(layout.Color.Normalize, true);
+
+  EXPECT_STREQ(layout.getName(), "Vertex_poss4_noro2_texh2_colu4");
+}
+
 } // anonymous namespace
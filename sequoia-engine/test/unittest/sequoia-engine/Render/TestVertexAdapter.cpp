@@ -123,4 +123,69 @@ TEST(VertexAdapterTest, SetColor) {
   EXPECT_EQ(vertex.Color[3], 255);
 }
 
+TEST(VertexAdapterTest, Quantized) {
+  auto adapter = VertexFactory::create("Vertex_poss4_noro2_texh2_colu4");
+  Vertex_poss4_noro2_texh2_colu4 vertex;
+
+  // Normalized 16-bit positions (clamped to [-1, 1])
+  adapter.setPosition(math::vec4(0.5f, -0.25f, 2.0f, 1.0f));
+  math::vec4 position = adapter.getPosition();
+  EXPECT_NEAR(position[0], 0.5f, 1e-4f);
+  EXPECT_NEAR(position[1], -0.25f, 1e-4f);
+  EXPECT_EQ(position[2], 1.0f);
+  EXPECT_EQ(position[3], 1.0f);
+
+  // Octahedral encoded normals
+  adapter.setNormal(math::vec3(0, 0, -2));
+  math::vec4 normal = adapter.getNormal();
+  EXPECT_NEAR(normal[0], 0.0f, 1e-4f);
+  EXPECT_NEAR(normal[1], 0.0f, 1e-4f);
+  EXPECT_NEAR(normal[2], -1.0f, 1e-4f);
+
+  math::vec3 direction = math::normalize(math::vec3(1, -2, 3));
+  adapter.setNormal(direction);
+  normal = adapter.getNormal();
+  for(int i = 0; i < 3; ++i)
+    EXPECT_NEAR(normal[i], direction[i], 1e-4f);
+
+  // Half precision texture coordinates
+  adapter.setTexCoord(math::vec2(0.5f, 3.0f));
+  EXPECT_EQ(adapter.getTexCoord(), math::vec4(0.5f, 3.0f, 0, 0));
+
+  // Normalized 8-bit colors are not affected
+  adapter.setColor(Color(1, 2, 3));
+  EXPECT_EQ(adapter.getColor(), Color(1, 2, 3));
+
+  adapter.copyTo(&vertex);
+  EXPECT_EQ(vertex.Position[0], toSnorm<std::int16_t>(0.5f));
+  EXPECT_EQ(vertex.Position[3], 32767);
+  EXPECT_EQ(vertex.TexCoord[1].Bits, Half(3.0f).Bits);
+  EXPECT_EQ(vertex.Color[2], 3);
+}
+
+TEST(VertexAdapterTest, QuantizedConversion) {
+  Vertex_posf3_norf3_texf2_colu4 vertex;
+  vertex.Position[0] = 1.0f;
+  vertex.Position[1] = 2.0f;
+  vertex.Position[2] = 3.0f;
+  vertex.Normal[0] = 0.0f;
+  vertex.Normal[1] = -1.0f;
+  vertex.Normal[2] = 0.0f;
+  vertex.TexCoord[0] = 0.25f;
+  vertex.TexCoord[1] = 0.75f;
+  std::fill_n(vertex.Color, 4, 128);
+
+  Vertex_posf3_noro2_texh2_colu4 compact;
+  quantizeVertices(&vertex, 1, &compact);
+
+  VertexAdapter reference(vertex.getLayout()), adapter(compact.getLayout());
+  reference.copyFrom(&vertex);
+  adapter.copyFrom(&compact);
+  EXPECT_EQ(adapter.getPosition(), reference.getPosition());
+  EXPECT_EQ(adapter.getTexCoord(), reference.getTexCoord());
+  EXPECT_EQ(adapter.getColor(), reference.getColor());
+  for(int i = 0; i < 3; ++i)
+    EXPECT_NEAR(adapter.getNormal()[i], reference.getNormal()[i], 1e-4f);
+}
+
 } // anonymous namespace
@@ -0,0 +1,173 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                         _____                        _
+//                        / ____|                      (_)
+//                       | (___   ___  __ _ _   _  ___  _  __ _
+//                        \___ \ / _ \/ _` | | | |/ _ \| |/ _` |
+//                        ____) |  __/ (_| | |_| | (_) | | (_| |
+//                       |_____/ \___|\__, |\__,_|\___/|_|\__,_| - Game Engine (2016-2017)
+//                                       | |
+//                                       |_|
+//
+// This file is distributed under the MIT License (MIT).
+// See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#include "sequoia-engine/Render/VertexQuantization.h"
+#include <array>
+#include <cmath>
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+
+using namespace sequoia;
+using namespace sequoia::render;
+
+namespace {
+
+/// @brief Angle (in radians) between the unit vectors `a` and `b`
+float getAngle(const float* a, const float* b) {
+  float dot = a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+  return std::acos(std::min(std::max(dot, -1.0f), 1.0f));
+}
+
+/// @brief Random unit vectors (including the axes)
+std::vector<std::array<float, 3>> makeDirections(int n) {
+  std::vector<std::array<float, 3>> directions = {
+      {{1, 0, 0}}, {{-1, 0, 0}}, {{0, 1, 0}}, {{0, -1, 0}}, {{0, 0, 1}}, {{0, 0, -1}}};
+
+  std::mt19937 gen(42);
+  std::normal_distribution<float> dist;
+  for(int i = 0; i < n; ++i) {
+    std::array<float, 3> d = {{dist(gen), dist(gen), dist(gen)}};
+    float length = std::sqrt(d[0] * d[0] + d[1] * d[1] + d[2] * d[2]);
+    for(float& x : d)
+      x /= length;
+    directions.push_back(d);
+  }
+  return directions;
+}
+
+TEST(VertexQuantizationTest, Snorm) {
+  EXPECT_EQ(toSnorm<std::int16_t>(1.0f), 32767);
+  EXPECT_EQ(toSnorm<std::int16_t>(-1.0f), -32767);
+  EXPECT_EQ(toSnorm<std::int16_t>(2.0f), 32767);
+  EXPECT_EQ(toSnorm<std::int16_t>(0.0f), 0);
+
+  EXPECT_EQ(fromSnorm<std::int16_t>(32767), 1.0f);
+  EXPECT_EQ(fromSnorm<std::int16_t>(-32768), -1.0f);
+  for(float value = -1.0f; value <= 1.0f; value += 0.01f)
+    EXPECT_NEAR(fromSnorm(toSnorm<std::int16_t>(value)), value, 0.5f / 32767);
+}
+
+TEST(VertexQuantizationTest, Octahedral) {
+  float maxAngle = 0.0f, maxAngleQuantized = 0.0f;
+
+  for(const auto& normal : makeDirections(10000)) {
+    float oct[2], decoded[3];
+    encodeOctahedral(normal.data(), oct);
+    EXPECT_LE(std::abs(oct[0]), 1.0f);
+    EXPECT_LE(std::abs(oct[1]), 1.0f);
+
+    decodeOctahedral(oct, decoded);
+    maxAngle = std::max(maxAngle, getAngle(normal.data(), decoded));
+
+    // 16-bit storage
+    for(int i = 0; i < 2; ++i)
+      oct[i] = fromSnorm(toSnorm<std::int16_t>(oct[i]));
+    decodeOctahedral(oct, decoded);
+    maxAngleQuantized = std::max(maxAngleQuantized, getAngle(normal.data(), decoded));
+  }
+
+  EXPECT_LT(maxAngle, 1e-3f);
+  EXPECT_LT(maxAngleQuantized, 1e-3f);
+
+  // Zero vectors are mapped to +z
+  float zero[3] = {0, 0, 0}, oct[2], decoded[3];
+  encodeOctahedral(zero, oct);
+  decodeOctahedral(oct, decoded);
+  EXPECT_EQ(decoded[2], 1.0f);
+}
+
+class VertexQuantizationConvertTest : public testing::Test {
+protected:
+  std::vector<Vertex_posf3_norf3_texf2_colu4> vertices;
+
+  virtual void SetUp() override {
+    std::mt19937 gen(0);
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+
+    for(const auto& normal : makeDirections(1000)) {
+      Vertex_posf3_norf3_texf2_colu4 vertex;
+      vertex.Position[0] = 10.0f + 5.0f * dist(gen);
+      vertex.Position[1] = -3.0f + 0.5f * dist(gen);
+      vertex.Position[2] = 100.0f * dist(gen);
+      std::copy(normal.begin(), normal.end(), vertex.Normal);
+      vertex.TexCoord[0] = 4.0f * dist(gen);
+      vertex.TexCoord[1] = 0.5f + 0.5f * dist(gen);
+      for(int i = 0; i < 4; ++i)
+        vertex.Color[i] = static_cast<std::uint8_t>(vertices.size() + i);
+      vertices.push_back(vertex);
+    }
+  }
+
+  template <class VertexType>
+  void checkAttributes(const Vertex_posf3_norf3_texf2_colu4& vertex, const VertexType& quantized) {
+    float oct[2] = {fromSnorm(quantized.Normal[0]), fromSnorm(quantized.Normal[1])};
+    float normal[3];
+    decodeOctahedral(oct, normal);
+    EXPECT_LT(getAngle(vertex.Normal, normal), 1e-3f);
+
+    for(int i = 0; i < 2; ++i)
+      EXPECT_NEAR(float(quantized.TexCoord[i]), vertex.TexCoord[i], 2e-3f);
+
+    for(int i = 0; i < 4; ++i)
+      EXPECT_EQ(quantized.Color[i], vertex.Color[i]);
+  }
+};
+
+TEST_F(VertexQuantizationConvertTest, Vertex_posf3_noro2_texh2_colu4) {
+  static_assert(sizeof(Vertex_posf3_noro2_texh2_colu4) == 24, "unexpected size");
+
+  std::vector<Vertex_posf3_noro2_texh2_colu4> quantized(vertices.size());
+  quantizeVertices(vertices.data(), vertices.size(), quantized.data());
+
+  for(std::size_t i = 0; i < vertices.size(); ++i) {
+    for(int j = 0; j < 3; ++j)
+      EXPECT_EQ(quantized[i].Position[j], vertices[i].Position[j]);
+    checkAttributes(vertices[i], quantized[i]);
+  }
+}
+
+TEST_F(VertexQuantizationConvertTest, Vertex_poss4_noro2_texh2_colu4) {
+  static_assert(sizeof(Vertex_poss4_noro2_texh2_colu4) == 20, "unexpected size");
+
+  std::vector<Vertex_poss4_noro2_texh2_colu4> quantized(vertices.size());
+  PositionDequantization dequantization =
+      quantizeVertices(vertices.data(), vertices.size(), quantized.data());
+
+  for(std::size_t i = 0; i < vertices.size(); ++i) {
+    float normalized[3], position[3];
+    for(int j = 0; j < 3; ++j)
+      normalized[j] = fromSnorm(quantized[i].Position[j]);
+    dequantization.apply(normalized, position);
+
+    // The error is bounded by half a quantization step of the extent
+    for(int j = 0; j < 3; ++j)
+      EXPECT_NEAR(position[j], vertices[i].Position[j], dequantization.Scale[j] * 1e-4f);
+    EXPECT_EQ(quantized[i].Position[3], 32767);
+    checkAttributes(vertices[i], quantized[i]);
+  }
+
+  // Degenerate extents
+  std::vector<Vertex_posf3_norf3_texf2_colu4> flat(2, vertices.front());
+  flat[1].Position[0] += 1.0f;
+  dequantization = quantizeVertices(flat.data(), flat.size(), quantized.data());
+  EXPECT_EQ(dequantization.Scale[1], 1.0f);
+  EXPECT_EQ(dequantization.Offset[1], flat[0].Position[1]);
+  EXPECT_EQ(quantized[0].Position[1], 0);
+  EXPECT_EQ(quantized[0].Position[0], -32767);
+  EXPECT_EQ(quantized[1].Position[0], 32767);
+}
+
+} // anonymous namespace
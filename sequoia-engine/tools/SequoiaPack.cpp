@@ -0,0 +1,97 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                         _____                        _
+//                        / ____|                      (_)
+//                       | (___   ___  __ _ _   _  ___  _  __ _
+//                        \___ \ / _ \/ _` | | | |/ _ \| |/ _` |
+//                        ____) |  __/ (_| | |_| | (_) | | (_| |
+//                       |_____/ \___|\__, |\__,_|\___/|_|\__,_| - Game Engine (2016-2017)
+//                                       | |
+//                                       |_|
+//
+// This file is distributed under the MIT License (MIT).
+// See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#include "sequoia-engine/Core/Archive.h"
+#include "sequoia-engine/Core/CommandLine.h"
+#include "sequoia-engine/Core/ErrorHandler.h"
+#include "sequoia-engine/Core/Exception.h"
+#include "sequoia-engine/Core/Logging.h"
+#include "sequoia-engine/Core/MappedFile.h"
+#include "sequoia-engine/Core/Options.h"
+#include "sequoia-engine/Core/PrettyStackTrace.h"
+#include "sequoia-engine/Core/Timer.h"
+#include <memory>
+
+using namespace sequoia;
+
+/// @brief Pack all files of a directory into an archive which can be served by
+/// `core::ArchiveFileSystem`
+///
+/// @code{.sh}
+///   SequoiaPack --input=assets/ --output=assets.sqpa --compress
+/// @endcode
+int main(int argc, char* argv[]) {
+  core::PrettyStackTrace trace;
+  auto logger = std::make_unique<core::Logger>();
+
+  auto options = std::make_shared<Options>();
+  options->setDefaultString(
+      "Pack.Input", "",
+      OptionMetaData{"input", "i", true, "DIR", "Pack all files of the directory DIR"});
+  options->setDefaultString(
+      "Pack.Output", "assets.sqpa",
+      OptionMetaData{"output", "o", true, "FILE", "Write the archive to FILE"});
+  options->setDefaultBool(
+      "Pack.Compress", false,
+      OptionMetaData{"compress", "c", false, "", "Compress the files (if it saves space)"});
+  options->setDefaultInt("Pack.Alignment", 32,
+                         OptionMetaData{"alignment", "", true, "N",
+                                        "Align the files to N bytes, where N is a power of 2"});
+
+  core::CommandLine cl("SequoiaPack", SEQUOIA_ENGINE_VERSION_STRING);
+  cl.parse(options, argc, argv);
+
+  const std::string input = options->getString("Pack.Input");
+  const std::string output = options->getString("Pack.Output");
+  const bool compress = options->getBool("Pack.Compress");
+  const int alignment = options->getInt("Pack.Alignment");
+
+  if(input.empty())
+    core::ErrorHandler::fatal("SequoiaPack: no input directory (see --help)");
+
+  if(alignment <= 0 || (alignment & (alignment - 1)) != 0)
+    core::ErrorHandler::fatal("SequoiaPack: alignment must be a power of 2");
+
+  try {
+    core::Timer timer;
+    const platform::Path inputPath = platform::asPath(input);
+    if(!platform::filesystem::is_directory(inputPath))
+      SEQUOIA_THROW(core::Exception, "no such directory: \"{}\"", input);
+
+    core::ArchiveWriter writer(alignment);
+    for(platform::filesystem::recursive_directory_iterator it(inputPath), end; it != end; ++it) {
+      if(!platform::filesystem::is_regular_file(it->path()))
+        continue;
+
+      const std::string path =
+          platform::filesystem::relative(it->path(), inputPath).generic_string();
+      Log::debug("Packing \"{}\" ...", path);
+
+      core::MappedFile file(it->path());
+      writer.add(path, file.getData(), file.getNumBytes(), compress);
+    }
+
+    writer.write(platform::asPath(output));
+
+    Log::info("Packed {} files into \"{}\" ({} bytes, {} bytes uncompressed) in {} ms",
+              writer.getNumEntries(), output, writer.getNumBytes(),
+              writer.getNumBytesUncompressed(), timer.stop());
+
+  } catch(core::Exception& exception) {
+    core::ErrorHandler::fatal(exception.what());
+  }
+
+  return 0;
+}